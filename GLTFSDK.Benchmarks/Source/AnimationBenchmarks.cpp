@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/AnimationEvaluator.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+using namespace Microsoft::glTF::Test;
+
+namespace
+{
+    // A translation, rotation and scale animation with state.range(0) keyframes, evaluated at 4096 sorted times
+    struct AnimationScene
+    {
+        explicit AnimationScene(const benchmark::State& state) :
+            readerWriter(std::make_shared<const StreamReaderWriter>()),
+            reader(readerWriter)
+        {
+            SceneGeneratorDesc desc;
+            desc.vertexCount = 4U;
+            desc.animationCount = 1U;
+            desc.keyframeCount = static_cast<size_t>(state.range(0));
+
+            doc = SceneGenerator(desc).Generate(readerWriter);
+
+            const AnimationEvaluator evaluator(doc, reader, doc.animations.Front(), ROTATION_INTERPOLATION_NLERP);
+
+            times.resize(4096U);
+
+            for (size_t i = 0; i < times.size(); ++i)
+            {
+                times[i] = evaluator.GetStartTime() + (evaluator.GetEndTime() - evaluator.GetStartTime()) * i / times.size();
+            }
+        }
+
+        std::shared_ptr<const StreamReaderWriter> readerWriter;
+        GLTFResourceReader reader;
+        Document doc;
+        std::vector<float> times;
+    };
+
+    // A minimal evaluator for LINEAR tracks with NLERP rotations that stores keyframe values either keyframe by keyframe
+    // (x0 y0 z0 x1 y1 z1 ..., as AnimationEvaluator does) or component by component (x0 x1 ... y0 y1 ... z0 z1 ...), to
+    // compare the two layouts without the rest of AnimationEvaluator's work
+    template<bool ComponentMajor>
+    class ReferenceEvaluator
+    {
+    public:
+        explicit ReferenceEvaluator(const AnimationEvaluator& evaluator) :
+            m_tracks(evaluator.GetTracks()),
+            m_times(evaluator.GetTimes()),
+            m_values(evaluator.GetValues().size()),
+            m_outputSize(evaluator.GetOutputSize())
+        {
+            for (const auto& track : m_tracks)
+            {
+                for (size_t k = 0; k < track.keyframeCount; ++k)
+                {
+                    for (size_t c = 0; c < track.componentCount; ++c)
+                    {
+                        m_values[track.valueOffset + GetIndex(track, k, c)] = evaluator.GetValues()[track.valueOffset + k * track.componentCount + c];
+                    }
+                }
+            }
+        }
+
+        void Evaluate(const float* times, size_t count, float* output) const
+        {
+            for (const auto& track : m_tracks)
+            {
+                const float* trackTimes = m_times.data() + track.timeOffset;
+                const float* values = m_values.data() + track.valueOffset;
+
+                size_t k = 0U;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const float time = std::min(std::max(times[i], trackTimes[0]), trackTimes[track.keyframeCount - 1U]);
+
+                    while (k + 2U < track.keyframeCount && trackTimes[k + 1U] <= time)
+                    {
+                        ++k;
+                    }
+
+                    const float s = (time - trackTimes[k]) / (trackTimes[k + 1U] - trackTimes[k]);
+                    float* trackOutput = output + i * m_outputSize + track.outputOffset;
+
+                    for (size_t c = 0; c < track.componentCount; ++c)
+                    {
+                        const float v0 = values[GetIndex(track, k, c)];
+                        const float v1 = values[GetIndex(track, k + 1U, c)];
+
+                        trackOutput[c] = v0 + (v1 - v0) * s;
+                    }
+
+                    if (track.path == TARGET_ROTATION)
+                    {
+                        const float length = std::sqrt(trackOutput[0] * trackOutput[0] + trackOutput[1] * trackOutput[1] + trackOutput[2] * trackOutput[2] + trackOutput[3] * trackOutput[3]);
+
+                        for (size_t c = 0; c < 4U; ++c)
+                        {
+                            trackOutput[c] /= length;
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        static size_t GetIndex(const AnimationTrack& track, size_t keyframe, size_t component)
+        {
+            return ComponentMajor ? component * track.keyframeCount + keyframe : keyframe * track.componentCount + component;
+        }
+
+        std::vector<AnimationTrack> m_tracks;
+        std::vector<float> m_times;
+        std::vector<float> m_values;
+        size_t m_outputSize;
+    };
+
+    void AnimationEvaluator_Evaluate(benchmark::State& state)
+    {
+        const AnimationScene scene(state);
+        const AnimationEvaluator evaluator(scene.doc, scene.reader, scene.doc.animations.Front(), ROTATION_INTERPOLATION_NLERP);
+
+        std::vector<float> output(evaluator.GetOutputSize() * scene.times.size());
+        std::vector<size_t> cursors;
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < scene.times.size(); ++i)
+            {
+                evaluator.Evaluate(scene.times[i], &output[i * evaluator.GetOutputSize()], cursors);
+            }
+
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * scene.times.size()));
+    }
+
+    void AnimationEvaluator_EvaluateBatch(benchmark::State& state)
+    {
+        const AnimationScene scene(state);
+        const AnimationEvaluator evaluator(scene.doc, scene.reader, scene.doc.animations.Front(), ROTATION_INTERPOLATION_NLERP);
+
+        std::vector<float> output(evaluator.GetOutputSize() * scene.times.size());
+
+        for (auto _ : state)
+        {
+            evaluator.Evaluate(scene.times.data(), scene.times.size(), output.data(), 1U);
+
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * scene.times.size()));
+    }
+
+    template<bool ComponentMajor>
+    void AnimationEvaluator_EvaluateBatch_Reference(benchmark::State& state)
+    {
+        const AnimationScene scene(state);
+        const AnimationEvaluator source(scene.doc, scene.reader, scene.doc.animations.Front(), ROTATION_INTERPOLATION_NLERP);
+        const ReferenceEvaluator<ComponentMajor> evaluator(source);
+
+        std::vector<float> output(source.GetOutputSize() * scene.times.size());
+
+        for (auto _ : state)
+        {
+            evaluator.Evaluate(scene.times.data(), scene.times.size(), output.data());
+
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * scene.times.size()));
+    }
+}
+
+BENCHMARK(AnimationEvaluator_Evaluate)->Arg(32)->Arg(1024);
+BENCHMARK(AnimationEvaluator_EvaluateBatch)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(AnimationEvaluator_EvaluateBatch_Reference, false)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(AnimationEvaluator_EvaluateBatch_Reference, true)->Arg(32)->Arg(1024);
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/MemoryUsage.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+// Route every allocation through the SDK's counting allocator so that benchmarks can report peak memory usage with
+// MemoryUsage::AllocationTracker. The overhead (a thread local lookup per allocation) is small compared to malloc.
+GLTFSDK_DEFINE_COUNTING_OPERATOR_NEW()
+
+std::shared_ptr<std::ostream> StreamReaderWriter::GetOutputStream(const std::string& uri) const
+{
+    return GetStream(uri);
+}
+
+std::shared_ptr<std::istream> StreamReaderWriter::GetInputStream(const std::string& uri) const
+{
+    return GetStream(uri);
+}
+
+std::shared_ptr<std::stringstream> StreamReaderWriter::GetStream(const std::string& uri) const
+{
+    auto& stream = m_streams[uri];
+
+    if (!stream)
+    {
+        stream = std::make_shared<std::stringstream>();
+    }
+
+    return stream;
+}
+
+size_t Benchmarks::GetBufferByteLength(const Document& doc)
+{
+    size_t byteLength = 0U;
+
+    for (const auto& buffer : doc.buffers.Elements())
+    {
+        byteLength += buffer.byteLength;
+    }
+
+    return byteLength;
+}
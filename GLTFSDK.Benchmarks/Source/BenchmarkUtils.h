@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/IStreamReader.h>
+#include <GLTFSDK/IStreamWriter.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Benchmarks
+        {
+            // Keeps every stream in memory so that benchmarks measure the SDK rather than the file system
+            class StreamReaderWriter : public IStreamWriter, public IStreamReader
+            {
+            public:
+                std::shared_ptr<std::ostream> GetOutputStream(const std::string& uri) const override;
+                std::shared_ptr<std::istream> GetInputStream(const std::string& uri) const override;
+
+            private:
+                std::shared_ptr<std::stringstream> GetStream(const std::string& uri) const;
+
+                mutable std::unordered_map<std::string, std::shared_ptr<std::stringstream>> m_streams;
+            };
+
+            // The total byte length of the document's buffers
+            size_t GetBufferByteLength(const Document& doc);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+using namespace Microsoft::glTF::Test;
+
+namespace
+{
+    // A single mesh with state.range(0) vertices, interleaved if state.range(1) is non-zero
+    struct MeshScene
+    {
+        explicit MeshScene(const benchmark::State& state) :
+            readerWriter(std::make_shared<const StreamReaderWriter>()),
+            reader(readerWriter)
+        {
+            SceneGeneratorDesc desc;
+            desc.vertexCount = static_cast<size_t>(state.range(0));
+            desc.interleaved = state.range(1) != 0;
+
+            doc = SceneGenerator(desc).Generate(readerWriter);
+        }
+
+        const MeshPrimitive& GetMeshPrimitive() const
+        {
+            return doc.meshes.Front().primitives.front();
+        }
+
+        std::shared_ptr<const StreamReaderWriter> readerWriter;
+        GLTFResourceReader reader;
+        Document doc;
+    };
+
+    void GetIndices32(benchmark::State& state)
+    {
+        const MeshScene scene(state);
+
+        for (auto _ : state)
+        {
+            const auto indices = MeshPrimitiveUtils::GetIndices32(scene.doc, scene.reader, scene.GetMeshPrimitive());
+
+            benchmark::DoNotOptimize(indices.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * scene.doc.accessors[scene.GetMeshPrimitive().indicesAccessorId].count));
+    }
+
+    void GetPositions(benchmark::State& state)
+    {
+        const MeshScene scene(state);
+
+        for (auto _ : state)
+        {
+            const auto positions = MeshPrimitiveUtils::GetPositions(scene.doc, scene.reader, scene.GetMeshPrimitive());
+
+            benchmark::DoNotOptimize(positions.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+    }
+
+    void GetInterleavedVertices(benchmark::State& state)
+    {
+        const MeshScene scene(state);
+
+        VertexLayout layout;
+        layout.elements = {
+            { ACCESSOR_POSITION, VERTEX_FORMAT_FLOAT32, 3U, 0U },
+            { ACCESSOR_NORMAL, VERTEX_FORMAT_SNORM8, 4U, 12U },
+            { ACCESSOR_TEXCOORD_0, VERTEX_FORMAT_FLOAT16, 2U, 16U }
+        };
+        layout.byteStride = 20U;
+
+        for (auto _ : state)
+        {
+            const auto vertices = MeshPrimitiveUtils::GetInterleavedVertices(scene.doc, scene.reader, scene.GetMeshPrimitive(), layout);
+
+            benchmark::DoNotOptimize(vertices.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+    }
+}
+
+BENCHMARK(GetIndices32)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 20 }, { 0 } });
+BENCHMARK(GetPositions)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 20 }, { 0, 1 } });
+BENCHMARK(GetInterleavedVertices)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 20 }, { 0, 1 } });
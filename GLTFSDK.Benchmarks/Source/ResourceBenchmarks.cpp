@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/GLBResourceReader.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MemoryUsage.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+using namespace Microsoft::glTF::Test;
+
+namespace
+{
+    const char* const GLBUri = "scene.glb";
+
+    // Scenes with 16 meshes of state.range(0) vertices each, so that the binary data dominates
+    SceneGeneratorDesc GetDataSceneDesc(const benchmark::State& state)
+    {
+        SceneGeneratorDesc desc;
+        desc.meshCount = 16U;
+        desc.nodeCount = 16U;
+        desc.vertexCount = static_cast<size_t>(state.range(0));
+
+        return desc;
+    }
+
+    size_t ReadAccessors(const Document& doc, const GLTFResourceReader& reader)
+    {
+        size_t byteCount = 0U;
+
+        for (const auto& accessor : doc.accessors.Elements())
+        {
+            if (accessor.componentType == COMPONENT_FLOAT)
+            {
+                const auto data = reader.ReadBinaryData<float>(doc, accessor);
+                byteCount += data.size() * sizeof(float);
+            }
+            else
+            {
+                const auto data = reader.ReadBinaryData<uint32_t>(doc, accessor);
+                byteCount += data.size() * sizeof(uint32_t);
+            }
+        }
+
+        return byteCount;
+    }
+
+    void ReadAccessorsImpl(benchmark::State& state, const SceneGeneratorDesc& desc)
+    {
+        auto readerWriter = std::make_shared<const StreamReaderWriter>();
+        const auto doc = SceneGenerator(desc).Generate(readerWriter);
+
+        GLTFResourceReader reader(readerWriter);
+
+        size_t byteCount = 0U;
+
+        for (auto _ : state)
+        {
+            byteCount += ReadAccessors(doc, reader);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(byteCount));
+
+        MemoryUsage::AllocationTracker tracker;
+        ReadAccessors(doc, reader);
+
+        state.counters["PeakBytes"] = static_cast<double>(tracker.GetPeakBytes());
+    }
+
+    void ReadAccessors_Packed(benchmark::State& state)
+    {
+        ReadAccessorsImpl(state, GetDataSceneDesc(state));
+    }
+
+    void ReadAccessors_Interleaved(benchmark::State& state)
+    {
+        auto desc = GetDataSceneDesc(state);
+        desc.interleaved = true;
+
+        ReadAccessorsImpl(state, desc);
+    }
+
+    void ReadAccessors_Sparse(benchmark::State& state)
+    {
+        auto desc = GetDataSceneDesc(state);
+        desc.sparse = true;
+
+        ReadAccessorsImpl(state, desc);
+    }
+
+    void ReadAccessors_Base64(benchmark::State& state)
+    {
+        auto desc = GetDataSceneDesc(state);
+        desc.base64 = true;
+
+        ReadAccessorsImpl(state, desc);
+    }
+
+    void BufferBuilder_Scene(benchmark::State& state)
+    {
+        const auto desc = GetDataSceneDesc(state);
+
+        size_t byteCount = 0U;
+
+        for (auto _ : state)
+        {
+            BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(std::make_shared<const StreamReaderWriter>()));
+
+            const auto doc = SceneGenerator(desc).Generate(bufferBuilder);
+            byteCount += GetBufferByteLength(doc);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(byteCount));
+    }
+
+    void GLBWrite_Scene(benchmark::State& state)
+    {
+        const SceneGenerator generator(GetDataSceneDesc(state));
+
+        size_t byteCount = 0U;
+
+        for (auto _ : state)
+        {
+            const auto doc = generator.WriteGLB(std::make_shared<const StreamReaderWriter>(), GLBUri);
+            byteCount += GetBufferByteLength(doc);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(byteCount));
+    }
+
+    // Includes parsing the GLB's manifest and reading every accessor
+    void GLBRead_Scene(benchmark::State& state)
+    {
+        auto readerWriter = std::make_shared<const StreamReaderWriter>();
+        SceneGenerator(GetDataSceneDesc(state)).WriteGLB(readerWriter, GLBUri);
+
+        size_t byteCount = 0U;
+
+        for (auto _ : state)
+        {
+            GLBResourceReader reader(readerWriter, readerWriter->GetInputStream(GLBUri));
+
+            const auto doc = Deserialize(reader.GetJson());
+            byteCount += ReadAccessors(doc, reader);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(byteCount));
+    }
+}
+
+BENCHMARK(ReadAccessors_Packed)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(ReadAccessors_Interleaved)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(ReadAccessors_Sparse)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(ReadAccessors_Base64)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BufferBuilder_Scene)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(GLBWrite_Scene)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(GLBRead_Scene)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
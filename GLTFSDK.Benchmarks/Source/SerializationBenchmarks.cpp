@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/MemoryUsage.h>
+#include <GLTFSDK/Serialize.h>
+#include <GLTFSDK/Validation.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+using namespace Microsoft::glTF::Test;
+
+namespace
+{
+    // Scenes with state.range(0) meshes and four nodes per mesh, so that the manifest is dominated by entities
+    // rather than binary data
+    Document CreateManifestScene(const benchmark::State& state)
+    {
+        SceneGeneratorDesc desc;
+        desc.meshCount = static_cast<size_t>(state.range(0));
+        desc.nodeCount = desc.meshCount * 4U;
+        desc.vertexCount = 4U;
+
+        return SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>());
+    }
+
+    void Serialize_Scene(benchmark::State& state)
+    {
+        const auto doc = CreateManifestScene(state);
+
+        size_t byteCount = 0U;
+
+        for (auto _ : state)
+        {
+            const auto json = Serialize(doc);
+            byteCount += json.size();
+
+            benchmark::DoNotOptimize(json.data());
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(byteCount));
+    }
+
+    void DeserializeImpl(benchmark::State& state, SchemaFlags schemaFlags)
+    {
+        const auto json = Serialize(CreateManifestScene(state));
+
+        for (auto _ : state)
+        {
+            auto doc = Deserialize(json, DeserializeFlags::None, schemaFlags);
+
+            benchmark::DoNotOptimize(doc);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+
+        // Measured once, outside of the timed loop: the peak transient allocation of deserializing (which includes the
+        // returned document) and the estimated size of the document itself
+        MemoryUsage::AllocationTracker tracker;
+        const auto doc = Deserialize(json, DeserializeFlags::None, schemaFlags);
+
+        state.counters["PeakBytes"] = static_cast<double>(tracker.GetPeakBytes());
+        state.counters["DocumentBytes"] = static_cast<double>(MemoryUsage::GetDocumentMemoryUsage(doc).GetTotal());
+    }
+
+    void Deserialize_Scene(benchmark::State& state)
+    {
+        DeserializeImpl(state, SchemaFlags::DisableSchemaRoot);
+    }
+
+    // The difference from Deserialize_Scene is the cost of schema validation
+    void Deserialize_Scene_SchemaValidation(benchmark::State& state)
+    {
+        DeserializeImpl(state, SchemaFlags::None);
+    }
+
+    void Validate_Scene(benchmark::State& state)
+    {
+        const auto doc = CreateManifestScene(state);
+
+        for (auto _ : state)
+        {
+            ValidationReport report;
+            Validation::Validate(doc, report);
+
+            benchmark::DoNotOptimize(report);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (doc.accessors.Size() + doc.meshes.Size())));
+    }
+}
+
+BENCHMARK(Serialize_Scene)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Deserialize_Scene)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Deserialize_Scene_SchemaValidation)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Validate_Scene)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMillisecond);
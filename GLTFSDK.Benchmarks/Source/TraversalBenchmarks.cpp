@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/Traverse.h>
+#include <GLTFSDK/Visitor.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <typeindex>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+using namespace Microsoft::glTF::Test;
+
+namespace
+{
+    // Large instanced scenes: state.range(0) nodes sharing 16 meshes, so most meshes are revisited
+    Document CreateInstancedScene(const benchmark::State& state)
+    {
+        SceneGeneratorDesc desc;
+        desc.meshCount = 16U;
+        desc.nodeCount = static_cast<size_t>(state.range(0));
+        desc.vertexCount = 4U;
+
+        return SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>());
+    }
+
+    template<TraversalAlgorithm Algorithm>
+    void Traverse_Scene(benchmark::State& state)
+    {
+        const auto doc = CreateInstancedScene(state);
+
+        for (auto _ : state)
+        {
+            size_t nodeCount = 0U;
+
+            Traverse<Algorithm>(doc, DefaultSceneIndex, [&nodeCount](const Node&, const Node*)
+            {
+                ++nodeCount;
+            });
+
+            benchmark::DoNotOptimize(nodeCount);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * doc.nodes.Size()));
+    }
+
+    void TraverseParallel_Scene(benchmark::State& state)
+    {
+        const auto doc = CreateInstancedScene(state);
+
+        for (auto _ : state)
+        {
+            std::atomic<size_t> nodeCount(0U);
+
+            TraverseParallel(doc, DefaultSceneIndex, [&nodeCount](const Node&, const Node*, size_t)
+            {
+                nodeCount.fetch_add(1U, std::memory_order_relaxed);
+            });
+
+            benchmark::DoNotOptimize(nodeCount.load());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * doc.nodes.Size()));
+    }
+
+    // Dominated by visit state tracking, as every node's mesh (and each mesh's material) is looked up in the visit
+    // state set and all but the first visit of each mesh finds it already visited
+    void Visit_Scene(benchmark::State& state)
+    {
+        const auto doc = CreateInstancedScene(state);
+
+        for (auto _ : state)
+        {
+            size_t newMeshCount = 0U;
+
+            Visit(doc, DefaultSceneIndex, [&newMeshCount](const Mesh&, VisitState visitState, const VisitDefaultAction&)
+            {
+                if (visitState == VisitState::New)
+                {
+                    ++newMeshCount;
+                }
+            });
+
+            benchmark::DoNotOptimize(newMeshCount);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * doc.nodes.Size()));
+    }
+
+    // The visit state tracking Visit used before Detail::VisitStateSet's per-type bitsets - a set of (type, index)
+    // pairs where each index is parsed from the entity's id, so ids must be numeric
+    class ReferenceVisitStateSet
+    {
+    public:
+        template<typename T>
+        VisitState GetVisitState(const T& t) const
+        {
+            return visitStateSet.find({ typeid(T), std::stoul(t.id) }) == visitStateSet.end() ?
+                VisitState::New :
+                VisitState::Duplicate;
+        }
+
+        template<typename T>
+        VisitState SetVisitState(const T& t)
+        {
+            const auto result = visitStateSet.emplace(typeid(T), std::stoul(t.id));
+
+            return result.second ?
+                VisitState::New :
+                VisitState::Duplicate;
+        }
+
+    private:
+        std::set<std::pair<std::type_index, size_t>> visitStateSet;
+    };
+
+    // Makes the same visit state queries and updates as Visit does for each entity, without invoking any callbacks
+    template<typename T>
+    VisitState ReferenceVisit(ReferenceVisitStateSet& visitStateSet, const T& t)
+    {
+        const VisitState visitState = visitStateSet.GetVisitState(t);
+        visitStateSet.SetVisitState(t);
+        return visitState;
+    }
+
+    void ReferenceVisit(const Document& doc, ReferenceVisitStateSet& visitStateSet, const Texture& texture)
+    {
+        ReferenceVisit(visitStateSet, texture);
+
+        if (!texture.imageId.empty())
+        {
+            ReferenceVisit(visitStateSet, doc.images.Get(texture.imageId));
+        }
+
+        if (!texture.samplerId.empty())
+        {
+            ReferenceVisit(visitStateSet, doc.samplers.Get(texture.samplerId));
+        }
+    }
+
+    void ReferenceVisit(const Document& doc, ReferenceVisitStateSet& visitStateSet, const Material& material)
+    {
+        ReferenceVisit(visitStateSet, material);
+
+        for (const auto& textureInfo : material.GetTextures())
+        {
+            if (!textureInfo.first.empty())
+            {
+                ReferenceVisit(doc, visitStateSet, doc.textures.Get(textureInfo.first));
+            }
+        }
+    }
+
+    // Visit_Scene with the previous visit state tracking, for comparison
+    void Visit_Scene_Reference(benchmark::State& state)
+    {
+        const auto doc = CreateInstancedScene(state);
+
+        for (auto _ : state)
+        {
+            size_t newMeshCount = 0U;
+            ReferenceVisitStateSet visitStateSet;
+
+            Traverse<DepthFirst>(doc, DefaultSceneIndex, [&doc, &visitStateSet, &newMeshCount](const Node& node, const Node*)
+            {
+                visitStateSet.SetVisitState(node);
+
+                if (!node.meshId.empty())
+                {
+                    const auto& mesh = doc.meshes.Get(node.meshId);
+
+                    if (ReferenceVisit(visitStateSet, mesh) == VisitState::New)
+                    {
+                        ++newMeshCount;
+                    }
+
+                    for (const auto& meshPrimitive : mesh.primitives)
+                    {
+                        if (!meshPrimitive.materialId.empty())
+                        {
+                            ReferenceVisit(doc, visitStateSet, doc.materials.Get(meshPrimitive.materialId));
+                        }
+                    }
+                }
+
+                if (!node.skinId.empty())
+                {
+                    ReferenceVisit(visitStateSet, doc.skins.Get(node.skinId));
+                }
+
+                if (!node.cameraId.empty())
+                {
+                    ReferenceVisit(visitStateSet, doc.cameras.Get(node.cameraId));
+                }
+            });
+
+            benchmark::DoNotOptimize(newMeshCount);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * doc.nodes.Size()));
+    }
+}
+
+BENCHMARK_TEMPLATE(Traverse_Scene, DepthFirst)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(Traverse_Scene, BreadthFirst)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(TraverseParallel_Scene)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Visit_Scene)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Visit_Scene_Reference)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,643 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "ConversionPipeline.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/GLBResourceReader.h>
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MemoryStreamWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <cassert>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Samples;
+
+namespace
+{
+    // Resolves the uris of external buffers and images relative to the input file's directory
+    class StreamReader : public IStreamReader
+    {
+    public:
+        StreamReader(fs::path pathBase) : m_pathBase(std::move(pathBase))
+        {
+        }
+
+        std::shared_ptr<std::istream> GetInputStream(const std::string& filename) const override
+        {
+            auto streamPath = m_pathBase / fs::u8path(filename);
+            auto stream = std::make_shared<std::ifstream>(streamPath, std::ios_base::binary);
+
+            if (!stream || !(*stream))
+            {
+                throw std::runtime_error("Unable to create a valid input stream for uri: " + filename);
+            }
+
+            return stream;
+        }
+
+    private:
+        fs::path m_pathBase;
+    };
+
+    // A queue between two pipeline stages. Push blocks while the queue is full and Pop blocks while it's empty, until
+    // the queue is closed by the producing stage.
+    template<typename T>
+    class BoundedQueue
+    {
+    public:
+        explicit BoundedQueue(size_t capacity) : m_capacity(capacity), m_isClosed(false)
+        {
+        }
+
+        void Push(T item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_notFull.wait(lock, [this]() { return m_items.size() < m_capacity; });
+            m_items.push_back(std::move(item));
+            m_notEmpty.notify_one();
+        }
+
+        bool Pop(T& item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_notEmpty.wait(lock, [this]() { return !m_items.empty() || m_isClosed; });
+
+            if (m_items.empty())
+            {
+                return false;
+            }
+
+            item = std::move(m_items.front());
+            m_items.pop_front();
+            m_notFull.notify_one();
+
+            return true;
+        }
+
+        void Close()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_isClosed = true;
+            m_notEmpty.notify_all();
+        }
+
+    private:
+        const size_t m_capacity;
+
+        std::mutex m_mutex;
+        std::condition_variable m_notEmpty;
+        std::condition_variable m_notFull;
+        std::deque<T> m_items;
+        bool m_isClosed;
+    };
+
+    // Bounds the estimated memory used by the files in flight (read but not yet written). A file that exceeds the whole
+    // budget is still converted, but only once every other file has been written.
+    //
+    // Each file acquires its whole estimate once, in the read stage, before anything else holds budget on its behalf. A
+    // file that waited for more budget while holding some could deadlock the pipeline: the budget it needs may be held
+    // by files queued behind it, waiting for the very stage it's blocking.
+    class MemoryBudget
+    {
+    public:
+        explicit MemoryBudget(size_t maxBytes) : m_maxBytes(maxBytes), m_bytes(0U)
+        {
+        }
+
+        void Acquire(size_t bytes)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_released.wait(lock, [&]() { return m_bytes + bytes <= m_maxBytes || m_bytes == 0U; });
+            m_bytes += bytes;
+        }
+
+        void Release(size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            assert(bytes <= m_bytes);
+
+            m_bytes -= bytes;
+            m_released.notify_all();
+        }
+
+    private:
+        const size_t m_maxBytes;
+
+        std::mutex m_mutex;
+        std::condition_variable m_released;
+        size_t m_bytes;
+    };
+
+    struct Job
+    {
+        fs::path inputPath;
+        fs::path outputPath;
+        size_t budgetBytes = 0U;
+
+        std::shared_ptr<std::stringstream> input;
+        std::unique_ptr<GLTFResourceReader> resourceReader;
+        Document document;
+        std::shared_ptr<MemoryStreamWriter> output;
+    };
+
+    bool IsGLB(const fs::path& path)
+    {
+        return path.extension() == std::string(".") + GLB_EXTENSION;
+    }
+
+    bool IsGLTF(const fs::path& path)
+    {
+        return path.extension() == std::string(".") + GLTF_EXTENSION;
+    }
+
+    // The mime type of an image that doesn't declare one, from the media type of a data uri or the extension of a file
+    std::string GetImageMimeType(const std::string& uri)
+    {
+        // Data uris have the form data:[<media type>][;base64],<data>
+        if (uri.compare(0U, 5U, "data:") == 0)
+        {
+            const auto mediaType = uri.substr(5U, uri.find_first_of(";,", 5U) - 5U);
+
+            if (mediaType.empty())
+            {
+                throw std::runtime_error("Unable to determine the mime type of an image data uri without a media type");
+            }
+
+            return mediaType;
+        }
+
+        auto extension = fs::u8path(uri).extension().u8string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(::tolower(c)); });
+
+        if (extension == ".png")
+        {
+            return MIMETYPE_PNG;
+        }
+
+        if (extension == ".jpg" || extension == ".jpeg")
+        {
+            return MIMETYPE_JPEG;
+        }
+
+        throw std::runtime_error("Unable to determine the mime type of image uri: " + uri);
+    }
+
+    // The uris of the files referenced by a .gltf manifest - its external buffers and images. The manifest is scanned
+    // for "uri" members rather than deserialized, as this is only used to estimate the memory a file will need before
+    // the parse stage runs.
+    std::vector<std::string> GetExternalUris(const std::string& manifest)
+    {
+        const std::string key = "\"uri\"";
+
+        std::vector<std::string> uris;
+
+        for (size_t i = manifest.find(key); i != std::string::npos; i = manifest.find(key, i))
+        {
+            i = manifest.find_first_not_of(" \t\r\n", i + key.size());
+
+            if (i == std::string::npos || manifest[i] != ':')
+            {
+                continue;
+            }
+
+            i = manifest.find_first_not_of(" \t\r\n", i + 1U);
+
+            if (i == std::string::npos || manifest[i] != '"')
+            {
+                continue;
+            }
+
+            std::string uri;
+
+            for (++i; i < manifest.size() && manifest[i] != '"'; ++i)
+            {
+                // Only escaped characters that may appear in a relative path are handled
+                if (manifest[i] == '\\' && i + 1U < manifest.size())
+                {
+                    ++i;
+                }
+
+                uri += manifest[i];
+            }
+
+            if (uri.compare(0U, 5U, "data:") != 0 && std::find(uris.begin(), uris.end(), uri) == uris.end())
+            {
+                uris.push_back(std::move(uri));
+            }
+        }
+
+        return uris;
+    }
+
+    // Stage 1: reads the whole input file into memory and acquires budget for it. The file's size is tripled to estimate
+    // the memory used by its document, its resources and its converted output. The external files referenced by a .gltf
+    // file are doubled, as they're read and then copied to the output. The estimate is acquired after the file is read,
+    // so at most one file per read thread is in memory outside of the budget.
+    void Read(Job& job, MemoryBudget& budget)
+    {
+        std::ifstream stream(job.inputPath, std::ios_base::binary);
+
+        if (!stream)
+        {
+            throw std::runtime_error("Unable to open the input file");
+        }
+
+        job.input = std::make_shared<std::stringstream>();
+        *job.input << stream.rdbuf();
+
+        size_t budgetBytes = static_cast<size_t>(fs::file_size(job.inputPath)) * 3U;
+
+        if (IsGLTF(job.inputPath))
+        {
+            for (const auto& uri : GetExternalUris(job.input->str()))
+            {
+                // Files that can't be found are reported by the parse or rewrite stage
+                std::error_code error;
+                const auto byteLength = fs::file_size(job.inputPath.parent_path() / fs::u8path(uri), error);
+
+                if (!error)
+                {
+                    budgetBytes += static_cast<size_t>(byteLength) * 2U;
+                }
+            }
+        }
+
+        budget.Acquire(budgetBytes);
+        job.budgetBytes = budgetBytes;
+    }
+
+    // Stage 2: deserializes the manifest (from the GLB's JSON chunk, or the whole .gltf file)
+    void Parse(Job& job)
+    {
+        auto streamReader = std::make_shared<StreamReader>(job.inputPath.parent_path());
+
+        std::string manifest;
+
+        if (IsGLB(job.inputPath))
+        {
+            auto glbResourceReader = std::make_unique<GLBResourceReader>(std::move(streamReader), job.input);
+            manifest = glbResourceReader->GetJson();
+
+            job.resourceReader = std::move(glbResourceReader);
+        }
+        else
+        {
+            manifest = job.input->str();
+
+            job.input.reset();
+            job.resourceReader = std::make_unique<GLTFResourceReader>(std::move(streamReader));
+        }
+
+        job.document = Deserialize(manifest);
+    }
+
+    // Stage 3: copies every buffer view (and, when converting to GLB, every image stored outside of a buffer view) into a
+    // single new buffer, then serializes the updated manifest
+    void Rewrite(Job& job)
+    {
+        const bool isOutputGLB = IsGLB(job.outputPath);
+        const auto outputFilename = job.outputPath.filename().u8string();
+
+        job.output = std::make_shared<MemoryStreamWriter>();
+
+        std::unique_ptr<ResourceWriter> resourceWriter;
+        GLBResourceWriter* glbResourceWriter = nullptr;
+
+        if (isOutputGLB)
+        {
+            auto writer = std::make_unique<GLBResourceWriter>(job.output);
+            glbResourceWriter = writer.get();
+            resourceWriter = std::move(writer);
+        }
+        else
+        {
+            auto writer = std::make_unique<GLTFResourceWriter>(job.output);
+            writer->SetUriPrefix(job.outputPath.stem().u8string() + "_");
+            resourceWriter = std::move(writer);
+        }
+
+        BufferBuilder bufferBuilder(std::move(resourceWriter));
+        bufferBuilder.AddBuffer(isOutputGLB ? GLB_BUFFER_ID : nullptr);
+
+        const Document& source = job.document;
+        const GLTFResourceReader& resourceReader = *job.resourceReader;
+
+        Document document = source;
+        document.buffers.Clear();
+        document.bufferViews.Clear();
+
+        // Buffer views are aligned to 4 bytes, the largest accessor component size
+        const size_t byteAlignment = 4U;
+
+        std::unordered_map<std::string, std::string> bufferViewIds;
+        std::vector<std::pair<std::string, const BufferView*>> copiedBufferViews;
+
+        for (const auto& bufferView : source.bufferViews.Elements())
+        {
+            const auto data = resourceReader.ReadBinaryData<uint8_t>(source, bufferView);
+            const auto& copiedBufferView = bufferBuilder.AddBufferView(data, bufferView.byteStride, bufferView.target, byteAlignment);
+
+            bufferViewIds[bufferView.id] = copiedBufferView.id;
+            copiedBufferViews.emplace_back(copiedBufferView.id, &bufferView);
+        }
+
+        if (isOutputGLB)
+        {
+            for (auto image : source.images.Elements())
+            {
+                if (image.uri.empty())
+                {
+                    continue;
+                }
+
+                const auto data = resourceReader.ReadBinaryData(source, image);
+
+                if (image.mimeType.empty())
+                {
+                    image.mimeType = GetImageMimeType(image.uri);
+                }
+
+                image.uri.clear();
+                image.bufferViewId = bufferBuilder.AddBufferView(data, {}, {}, byteAlignment).id;
+
+                document.images.Replace(std::move(image));
+            }
+        }
+
+        bufferBuilder.Output(document);
+
+        // Restore the properties of the copied buffer views that BufferBuilder doesn't know about
+        for (const auto& copiedBufferView : copiedBufferViews)
+        {
+            BufferView bufferView = document.bufferViews.Get(copiedBufferView.first);
+
+            bufferView.name = copiedBufferView.second->name;
+            bufferView.extensions = copiedBufferView.second->extensions;
+            bufferView.extras = copiedBufferView.second->extras;
+
+            document.bufferViews.Replace(std::move(bufferView));
+        }
+
+        auto remapBufferViewId = [&bufferViewIds](std::string& bufferViewId)
+        {
+            if (!bufferViewId.empty())
+            {
+                bufferViewId = bufferViewIds.at(bufferViewId);
+            }
+        };
+
+        for (auto accessor : source.accessors.Elements())
+        {
+            remapBufferViewId(accessor.bufferViewId);
+            remapBufferViewId(accessor.sparse.indicesBufferViewId);
+            remapBufferViewId(accessor.sparse.valuesBufferViewId);
+
+            document.accessors.Replace(std::move(accessor));
+        }
+
+        for (auto image : source.images.Elements())
+        {
+            // Images embedded by this stage already refer to a new buffer view
+            if (!image.bufferViewId.empty() && image.uri.empty() && bufferViewIds.count(image.bufferViewId))
+            {
+                remapBufferViewId(image.bufferViewId);
+                document.images.Replace(std::move(image));
+            }
+        }
+
+        // The source document and resources are no longer needed
+        job.resourceReader.reset();
+        job.input.reset();
+        job.document = {};
+
+        if (isOutputGLB)
+        {
+            glbResourceWriter->Flush(Serialize(document), outputFilename);
+        }
+        else
+        {
+            *job.output->GetOutputStream(outputFilename) << Serialize(document, SerializeFlags::Pretty);
+        }
+    }
+
+    // Stage 4: writes the converted file (and its buffer) to the output directory
+    void Write(Job& job)
+    {
+        for (const auto& output : job.output->GetStreams())
+        {
+            const auto outputPath = job.outputPath.parent_path() / fs::u8path(output.first);
+
+            std::ofstream stream(outputPath, std::ios_base::binary);
+
+            if (!stream || !(stream << output.second->rdbuf()))
+            {
+                throw std::runtime_error("Unable to write the output file " + outputPath.u8string());
+            }
+        }
+
+        job.output.reset();
+    }
+
+    class ConversionPipeline
+    {
+    public:
+        explicit ConversionPipeline(const ConvertOptions& options) :
+            m_options(options),
+            m_budget(options.maxMemoryBytes),
+            m_parseQueue(options.threadCount * 2U),
+            m_rewriteQueue(options.threadCount * 2U),
+            m_writeQueue(options.ioThreadCount * 2U),
+            m_successCount(0U),
+            m_failureCount(0U)
+        {
+        }
+
+        // Returns the number of files that failed to convert
+        size_t Run(std::vector<Job> jobs)
+        {
+            std::atomic<size_t> nextJob(0U);
+
+            auto readThreads = StartStage(m_options.ioThreadCount, [this, &jobs, &nextJob]()
+            {
+                for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+                {
+                    auto job = std::make_unique<Job>(std::move(jobs[i]));
+
+                    if (RunStep(*job, [this](Job& j) { Read(j, m_budget); }))
+                    {
+                        m_parseQueue.Push(std::move(job));
+                    }
+                }
+            });
+
+            auto parseThreads = StartStage(m_options.threadCount, [this]() { RunStage(m_parseQueue, &m_rewriteQueue, Parse); });
+            auto rewriteThreads = StartStage(m_options.threadCount, [this]() { RunStage(m_rewriteQueue, &m_writeQueue, Rewrite); });
+            auto writeThreads = StartStage(m_options.ioThreadCount, [this]() { RunStage(m_writeQueue, nullptr, Write); });
+
+            // Each stage's queue is closed once the threads of the previous stage have finished
+            Join(readThreads);
+            m_parseQueue.Close();
+            Join(parseThreads);
+            m_rewriteQueue.Close();
+            Join(rewriteThreads);
+            m_writeQueue.Close();
+            Join(writeThreads);
+
+            std::cout << "Converted " << m_successCount << " file(s), " << m_failureCount << " failed\n";
+
+            return m_failureCount;
+        }
+
+    private:
+        typedef BoundedQueue<std::unique_ptr<Job>> JobQueue;
+
+        template<typename Fn>
+        static std::vector<std::thread> StartStage(size_t threadCount, Fn fn)
+        {
+            std::vector<std::thread> threads;
+
+            for (size_t i = 0U; i < std::max<size_t>(threadCount, 1U); ++i)
+            {
+                threads.emplace_back(fn);
+            }
+
+            return threads;
+        }
+
+        static void Join(std::vector<std::thread>& threads)
+        {
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        template<typename Fn>
+        void RunStage(JobQueue& input, JobQueue* output, Fn fn)
+        {
+            std::unique_ptr<Job> job;
+
+            while (input.Pop(job))
+            {
+                if (!RunStep(*job, fn))
+                {
+                    continue;
+                }
+
+                if (output)
+                {
+                    output->Push(std::move(job));
+                }
+                else
+                {
+                    m_budget.Release(job->budgetBytes);
+                    Report(*job, nullptr);
+                }
+            }
+        }
+
+        // Returns false (releasing the job's budget) if the step failed
+        template<typename Fn>
+        bool RunStep(Job& job, Fn fn)
+        {
+            try
+            {
+                fn(job);
+                return true;
+            }
+            catch (const std::exception& ex)
+            {
+                m_budget.Release(job.budgetBytes);
+                Report(job, ex.what());
+                return false;
+            }
+        }
+
+        void Report(const Job& job, const char* error)
+        {
+            std::lock_guard<std::mutex> lock(m_outputMutex);
+
+            if (error)
+            {
+                ++m_failureCount;
+                std::cerr << "Error! - " << job.inputPath.u8string() << ": " << error << "\n";
+            }
+            else
+            {
+                ++m_successCount;
+                std::cout << job.inputPath.filename().u8string() << " -> " << job.outputPath.filename().u8string() << "\n";
+            }
+        }
+
+        const ConvertOptions& m_options;
+
+        MemoryBudget m_budget;
+        JobQueue m_parseQueue;
+        JobQueue m_rewriteQueue;
+        JobQueue m_writeQueue;
+
+        std::mutex m_outputMutex;
+        size_t m_successCount;
+        size_t m_failureCount;
+    };
+
+    std::vector<Job> CreateJobs(const ConvertOptions& options)
+    {
+        std::vector<Job> jobs;
+
+        for (const auto& entry : fs::directory_iterator(options.inputDirectory))
+        {
+            const auto& path = entry.path();
+
+            if (!fs::is_regular_file(path) || !(IsGLB(path) || IsGLTF(path)))
+            {
+                continue;
+            }
+
+            Job job;
+            job.inputPath = path;
+            job.outputPath = options.outputDirectory / path.filename();
+            job.outputPath.replace_extension(IsGLB(path) ? GLTF_EXTENSION : GLB_EXTENSION);
+
+            jobs.push_back(std::move(job));
+        }
+
+        // Convert the largest files first, so that a large file found last doesn't leave the other threads idle
+        std::sort(jobs.begin(), jobs.end(), [](const Job& lhs, const Job& rhs)
+        {
+            return fs::file_size(lhs.inputPath) > fs::file_size(rhs.inputPath);
+        });
+
+        return jobs;
+    }
+}
+
+size_t Samples::ConvertDirectory(const ConvertOptions& options)
+{
+    return ConversionPipeline(options).Run(CreateJobs(options));
+}
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/ParallelUtils.h>
+
+#if __EMSCRIPTEN__
+#include <filesystem>
+namespace fs = std::__fs::filesystem;
+#else
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif ((defined(_MSVC_LANG) && _MSVC_LANG >= 201402L) || __cplusplus >= 201402L)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+    #error "Unsupported C++ standard"
+#endif
+#endif
+
+#include <cstddef>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Samples
+        {
+            struct ConvertOptions
+            {
+                fs::path inputDirectory;
+                fs::path outputDirectory;
+                size_t threadCount = ParallelUtils::GetDefaultThreadCount(); // The number of threads of each of the parse and rewrite stages
+                size_t ioThreadCount = 2U;                                    // The number of threads of each of the read and write stages
+                size_t maxMemoryBytes = 512U * 1024U * 1024U;
+            };
+
+            // Converts every .gltf file in the input directory to .glb, and every .glb file to .gltf (with a single .bin
+            // buffer), writing them to the output directory - which must exist. Files are processed by a pipeline of four
+            // stages - read, parse, rewrite and write - each with its own threads, so that file I/O overlaps with parsing
+            // and rewriting. The number of files in flight is bounded by an estimate of their memory usage.
+            //
+            // Each file is reported to std::cout, or std::cerr if it fails. Returns the number of files that failed.
+            size_t ConvertDirectory(const ConvertOptions& options);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "ConversionPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Samples;
+
+// Converts every .gltf file in a directory to .glb, and every .glb file to .gltf (see ConvertDirectory)
+namespace
+{
+    fs::path MakeAbsolute(fs::path path)
+    {
+        if (path.is_relative())
+        {
+            path = fs::current_path() / path;
+        }
+
+        return path;
+    }
+
+    ConvertOptions ParseOptions(int argc, const std::vector<std::string>& args)
+    {
+        if (argc < 3)
+        {
+            throw std::runtime_error("Usage: Convert <input directory> <output directory> [--threads <count>] [--max-memory <megabytes>]");
+        }
+
+        ConvertOptions options;
+        options.inputDirectory = MakeAbsolute(fs::u8path(args[1U]));
+        options.outputDirectory = MakeAbsolute(fs::u8path(args[2U]));
+
+        for (size_t i = 3U; i < args.size(); i += 2U)
+        {
+            if (i + 1U == args.size())
+            {
+                throw std::runtime_error("Missing value for command line option " + args[i]);
+            }
+
+            const auto value = static_cast<size_t>(std::stoull(args[i + 1U]));
+
+            if (args[i] == "--threads")
+            {
+                options.threadCount = std::max<size_t>(value, 1U);
+            }
+            else if (args[i] == "--max-memory")
+            {
+                options.maxMemoryBytes = value * 1024U * 1024U;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown command line option " + args[i]);
+            }
+        }
+
+        if (!fs::is_directory(options.inputDirectory))
+        {
+            throw std::runtime_error("The input directory doesn't exist");
+        }
+
+        return options;
+    }
+}
+
+#if defined _WIN32 && defined _UNICODE
+int wmain(int argc, wchar_t* argv[])
+#else // _WIN32 & _UNICODE
+int main(int argc, char* argv[])
+#endif
+{
+    try
+    {
+        std::vector<std::string> args;
+
+        for (int i = 0; i < argc; ++i)
+        {
+            args.push_back(fs::path(argv[i]).u8string());
+        }
+
+        const auto options = ParseOptions(argc, args);
+
+        fs::create_directories(options.outputDirectory);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto failureCount = ConvertDirectory(options);
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Elapsed: " << duration.count() << "ms\n";
+
+        if (failureCount > 0U)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Error! - ";
+        std::cerr << ex.what() << "\n";
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
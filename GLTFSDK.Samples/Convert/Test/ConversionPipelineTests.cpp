@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <TestUtilsCommon/UnitTestBridge.h>
+
+#include "ConversionPipeline.h"
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/GLBResourceReader.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MemoryStreamWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+    using namespace Microsoft::glTF::Samples;
+
+    class FileStreamReader : public IStreamReader
+    {
+    public:
+        explicit FileStreamReader(fs::path directory) : m_directory(std::move(directory))
+        {
+        }
+
+        std::shared_ptr<std::istream> GetInputStream(const std::string& uri) const override
+        {
+            return std::make_shared<std::ifstream>(m_directory / fs::u8path(uri), std::ios_base::binary);
+        }
+
+    private:
+        fs::path m_directory;
+    };
+
+    // A uniquely named directory under the system's temporary directory, removed with everything in it on destruction
+    class TemporaryDirectory
+    {
+    public:
+        explicit TemporaryDirectory(const std::string& name) :
+            m_path(fs::temp_directory_path() / (name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())))
+        {
+            fs::create_directories(m_path / "input");
+            fs::create_directories(m_path / "output");
+        }
+
+        ~TemporaryDirectory()
+        {
+            std::error_code error;
+            fs::remove_all(m_path, error);
+        }
+
+        fs::path GetInputPath() const
+        {
+            return m_path / "input";
+        }
+
+        fs::path GetOutputPath() const
+        {
+            return m_path / "output";
+        }
+
+    private:
+        fs::path m_path;
+    };
+
+    void WriteFile(const fs::path& path, const std::string& data)
+    {
+        std::ofstream stream(path, std::ios_base::binary);
+
+        if (!(stream << data))
+        {
+            throw std::runtime_error("Unable to write " + path.u8string());
+        }
+    }
+
+    // Writes a generated scene to 'name'.gltf with its buffer in the external file 'name'.bin
+    Document WriteGLTF(const fs::path& directory, const std::string& name, const Test::SceneGeneratorDesc& desc, Image* image = nullptr)
+    {
+        auto memoryWriter = std::make_shared<MemoryStreamWriter>();
+        auto doc = Test::SceneGenerator(desc).Generate(memoryWriter);
+
+        auto buffer = doc.buffers.Front();
+        WriteFile(directory / (name + ".bin"), memoryWriter->GetData(buffer.uri));
+
+        buffer.uri = name + ".bin";
+        doc.buffers.Replace(buffer);
+
+        if (image)
+        {
+            doc.images.Append(*image);
+        }
+
+        WriteFile(directory / (name + ".gltf"), Serialize(doc));
+
+        return doc;
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(ConversionPipelineTests)
+            {
+                GLTFSDK_TEST_METHOD(ConversionPipelineTests, ConversionPipeline_Test_BuffersExceedBudget)
+                {
+                    const TemporaryDirectory directory("ConversionPipelineTests");
+
+                    // Several .gltf files whose external buffers are each larger than the whole memory budget, so every
+                    // file must wait for all of the others to be written
+                    const size_t fileCount = 6U;
+
+                    SceneGeneratorDesc desc;
+                    desc.vertexCount = 4096U;
+
+                    // An embedded PNG image without a mime type, which must be inferred from its data uri
+                    Image image;
+                    image.id = "0";
+                    image.uri = "data:image/png;base64,iVBORw0KGgo=";
+
+                    std::vector<Document> sources;
+
+                    for (size_t i = 0; i < fileCount; ++i)
+                    {
+                        desc.seed = static_cast<uint32_t>(i);
+                        sources.push_back(WriteGLTF(directory.GetInputPath(), "scene" + std::to_string(i), desc, i == 0U ? &image : nullptr));
+                    }
+
+                    auto options = std::make_shared<ConvertOptions>();
+                    options->inputDirectory = directory.GetInputPath();
+                    options->outputDirectory = directory.GetOutputPath();
+                    options->threadCount = 4U;
+                    options->maxMemoryBytes = fs::file_size(directory.GetInputPath() / "scene0.bin") / 2U;
+
+                    // The conversion runs on its own thread so that a deadlock fails the test rather than hanging it
+                    auto failureCount = std::make_shared<std::promise<size_t>>();
+                    auto result = failureCount->get_future();
+
+                    std::thread([options, failureCount]() { failureCount->set_value(ConvertDirectory(*options)); }).detach();
+
+                    Assert::IsTrue(result.wait_for(std::chrono::seconds(60)) == std::future_status::ready, L"The conversion didn't finish");
+                    Assert::AreEqual<size_t>(0U, result.get());
+
+                    const GLTFResourceReader sourceReader(std::make_shared<FileStreamReader>(directory.GetInputPath()));
+
+                    for (size_t i = 0; i < fileCount; ++i)
+                    {
+                        const auto outputPath = directory.GetOutputPath() / ("scene" + std::to_string(i) + ".glb");
+
+                        Assert::IsTrue(fs::exists(outputPath));
+
+                        GLBResourceReader reader(std::make_shared<FileStreamReader>(directory.GetOutputPath()), std::make_shared<std::ifstream>(outputPath, std::ios_base::binary));
+
+                        const auto doc = Deserialize(reader.GetJson());
+
+                        Assert::AreEqual<size_t>(1U, doc.buffers.Size());
+                        Assert::AreEqual(sources[i].accessors.Size(), doc.accessors.Size());
+
+                        const auto& source = sources[i];
+                        const auto& positionsId = source.meshes.Front().primitives.front().GetAttributeAccessorId(ACCESSOR_POSITION);
+
+                        Assert::IsTrue(sourceReader.ReadBinaryData<float>(source, source.accessors[positionsId]) == reader.ReadBinaryData<float>(doc, doc.accessors[positionsId]));
+
+                        if (i == 0U)
+                        {
+                            const auto& convertedImage = doc.images.Front();
+
+                            Assert::AreEqual<std::string>(MIMETYPE_PNG, convertedImage.mimeType);
+                            Assert::IsTrue(convertedImage.uri.empty());
+                            Assert::IsFalse(convertedImage.bufferViewId.empty());
+                        }
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/AccessorUtils.h>
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+
+#include "TestUtils.h"
+
+#include <cmath>
+#include <cstddef>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(AccessorUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(AccessorUtilsTests, AccessorUtils_Test_ComputeMinMax)
+                {
+                    // Enough elements to be split between several threads
+                    const size_t count = 200000U;
+
+                    std::vector<float> positions;
+                    positions.reserve(count * 3U);
+
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        positions.insert(positions.end(), { static_cast<float>(i), -static_cast<float>(i) * 0.5f, 1.0f });
+                    }
+
+                    positions[1234U * 3U + 2U] = NAN;
+
+                    auto bounds = AccessorUtils::ComputeMinMax(positions.data(), count, 0U, TYPE_VEC3, COMPONENT_FLOAT, 4U);
+
+                    AreEqual({ 0.0f, (count - 1U) * -0.5f, 1.0f }, bounds.min);
+                    AreEqual({ static_cast<float>(count - 1U), 0.0f, 1.0f }, bounds.max);
+
+                    // Every other unsigned short VEC2 element of an interleaved stream
+                    const std::vector<uint16_t> interleaved = { 1U, 9U, 100U, 100U, 5U, 2U, 0U, 0U, 3U, 7U, 100U, 100U };
+
+                    bounds = AccessorUtils::ComputeMinMax(interleaved.data(), 3U, 8U, TYPE_VEC2, COMPONENT_UNSIGNED_SHORT);
+
+                    AreEqual({ 1.0f, 2.0f }, bounds.min);
+                    AreEqual({ 5.0f, 9.0f }, bounds.max);
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        AccessorUtils::ComputeMinMax(interleaved.data(), 3U, 2U, TYPE_VEC2, COMPONENT_UNSIGNED_SHORT);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(AccessorUtilsTests, AccessorUtils_Test_BufferBuilder_ComputeMinMax)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    Assert::IsFalse(bufferBuilder.GetComputeMinMax());
+                    bufferBuilder.SetComputeMinMax(true);
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    auto& indicesAccessor = bufferBuilder.AddAccessor(std::vector<uint16_t>{ 4U, 2U, 7U }, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+
+                    AreEqual({ 2.0f }, indicesAccessor.min);
+                    AreEqual({ 7.0f }, indicesAccessor.max);
+
+                    // Values that are specified explicitly are kept
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto& texCoordsAccessor = bufferBuilder.AddAccessor(std::vector<float>{ 0.25f, 0.5f }, { TYPE_VEC2, COMPONENT_FLOAT, false, { 0.0f, 0.0f }, { 1.0f, 1.0f } });
+
+                    AreEqual({ 0.0f, 0.0f }, texCoordsAccessor.min);
+                    AreEqual({ 1.0f, 1.0f }, texCoordsAccessor.max);
+
+                    // Interleaved positions (VEC3) and colors (normalized unsigned byte VEC4)
+                    struct Vertex
+                    {
+                        float position[3];
+                        uint8_t color[4];
+                    };
+
+                    const std::vector<Vertex> vertices = {
+                        { { -1.0f, 2.0f, 0.0f }, { 255U, 0U, 10U, 255U } },
+                        { { 3.0f, -2.0f, 0.5f }, { 0U, 128U, 20U, 255U } }
+                    };
+
+                    const AccessorDesc descs[] = {
+                        { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, 0U },
+                        { TYPE_VEC4, COMPONENT_UNSIGNED_BYTE, true, {}, {}, offsetof(Vertex, color) }
+                    };
+
+                    std::string ids[2];
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    bufferBuilder.AddAccessors(vertices.data(), vertices.size(), sizeof(Vertex), descs, 2U, ids);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    AreEqual({ -1.0f, -2.0f, 0.0f }, doc.accessors.Get(ids[0]).min);
+                    AreEqual({ 3.0f, 2.0f, 0.5f }, doc.accessors.Get(ids[0]).max);
+                    AreEqual({ 0.0f, 0.0f, 10.0f, 255.0f }, doc.accessors.Get(ids[1]).min);
+                    AreEqual({ 255.0f, 128.0f, 20.0f, 255.0f }, doc.accessors.Get(ids[1]).max);
+                }
+
+                GLTFSDK_TEST_METHOD(AccessorUtilsTests, AccessorUtils_Test_VerifyMinMax)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    bufferBuilder.AddAccessor(std::vector<float>{ 0.0f, 1.0f, 2.0f, 3.0f }, { TYPE_VEC2, COMPONENT_FLOAT, false, { 0.0f, 1.0f }, { 2.0f, 3.0f } });
+                    bufferBuilder.AddAccessor(std::vector<float>{ 0.0f, 1.0f, 2.0f, 3.0f }, { TYPE_VEC2, COMPONENT_FLOAT, false, { 0.0f, 0.0f }, { 2.0f, 3.0f } });
+                    bufferBuilder.AddAccessor(std::vector<float>{ 5.0f, 6.0f }, { TYPE_SCALAR, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto bounds = AccessorUtils::ComputeMinMax(doc, reader);
+
+                    Assert::AreEqual<size_t>(3U, bounds.size());
+                    AreEqual({ 0.0f, 1.0f }, bounds[1].min);
+                    AreEqual({ 5.0f }, bounds[2].min);
+                    AreEqual({ 6.0f }, bounds[2].max);
+
+                    // Only the second accessor specifies min and max values that don't match its data
+                    auto mismatches = AccessorUtils::VerifyMinMax(doc, reader);
+
+                    Assert::AreEqual<size_t>(1U, mismatches.size());
+                    Assert::AreEqual(doc.accessors[1].id, mismatches.front());
+
+                    Assert::IsTrue(AccessorUtils::VerifyMinMax(doc, reader, 1.0f).empty());
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/AnimationEvaluator.h>
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+
+#include "TestUtils.h"
+
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    // Adds a sampler, and a channel targeting node "0", to 'animation'
+    void AddChannel(BufferBuilder& bufferBuilder, Animation& animation, TargetPath path, InterpolationType interpolation,
+        const std::vector<float>& times, const std::vector<float>& values)
+    {
+        AnimationSampler sampler;
+        sampler.id = std::to_string(animation.samplers.Size());
+        sampler.interpolation = interpolation;
+        sampler.inputAccessorId = bufferBuilder.AddAccessor(times, { TYPE_SCALAR, COMPONENT_FLOAT }).id;
+        sampler.outputAccessorId = bufferBuilder.AddAccessor(values, { path == TARGET_ROTATION ? TYPE_VEC4 : (path == TARGET_WEIGHTS ? TYPE_SCALAR : TYPE_VEC3), COMPONENT_FLOAT }).id;
+
+        AnimationChannel channel;
+        channel.id = std::to_string(animation.channels.Size());
+        channel.samplerId = sampler.id;
+        channel.target.nodeId = "0";
+        channel.target.path = path;
+
+        animation.samplers.Append(std::move(sampler));
+        animation.channels.Append(std::move(channel));
+    }
+
+    void AreEqualValues(const std::vector<float>& expected, const float* actual)
+    {
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            Assert::AreEqual(expected[i], actual[i], 0.0001f);
+        }
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(AnimationEvaluatorTests)
+            {
+                GLTFSDK_TEST_METHOD(AnimationEvaluatorTests, AnimationEvaluator_Test_Interpolation)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    Animation animation;
+
+                    AddChannel(bufferBuilder, animation, TARGET_TRANSLATION, INTERPOLATION_LINEAR, { 0.0f, 1.0f, 2.0f }, { 0.0f, 0.0f, 0.0f, 2.0f, 4.0f, 6.0f, 4.0f, 4.0f, 4.0f });
+                    AddChannel(bufferBuilder, animation, TARGET_SCALE, INTERPOLATION_STEP, { 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 2.0f, 2.0f, 2.0f });
+                    AddChannel(bufferBuilder, animation, TARGET_WEIGHTS, INTERPOLATION_LINEAR, { 0.0f, 2.0f }, { 0.0f, 1.0f, 1.0f, 0.0f });
+
+                    // Each cubic spline keyframe is an in-tangent, a value and an out-tangent
+                    AddChannel(bufferBuilder, animation, TARGET_TRANSLATION, INTERPOLATION_CUBICSPLINE, { 0.0f, 1.0f }, {
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+                    AnimationEvaluator evaluator(doc, reader, animation);
+
+                    Assert::AreEqual<size_t>(4U, evaluator.GetTracks().size());
+                    Assert::AreEqual<size_t>(11U, evaluator.GetOutputSize());
+                    Assert::AreEqual<size_t>(2U, evaluator.GetTracks()[2].componentCount);
+                    Assert::AreEqual(0.0f, evaluator.GetStartTime());
+                    Assert::AreEqual(2.0f, evaluator.GetEndTime());
+
+                    std::vector<float> output(evaluator.GetOutputSize());
+                    std::vector<size_t> cursors;
+
+                    evaluator.Evaluate(0.5f, output.data(), cursors);
+
+                    AreEqualValues({ 1.0f, 2.0f, 3.0f }, &output[0]);
+                    AreEqualValues({ 1.0f, 1.0f, 1.0f }, &output[3]);
+                    AreEqualValues({ 0.25f, 0.75f }, &output[6]);
+                    AreEqualValues({ 0.625f, 0.5f, 0.5f }, &output[8]);
+
+                    evaluator.Evaluate(1.5f, output.data(), cursors);
+
+                    AreEqualValues({ 3.0f, 4.0f, 5.0f }, &output[0]);
+                    AreEqualValues({ 2.0f, 2.0f, 2.0f }, &output[3]);
+                    AreEqualValues({ 0.75f, 0.25f }, &output[6]);
+                    AreEqualValues({ 1.0f, 1.0f, 1.0f }, &output[8]);
+
+                    // Times before the first keyframe evaluate to the first value, even with a cursor past that keyframe
+                    evaluator.Evaluate(-1.0f, output.data(), cursors);
+
+                    AreEqualValues({ 0.0f, 0.0f, 0.0f }, &output[0]);
+                    AreEqualValues({ 0.0f, 1.0f }, &output[6]);
+
+                    evaluator.Evaluate(0.25f, output.data(), cursors);
+                    AreEqualValues({ 0.5f, 1.0f, 1.5f }, &output[0]);
+
+                    evaluator.Evaluate(10.0f, output.data());
+                    AreEqualValues({ 4.0f, 4.0f, 4.0f }, &output[0]);
+                }
+
+                GLTFSDK_TEST_METHOD(AnimationEvaluatorTests, AnimationEvaluator_Test_Rotation)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    // Rotates 90 degrees about Z. The second channel's final key is negated, which represents the same rotation.
+                    const float halfAngle = std::sin(3.14159265f / 4.0f);
+
+                    Animation animation;
+
+                    AddChannel(bufferBuilder, animation, TARGET_ROTATION, INTERPOLATION_LINEAR, { 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, halfAngle, halfAngle });
+                    AddChannel(bufferBuilder, animation, TARGET_ROTATION, INTERPOLATION_LINEAR, { 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -halfAngle, -halfAngle });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<float> output(8U);
+
+                    // Slerp rotates at a constant rate so a quarter of the way through is a 22.5 degree rotation
+                    AnimationEvaluator slerpEvaluator(doc, reader, animation);
+                    slerpEvaluator.Evaluate(0.25f, output.data());
+
+                    const float quarterAngle = 3.14159265f / 16.0f;
+                    AreEqualValues({ 0.0f, 0.0f, std::sin(quarterAngle), std::cos(quarterAngle) }, &output[0]);
+                    AreEqualValues({ 0.0f, 0.0f, std::sin(quarterAngle), std::cos(quarterAngle) }, &output[4]);
+
+                    // Nlerp gives a unit quaternion that is close to, but not exactly, the slerp result
+                    AnimationEvaluator nlerpEvaluator(doc, reader, animation, ROTATION_INTERPOLATION_NLERP);
+                    nlerpEvaluator.Evaluate(0.25f, output.data());
+
+                    Assert::AreEqual(1.0f, std::sqrt(output[2] * output[2] + output[3] * output[3]), 0.0001f);
+                    Assert::AreEqual(std::sin(quarterAngle), output[2], 0.01f);
+                    Assert::IsTrue(std::abs(std::sin(quarterAngle) - output[2]) > 0.0001f);
+                    AreEqualValues({ output[0], output[1], output[2], output[3] }, &output[4]);
+                }
+
+                GLTFSDK_TEST_METHOD(AnimationEvaluatorTests, AnimationEvaluator_Test_EvaluateBatch)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    std::vector<float> times;
+                    std::vector<float> translations;
+
+                    for (size_t i = 0; i < 100U; ++i)
+                    {
+                        times.push_back(i * 0.1f);
+                        translations.insert(translations.end(), { std::sin(i * 0.1f), std::cos(i * 0.1f), static_cast<float>(i) });
+                    }
+
+                    Animation animation;
+
+                    AddChannel(bufferBuilder, animation, TARGET_TRANSLATION, INTERPOLATION_LINEAR, times, translations);
+                    AddChannel(bufferBuilder, animation, TARGET_SCALE, INTERPOLATION_STEP, times, translations);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+                    AnimationEvaluator evaluator(doc, reader, animation);
+
+                    // Unsorted times, some outside of the animation's range
+                    std::vector<float> batchTimes;
+
+                    for (size_t i = 0; i < 1000U; ++i)
+                    {
+                        batchTimes.push_back(((i * 7919U) % 1100U) * 0.01f - 0.5f);
+                    }
+
+                    const size_t outputSize = evaluator.GetOutputSize();
+
+                    std::vector<float> batchOutput(batchTimes.size() * outputSize);
+                    evaluator.Evaluate(batchTimes.data(), batchTimes.size(), batchOutput.data(), 4U);
+
+                    std::vector<float> output(outputSize);
+
+                    for (size_t i = 0; i < batchTimes.size(); ++i)
+                    {
+                        evaluator.Evaluate(batchTimes[i], output.data());
+                        AreEqualValues(output, &batchOutput[i * outputSize]);
+                    }
+                }
+            };
+        }
+    }
+}
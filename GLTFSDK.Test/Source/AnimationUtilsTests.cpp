@@ -5,6 +5,7 @@
 #include <typeinfo>
 #include <map>
 
+#include <GLTFSDK/AnimationEvaluator.h>
 #include <GLTFSDK/AnimationUtils.h>
 #include <GLTFSDK/BufferBuilder.h>
 #include <GLTFSDK/GLTF.h>
@@ -14,6 +15,8 @@
 
 #include "TestUtils.h"
 
+#include <cmath>
+
 namespace Microsoft
 {
     namespace glTF
@@ -126,6 +129,37 @@ namespace Microsoft
                     output = AnimationUtils::GetRotations(doc, reader, animationSampler);
                     AreEqual(expectedOutput, output, msg.c_str());
                 }
+
+                // Adds a sampler, and a channel targeting node "0", to 'animation'
+                void AddChannel(BufferBuilder& bufferBuilder, Animation& animation, TargetPath path, InterpolationType interpolation,
+                    const std::vector<float>& times, const std::vector<float>& values)
+                {
+                    AnimationSampler sampler;
+                    sampler.id = std::to_string(animation.samplers.Size());
+                    sampler.interpolation = interpolation;
+                    sampler.inputAccessorId = bufferBuilder.AddAccessor(times, { TYPE_SCALAR, COMPONENT_FLOAT }).id;
+                    sampler.outputAccessorId = bufferBuilder.AddAccessor(values, { path == TARGET_ROTATION ? TYPE_VEC4 : (path == TARGET_WEIGHTS ? TYPE_SCALAR : TYPE_VEC3), COMPONENT_FLOAT }).id;
+
+                    AnimationChannel channel;
+                    channel.id = std::to_string(animation.channels.Size());
+                    channel.samplerId = sampler.id;
+                    channel.target.nodeId = "0";
+                    channel.target.path = path;
+
+                    animation.samplers.Append(std::move(sampler));
+                    animation.channels.Append(std::move(channel));
+                }
+
+                BufferBuilder CreateBufferBuilder(const Document& doc, std::shared_ptr<const StreamReaderWriter> readerWriter)
+                {
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.buffers.Size() + builder.GetBufferCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.bufferViews.Size() + builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    bufferBuilder.AddBuffer();
+                    return bufferBuilder;
+                }
             }
 
             GLTFSDK_TEST_CLASS(AnimationUtilsTests)
@@ -261,6 +295,169 @@ namespace Microsoft
                     VerifyGetRotations<int16_t>(testValues);
                     VerifyGetRotations<uint16_t>(testValuesPositivesOnly);
                 }
+
+                GLTFSDK_TEST_METHOD(AnimationUtilsTests, AnimationUtils_Test_ReduceKeyframes)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    // A key on every frame: a translation that changes direction once, a constant rate rotation about Z,
+                    // a STEP scale that changes once and morph target weights that never change
+                    std::vector<float> times;
+                    std::vector<float> translations;
+                    std::vector<float> rotations;
+                    std::vector<float> scales;
+                    std::vector<float> weights;
+
+                    for (size_t i = 0; i <= 30U; ++i)
+                    {
+                        const float angle = i * 0.05f;
+
+                        times.push_back(i / 30.0f);
+                        translations.insert(translations.end(), { i < 10U ? i * 1.0f : 10.0f, i < 10U ? 0.0f : i - 10.0f, 0.0f });
+                        rotations.insert(rotations.end(), { 0.0f, 0.0f, std::sin(angle), std::cos(angle) });
+                        scales.insert(scales.end(), { i < 20U ? 1.0f : 2.0f, 1.0f, 1.0f });
+                        weights.insert(weights.end(), { 0.5f, 0.25f });
+                    }
+
+                    Animation animation;
+                    animation.id = "animation";
+
+                    AddChannel(bufferBuilder, animation, TARGET_TRANSLATION, INTERPOLATION_LINEAR, times, translations);
+                    AddChannel(bufferBuilder, animation, TARGET_ROTATION, INTERPOLATION_LINEAR, times, rotations);
+                    AddChannel(bufferBuilder, animation, TARGET_SCALE, INTERPOLATION_STEP, times, scales);
+                    AddChannel(bufferBuilder, animation, TARGET_WEIGHTS, INTERPOLATION_LINEAR, times, weights);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto reducedBufferBuilder = CreateBufferBuilder(doc, readerWriter);
+                    auto reduced = AnimationUtils::ReduceKeyframes(doc, reader, animation, reducedBufferBuilder, {}, 2U);
+                    reducedBufferBuilder.Output(doc);
+
+                    Assert::AreEqual(animation.id, reduced.id);
+                    Assert::AreEqual<size_t>(4U, reduced.channels.Size());
+                    Assert::AreEqual<size_t>(4U, reduced.samplers.Size());
+
+                    const std::vector<std::vector<float>> expectedTimes = {
+                        { 0.0f, 10.0f / 30.0f, 1.0f },
+                        { 0.0f, 1.0f },
+                        { 0.0f, 20.0f / 30.0f, 1.0f },
+                        { 0.0f, 1.0f }
+                    };
+
+                    for (size_t i = 0; i < reduced.channels.Size(); ++i)
+                    {
+                        const auto& channel = reduced.channels[i];
+                        const auto& sampler = reduced.samplers.Get(channel.samplerId);
+
+                        Assert::IsTrue(animation.channels[i].target.path == channel.target.path);
+                        Assert::IsTrue(animation.samplers[i].interpolation == sampler.interpolation);
+                        AreEqual(expectedTimes[i], AnimationUtils::GetKeyframeTimes(doc, reader, sampler));
+
+                        // The spec requires min and max for animation sampler inputs
+                        Assert::AreEqual<size_t>(1U, doc.accessors[sampler.inputAccessorId].min.size());
+                    }
+
+                    // The reduced animation evaluates to the original, within tolerance, at every frame
+                    AnimationEvaluator originalEvaluator(doc, reader, animation);
+                    AnimationEvaluator reducedEvaluator(doc, reader, reduced);
+
+                    std::vector<float> expected(originalEvaluator.GetOutputSize());
+                    std::vector<float> actual(reducedEvaluator.GetOutputSize());
+
+                    for (const float time : times)
+                    {
+                        originalEvaluator.Evaluate(time, expected.data());
+                        reducedEvaluator.Evaluate(time, actual.data());
+
+                        for (size_t c = 0; c < expected.size(); ++c)
+                        {
+                            Assert::AreEqual(expected[c], actual[c], 0.001f);
+                        }
+                    }
+
+                    // A larger tolerance removes the corner from the translation channel
+                    KeyframeReductionOptions options;
+                    options.translationTolerance = 10.0f;
+
+                    auto looseBufferBuilder = CreateBufferBuilder(doc, readerWriter);
+                    reduced = AnimationUtils::ReduceKeyframes(doc, reader, animation, looseBufferBuilder, options);
+                    looseBufferBuilder.Output(doc);
+
+                    Assert::AreEqual<size_t>(2U, AnimationUtils::GetKeyframeTimes(doc, reader, reduced.samplers[0]).size());
+                }
+
+                GLTFSDK_TEST_METHOD(AnimationUtilsTests, AnimationUtils_Test_ReduceKeyframes_Resample)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    Animation animation;
+
+                    // Each cubic spline keyframe is an in-tangent, a value and an out-tangent
+                    AddChannel(bufferBuilder, animation, TARGET_TRANSLATION, INTERPOLATION_CUBICSPLINE, { 0.0f, 1.05f }, {
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // Cubic spline channels are left unchanged unless they are resampled
+                    auto emptyBufferBuilder = CreateBufferBuilder(doc, readerWriter);
+                    auto reduced = AnimationUtils::ReduceKeyframes(doc, reader, animation, emptyBufferBuilder);
+
+                    Assert::AreEqual<size_t>(0U, emptyBufferBuilder.GetAccessorCount());
+                    Assert::IsTrue(animation.samplers[0] == reduced.samplers[0]);
+
+                    // Resampling at 10 keys per second with no reduction gives a key every 0.1s plus one at the end time
+                    KeyframeReductionOptions options;
+                    options.sampleRate = 10.0f;
+                    options.translationTolerance = 0.0f;
+
+                    auto resampledBufferBuilder = CreateBufferBuilder(doc, readerWriter);
+                    reduced = AnimationUtils::ReduceKeyframes(doc, reader, animation, resampledBufferBuilder, options);
+                    resampledBufferBuilder.Output(doc);
+
+                    Assert::IsTrue(reduced.samplers[0].interpolation == INTERPOLATION_LINEAR);
+
+                    const auto times = AnimationUtils::GetKeyframeTimes(doc, reader, reduced.samplers[0]);
+
+                    Assert::AreEqual<size_t>(12U, times.size());
+                    Assert::AreEqual(0.5f, times[5], 0.0001f);
+                    Assert::AreEqual(1.05f, times.back());
+
+                    AnimationEvaluator originalEvaluator(doc, reader, animation);
+                    AnimationEvaluator resampledEvaluator(doc, reader, reduced);
+
+                    std::vector<float> expected(3U);
+                    std::vector<float> actual(3U);
+
+                    for (const float time : times)
+                    {
+                        originalEvaluator.Evaluate(time, expected.data());
+                        resampledEvaluator.Evaluate(time, actual.data());
+                        AreEqual(expected, actual);
+                    }
+
+                    // Reduced samplers are written to the current buffer so one is required
+                    auto noBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        AnimationUtils::ReduceKeyframes(doc, reader, animation, noBufferBuilder);
+                    });
+                }
             };
         }
     }
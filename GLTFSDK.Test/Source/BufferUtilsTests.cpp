@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/BufferUtils.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include "TestUtils.h"
+
+#include <initializer_list>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    template<typename T>
+    void AreEqualAccessorData(const Document& expectedDoc, const GLTFResourceReader& expectedReader, const Document& actualDoc, const GLTFResourceReader& actualReader, const std::string& accessorId)
+    {
+        const auto expected = expectedReader.ReadBinaryData<T>(expectedDoc, expectedDoc.accessors[accessorId]);
+        const auto actual = actualReader.ReadBinaryData<T>(actualDoc, actualDoc.accessors[accessorId]);
+
+        Assert::IsTrue(expected == actual, L"Repacked accessor data doesn't match the source");
+    }
+
+    void AreEqualAccessorData(const Document& expectedDoc, const GLTFResourceReader& expectedReader, const Document& actualDoc, const GLTFResourceReader& actualReader)
+    {
+        for (const auto& accessor : actualDoc.accessors.Elements())
+        {
+            switch (accessor.componentType)
+            {
+            case COMPONENT_UNSIGNED_BYTE:
+                AreEqualAccessorData<uint8_t>(expectedDoc, expectedReader, actualDoc, actualReader, accessor.id);
+                break;
+            case COMPONENT_UNSIGNED_SHORT:
+                AreEqualAccessorData<uint16_t>(expectedDoc, expectedReader, actualDoc, actualReader, accessor.id);
+                break;
+            case COMPONENT_UNSIGNED_INT:
+                AreEqualAccessorData<uint32_t>(expectedDoc, expectedReader, actualDoc, actualReader, accessor.id);
+                break;
+            default:
+                AreEqualAccessorData<float>(expectedDoc, expectedReader, actualDoc, actualReader, accessor.id);
+                break;
+            }
+        }
+    }
+
+    Mesh CreateMesh(const std::string& meshId, const std::string& positionsAccessorId)
+    {
+        MeshPrimitive primitive;
+        primitive.attributes[ACCESSOR_POSITION] = positionsAccessorId;
+
+        Mesh mesh;
+        mesh.id = meshId;
+        mesh.primitives.push_back(std::move(primitive));
+
+        return mesh;
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(BufferUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(BufferUtilsTests, BufferUtils_Test_RepackBuffers)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+                    bufferBuilder.AddBuffer();
+
+                    // An unreferenced buffer view
+                    bufferBuilder.AddBufferView(std::vector<uint8_t>{ 1, 2, 3 });
+
+                    // Mesh "1"'s data is written before mesh "0"'s
+                    const std::vector<float> positions1 = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f };
+                    const std::vector<float> positions0 = { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    const auto accessorId1 = bufferBuilder.AddAccessor(positions1, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    const auto accessorId0 = bufferBuilder.AddAccessor(positions0, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    // An unreferenced accessor at the end of mesh "0"'s buffer view
+                    bufferBuilder.AddAccessor(positions1, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    doc.meshes.Append(CreateMesh("0", accessorId0));
+                    doc.meshes.Append(CreateMesh("1", accessorId1));
+
+                    auto repackedReaderWriter = std::make_shared<const StreamReaderWriter>();
+
+                    BufferBuilder repackedBufferBuilder(std::make_unique<GLTFResourceWriter>(repackedReaderWriter));
+                    repackedBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+                    BufferRepackStatistics statistics;
+
+                    const auto repackedDoc = BufferUtils::RepackBuffers(doc, reader, repackedBufferBuilder, {}, &statistics);
+
+                    Assert::AreEqual<size_t>(1U, statistics.removedAccessorCount);
+                    Assert::AreEqual<size_t>(1U, statistics.removedBufferViewCount);
+                    Assert::AreEqual(doc.buffers.Front().byteLength, statistics.sourceByteLength);
+                    Assert::AreEqual<size_t>(72U, statistics.repackedByteLength);
+
+                    Assert::AreEqual<size_t>(1U, repackedDoc.buffers.Size());
+                    Assert::AreEqual<size_t>(72U, repackedDoc.buffers.Front().byteLength);
+                    Assert::AreEqual<size_t>(2U, repackedDoc.bufferViews.Size());
+                    Assert::AreEqual<size_t>(2U, repackedDoc.accessors.Size());
+
+                    // Mesh "0"'s data comes first and its buffer view no longer includes the unreferenced accessor
+                    const auto& bufferView0 = repackedDoc.bufferViews[repackedDoc.accessors[accessorId0].bufferViewId];
+                    const auto& bufferView1 = repackedDoc.bufferViews[repackedDoc.accessors[accessorId1].bufferViewId];
+
+                    Assert::AreEqual<size_t>(0U, bufferView0.byteOffset);
+                    Assert::AreEqual<size_t>(36U, bufferView0.byteLength);
+                    Assert::AreEqual<size_t>(36U, bufferView1.byteOffset);
+                    Assert::AreEqual<size_t>(36U, bufferView1.byteLength);
+                    Assert::IsTrue(bufferView0.target.Get() == BufferViewTarget::ARRAY_BUFFER);
+
+                    AreEqualAccessorData(doc, reader, repackedDoc, GLTFResourceReader(repackedReaderWriter));
+                }
+
+                GLTFSDK_TEST_METHOD(BufferUtilsTests, BufferUtils_Test_RepackBuffers_SceneGenerator)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.meshCount = 3U;
+                    desc.vertexCount = 64U;
+                    desc.morphTargetCount = 1U;
+                    desc.sparse = true;
+                    desc.animationCount = 2U;
+                    desc.interleaved = true;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    const auto doc = SceneGenerator(desc).Generate(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    for (const bool removeUnused : { true, false })
+                    {
+                        for (const bool groupByMesh : { true, false })
+                        {
+                            BufferRepackOptions options;
+                            options.removeUnused = removeUnused;
+                            options.groupByMesh = groupByMesh;
+                            options.byteAlignment = 16U;
+
+                            auto repackedReaderWriter = std::make_shared<const StreamReaderWriter>();
+
+                            BufferBuilder repackedBufferBuilder(std::make_unique<GLTFResourceWriter>(repackedReaderWriter));
+                            repackedBufferBuilder.AddBuffer();
+
+                            const auto repackedDoc = BufferUtils::RepackBuffers(doc, reader, repackedBufferBuilder, options);
+
+                            Assert::AreEqual(doc.accessors.Size(), repackedDoc.accessors.Size());
+                            Assert::AreEqual(doc.bufferViews.Size(), repackedDoc.bufferViews.Size());
+
+                            for (const auto& bufferView : repackedDoc.bufferViews.Elements())
+                            {
+                                Assert::AreEqual<size_t>(0U, bufferView.byteOffset % 16U);
+                            }
+
+                            AreEqualAccessorData(doc, reader, repackedDoc, GLTFResourceReader(repackedReaderWriter));
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(BufferUtilsTests, BufferUtils_Test_RepackBuffers_ExtensionReferences)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.vertexCount = 16U;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    auto doc = SceneGenerator(desc).Generate(readerWriter);
+                    doc.extensionsUsed.insert("EXT_meshopt_compression");
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto repackedReaderWriter = std::make_shared<const StreamReaderWriter>();
+
+                    BufferBuilder repackedBufferBuilder(std::make_unique<GLTFResourceWriter>(repackedReaderWriter));
+                    repackedBufferBuilder.AddBuffer();
+
+                    // The extension's references to buffer views would be left dangling
+                    Assert::ExpectException<InvalidGLTFException>([&]()
+                    {
+                        BufferUtils::RepackBuffers(doc, reader, repackedBufferBuilder);
+                    });
+
+                    // Unless the caller opts in to updating them itself
+                    BufferRepackOptions options;
+                    options.allowExtensionReferences = true;
+
+                    const auto repackedDoc = BufferUtils::RepackBuffers(doc, reader, repackedBufferBuilder, options);
+
+                    Assert::AreEqual(doc.accessors.Size(), repackedDoc.accessors.Size());
+                    Assert::IsTrue(repackedDoc.extensionsUsed.count("EXT_meshopt_compression") > 0U);
+
+                    AreEqualAccessorData(doc, reader, repackedDoc, GLTFResourceReader(repackedReaderWriter));
+                }
+            };
+        }
+    }
+}
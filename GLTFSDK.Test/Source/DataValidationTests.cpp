@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/DataValidation.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include "TestUtils.h"
+
+#include <limits>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                // Creates a document with a single skinned, indexed triangle (without joints, which aren't needed by the checks)
+                Document CreateTriangle(std::shared_ptr<const StreamReaderWriter> readerWriter, const std::vector<float>& positions,
+                    std::vector<float> positionsMin, std::vector<float> positionsMax, const std::vector<uint16_t>& indices, const std::vector<float>& weights)
+                {
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+                    bufferBuilder.AddBuffer();
+
+                    MeshPrimitive meshPrimitive;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, std::move(positionsMin), std::move(positionsMax) }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    meshPrimitive.indicesAccessorId = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_WEIGHTS_0] = bufferBuilder.AddAccessor(weights, { TYPE_VEC4, COMPONENT_FLOAT }).id;
+
+                    Mesh mesh;
+                    mesh.id = "0";
+                    mesh.primitives.push_back(std::move(meshPrimitive));
+
+                    Document doc;
+                    doc.meshes.Append(std::move(mesh));
+
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(DataValidationTests)
+            {
+                GLTFSDK_TEST_METHOD(DataValidationTests, DataValidation_Test_Valid)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    const auto doc = CreateTriangle(readerWriter,
+                        { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f },
+                        { 0U, 1U, 2U },
+                        { 1.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.25f, 0.25f, 0.25f, 0.25f });
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    ValidationReport report;
+
+                    Validation::Validate(doc);
+                    Validation::ValidateData(doc, reader, report);
+
+                    Assert::IsTrue(report.GetIssues().empty());
+                }
+
+                GLTFSDK_TEST_METHOD(DataValidationTests, DataValidation_Test_Issues)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    // The positions contain a NaN and their x maximum isn't the declared value, an index is out of
+                    // range and the weights of the last vertex sum to 0.7
+                    const auto doc = CreateTriangle(readerWriter,
+                        { 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, std::numeric_limits<float>::quiet_NaN(), 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f },
+                        { 0U, 1U, 3U },
+                        { 1.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.5f, 0.2f, 0.0f, 0.0f });
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // The document is structurally valid
+                    Validation::Validate(doc);
+
+                    const auto& primitive = doc.meshes.Front().primitives.front();
+                    const auto positionsId = primitive.GetAttributeAccessorId(ACCESSOR_POSITION);
+                    const auto weightsId = primitive.GetAttributeAccessorId(ACCESSOR_WEIGHTS_0);
+
+                    // Every issue is reported, in accessor order
+                    ValidationReport report;
+                    Validation::ValidateData(doc, reader, report, {}, 2U);
+
+                    auto issues = report.GetIssues();
+
+                    Assert::AreEqual<size_t>(4U, issues.size());
+                    Assert::AreEqual(positionsId, issues[0].entityId);
+                    Assert::AreEqual(positionsId, issues[1].entityId);
+                    Assert::AreEqual(primitive.indicesAccessorId, issues[2].entityId);
+                    Assert::AreEqual(weightsId, issues[3].entityId);
+
+                    Assert::IsTrue(issues[0].message.find("non-finite") != std::string::npos);
+                    Assert::IsTrue(issues[3].message.find("element 2") != std::string::npos);
+
+                    Assert::AreEqual<std::string>("/accessors/0/max/0", issues[1].pointer);
+                    Assert::IsTrue(issues[3].severity == ValidationSeverity::Warning);
+                    Assert::AreEqual<size_t>(3U, report.GetIssueCount(ValidationSeverity::Error));
+
+                    // Checks can be disabled individually
+                    DataValidationOptions options;
+                    options.checkFinite = false;
+                    options.checkWeights = false;
+
+                    ValidationReport partialReport;
+                    Validation::ValidateData(doc, reader, partialReport, options);
+
+                    issues = partialReport.GetIssues();
+
+                    Assert::AreEqual<size_t>(2U, issues.size());
+                    Assert::AreEqual(positionsId, issues[0].entityId);
+                    Assert::AreEqual(primitive.indicesAccessorId, issues[1].entityId);
+                }
+
+                GLTFSDK_TEST_METHOD(DataValidationTests, DataValidation_Test_HugeCount)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    auto doc = CreateTriangle(readerWriter,
+                        { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f },
+                        { 0U, 1U, 2U },
+                        { 1.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.25f, 0.25f, 0.25f, 0.25f });
+
+                    const size_t hugeCount = std::numeric_limits<size_t>::max() / 8U;
+
+                    // A count far larger than the buffer view is reported rather than allocated
+                    Accessor huge = doc.accessors.Front();
+                    huge.id = "huge";
+                    huge.count = hugeCount;
+                    doc.accessors.Append(std::move(huge));
+
+                    // Accessors without a buffer view are zero, which is checked without materializing the data
+                    Accessor zero;
+                    zero.id = "zero";
+                    zero.type = TYPE_VEC3;
+                    zero.componentType = COMPONENT_FLOAT;
+                    zero.count = hugeCount;
+                    zero.min = { 0.0f, 0.0f, 0.0f };
+                    zero.max = { 0.0f, 0.0f, 0.0f };
+                    doc.accessors.Append(zero);
+
+                    zero.id = "zeroMax";
+                    zero.max = { 1.0f, 0.0f, 0.0f };
+                    doc.accessors.Append(std::move(zero));
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    ValidationReport report;
+                    Validation::ValidateData(doc, reader, report);
+
+                    const auto issues = report.GetIssues();
+
+                    Assert::AreEqual<size_t>(2U, issues.size());
+                    Assert::AreEqual<std::string>("huge", issues[0].entityId);
+                    Assert::IsTrue(issues[0].message.find("can't be read") != std::string::npos);
+                    Assert::AreEqual<std::string>("zeroMax", issues[1].entityId);
+                    Assert::AreEqual<std::string>("/accessors/5/max/0", issues[1].pointer);
+
+                    // Sparse accessors without a buffer view combine the zeros with their sparse values
+                    SceneGeneratorDesc desc;
+                    desc.vertexCount = 64U;
+                    desc.morphTargetCount = 2U;
+                    desc.sparse = true;
+
+                    const auto sparseReaderWriter = std::make_shared<const StreamReaderWriter>();
+                    const auto sparseDoc = SceneGenerator(desc).Generate(sparseReaderWriter);
+
+                    ValidationReport sparseReport;
+                    Validation::ValidateData(sparseDoc, GLTFResourceReader(sparseReaderWriter), sparseReport);
+
+                    Assert::IsTrue(sparseReport.GetIssues().empty());
+                }
+            };
+        }
+    }
+}
@@ -5,12 +5,14 @@
 
 #include <GLTFSDK/BufferBuilder.h>
 #include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/GLTFResourceReader.h>
 #include <GLTFSDK/GLTFResourceWriter.h>
 #include <GLTFSDK/MeshPrimitiveUtils.h>
 #include <GLTFSDK/Serialize.h>
 
 #include "TestUtils.h"
 
+#include <cstring>
 #include <map>
 
 using namespace glTF::UnitTest;
@@ -604,6 +606,39 @@ namespace Microsoft
                     Assert::AreEqual(expectedBufferBuilderMultiple, gltfManifest.c_str());
                 }
 
+                GLTFSDK_TEST_METHOD(GLTFResourceWriterTests, BufferBuilderBufferViewAlignment)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    std::vector<uint8_t> bytes = { 1, 2, 3 };
+                    std::vector<float> floats = { 1.0f, 2.0f };
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(bytes);
+
+                    const auto bufferView = bufferBuilder.AddBufferView(floats, {}, {}, 4U);
+
+                    Assert::AreEqual<size_t>(4U, bufferView.byteOffset);
+                    Assert::AreEqual<size_t>(8U, bufferView.byteLength);
+
+                    Assert::ExpectException<InvalidGLTFException>([&]()
+                    {
+                        bufferBuilder.AddBufferView(floats, {}, {}, 0U);
+                    });
+
+                    Document gltfDocument;
+                    bufferBuilder.Output(gltfDocument);
+
+                    Assert::AreEqual<size_t>(12U, gltfDocument.buffers.Front().byteLength);
+
+                    GLTFResourceReader reader(readerWriter);
+                    const auto data = reader.ReadBinaryData<uint8_t>(gltfDocument, gltfDocument.bufferViews[bufferView.id]);
+
+                    Assert::AreEqual<size_t>(8U, data.size());
+                    Assert::AreEqual(0, std::memcmp(data.data(), floats.data(), data.size()));
+                }
+
                 GLTFSDK_TEST_METHOD(GLTFResourceWriterTests, BufferBuilderAccessor)
                 {
                     auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(std::make_shared<const StreamReaderWriter>()));
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IOStatistics.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include "TestUtils.h"
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(IOStatisticsTests)
+            {
+                GLTFSDK_TEST_METHOD(IOStatisticsTests, IOStatistics_Test_ReaderWriter)
+                {
+                    const auto processStatistics = IOCounters::GetProcessStatistics();
+
+                    SceneGeneratorDesc desc;
+                    desc.meshCount = 1U;
+                    desc.vertexCount = 32U;
+                    desc.interleaved = true;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+                    const auto doc = SceneGenerator(desc).Generate(bufferBuilder);
+
+                    const auto writerStatistics = bufferBuilder.GetResourceWriter().GetIOStatistics();
+
+                    Assert::AreEqual<uint64_t>(doc.buffers.Front().byteLength, writerStatistics.bytesWritten);
+                    Assert::AreEqual<uint64_t>(1U, writerStatistics.cacheMissCount);
+                    Assert::AreEqual<uint64_t>(writerStatistics.writeCount - 1U, writerStatistics.cacheHitCount);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto& primitive = doc.meshes.Front().primitives.front();
+
+                    // Interleaved data is read with a seek and a read per element
+                    reader.ReadBinaryData<float>(doc, doc.accessors[primitive.GetAttributeAccessorId(ACCESSOR_POSITION)]);
+
+                    auto readerStatistics = reader.GetIOStatistics();
+
+                    Assert::AreEqual<uint64_t>(32U * 3U * sizeof(float), readerStatistics.bytesRead);
+                    Assert::AreEqual<uint64_t>(32U, readerStatistics.readCount);
+                    Assert::AreEqual<uint64_t>(32U, readerStatistics.seekCount);
+                    Assert::AreEqual<uint64_t>(1U, readerStatistics.cacheMissCount);
+                    Assert::AreEqual<uint64_t>(0U, readerStatistics.cacheHitCount);
+
+                    const auto indices = reader.ReadBinaryData<uint32_t>(doc, doc.accessors[primitive.indicesAccessorId]);
+
+                    readerStatistics = reader.GetIOStatistics();
+
+                    Assert::AreEqual<uint64_t>(32U * 3U * sizeof(float) + indices.size() * sizeof(uint32_t), readerStatistics.bytesRead);
+                    Assert::AreEqual<uint64_t>(33U, readerStatistics.readCount);
+                    Assert::AreEqual<uint64_t>(34U, readerStatistics.seekCount);
+                    Assert::AreEqual<uint64_t>(1U, readerStatistics.cacheHitCount);
+                    Assert::AreEqual<uint64_t>(0U, readerStatistics.base64BytesDecoded);
+
+                    // Every instance's counts are also added to the process-wide totals
+                    const auto processDelta = IOCounters::GetProcessStatistics();
+
+                    Assert::AreEqual(processStatistics.bytesRead + readerStatistics.bytesRead, processDelta.bytesRead);
+                    Assert::AreEqual(processStatistics.bytesWritten + writerStatistics.bytesWritten, processDelta.bytesWritten);
+                    Assert::AreEqual(processStatistics.cacheMissCount + readerStatistics.cacheMissCount + writerStatistics.cacheMissCount, processDelta.cacheMissCount);
+
+                    reader.ResetIOStatistics();
+
+                    Assert::IsTrue(reader.GetIOStatistics() == IOStatistics());
+                    Assert::IsTrue(IOCounters::GetProcessStatistics() == processDelta);
+                }
+
+                GLTFSDK_TEST_METHOD(IOStatisticsTests, IOStatistics_Test_CacheEviction)
+                {
+                    auto cache = MakeStreamReaderCache<StreamReaderCacheLRU>(std::make_shared<const StreamReaderWriter>(), 1U);
+
+                    cache->Get("a");
+                    cache->Get("a");
+                    cache->Get("b");
+                    cache->Get("a");
+
+                    const auto statistics = cache->GetIOStatistics();
+
+                    Assert::AreEqual<uint64_t>(1U, statistics.cacheHitCount);
+                    Assert::AreEqual<uint64_t>(3U, statistics.cacheMissCount);
+                    Assert::AreEqual<uint64_t>(2U, statistics.cacheEvictionCount);
+                    Assert::AreEqual<uint64_t>(0U, statistics.bytesRead);
+                }
+
+                GLTFSDK_TEST_METHOD(IOStatisticsTests, IOStatistics_Test_Base64)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.meshCount = 1U;
+                    desc.vertexCount = 32U;
+                    desc.base64 = true;
+
+                    const auto doc = SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>());
+
+                    GLTFResourceReader reader(std::make_shared<const StreamReaderWriter>());
+
+                    const auto& primitive = doc.meshes.Front().primitives.front();
+                    reader.ReadBinaryData<float>(doc, doc.accessors[primitive.GetAttributeAccessorId(ACCESSOR_POSITION)]);
+
+                    const auto statistics = reader.GetIOStatistics();
+
+                    Assert::AreEqual<uint64_t>(32U * 3U * sizeof(float), statistics.base64BytesDecoded);
+                    Assert::AreEqual<uint64_t>(0U, statistics.bytesRead);
+                    Assert::AreEqual<uint64_t>(0U, statistics.readCount);
+                    Assert::AreEqual<uint64_t>(0U, statistics.cacheMissCount);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Instrumentation.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include "TestUtils.h"
+
+#include <sstream>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(InstrumentationTests)
+            {
+                GLTFSDK_TEST_METHOD(InstrumentationTests, Instrumentation_Test_SummarySink)
+                {
+                    auto sink = std::make_shared<Instrumentation::SummarySink>();
+
+                    {
+                        Instrumentation::ScopedSink scopedSink(sink);
+
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            Instrumentation::ScopedTimer timer("Scope");
+                            Instrumentation::AddCounter("Counter", 5);
+                        }
+                    }
+
+                    // Nothing is recorded once the ScopedSink is destroyed (and there is no global sink)
+                    Instrumentation::AddCounter("Counter", 100);
+
+                    const auto scopes = sink->GetScopes();
+                    const auto counters = sink->GetCounters();
+
+                    Assert::AreEqual<size_t>(1U, scopes.size());
+                    Assert::AreEqual<size_t>(3U, scopes.at("Scope").count);
+                    Assert::AreEqual<size_t>(3U, counters.at("Counter").count);
+                    Assert::AreEqual<int64_t>(15, counters.at("Counter").total);
+
+                    sink->Clear();
+
+                    Assert::IsTrue(sink->GetScopes().empty());
+                }
+
+                GLTFSDK_TEST_METHOD(InstrumentationTests, Instrumentation_Test_ChromeTraceSink)
+                {
+                    auto stream = std::make_shared<std::stringstream>();
+
+                    {
+                        auto sink = std::make_shared<Instrumentation::ChromeTraceSink>(stream);
+
+                        Instrumentation::ScopedSink scopedSink(sink);
+
+                        {
+                            Instrumentation::ScopedTimer timer("Load \"asset\"");
+                            Instrumentation::AddCounter("Bytes", 1024);
+                        }
+                    }
+
+                    const auto trace = stream->str();
+
+                    Assert::AreEqual<size_t>(0U, trace.find("[\n"));
+                    Assert::IsTrue(trace.find("{\"name\":\"Load \\\"asset\\\"\",\"ph\":\"X\"") != std::string::npos);
+                    Assert::IsTrue(trace.find("\"name\":\"Bytes\",\"ph\":\"C\"") != std::string::npos);
+                    Assert::IsTrue(trace.find("\"args\":{\"value\":1024}}") != std::string::npos);
+                    Assert::AreEqual<size_t>(trace.size() - 3U, trace.rfind("\n]\n"));
+
+                    // A trace without events is still a valid JSON array
+                    auto emptyStream = std::make_shared<std::stringstream>();
+                    Instrumentation::ChromeTraceSink(emptyStream).Flush();
+
+                    Assert::AreEqual<std::string>("[]\n", emptyStream->str());
+                }
+
+                GLTFSDK_TEST_METHOD(InstrumentationTests, Instrumentation_Test_ReadBinaryData)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.meshCount = 1U;
+                    desc.vertexCount = 32U;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    const auto doc = SceneGenerator(desc).Generate(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto sink = std::make_shared<Instrumentation::SummarySink>();
+
+                    {
+                        Instrumentation::ScopedSink scopedSink(sink);
+
+                        const auto& primitive = doc.meshes.Front().primitives.front();
+                        reader.ReadBinaryData<float>(doc, doc.accessors[primitive.GetAttributeAccessorId(ACCESSOR_POSITION)]);
+                    }
+
+                    const auto scopes = sink->GetScopes();
+                    const auto counters = sink->GetCounters();
+
+#if GLTFSDK_ENABLE_INSTRUMENTATION
+                    Assert::AreEqual<size_t>(1U, scopes.at("GLTFResourceReader::ReadBinaryData").count);
+                    Assert::AreEqual<int64_t>(32 * 3 * sizeof(float), counters.at("GLTFResourceReader::BytesRead").total);
+#else
+                    // The SDK's instrumentation is compiled out
+                    Assert::IsTrue(scopes.empty());
+                    Assert::IsTrue(counters.empty());
+#endif
+                }
+            };
+        }
+    }
+}
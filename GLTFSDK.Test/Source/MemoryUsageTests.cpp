@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/MemoryUsage.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include "TestUtils.h"
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(MemoryUsageTests)
+            {
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, MemoryUsage_Test_Document)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.nodeCount = 10U;
+                    desc.meshCount = 2U;
+                    desc.vertexCount = 4U;
+                    desc.extensionDensity = 1.0f;
+
+                    auto doc = SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>());
+
+                    const auto usage = MemoryUsage::GetDocumentMemoryUsage(doc);
+
+                    Assert::IsTrue(usage.nodes >= doc.nodes.Size() * sizeof(Node));
+                    Assert::IsTrue(usage.accessors >= doc.accessors.Size() * sizeof(Accessor));
+                    Assert::IsTrue(usage.extensions > 0U);
+                    Assert::AreEqual<size_t>(0U, usage.cameras);
+
+                    // Long strings are counted in their container and by kind
+                    const std::string name(200U, 'n');
+                    const std::string extras(300U, 'e');
+
+                    Node node = doc.nodes.Front();
+                    node.name = name;
+                    node.extras = extras;
+                    doc.nodes.Replace(node);
+
+                    const auto updatedUsage = MemoryUsage::GetDocumentMemoryUsage(doc);
+                    const size_t addedBytes = (doc.nodes.Front().name.capacity() + 1U) + (doc.nodes.Front().extras.capacity() + 1U);
+
+                    Assert::AreEqual(usage.nodes + addedBytes, updatedUsage.nodes);
+                    Assert::AreEqual(usage.strings + doc.nodes.Front().name.capacity() + 1U, updatedUsage.strings);
+                    Assert::AreEqual(usage.extras + doc.nodes.Front().extras.capacity() + 1U, updatedUsage.extras);
+                    Assert::AreEqual(usage.GetTotal() + addedBytes, updatedUsage.GetTotal());
+                    Assert::AreEqual(usage.meshes, updatedUsage.meshes);
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, MemoryUsage_Test_AllocationTracker)
+                {
+                    MemoryUsage::AllocationTracker outer;
+
+                    MemoryUsage::RecordAllocation(100U);
+
+                    {
+                        MemoryUsage::AllocationTracker inner;
+
+                        MemoryUsage::RecordAllocation(50U);
+                        MemoryUsage::RecordDeallocation(150U);
+
+                        Assert::AreEqual<int64_t>(-100, inner.GetCurrentBytes());
+                        Assert::AreEqual<size_t>(50U, inner.GetPeakBytes());
+                        Assert::AreEqual<size_t>(1U, inner.GetAllocationCount());
+                    }
+
+                    // Allocations made after the inner tracker is destroyed are only reported to the outer tracker
+                    MemoryUsage::RecordAllocation(10U);
+
+                    Assert::AreEqual<int64_t>(10, outer.GetCurrentBytes());
+                    Assert::AreEqual<size_t>(150U, outer.GetPeakBytes());
+                    Assert::AreEqual<size_t>(3U, outer.GetAllocationCount());
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, MemoryUsage_Test_CountingAllocate)
+                {
+                    MemoryUsage::AllocationTracker tracker;
+
+                    void* first = MemoryUsage::CountingAllocate(1000U);
+                    void* second = MemoryUsage::CountingAllocate(24U, std::nothrow);
+
+                    Assert::IsTrue(reinterpret_cast<uintptr_t>(second) % alignof(std::max_align_t) == 0U);
+
+                    MemoryUsage::CountingFree(first);
+
+                    void* third = MemoryUsage::CountingAllocate(0U);
+
+                    MemoryUsage::CountingFree(second);
+                    MemoryUsage::CountingFree(third);
+                    MemoryUsage::CountingFree(nullptr);
+
+                    Assert::AreEqual<int64_t>(0, tracker.GetCurrentBytes());
+                    Assert::AreEqual<size_t>(1024U, tracker.GetPeakBytes());
+                    Assert::AreEqual<size_t>(3U, tracker.GetAllocationCount());
+                }
+            };
+        }
+    }
+}
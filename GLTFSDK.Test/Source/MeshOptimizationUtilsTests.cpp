@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/MeshOptimizationUtils.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+
+#include <TestUtilsCommon/MeshGenerator.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    // Deterministically shuffles the triangles of a triangle list (keeping each triangle's winding)
+    void ShuffleTriangles(std::vector<uint32_t>& indices)
+    {
+        uint32_t state = 12345U;
+        const size_t triangleCount = indices.size() / 3U;
+
+        for (size_t i = triangleCount - 1U; i > 0U; --i)
+        {
+            state = state * 1664525U + 1013904223U;
+            const size_t j = state % (i + 1U);
+
+            std::swap_ranges(indices.begin() + i * 3U, indices.begin() + i * 3U + 3U, indices.begin() + j * 3U);
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> GetSortedTriangles(const std::vector<uint32_t>& indices)
+    {
+        std::vector<std::array<uint32_t, 3>> triangles;
+
+        for (size_t i = 0; i < indices.size(); i += 3U)
+        {
+            triangles.push_back({ { indices[i], indices[i + 1U], indices[i + 2U] } });
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(MeshOptimizationUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(MeshOptimizationUtilsTests, MeshOptimizationUtils_Test_OptimizeVertexCache)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(32U, positions, indices);
+                    ShuffleTriangles(indices);
+
+                    const size_t vertexCount = positions.size() / 3U;
+                    auto output = MeshOptimizationUtils::OptimizeVertexCache(indices, vertexCount);
+
+                    Assert::IsTrue(GetSortedTriangles(indices) == GetSortedTriangles(output));
+
+                    const float acmrBefore = MeshOptimizationUtils::GetAverageCacheMissRatio(indices, vertexCount);
+                    const float acmrAfter = MeshOptimizationUtils::GetAverageCacheMissRatio(output, vertexCount);
+
+                    // A shuffled grid misses almost every vertex, an optimized grid approaches 0.5 - 0.7 misses per triangle
+                    Assert::IsTrue(acmrAfter < 0.8f);
+                    Assert::IsTrue(acmrAfter < acmrBefore * 0.5f);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizationUtilsTests, MeshOptimizationUtils_Test_OptimizeOverdraw)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(32U, positions, indices);
+                    ShuffleTriangles(indices);
+
+                    const size_t vertexCount = positions.size() / 3U;
+                    const float threshold = 1.05f;
+
+                    auto optimized = MeshOptimizationUtils::OptimizeVertexCache(indices, vertexCount);
+                    auto output = MeshOptimizationUtils::OptimizeOverdraw(optimized, positions, threshold);
+
+                    Assert::IsTrue(GetSortedTriangles(indices) == GetSortedTriangles(output));
+
+                    const float acmrBefore = MeshOptimizationUtils::GetAverageCacheMissRatio(optimized, vertexCount);
+                    const float acmrAfter = MeshOptimizationUtils::GetAverageCacheMissRatio(output, vertexCount);
+
+                    // Cluster boundaries use a cold cache so allow a little slack beyond the threshold
+                    Assert::IsTrue(acmrAfter <= acmrBefore * threshold * 1.1f);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizationUtilsTests, MeshOptimizationUtils_Test_OptimizeVertexFetchRemap)
+                {
+                    std::vector<uint32_t> indices = { 2U, 1U, 0U, 2U, 3U, 1U };
+
+                    auto remap = MeshOptimizationUtils::OptimizeVertexFetchRemap(indices, 5U);
+
+                    std::vector<uint32_t> expectedRemap = { 2U, 1U, 0U, 3U, 4U };
+                    AreEqual(expectedRemap, remap);
+
+                    auto output = MeshOptimizationUtils::RemapIndices(indices, remap);
+
+                    std::vector<uint32_t> expectedIndices = { 0U, 1U, 2U, 0U, 3U, 1U };
+                    AreEqual(expectedIndices, output);
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        MeshOptimizationUtils::OptimizeVertexFetchRemap(indices, 3U);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizationUtilsTests, MeshOptimizationUtils_Test_OptimizeMeshPrimitive)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(8U, positions, indices);
+                    ShuffleTriangles(indices);
+
+                    const size_t vertexCount = positions.size() / 3U;
+
+                    // An unsigned byte VEC3 attribute requires padding to keep vertex elements 4-byte aligned
+                    std::vector<uint8_t> colors;
+
+                    for (size_t i = 0; i < vertexCount; ++i)
+                    {
+                        colors.insert(colors.end(), { static_cast<uint8_t>(i), static_cast<uint8_t>(i * 2U), static_cast<uint8_t>(i * 3U) });
+                    }
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT });
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 0.0f }, { 8.0f, 8.0f, 0.0f } });
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto colorsAccessor = bufferBuilder.AddAccessor(colors, { TYPE_VEC3, COMPONENT_UNSIGNED_BYTE, true });
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_COLOR_0] = colorsAccessor.id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    // The optimized accessors are written to a second buffer, ids must not collide with those already in the document
+                    auto optimizedBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.buffers.Size() + builder.GetBufferCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.bufferViews.Size() + builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    optimizedBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto optimized = MeshOptimizationUtils::OptimizeMeshPrimitive(doc, reader, meshPrimitive, optimizedBufferBuilder);
+                    optimizedBufferBuilder.Output(doc);
+
+                    Assert::IsTrue(optimized.mode == MESH_TRIANGLES);
+                    Assert::IsTrue(doc.accessors.Get(optimized.indicesAccessorId).componentType == COMPONENT_UNSIGNED_SHORT);
+                    Assert::IsTrue(doc.accessors.Get(optimized.attributes[ACCESSOR_POSITION]).max == positionsAccessor.max);
+
+                    auto outputIndices = MeshPrimitiveUtils::GetIndices32(doc, reader, optimized);
+                    auto outputPositions = MeshPrimitiveUtils::GetPositions(doc, reader, optimized);
+                    auto outputColors = reader.ReadBinaryData<uint8_t>(doc, doc.accessors.Get(optimized.attributes[ACCESSOR_COLOR_0]));
+
+                    // Every triangle must reference the same vertex data as before, in the same winding order
+                    auto getTriangleData = [](const std::vector<uint32_t>& triangleIndices, const std::vector<float>& p, const std::vector<uint8_t>& c)
+                    {
+                        std::vector<std::vector<float>> triangles;
+
+                        for (size_t i = 0; i < triangleIndices.size(); i += 3U)
+                        {
+                            std::vector<float> triangle;
+
+                            for (size_t j = 0; j < 3U; ++j)
+                            {
+                                const uint32_t index = triangleIndices[i + j];
+                                triangle.insert(triangle.end(), { p[index * 3U], p[index * 3U + 1U], p[index * 3U + 2U] });
+                                triangle.insert(triangle.end(), { static_cast<float>(c[index * 3U]), static_cast<float>(c[index * 3U + 1U]), static_cast<float>(c[index * 3U + 2U]) });
+                            }
+
+                            triangles.push_back(triangle);
+                        }
+
+                        std::sort(triangles.begin(), triangles.end());
+                        return triangles;
+                    };
+
+                    Assert::IsTrue(getTriangleData(indices, positions, colors) == getTriangleData(outputIndices, outputPositions, outputColors));
+
+                    // Vertices are ordered by first use
+                    std::vector<uint32_t> firstUse;
+
+                    for (const auto index : outputIndices)
+                    {
+                        if (std::find(firstUse.begin(), firstUse.end(), index) == firstUse.end())
+                        {
+                            firstUse.push_back(index);
+                        }
+                    }
+
+                    for (size_t i = 0; i < firstUse.size(); ++i)
+                    {
+                        Assert::AreEqual<uint32_t>(static_cast<uint32_t>(i), firstUse[i]);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizationUtilsTests, MeshOptimizationUtils_Test_GenerateVertexRemap)
+                {
+                    std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f,
+                        1.0f, 0.001f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f
+                    };
+
+                    std::vector<uint16_t> values = { 1U, 1U, 1U, 1U, 1U, 2U };
+
+                    std::vector<VertexStream> streams = {
+                        { positions.data(), COMPONENT_FLOAT, 3U },
+                        { values.data(), COMPONENT_UNSIGNED_SHORT, 1U }
+                    };
+
+                    size_t uniqueVertexCount = 0U;
+                    auto remap = MeshOptimizationUtils::GenerateVertexRemap(streams, 6U, uniqueVertexCount);
+
+                    std::vector<uint32_t> expected = { 0U, 1U, 0U, 2U, 3U, 4U };
+                    AreEqual(expected, remap);
+                    Assert::AreEqual<size_t>(5U, uniqueVertexCount);
+
+                    // With an epsilon the nearly identical vertices 1 and 3 are also welded. Results must not depend on the thread count
+                    for (size_t threadCount = 1U; threadCount <= 4U; ++threadCount)
+                    {
+                        remap = MeshOptimizationUtils::GenerateVertexRemap(streams, 6U, uniqueVertexCount, 0.01f, threadCount);
+
+                        expected = { 0U, 1U, 0U, 1U, 2U, 3U };
+                        AreEqual(expected, remap);
+                        Assert::AreEqual<size_t>(4U, uniqueVertexCount);
+                    }
+
+                    // Two copies of a grid, large enough that every thread's chunk of vertices spans several shards
+                    std::vector<uint32_t> gridIndices;
+                    positions.clear();
+                    CreateGrid(32U, positions, gridIndices);
+                    const std::vector<float> gridPositions = positions;
+                    positions.insert(positions.end(), gridPositions.begin(), gridPositions.end());
+
+                    const size_t gridVertexCount = positions.size() / 6U;
+                    const std::vector<VertexStream> gridStreams = { { positions.data(), COMPONENT_FLOAT, 3U } };
+
+                    for (size_t threadCount = 1U; threadCount <= 4U; ++threadCount)
+                    {
+                        remap = MeshOptimizationUtils::GenerateVertexRemap(gridStreams, gridVertexCount * 2U, uniqueVertexCount, 0.0f, threadCount);
+
+                        Assert::AreEqual(gridVertexCount, uniqueVertexCount);
+
+                        for (size_t i = 0; i < gridVertexCount; ++i)
+                        {
+                            Assert::AreEqual<uint32_t>(static_cast<uint32_t>(i), remap[i]);
+                            Assert::AreEqual<uint32_t>(static_cast<uint32_t>(i), remap[i + gridVertexCount]);
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizationUtilsTests, MeshOptimizationUtils_Test_WeldVertices)
+                {
+                    // A non-indexed quad - vertices 3 and 4 duplicate vertices 2 and 1, except that vertex 4 differs in the morph target
+                    std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        1.0f, 1.0f, 0.0f
+                    };
+
+                    std::vector<float> targetPositions = {
+                        0.0f, 0.0f, 1.0f,
+                        0.0f, 0.0f, 1.0f,
+                        0.0f, 0.0f, 1.0f,
+                        0.0f, 0.0f, 1.0f,
+                        0.0f, 0.0f, 2.0f,
+                        0.0f, 0.0f, 1.0f
+                    };
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f } });
+                    auto targetPositionsAccessor = bufferBuilder.AddAccessor(targetPositions, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 2.0f } });
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+
+                    MorphTarget target;
+                    target.positionsAccessorId = targetPositionsAccessor.id;
+                    meshPrimitive.targets.push_back(target);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    auto weldedBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.buffers.Size() + builder.GetBufferCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.bufferViews.Size() + builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    weldedBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto welded = MeshOptimizationUtils::WeldVertices(doc, reader, meshPrimitive, weldedBufferBuilder);
+                    weldedBufferBuilder.Output(doc);
+
+                    auto outputIndices = MeshPrimitiveUtils::GetIndices32(doc, reader, welded);
+                    std::vector<uint32_t> expectedIndices = { 0U, 1U, 2U, 2U, 3U, 4U };
+                    AreEqual(expectedIndices, outputIndices);
+
+                    auto outputPositions = MeshPrimitiveUtils::GetPositions(doc, reader, welded);
+                    std::vector<float> expectedPositions = {
+                        0.0f, 0.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        1.0f, 1.0f, 0.0f
+                    };
+                    AreEqual(expectedPositions, outputPositions);
+
+                    auto outputTargetPositions = MeshPrimitiveUtils::GetPositions(doc, reader, welded.targets.front());
+                    Assert::AreEqual<size_t>(15U, outputTargetPositions.size());
+                    Assert::AreEqual(2.0f, outputTargetPositions[11]);
+
+                    std::vector<float> expectedMax = { 0.0f, 0.0f, 2.0f };
+                    AreEqual(expectedMax, doc.accessors.Get(welded.targets.front().positionsAccessorId).max);
+                }
+            };
+        }
+    }
+}
@@ -10,8 +10,14 @@
 #include <GLTFSDK/IStreamWriter.h>
 #include <GLTFSDK/MeshPrimitiveUtils.h>
 
+#include <TestUtilsCommon/SceneGenerator.h>
+
 #include "TestUtils.h"
 
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+
 using namespace glTF::UnitTest;
 
 namespace Microsoft
@@ -1709,6 +1715,298 @@ namespace Microsoft
 
                     AreEqual(outputIndices, indices);
                 }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetInterleavedVertices)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<float> positions = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    std::vector<float> normals = { 0.0f, 0.0f, 1.0f, -1.0f, 0.5f, 0.0f };
+                    auto normalsAccessor = bufferBuilder.AddAccessor(normals, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    std::vector<uint8_t> texCoords = { 0U, 255U, 255U, 51U };
+                    auto texCoordsAccessor = bufferBuilder.AddAccessor(texCoords, { TYPE_VEC2, COMPONENT_UNSIGNED_BYTE, true });
+
+                    std::vector<float> colors = { 1.0f, 0.0f, 0.2f, 2.0f, -1.0f, 0.5f };
+                    auto colorsAccessor = bufferBuilder.AddAccessor(colors, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_NORMAL] = normalsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_TEXCOORD_0] = texCoordsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_COLOR_0] = colorsAccessor.id;
+
+                    VertexLayout layout;
+                    layout.elements.emplace_back(ACCESSOR_POSITION, VERTEX_FORMAT_FLOAT32, 3U, 0U);
+                    layout.elements.emplace_back(ACCESSOR_NORMAL, VERTEX_FORMAT_FLOAT16, 3U, 12U);
+                    layout.elements.emplace_back(ACCESSOR_TEXCOORD_0, VERTEX_FORMAT_FLOAT32, 2U, 20U);
+                    layout.elements.emplace_back(ACCESSOR_COLOR_0, VERTEX_FORMAT_UNORM8, 4U, 28U);
+                    layout.byteStride = 32U;
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto output = MeshPrimitiveUtils::GetInterleavedVertices(doc, reader, meshPrimitive, layout);
+
+                    Assert::AreEqual<size_t>(64U, output.size());
+
+                    for (size_t i = 0; i < 2U; ++i)
+                    {
+                        const uint8_t* vertex = output.data() + i * layout.byteStride;
+
+                        float position[3];
+                        std::memcpy(position, vertex, sizeof(position));
+
+                        uint16_t normal[3];
+                        std::memcpy(normal, vertex + 12U, sizeof(normal));
+
+                        float texCoord[2];
+                        std::memcpy(texCoord, vertex + 20U, sizeof(texCoord));
+
+                        for (size_t c = 0; c < 3U; ++c)
+                        {
+                            Assert::AreEqual(positions[i * 3U + c], position[c]);
+                            Assert::AreEqual(normals[i * 3U + c], Math::HalfToFloat(normal[c]));
+                        }
+
+                        for (size_t c = 0; c < 2U; ++c)
+                        {
+                            Assert::AreEqual(texCoords[i * 2U + c] / 255.0f, texCoord[c]);
+                        }
+                    }
+
+                    // Color values are clamped to [0,1] and the missing alpha component defaults to 1
+                    std::vector<uint8_t> outputColors(output.begin() + 28U, output.begin() + 32U);
+                    outputColors.insert(outputColors.end(), output.begin() + 60U, output.end());
+
+                    std::vector<uint8_t> expectedColors = { 255U, 0U, 51U, 255U, 255U, 0U, 128U, 255U };
+                    AreEqual(expectedColors, outputColors);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetInterleavedVertices_OptionalAttribute)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<float> positions = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+
+                    VertexLayout layout;
+                    layout.elements.emplace_back(ACCESSOR_POSITION, VERTEX_FORMAT_UINT16, 2U, 0U);
+                    layout.elements.emplace_back(ACCESSOR_COLOR_0, VERTEX_FORMAT_UINT8, 4U, 4U, false);
+                    layout.byteStride = 8U;
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto output = MeshPrimitiveUtils::GetInterleavedVertices(doc, reader, meshPrimitive, layout);
+
+                    std::vector<uint16_t> outputPositions(4U);
+                    std::memcpy(&outputPositions[0], output.data(), 4U);
+                    std::memcpy(&outputPositions[2], output.data() + 8U, 4U);
+
+                    std::vector<uint16_t> expectedPositions = { 0U, 1U, 3U, 4U };
+                    AreEqual(expectedPositions, outputPositions);
+
+                    std::vector<uint8_t> outputColors(output.begin() + 4U, output.begin() + 8U);
+                    std::vector<uint8_t> expectedColors = { 0U, 0U, 0U, 1U };
+                    AreEqual(expectedColors, outputColors);
+
+                    // Marking the missing attribute as required causes the decode to fail
+                    layout.elements.back().required = true;
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        MeshPrimitiveUtils::GetInterleavedVertices(doc, reader, meshPrimitive, layout);
+                    });
+
+                    // Elements must lie within the layout's stride
+                    layout.elements.back().required = false;
+                    layout.byteStride = 6U;
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        MeshPrimitiveUtils::GetInterleavedVertices(doc, reader, meshPrimitive, layout);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetInterleavedVertices_Chunked)
+                {
+                    // Enough vertices that each attribute is read in several chunks, from strided and base64 encoded buffers
+                    for (const bool base64 : { false, true })
+                    {
+                        SceneGeneratorDesc desc;
+                        desc.vertexCount = 4096U;
+                        desc.interleaved = true;
+                        desc.base64 = base64;
+
+                        auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                        const auto doc = SceneGenerator(desc).Generate(readerWriter);
+                        const auto& meshPrimitive = doc.meshes.Front().primitives.front();
+
+                        VertexLayout layout;
+                        layout.elements.emplace_back(ACCESSOR_POSITION, VERTEX_FORMAT_FLOAT32, 3U, 0U);
+                        layout.elements.emplace_back(ACCESSOR_TEXCOORD_0, VERTEX_FORMAT_FLOAT32, 2U, 12U);
+                        layout.byteStride = 20U;
+
+                        GLTFResourceReader reader(readerWriter);
+                        const auto output = MeshPrimitiveUtils::GetInterleavedVertices(doc, reader, meshPrimitive, layout);
+
+                        const auto positions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+                        const auto texCoords = MeshPrimitiveUtils::GetTexCoords_0(doc, reader, meshPrimitive);
+
+                        Assert::AreEqual(positions.size() / 3U * layout.byteStride, output.size());
+
+                        for (size_t i = 0; i < positions.size() / 3U; ++i)
+                        {
+                            float vertex[5];
+                            std::memcpy(vertex, output.data() + i * layout.byteStride, sizeof(vertex));
+
+                            Assert::IsTrue(std::memcmp(vertex, &positions[i * 3U], 3U * sizeof(float)) == 0);
+                            Assert::IsTrue(std::memcmp(vertex + 3U, &texCoords[i * 2U], 2U * sizeof(float)) == 0);
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetInterleavedVertices_UInt32Clamp)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<float> positions = { 5.0e9f, -1.0f, 7.0f, 4294967295.0f, std::numeric_limits<float>::quiet_NaN(), 1.0f };
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+
+                    VertexLayout layout;
+                    layout.elements.emplace_back(ACCESSOR_POSITION, VERTEX_FORMAT_UINT32, 3U, 0U);
+                    layout.byteStride = 12U;
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto output = MeshPrimitiveUtils::GetInterleavedVertices(doc, reader, meshPrimitive, layout);
+
+                    std::vector<uint32_t> outputPositions(6U);
+                    std::memcpy(outputPositions.data(), output.data(), output.size());
+
+                    // Values are clamped to [0, UINT32_MAX] and NaN encodes as zero
+                    std::vector<uint32_t> expectedPositions = { std::numeric_limits<uint32_t>::max(), 0U, 7U, std::numeric_limits<uint32_t>::max(), 0U, 1U };
+                    AreEqual(expectedPositions, outputPositions);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetJointsAndWeights)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint8_t> joints = {
+                        1, 2, 3, 4,
+                        250, 0, 17, 255
+                    };
+                    auto jointsAccessor = bufferBuilder.AddAccessor(joints, { TYPE_VEC4, COMPONENT_UNSIGNED_BYTE });
+
+                    std::vector<uint16_t> joints16 = {
+                        1, 2, 3, 4,
+                        1000, 0, 17, 65535
+                    };
+                    auto joints16Accessor = bufferBuilder.AddAccessor(joints16, { TYPE_VEC4, COMPONENT_UNSIGNED_SHORT });
+
+                    std::vector<float> weights = {
+                        0.5f, 0.25f, 0.25f, 0.0f,
+                        1.0f, 0.0f, 0.0f, 0.0f
+                    };
+                    auto weightsAccessor = bufferBuilder.AddAccessor(weights, { TYPE_VEC4, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint32_t> expectedJoints32 = { 0x04030201U, 0xFF1100FAU };
+                    AreEqual(expectedJoints32, MeshPrimitiveUtils::GetJointIndices32(doc, reader, jointsAccessor));
+
+                    std::vector<uint64_t> expectedJoints64 = { 0x0004000300020001ULL, 0xFFFF0011000003E8ULL };
+                    AreEqual(expectedJoints64, MeshPrimitiveUtils::GetJointIndices64(doc, reader, joints16Accessor));
+
+                    std::vector<uint32_t> expectedWeights32 = { 0x00404080U, 0x000000FFU };
+                    AreEqual(expectedWeights32, MeshPrimitiveUtils::GetJointWeights32(doc, reader, weightsAccessor));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetJointsAndWeightsSoA)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint16_t> joints = {
+                        1, 2, 3, 4,
+                        1000, 0, 17, 65535
+                    };
+                    auto jointsAccessor = bufferBuilder.AddAccessor(joints, { TYPE_VEC4, COMPONENT_UNSIGNED_SHORT });
+
+                    std::vector<uint8_t> weights = {
+                        255, 0, 0, 0,
+                        51, 102, 102, 0
+                    };
+                    auto weightsAccessor = bufferBuilder.AddAccessor(weights, { TYPE_VEC4, COMPONENT_UNSIGNED_BYTE, true });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_JOINTS_0] = jointsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_WEIGHTS_0] = weightsAccessor.id;
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto outputJoints = MeshPrimitiveUtils::GetJointIndicesSoA_0(doc, reader, meshPrimitive);
+
+                    AreEqual({ 1U, 1000U }, outputJoints[0]);
+                    AreEqual({ 2U, 0U }, outputJoints[1]);
+                    AreEqual({ 3U, 17U }, outputJoints[2]);
+                    AreEqual({ 4U, 65535U }, outputJoints[3]);
+
+                    auto outputWeights = MeshPrimitiveUtils::GetJointWeightsSoA_0(doc, reader, meshPrimitive);
+
+                    AreEqual({ 1.0f, 0.2f }, outputWeights[0]);
+                    AreEqual({ 0.0f, 0.4f }, outputWeights[1]);
+                    AreEqual({ 0.0f, 0.4f }, outputWeights[2]);
+                    AreEqual({ 0.0f, 0.0f }, outputWeights[3]);
+
+                    // Joint indices must be VEC4
+                    Accessor vec3Accessor = jointsAccessor;
+                    vec3Accessor.type = TYPE_VEC3;
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        MeshPrimitiveUtils::GetJointIndicesSoA(doc, reader, vec3Accessor);
+                    });
+                }
             };
         }
     }
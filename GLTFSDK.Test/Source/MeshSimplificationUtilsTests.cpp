@@ -0,0 +1,294 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/MeshSimplificationUtils.h>
+
+#include <TestUtilsCommon/MeshGenerator.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    // Sum of the signed areas (z component of the normal) of all triangles in the XY plane
+    float GetSignedArea(const std::vector<uint32_t>& indices, const std::vector<float>& positions)
+    {
+        float area = 0.0f;
+
+        for (size_t i = 0; i < indices.size(); i += 3U)
+        {
+            const float* p0 = &positions[indices[i] * 3U];
+            const float* p1 = &positions[indices[i + 1U] * 3U];
+            const float* p2 = &positions[indices[i + 2U] * 3U];
+
+            area += 0.5f * ((p1[0] - p0[0]) * (p2[1] - p0[1]) - (p1[1] - p0[1]) * (p2[0] - p0[0]));
+        }
+
+        return area;
+    }
+
+    // A closed unit sphere centered on the origin with a single vertex at each pole and no seam along the meridian
+    void CreateSphere(size_t rings, size_t segments, std::vector<float>& positions, std::vector<uint32_t>& indices)
+    {
+        const float pi = 3.14159265358979f;
+
+        positions.insert(positions.end(), { 0.0f, 1.0f, 0.0f });
+
+        for (size_t ring = 1U; ring < rings; ++ring)
+        {
+            const float theta = pi * ring / rings;
+
+            for (size_t segment = 0U; segment < segments; ++segment)
+            {
+                const float phi = 2.0f * pi * segment / segments;
+
+                positions.insert(positions.end(), { std::sin(theta) * std::cos(phi), std::cos(theta), -std::sin(theta) * std::sin(phi) });
+            }
+        }
+
+        positions.insert(positions.end(), { 0.0f, -1.0f, 0.0f });
+
+        const uint32_t bottom = static_cast<uint32_t>(positions.size() / 3U - 1U);
+
+        auto vertex = [segments](size_t ring, size_t segment)
+        {
+            return static_cast<uint32_t>(1U + (ring - 1U) * segments + segment % segments);
+        };
+
+        for (size_t segment = 0U; segment < segments; ++segment)
+        {
+            indices.insert(indices.end(), { 0U, vertex(1U, segment), vertex(1U, segment + 1U) });
+            indices.insert(indices.end(), { bottom, vertex(rings - 1U, segment + 1U), vertex(rings - 1U, segment) });
+
+            for (size_t ring = 1U; ring < rings - 1U; ++ring)
+            {
+                indices.insert(indices.end(), { vertex(ring, segment), vertex(ring + 1U, segment), vertex(ring + 1U, segment + 1U) });
+                indices.insert(indices.end(), { vertex(ring, segment), vertex(ring + 1U, segment + 1U), vertex(ring, segment + 1U) });
+            }
+        }
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(MeshSimplificationUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(MeshSimplificationUtilsTests, MeshSimplificationUtils_Test_Simplify_Plane)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(16U, positions, indices);
+
+                    const size_t targetIndexCount = indices.size() / 4U;
+
+                    float error = -1.0f;
+                    auto output = MeshSimplificationUtils::Simplify(indices, positions, targetIndexCount, 0.01f, &error);
+
+                    // Interior vertices of a plane can be removed without introducing any error or folding the surface
+                    Assert::IsTrue(output.size() <= targetIndexCount);
+                    Assert::IsTrue(output.size() > 0U);
+                    Assert::AreEqual(0.0f, error);
+                    Assert::AreEqual(GetSignedArea(indices, positions), GetSignedArea(output, positions), 0.001f);
+
+                    // Border vertices are locked so every corner remains
+                    for (const uint32_t corner : { 0U, 16U, 272U, 288U })
+                    {
+                        Assert::IsTrue(std::find(output.begin(), output.end(), corner) != output.end());
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplificationUtilsTests, MeshSimplificationUtils_Test_Simplify_ErrorThreshold)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(8U, positions, indices);
+
+                    // Raise the center vertex so that removing it would introduce a large error
+                    const uint32_t peak = 4U * 9U + 4U;
+                    positions[peak * 3U + 2U] = 2.0f;
+
+                    auto output = MeshSimplificationUtils::Simplify(indices, positions, 0U, 0.001f);
+
+                    Assert::IsTrue(output.size() < indices.size());
+                    Assert::IsTrue(std::find(output.begin(), output.end(), peak) != output.end());
+
+                    // A group per vertex prevents every collapse
+                    std::vector<uint32_t> vertexGroups(positions.size() / 3U);
+
+                    for (size_t i = 0; i < vertexGroups.size(); ++i)
+                    {
+                        vertexGroups[i] = static_cast<uint32_t>(i);
+                    }
+
+                    output = MeshSimplificationUtils::Simplify(indices, positions, 0U, 1.0f, nullptr, vertexGroups);
+                    AreEqual(indices, output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplificationUtilsTests, MeshSimplificationUtils_Test_Simplify_Sphere)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateSphere(32U, 64U, positions, indices);
+
+                    // The sphere's largest dimension is 2 so the absolute error may be up to twice the target error
+                    for (const float targetRmsError : { 0.005f, 0.01f, 0.05f })
+                    {
+                        float error = -1.0f;
+                        const auto output = MeshSimplificationUtils::Simplify(indices, positions, 0U, targetRmsError, &error);
+
+                        Assert::IsTrue(output.size() < indices.size() / 2U);
+                        Assert::IsTrue(error <= targetRmsError);
+
+                        // Every vertex lies on the sphere so the deviation is measured at points sampled across the
+                        // surface of each remaining triangle, weighted by the triangle's area
+                        const size_t sampleCount = 8U;
+                        double squaredDeviationSum = 0.0;
+                        double weightSum = 0.0;
+
+                        for (size_t i = 0; i < output.size(); i += 3U)
+                        {
+                            const float* p0 = &positions[output[i] * 3U];
+                            const float* p1 = &positions[output[i + 1U] * 3U];
+                            const float* p2 = &positions[output[i + 2U] * 3U];
+
+                            const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                            const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                            const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                            const float area = 0.5f * std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                            for (size_t u = 0; u <= sampleCount; ++u)
+                            {
+                                for (size_t v = 0; u + v <= sampleCount; ++v)
+                                {
+                                    const float b1 = static_cast<float>(u) / sampleCount;
+                                    const float b2 = static_cast<float>(v) / sampleCount;
+                                    const float b0 = 1.0f - b1 - b2;
+
+                                    const float x = b0 * p0[0] + b1 * p1[0] + b2 * p2[0];
+                                    const float y = b0 * p0[1] + b1 * p1[1] + b2 * p2[1];
+                                    const float z = b0 * p0[2] + b1 * p1[2] + b2 * p2[2];
+
+                                    const float deviation = 1.0f - std::sqrt(x * x + y * y + z * z);
+
+                                    squaredDeviationSum += area * deviation * deviation;
+                                    weightSum += area;
+                                }
+                            }
+                        }
+
+                        // The error is estimated from the planes of the source triangles rather than the sphere itself, so
+                        // allow a little slack over the target
+                        const double rmsDeviation = std::sqrt(squaredDeviationSum / weightSum);
+
+                        Assert::IsTrue(rmsDeviation / 2.0 <= targetRmsError * 1.25);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplificationUtilsTests, MeshSimplificationUtils_Test_GenerateLODs)
+                {
+                    // Two grids that share positions along x = 8 - a seam where the texture coordinates differ
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(8U, positions, indices);
+                    CreateGrid(8U, positions, indices, 8.0f);
+
+                    const size_t vertexCount = positions.size() / 3U;
+
+                    std::vector<float> texCoords;
+
+                    for (size_t i = 0; i < vertexCount; ++i)
+                    {
+                        texCoords.insert(texCoords.end(), { i < vertexCount / 2U ? 0.0f : 1.0f, positions[i * 3U + 1U] / 8.0f });
+                    }
+
+                    std::vector<uint8_t> joints(vertexCount * 4U, 0U);
+                    std::vector<float> weights(vertexCount * 4U, 0.0f);
+
+                    for (size_t i = 0; i < vertexCount; ++i)
+                    {
+                        joints[i * 4U] = positions[i * 3U] < 6.0f ? 0U : 1U;
+                        weights[i * 4U] = 1.0f;
+                    }
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT });
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 0.0f }, { 16.0f, 8.0f, 0.0f } });
+                    auto texCoordsAccessor = bufferBuilder.AddAccessor(texCoords, { TYPE_VEC2, COMPONENT_FLOAT });
+                    auto jointsAccessor = bufferBuilder.AddAccessor(joints, { TYPE_VEC4, COMPONENT_UNSIGNED_BYTE });
+                    auto weightsAccessor = bufferBuilder.AddAccessor(weights, { TYPE_VEC4, COMPONENT_FLOAT });
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_TEXCOORD_0] = texCoordsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_JOINTS_0] = jointsAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_WEIGHTS_0] = weightsAccessor.id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    auto lodBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.buffers.Size() + builder.GetBufferCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.bufferViews.Size() + builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    lodBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto lods = MeshSimplificationUtils::GenerateLODs(doc, reader, meshPrimitive, lodBufferBuilder, { { 0.5f, 0.01f }, { 0.25f, 0.01f } });
+                    lodBufferBuilder.Output(doc);
+
+                    Assert::AreEqual<size_t>(2U, lods.size());
+
+                    size_t previousIndexCount = indices.size();
+
+                    for (const auto& lod : lods)
+                    {
+                        // Vertex attributes are shared with the source primitive
+                        Assert::IsTrue(lod.attributes == meshPrimitive.attributes);
+
+                        auto lodIndices = MeshPrimitiveUtils::GetIndices32(doc, reader, lod);
+
+                        Assert::IsTrue(lodIndices.size() < previousIndexCount);
+                        Assert::AreEqual(GetSignedArea(indices, positions), GetSignedArea(lodIndices, positions), 0.001f);
+
+                        // Every seam vertex is retained on both sides of the seam
+                        for (uint32_t y = 0; y <= 8U; ++y)
+                        {
+                            Assert::IsTrue(std::find(lodIndices.begin(), lodIndices.end(), y * 9U + 8U) != lodIndices.end());
+                            Assert::IsTrue(std::find(lodIndices.begin(), lodIndices.end(), 81U + y * 9U) != lodIndices.end());
+                        }
+
+                        previousIndexCount = lodIndices.size();
+                    }
+                }
+            };
+        }
+    }
+}
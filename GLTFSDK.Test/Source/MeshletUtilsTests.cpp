@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/MeshletUtils.h>
+#include <GLTFSDK/Serialize.h>
+
+#include <TestUtilsCommon/MeshGenerator.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    // The cone culling test documented by MeshletBounds
+    bool IsBackFacing(const MeshletBounds& bounds, const std::array<float, 3>& position)
+    {
+        const float d[3] = { bounds.center[0] - position[0], bounds.center[1] - position[1], bounds.center[2] - position[2] };
+        const float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+
+        return d[0] * bounds.coneAxis[0] + d[1] * bounds.coneAxis[1] + d[2] * bounds.coneAxis[2] >= bounds.coneCutoff * distance + bounds.radius;
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(MeshletUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(MeshletUtilsTests, MeshletUtils_Test_BuildMeshlets)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(16U, positions, indices);
+
+                    const size_t maxVertices = 16U;
+                    const size_t maxTriangles = 20U;
+
+                    auto meshletData = MeshletUtils::BuildMeshlets(indices, positions, maxVertices, maxTriangles);
+
+                    Assert::AreEqual(meshletData.meshlets.size(), meshletData.bounds.size());
+
+                    std::vector<uint32_t> outputIndices;
+
+                    for (size_t m = 0; m < meshletData.meshlets.size(); ++m)
+                    {
+                        const auto& meshlet = meshletData.meshlets[m];
+                        const auto& bounds = meshletData.bounds[m];
+
+                        Assert::IsTrue(meshlet.vertexCount <= maxVertices);
+                        Assert::IsTrue(meshlet.triangleCount <= maxTriangles);
+
+                        for (size_t i = 0; i < meshlet.triangleCount * 3U; ++i)
+                        {
+                            const uint8_t localIndex = meshletData.triangles[meshlet.triangleOffset * 3U + i];
+
+                            Assert::IsTrue(localIndex < meshlet.vertexCount);
+                            outputIndices.push_back(meshletData.vertices[meshlet.vertexOffset + localIndex]);
+                        }
+
+                        // The bounding sphere contains every vertex of the meshlet
+                        for (size_t i = 0; i < meshlet.vertexCount; ++i)
+                        {
+                            const float* p = &positions[meshletData.vertices[meshlet.vertexOffset + i] * 3U];
+
+                            const float dx = p[0] - bounds.center[0];
+                            const float dy = p[1] - bounds.center[1];
+                            const float dz = p[2] - bounds.center[2];
+
+                            Assert::IsTrue(std::sqrt(dx * dx + dy * dy + dz * dz) <= bounds.radius * 1.0001f);
+                        }
+
+                        // Every triangle of a flat grid faces +Z
+                        Assert::AreEqual(0.0f, bounds.coneAxis[0], 0.0001f);
+                        Assert::AreEqual(0.0f, bounds.coneAxis[1], 0.0001f);
+                        Assert::AreEqual(1.0f, bounds.coneAxis[2], 0.0001f);
+                        Assert::AreEqual(0.0f, bounds.coneCutoff, 0.0001f);
+                    }
+
+                    // Every triangle is in exactly one meshlet
+                    Assert::AreEqual(indices.size(), outputIndices.size());
+
+                    auto sortTriangles = [](std::vector<uint32_t> triangleIndices)
+                    {
+                        std::vector<std::vector<uint32_t>> triangles;
+
+                        for (size_t i = 0; i < triangleIndices.size(); i += 3U)
+                        {
+                            triangles.push_back({ triangleIndices[i], triangleIndices[i + 1U], triangleIndices[i + 2U] });
+                        }
+
+                        std::sort(triangles.begin(), triangles.end());
+                        return triangles;
+                    };
+
+                    Assert::IsTrue(sortTriangles(indices) == sortTriangles(outputIndices));
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        MeshletUtils::BuildMeshlets(indices, positions, MeshletUtils::MaxMeshletVertexCount + 1U, maxTriangles);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshletUtilsTests, MeshletUtils_Test_ComputeMeshletBounds_Culling)
+                {
+                    // Two parallel triangles facing +Z, at z = 0 and z = 1
+                    const std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f
+                    };
+
+                    const std::vector<uint32_t> indices = { 0U, 1U, 2U, 3U, 4U, 5U };
+
+                    const auto meshletData = MeshletUtils::BuildMeshlets(indices, positions);
+
+                    Assert::AreEqual<size_t>(1U, meshletData.meshlets.size());
+
+                    const auto& bounds = meshletData.bounds.front();
+
+                    Assert::AreEqual(1.0f, bounds.coneAxis[2], 0.0001f);
+                    Assert::AreEqual(0.0f, bounds.coneCutoff, 0.0001f);
+
+                    // Between the triangles the one at z = 0 is front facing, even though the direction to the bounds'
+                    // center is within the normal cone
+                    Assert::IsFalse(IsBackFacing(bounds, { { 0.25f, 0.25f, 0.3f } }));
+                    Assert::IsFalse(IsBackFacing(bounds, { { 0.25f, 0.25f, 5.0f } }));
+                    Assert::IsTrue(IsBackFacing(bounds, { { 0.25f, 0.25f, -5.0f } }));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshletUtilsTests, MeshletUtils_Test_AddMeshlets)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(8U, positions, indices);
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT });
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+                    meshPrimitive.extras = "{ \"name\": \"grid\" }";
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    auto meshletBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.buffers.Size() + builder.GetBufferCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.bufferViews.Size() + builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    meshletBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto output = MeshletUtils::AddMeshlets(doc, reader, meshPrimitive, meshletBufferBuilder, 32U, 32U);
+                    meshletBufferBuilder.Output(doc);
+
+                    // Buffer views and accessors 0 and 1 are the source indices and positions, the meshlet data follows in order
+                    const std::string expectedExtras = "{\"name\":\"grid\",\"meshlets\":{\"maxVertices\":32,\"maxTriangles\":32,\"meshletsBufferView\":\"2\",\"verticesBufferView\":\"3\",\"triangles\":\"2\",\"bounds\":\"3\",\"cones\":\"4\"}}";
+                    Assert::AreEqual(expectedExtras, output.extras);
+
+                    // Building meshlets again replaces the "meshlets" member rather than adding a second one
+                    const auto rebuilt = MeshletUtils::AddMeshlets(doc, reader, output, meshletBufferBuilder, 32U, 32U);
+
+                    const auto first = rebuilt.extras.find("\"meshlets\":");
+
+                    Assert::IsTrue(first != std::string::npos);
+                    Assert::IsTrue(rebuilt.extras.find("\"meshlets\":", first + 1U) == std::string::npos);
+                    Assert::IsTrue(rebuilt.extras.find("\"name\":\"grid\"") != std::string::npos);
+
+                    // 128 triangles in meshlets of at most 32 triangles
+                    auto meshlets = reader.ReadBinaryData<uint32_t>(doc, doc.bufferViews.Get("2"));
+                    Assert::IsTrue(meshlets.size() >= 16U);
+                    Assert::AreEqual(meshlets.size() / 4U, doc.accessors.Get("3").count);
+                    Assert::AreEqual<size_t>(indices.size(), doc.accessors.Get("2").count);
+
+                    for (const auto& accessor : doc.accessors.Elements())
+                    {
+                        Assert::IsTrue(accessor.componentType != COMPONENT_UNSIGNED_INT || accessor.id == indicesAccessor.id);
+                    }
+
+                    uint32_t triangleCount = 0U;
+
+                    for (size_t i = 0; i < meshlets.size(); i += 4U)
+                    {
+                        Assert::AreEqual(triangleCount, meshlets[i + 2U]);
+                        triangleCount += meshlets[i + 3U];
+                    }
+
+                    Assert::AreEqual<uint32_t>(128U, triangleCount);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshletUtilsTests, MeshletUtils_Test_ResolveMeshletIndices_RoundTrip)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(4U, positions, indices);
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT });
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    // Ids that differ from the indices the meshlet data will have in the serialized document
+                    auto meshletBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [](const BufferBuilder& builder) { return "meshletBuffer" + std::to_string(builder.GetBufferCount()); },
+                        [](const BufferBuilder& builder) { return "meshletBufferView" + std::to_string(builder.GetBufferViewCount()); },
+                        [](const BufferBuilder& builder) { return "meshletAccessor" + std::to_string(builder.GetAccessorCount()); });
+
+                    meshletBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+                    const auto output = MeshletUtils::AddMeshlets(doc, reader, meshPrimitive, meshletBufferBuilder);
+                    meshletBufferBuilder.Output(doc);
+
+                    // The ids can't be resolved against a document the meshlet data hasn't been output to
+                    Assert::ExpectException<GLTFException>([&]() { MeshletUtils::ResolveMeshletIndices(Document(), output); });
+
+                    const auto resolved = MeshletUtils::ResolveMeshletIndices(doc, output);
+
+                    Mesh mesh;
+                    mesh.id = "0";
+                    mesh.primitives.push_back(resolved);
+                    doc.meshes.Append(std::move(mesh));
+
+                    const auto roundTripped = Deserialize(Serialize(doc));
+                    const auto& roundTrippedPrimitive = roundTripped.meshes.Front().primitives.front();
+
+                    // Buffer views and accessors 0 and 1 are the source indices and positions, the meshlet data follows in order
+                    const std::string expectedExtras = "{\"meshlets\":{\"maxVertices\":64,\"maxTriangles\":124,\"meshletsBufferView\":2,\"verticesBufferView\":3,\"triangles\":2,\"bounds\":3,\"cones\":4}}";
+                    Assert::AreEqual(expectedExtras, resolved.extras);
+                    Assert::AreEqual(expectedExtras, roundTrippedPrimitive.extras);
+
+                    Assert::AreEqual(doc.accessors["meshletAccessor0"].count, roundTripped.accessors[2].count);
+                    Assert::IsTrue(roundTripped.accessors[2].componentType == COMPONENT_UNSIGNED_BYTE);
+                    Assert::AreEqual(doc.accessors["meshletAccessor1"].count, roundTripped.accessors[3].count);
+                    Assert::AreEqual(doc.accessors["meshletAccessor2"].count, roundTripped.accessors[4].count);
+                    Assert::AreEqual(doc.bufferViews["meshletBufferView1"].byteLength, roundTripped.bufferViews[3].byteLength);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,338 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/SceneBVH.h>
+#include <GLTFSDK/SceneGraph.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    void AddAccessor(Document& doc, const std::string& id, std::vector<float> min, std::vector<float> max)
+    {
+        Accessor accessor;
+        accessor.id = id;
+        accessor.type = TYPE_VEC3;
+        accessor.componentType = COMPONENT_FLOAT;
+        accessor.count = 8U;
+        accessor.min = std::move(min);
+        accessor.max = std::move(max);
+
+        doc.accessors.Append(std::move(accessor));
+    }
+
+    // Creates a document with a mesh bounded by the cube from (-1, -1, -1) to (1, 1, 1), instanced by a root node's
+    // children. Child i is translated to positions[i], and the root node has no mesh.
+    Document CreateDocument(const std::vector<Vector3>& positions)
+    {
+        Document doc;
+
+        AddAccessor(doc, "0", { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f });
+
+        MeshPrimitive meshPrimitive;
+        meshPrimitive.attributes[ACCESSOR_POSITION] = "0";
+
+        Mesh mesh;
+        mesh.id = "0";
+        mesh.primitives.push_back(std::move(meshPrimitive));
+
+        doc.meshes.Append(std::move(mesh));
+
+        Node root;
+        root.id = "root";
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            Node node;
+            node.id = std::to_string(i);
+            node.meshId = "0";
+            node.translation = positions[i];
+
+            root.children.push_back(node.id);
+            doc.nodes.Append(std::move(node));
+        }
+
+        doc.nodes.Append(std::move(root));
+
+        return doc;
+    }
+
+    void AreEqualVector3(const Vector3& expected, const Vector3& actual)
+    {
+        Assert::AreEqual(expected.x, actual.x, 0.0001f);
+        Assert::AreEqual(expected.y, actual.y, 0.0001f);
+        Assert::AreEqual(expected.z, actual.z, 0.0001f);
+    }
+
+    std::vector<size_t> GetNodeIndices(const SceneGraph& sceneGraph, std::vector<size_t> sceneIndices)
+    {
+        for (auto& index : sceneIndices)
+        {
+            index = sceneGraph.GetNodeIndex(index);
+        }
+
+        std::sort(sceneIndices.begin(), sceneIndices.end());
+
+        return sceneIndices;
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(SceneBVHTests)
+            {
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Queries)
+                {
+                    // 100 cubes along the x axis, centered at x = 0, 3, 6, ...
+                    std::vector<Vector3> positions;
+
+                    for (size_t i = 0; i < 100U; ++i)
+                    {
+                        positions.push_back({ i * 3.0f, 0.0f, 0.0f });
+                    }
+
+                    const auto doc = CreateDocument(positions);
+                    const SceneGraph sceneGraph(doc);
+                    const SceneBVH bvh(doc, sceneGraph);
+
+                    Assert::AreEqual<size_t>(100U, bvh.GetItemCount());
+
+                    // Every item is in exactly one leaf, and leaves are small
+                    std::vector<size_t> leafItems = bvh.GetLeafItems();
+                    std::sort(leafItems.begin(), leafItems.end());
+
+                    for (size_t i = 0; i < leafItems.size(); ++i)
+                    {
+                        Assert::AreEqual(i, leafItems[i]);
+                    }
+
+                    for (const auto& node : bvh.GetNodes())
+                    {
+                        Assert::IsTrue(node.count <= 4U);
+                    }
+
+                    AreEqualVector3({ -1.0f, -1.0f, -1.0f }, bvh.GetNodes()[0].bounds.min);
+                    AreEqualVector3({ 298.0f, 1.0f, 1.0f }, bvh.GetNodes()[0].bounds.max);
+
+                    // Box
+                    std::vector<size_t> sceneIndices;
+                    bvh.QueryBox({ { 29.5f, -0.5f, -0.5f }, { 30.5f, 0.5f, 0.5f } }, sceneIndices);
+
+                    Assert::IsTrue(std::vector<size_t>({ 10U }) == GetNodeIndices(sceneGraph, sceneIndices));
+
+                    // Ray - hits are ordered by distance and limited to 'maxDistance'
+                    std::vector<RayHit> hits;
+                    bvh.QueryRay({ -10.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, 20.0f, hits);
+
+                    Assert::AreEqual<size_t>(4U, hits.size());
+
+                    for (size_t i = 0; i < hits.size(); ++i)
+                    {
+                        Assert::AreEqual(i, sceneGraph.GetNodeIndex(hits[i].sceneIndex));
+                        Assert::AreEqual(9.0f + i * 3.0f, hits[i].distance, 0.0001f);
+                    }
+
+                    hits.clear();
+                    bvh.QueryRay({ -10.0f, 2.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, 1000.0f, hits);
+
+                    Assert::IsTrue(hits.empty());
+
+                    // Orthographic frustum from x = -2 to 7.5
+                    const float left = -2.0f;
+                    const float right = 7.5f;
+
+                    const auto planes = SceneBVH::GetFrustumPlanes({{
+                        2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+                        0.0f, 0.1f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.1f, 0.0f,
+                        -(right + left) / (right - left), 0.0f, 0.0f, 1.0f }});
+
+                    Assert::AreEqual<size_t>(6U, planes.size());
+
+                    sceneIndices.clear();
+                    bvh.QueryFrustum(planes, sceneIndices);
+
+                    Assert::IsTrue(std::vector<size_t>({ 0U, 1U, 2U }) == GetNodeIndices(sceneGraph, sceneIndices));
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Refit)
+                {
+                    // A 64 x 64 grid of cubes in the xy plane, built across threads
+                    std::vector<Vector3> positions;
+
+                    for (size_t i = 0; i < 64U * 64U; ++i)
+                    {
+                        positions.push_back({ (i % 64U) * 3.0f, (i / 64U) * 3.0f, 0.0f });
+                    }
+
+                    const auto doc = CreateDocument(positions);
+                    SceneGraph sceneGraph(doc);
+                    SceneBVH bvh(doc, sceneGraph, 4U);
+
+                    const BoundingBox box = { { 10.5f, 10.5f, -1.0f }, { 19.5f, 16.5f, 1.0f } };
+
+                    auto queryBruteForce = [&bvh, &box]()
+                    {
+                        std::vector<size_t> sceneIndices;
+
+                        for (size_t i = 0; i < bvh.GetItemCount(); ++i)
+                        {
+                            if (bvh.GetItemBounds()[i].Intersects(box))
+                            {
+                                sceneIndices.push_back(bvh.GetSceneIndices()[i]);
+                            }
+                        }
+
+                        return sceneIndices;
+                    };
+
+                    std::vector<size_t> sceneIndices;
+                    bvh.QueryBox(box, sceneIndices);
+
+                    Assert::AreEqual<size_t>(6U, sceneIndices.size());
+                    Assert::IsTrue(GetNodeIndices(sceneGraph, queryBruteForce()) == GetNodeIndices(sceneGraph, sceneIndices));
+
+                    // Move node "0" into the box and scale the root, which moves every node, then refit
+                    const size_t nodeSceneIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex("0"));
+                    const size_t rootSceneIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex("root"));
+
+                    sceneGraph.SetLocalTransform(nodeSceneIndex, { 15.0f, 15.0f, 0.0f }, Quaternion::IDENTITY, Vector3::ONE);
+                    sceneGraph.SetLocalTransform(rootSceneIndex, Vector3::ZERO, Quaternion::IDENTITY, { 1.0f, 1.0f, 0.5f });
+                    sceneGraph.UpdateWorldMatrices();
+
+                    bvh.Refit(sceneGraph, 4U);
+
+                    AreEqualVector3({ 14.0f, 14.0f, -0.5f }, bvh.GetItemBounds()[0].min);
+                    AreEqualVector3({ 16.0f, 16.0f, 0.5f }, bvh.GetItemBounds()[0].max);
+
+                    sceneIndices.clear();
+                    bvh.QueryBox(box, sceneIndices);
+
+                    const auto nodeIndices = GetNodeIndices(sceneGraph, sceneIndices);
+
+                    Assert::AreEqual<size_t>(7U, nodeIndices.size());
+                    Assert::AreEqual<size_t>(0U, nodeIndices.front());
+                    Assert::IsTrue(GetNodeIndices(sceneGraph, queryBruteForce()) == nodeIndices);
+
+                    // Meshes without bounds can't be added
+                    Document invalidDoc = CreateDocument({ Vector3::ZERO });
+                    AddAccessor(invalidDoc, "1", {}, {});
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = "1";
+
+                    Mesh mesh;
+                    mesh.id = "1";
+                    mesh.primitives.push_back(std::move(meshPrimitive));
+                    invalidDoc.meshes.Append(std::move(mesh));
+
+                    Node node;
+                    node.id = "1";
+                    node.meshId = "1";
+                    invalidDoc.nodes.Append(std::move(node));
+
+                    Assert::ExpectException<GLTFException>([&invalidDoc]()
+                    {
+                        SceneBVH invalidBvh(invalidDoc, SceneGraph(invalidDoc));
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Skinned)
+                {
+                    // Node "0" is skinned by two joints at x = 10 and x = 20. Its own translation is ignored.
+                    Document doc = CreateDocument({ { 100.0f, 0.0f, 0.0f } });
+
+                    Skin skin;
+                    skin.id = "skin";
+
+                    for (const float x : { 10.0f, 20.0f })
+                    {
+                        Node joint;
+                        joint.id = "joint" + std::to_string(skin.jointIds.size());
+                        joint.translation = { x, 0.0f, 0.0f };
+
+                        skin.jointIds.push_back(joint.id);
+                        doc.nodes.Append(std::move(joint));
+                    }
+
+                    Node node = doc.nodes.Get("0");
+                    node.skinId = skin.id;
+                    doc.nodes.Replace(std::move(node));
+                    doc.skins.Append(skin);
+
+                    SceneGraph sceneGraph(doc);
+                    SceneBVH bvh(doc, sceneGraph);
+
+                    Assert::AreEqual<size_t>(1U, bvh.GetItemCount());
+                    AreEqualVector3({ 9.0f, -1.0f, -1.0f }, bvh.GetItemBounds()[0].min);
+                    AreEqualVector3({ 21.0f, 1.0f, 1.0f }, bvh.GetItemBounds()[0].max);
+
+                    // Moving a joint moves the bounds, moving the skinned node doesn't
+                    sceneGraph.SetLocalTransform(sceneGraph.GetSceneIndex(doc.nodes.GetIndex("joint1")), { 30.0f, 5.0f, 0.0f }, Quaternion::IDENTITY, Vector3::ONE);
+                    sceneGraph.SetLocalTransform(sceneGraph.GetSceneIndex(doc.nodes.GetIndex("0")), { -100.0f, 0.0f, 0.0f }, Quaternion::IDENTITY, Vector3::ONE);
+                    sceneGraph.UpdateWorldMatrices();
+
+                    bvh.Refit(sceneGraph);
+
+                    AreEqualVector3({ 9.0f, -1.0f, -1.0f }, bvh.GetItemBounds()[0].min);
+                    AreEqualVector3({ 31.0f, 6.0f, 1.0f }, bvh.GetItemBounds()[0].max);
+                    AreEqualVector3({ 9.0f, -1.0f, -1.0f }, bvh.GetNodes()[0].bounds.min);
+
+                    // Inverse bind matrices that undo each joint's translation bind the mesh at the origin
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    // Accessor ids must not collide with the positions accessor already in the document
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [](const BufferBuilder& builder) { return std::to_string(builder.GetBufferCount()); },
+                        [](const BufferBuilder& builder) { return std::to_string(builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    std::vector<float> inverseBindMatrices;
+
+                    for (const float x : { -10.0f, -20.0f })
+                    {
+                        std::vector<float> matrix(Matrix4::IDENTITY.values.begin(), Matrix4::IDENTITY.values.end());
+                        matrix[12] = x;
+
+                        inverseBindMatrices.insert(inverseBindMatrices.end(), matrix.begin(), matrix.end());
+                    }
+
+                    skin.inverseBindMatricesAccessorId = bufferBuilder.AddAccessor(inverseBindMatrices, { TYPE_MAT4, COMPONENT_FLOAT }).id;
+                    doc.skins.Replace(skin);
+                    bufferBuilder.Output(doc);
+
+                    const GLTFResourceReader reader(readerWriter);
+                    const SceneBVH boundBvh(doc, reader, SceneGraph(doc));
+
+                    AreEqualVector3({ -1.0f, -1.0f, -1.0f }, boundBvh.GetItemBounds()[0].min);
+                    AreEqualVector3({ 1.0f, 1.0f, 1.0f }, boundBvh.GetItemBounds()[0].max);
+
+                    // Without a reader the inverse bind matrices can't be read
+                    Assert::ExpectException<GLTFException>([&doc]()
+                    {
+                        SceneBVH invalidBvh(doc, SceneGraph(doc));
+                    });
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Validation.h>
+
+#include <TestUtilsCommon/SceneGenerator.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(SceneGeneratorTests)
+            {
+                GLTFSDK_TEST_METHOD(SceneGeneratorTests, SceneGenerator_Test_Deterministic)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.seed = 42U;
+                    desc.nodeCount = 100U;
+                    desc.meshCount = 10U;
+                    desc.materialCount = 3U;
+                    desc.vertexCount = 64U;
+                    desc.morphTargetCount = 2U;
+                    desc.animationCount = 5U;
+                    desc.interleaved = true;
+                    desc.extensionDensity = 0.25f;
+
+                    const auto doc = SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>());
+
+                    Assert::IsTrue(doc == SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>()));
+
+                    Assert::AreEqual<size_t>(100U, doc.nodes.Size());
+                    Assert::AreEqual<size_t>(10U, doc.meshes.Size());
+                    Assert::AreEqual<size_t>(3U, doc.materials.Size());
+                    Assert::AreEqual<size_t>(5U, doc.animations.Size());
+                    Assert::AreEqual<size_t>(2U, doc.meshes.Front().primitives.front().targets.size());
+
+                    const auto nodeExtensionCount = std::count_if(doc.nodes.Elements().begin(), doc.nodes.Elements().end(), [](const Node& node)
+                    {
+                        return node.extensions.count(SYNTHETIC_EXTENSION_NAME) > 0U;
+                    });
+
+                    Assert::AreEqual<ptrdiff_t>(25, nodeExtensionCount);
+                    Assert::AreEqual<size_t>(1U, doc.extensionsUsed.count(SYNTHETIC_EXTENSION_NAME));
+
+                    // Every node is reachable from the scene's root
+                    Assert::AreEqual<size_t>(1U, doc.GetDefaultScene().nodes.size());
+
+                    ValidationReport report;
+                    Validation::Validate(doc, report);
+
+                    Assert::IsTrue(report.GetIssues().empty());
+
+                    // A different seed generates different geometry
+                    desc.seed = 43U;
+
+                    Assert::IsFalse(doc == SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>()));
+                }
+
+                GLTFSDK_TEST_METHOD(SceneGeneratorTests, SceneGenerator_Test_Data)
+                {
+                    SceneGeneratorDesc desc;
+                    desc.meshCount = 2U;
+                    desc.vertexCount = 30U; // Rounded up to 32
+                    desc.morphTargetCount = 1U;
+                    desc.sparse = true;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    const auto doc = SceneGenerator(desc).Generate(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto& primitive = doc.meshes.Front().primitives.front();
+
+                    const auto positions = reader.ReadBinaryData<float>(doc, doc.accessors[primitive.GetAttributeAccessorId(ACCESSOR_POSITION)]);
+                    const auto indices = reader.ReadBinaryData<uint32_t>(doc, doc.accessors[primitive.indicesAccessorId]);
+
+                    Assert::AreEqual<size_t>(32U * 3U, positions.size());
+                    Assert::AreEqual<size_t>(8U * 6U, indices.size());
+                    Assert::IsTrue(*std::max_element(indices.begin(), indices.end()) == 31U);
+
+                    // Sparse morph targets displace every eighth vertex
+                    const auto& morphTargetAccessor = doc.accessors[primitive.targets.front().positionsAccessorId];
+                    Assert::AreEqual<size_t>(4U, morphTargetAccessor.sparse.count);
+
+                    const auto displacements = reader.ReadBinaryData<float>(doc, morphTargetAccessor);
+
+                    for (size_t i = 0; i < 32U; ++i)
+                    {
+                        Assert::AreEqual(i % 8U == 0U ? 0.25f : 0.0f, displacements[i * 3U + 2U]);
+                    }
+
+                    // Embedded buffers contain the same data
+                    desc.base64 = true;
+
+                    const auto embeddedDoc = SceneGenerator(desc).Generate(std::make_shared<const StreamReaderWriter>());
+                    Assert::AreEqual<size_t>(0U, embeddedDoc.buffers.Front().uri.find("data:application/octet-stream;base64,"));
+
+                    GLTFResourceReader embeddedReader(std::make_shared<const StreamReaderWriter>());
+
+                    for (const auto& accessor : doc.accessors.Elements())
+                    {
+                        if (accessor.componentType == COMPONENT_FLOAT)
+                        {
+                            AreEqual(reader.ReadBinaryData<float>(doc, accessor), embeddedReader.ReadBinaryData<float>(embeddedDoc, embeddedDoc.accessors[accessor.id]));
+                        }
+                        else
+                        {
+                            AreEqual(reader.ReadBinaryData<uint32_t>(doc, accessor), embeddedReader.ReadBinaryData<uint32_t>(embeddedDoc, embeddedDoc.accessors[accessor.id]));
+                        }
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/SceneGraph.h>
+
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    void AddNode(Document& doc, const std::string& id, const Vector3& translation, std::vector<std::string> children = {})
+    {
+        Node node;
+        node.id = id;
+        node.translation = translation;
+        node.children = std::move(children);
+
+        doc.nodes.Append(std::move(node));
+    }
+
+    void AreEqualTranslation(const Vector3& expected, const float* matrix)
+    {
+        Assert::AreEqual(expected.x, matrix[12], 0.0001f);
+        Assert::AreEqual(expected.y, matrix[13], 0.0001f);
+        Assert::AreEqual(expected.z, matrix[14], 0.0001f);
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(SceneGraphTests)
+            {
+                GLTFSDK_TEST_METHOD(SceneGraphTests, SceneGraph_Test_Flatten)
+                {
+                    Document doc;
+
+                    // Node "0" has a matrix transform with a uniform scale of 2
+                    Node root;
+                    root.id = "0";
+                    root.children = { "1", "2" };
+                    root.matrix.values = {{ 2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f }};
+
+                    doc.nodes.Append(std::move(root));
+
+                    AddNode(doc, "1", { 0.0f, 1.0f, 0.0f }, { "3" });
+                    AddNode(doc, "2", { 0.0f, 0.0f, 1.0f });
+                    AddNode(doc, "3", { 0.0f, 2.0f, 0.0f });
+                    AddNode(doc, "4", { 5.0f, 0.0f, 0.0f });
+
+                    SceneGraph sceneGraph(doc);
+
+                    // Pre-order: a node's descendants immediately follow it
+                    Assert::AreEqual<size_t>(5U, sceneGraph.GetNodeCount());
+                    Assert::IsTrue(std::vector<size_t>({ 0U, 1U, 3U, 2U, 4U }) == std::vector<size_t>({
+                        sceneGraph.GetNodeIndex(0U), sceneGraph.GetNodeIndex(1U), sceneGraph.GetNodeIndex(2U), sceneGraph.GetNodeIndex(3U), sceneGraph.GetNodeIndex(4U) }));
+
+                    Assert::AreEqual<size_t>(2U, sceneGraph.GetSceneIndex(3U));
+
+                    const auto noIndex = SceneGraph::NoIndex;
+                    Assert::IsTrue(std::vector<size_t>({ noIndex, 0U, 1U, 0U, noIndex }) == sceneGraph.GetParentIndices());
+                    Assert::IsTrue(std::vector<size_t>({ 4U, 3U, 3U, 4U, 5U }) == sceneGraph.GetSubtreeEnds());
+                    Assert::IsFalse(sceneGraph.IsDirty());
+
+                    AreEqualTranslation({ 1.0f, 0.0f, 0.0f }, sceneGraph.GetWorldMatrix(0U));
+                    AreEqualTranslation({ 1.0f, 2.0f, 0.0f }, sceneGraph.GetWorldMatrix(1U));
+                    AreEqualTranslation({ 1.0f, 6.0f, 0.0f }, sceneGraph.GetWorldMatrix(2U));
+                    AreEqualTranslation({ 1.0f, 0.0f, 2.0f }, sceneGraph.GetWorldMatrix(3U));
+                    AreEqualTranslation({ 5.0f, 0.0f, 0.0f }, sceneGraph.GetWorldMatrix(4U));
+
+                    // A scene only includes the hierarchies of its root nodes
+                    Scene scene;
+                    scene.nodes = { "1" };
+
+                    SceneGraph subGraph(doc, scene);
+
+                    Assert::AreEqual<size_t>(2U, subGraph.GetNodeCount());
+                    Assert::AreEqual(noIndex, subGraph.GetSceneIndex(0U));
+                    AreEqualTranslation({ 0.0f, 3.0f, 0.0f }, subGraph.GetWorldMatrix(1U));
+
+                    // Nodes with more than one parent can't be flattened
+                    Document invalidDoc;
+
+                    AddNode(invalidDoc, "0", Vector3::ZERO, { "1", "2" });
+                    AddNode(invalidDoc, "1", Vector3::ZERO, { "2" });
+                    AddNode(invalidDoc, "2", Vector3::ZERO);
+
+                    Assert::ExpectException<GLTFException>([&invalidDoc]()
+                    {
+                        SceneGraph invalidGraph(invalidDoc);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(SceneGraphTests, SceneGraph_Test_UpdateWorldMatrices)
+                {
+                    // A root with 100 children, each with 99 children of their own
+                    const size_t childCount = 100U;
+
+                    Document doc;
+
+                    std::vector<std::string> rootChildren;
+
+                    for (size_t i = 0; i < childCount; ++i)
+                    {
+                        std::vector<std::string> grandchildren;
+
+                        for (size_t j = 0; j < childCount - 1U; ++j)
+                        {
+                            grandchildren.push_back(std::to_string(i) + "_" + std::to_string(j));
+                            AddNode(doc, grandchildren.back(), { 0.0f, 0.0f, static_cast<float>(j) });
+                        }
+
+                        rootChildren.push_back(std::to_string(i));
+                        AddNode(doc, rootChildren.back(), { 0.0f, static_cast<float>(i), 0.0f }, std::move(grandchildren));
+                    }
+
+                    AddNode(doc, "root", Vector3::ZERO, std::move(rootChildren));
+
+                    SceneGraph sceneGraph(doc);
+
+                    Assert::AreEqual<size_t>(childCount * childCount + 1U, sceneGraph.GetNodeCount());
+
+                    const size_t rootIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex("root"));
+                    const size_t childIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex("7"));
+                    const size_t grandchildIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex("7_3"));
+                    const size_t otherGrandchildIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex("8_3"));
+
+                    AreEqualTranslation({ 0.0f, 7.0f, 3.0f }, sceneGraph.GetWorldMatrix(grandchildIndex));
+
+                    // Only the subtree of node "7" is updated
+                    sceneGraph.SetLocalTransform(childIndex, { 1.0f, 7.0f, 0.0f }, Quaternion::IDENTITY, Vector3::ONE);
+                    Assert::IsTrue(sceneGraph.IsDirty());
+
+                    sceneGraph.UpdateWorldMatrices();
+                    Assert::IsFalse(sceneGraph.IsDirty());
+
+                    AreEqualTranslation({ 1.0f, 7.0f, 3.0f }, sceneGraph.GetWorldMatrix(grandchildIndex));
+                    AreEqualTranslation({ 0.0f, 8.0f, 3.0f }, sceneGraph.GetWorldMatrix(otherGrandchildIndex));
+
+                    // Updating the root (and, redundantly, a node within its subtree) updates every node across threads
+                    const float rootMatrix[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 10.0f, 0.0f, 0.0f, 1.0f };
+
+                    sceneGraph.SetLocalMatrix(rootIndex, rootMatrix);
+                    sceneGraph.SetLocalTransform(grandchildIndex, { 0.0f, 0.0f, 4.0f }, Quaternion::IDENTITY, Vector3::ONE);
+                    sceneGraph.UpdateWorldMatrices(4U);
+
+                    AreEqualTranslation({ 11.0f, 7.0f, 4.0f }, sceneGraph.GetWorldMatrix(grandchildIndex));
+                    AreEqualTranslation({ 10.0f, 8.0f, 3.0f }, sceneGraph.GetWorldMatrix(otherGrandchildIndex));
+
+                    for (size_t i = 0; i < sceneGraph.GetNodeCount(); ++i)
+                    {
+                        Assert::IsTrue(sceneGraph.GetWorldMatrix(i)[12] >= 10.0f);
+                    }
+
+                    Assert::ExpectException<GLTFException>([&sceneGraph]()
+                    {
+                        sceneGraph.SetLocalMatrix(sceneGraph.GetNodeCount(), nullptr);
+                    });
+                }
+            };
+        }
+    }
+}
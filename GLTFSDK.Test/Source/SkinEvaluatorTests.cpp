@@ -0,0 +1,218 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/AnimationEvaluator.h>
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/SkinEvaluator.h>
+
+#include "TestUtils.h"
+
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    const float HalfSqrt2 = 0.70710678f;
+
+    // A root node translated by (1, 0, 0) with a chain of two joints: joint "1" is rotated 90 degrees about Z and
+    // joint "2" is translated by (0, 2, 0). The skin's inverse bind matrices are the inverse of the joints' world
+    // transforms so the rest pose palette is all identity matrices. Joints are listed child first.
+    Skin CreateSkeleton(BufferBuilder& bufferBuilder, Document& doc)
+    {
+        Node root;
+        root.id = "0";
+        root.translation = { 1.0f, 0.0f, 0.0f };
+        root.children = { "1" };
+
+        Node joint1;
+        joint1.id = "1";
+        joint1.rotation = { 0.0f, 0.0f, HalfSqrt2, HalfSqrt2 };
+        joint1.children = { "2" };
+
+        Node joint2;
+        joint2.id = "2";
+        joint2.translation = { 0.0f, 2.0f, 0.0f };
+
+        doc.nodes.Append(std::move(root));
+        doc.nodes.Append(std::move(joint1));
+        doc.nodes.Append(std::move(joint2));
+
+        const std::vector<float> inverseBindMatrices = {
+            0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f,
+            0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f
+        };
+
+        Skin skin;
+        skin.id = "0";
+        skin.jointIds = { "2", "1" };
+        skin.inverseBindMatricesAccessorId = bufferBuilder.AddAccessor(inverseBindMatrices, { TYPE_MAT4, COMPONENT_FLOAT }).id;
+
+        return skin;
+    }
+
+    void AreEqualMatrices(const std::vector<float>& expected, const float* actual)
+    {
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            Assert::AreEqual(expected[i], actual[i], 0.0001f);
+        }
+    }
+
+    const std::vector<float> Identity = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(SkinEvaluatorTests)
+            {
+                GLTFSDK_TEST_METHOD(SkinEvaluatorTests, SkinEvaluator_Test_ComputePalette)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    Document doc;
+                    const auto skin = CreateSkeleton(bufferBuilder, doc);
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+                    SkinEvaluator evaluator(doc, reader, skin);
+
+                    Assert::AreEqual<size_t>(2U, evaluator.GetJointCount());
+                    Assert::AreEqual<size_t>(32U, evaluator.GetPaletteSize());
+
+                    // Ancestors precede the joints they are needed by
+                    Assert::IsTrue(evaluator.GetNodeIds() == std::vector<std::string>({ "0", "1", "2" }));
+
+                    JointPalette palette(evaluator.GetJointCount());
+                    Assert::AreEqual<uintptr_t>(0U, reinterpret_cast<uintptr_t>(palette.GetData()) % JointPalette::PaletteAlignment);
+
+                    evaluator.ComputePalette(palette.GetData());
+
+                    AreEqualMatrices(Identity, palette.GetData());
+                    AreEqualMatrices(Identity, palette.GetData() + 16U);
+
+                    // Joint "1" loses its rotation, which moves joint "2" from (-1, 0, 0) to (1, 2, 0)
+                    std::vector<float> localMatrices = {
+                        1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+                        1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                        1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 0.0f, 1.0f
+                    };
+
+                    evaluator.ComputePalette(localMatrices.data(), palette.GetData());
+
+                    // The first joint matrix (joint "2") transforms the joint's bind position to its posed position
+                    const float* joint2 = palette.GetData();
+                    Assert::AreEqual(1.0f, joint2[0] * -1.0f + joint2[12], 0.0001f);
+                    Assert::AreEqual(2.0f, joint2[1] * -1.0f + joint2[13], 0.0001f);
+
+                    AreEqualMatrices({ 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f }, palette.GetData() + 16U);
+
+                    // Many instances of the same pose
+                    const size_t instanceCount = 100U;
+
+                    std::vector<float> instanceMatrices;
+
+                    for (size_t i = 0; i < instanceCount; ++i)
+                    {
+                        instanceMatrices.insert(instanceMatrices.end(), localMatrices.begin(), localMatrices.end());
+                    }
+
+                    JointPalette palettes(evaluator.GetJointCount(), instanceCount);
+                    evaluator.ComputePalettes(instanceMatrices.data(), instanceCount, palettes.GetData(), 4U);
+
+                    for (size_t i = 0; i < instanceCount; ++i)
+                    {
+                        AreEqualMatrices(std::vector<float>(palette.GetData(), palette.GetData() + 32U), palettes.GetInstanceData(i));
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(SkinEvaluatorTests, SkinEvaluator_Test_ComputePalettes_Animation)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+
+                    Document doc;
+                    const auto skin = CreateSkeleton(bufferBuilder, doc);
+
+                    // Rotates joint "1" from its rest rotation to the identity over one second. The channel targeting a node
+                    // outside of the skeleton is ignored.
+                    AnimationSampler sampler;
+                    sampler.id = "0";
+                    sampler.inputAccessorId = bufferBuilder.AddAccessor(std::vector<float>({ 0.0f, 1.0f }), { TYPE_SCALAR, COMPONENT_FLOAT }).id;
+                    sampler.outputAccessorId = bufferBuilder.AddAccessor(std::vector<float>({ 0.0f, 0.0f, HalfSqrt2, HalfSqrt2, 0.0f, 0.0f, 0.0f, 1.0f }), { TYPE_VEC4, COMPONENT_FLOAT }).id;
+
+                    AnimationChannel channel;
+                    channel.id = "0";
+                    channel.samplerId = sampler.id;
+                    channel.target.nodeId = "1";
+                    channel.target.path = TARGET_ROTATION;
+
+                    AnimationChannel otherChannel = channel;
+                    otherChannel.id = "1";
+                    otherChannel.target.nodeId = "3";
+
+                    Animation animation;
+                    animation.samplers.Append(std::move(sampler));
+                    animation.channels.Append(std::move(channel));
+                    animation.channels.Append(std::move(otherChannel));
+
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    AnimationEvaluator animationEvaluator(doc, reader, animation);
+                    SkinEvaluator evaluator(doc, reader, skin);
+
+                    std::vector<float> times;
+
+                    for (size_t i = 0; i <= 100U; ++i)
+                    {
+                        times.push_back(i * 0.01f);
+                    }
+
+                    JointPalette palettes(evaluator.GetJointCount(), times.size());
+                    evaluator.ComputePalettes(animationEvaluator, times.data(), times.size(), palettes.GetData(), 4U);
+
+                    // At the start of the animation the skeleton is in its bind pose
+                    AreEqualMatrices(Identity, palettes.GetInstanceData(0U));
+                    AreEqualMatrices(Identity, palettes.GetInstanceData(0U) + 16U);
+
+                    // At the end joint "1" has no rotation
+                    AreEqualMatrices({ 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f }, palettes.GetInstanceData(100U) + 16U);
+
+                    // Every instance matches evaluating the animation and the skin one time at a time
+                    std::vector<float> animationOutput(animationEvaluator.GetOutputSize());
+                    JointPalette palette(evaluator.GetJointCount());
+
+                    for (size_t i = 0; i < times.size(); ++i)
+                    {
+                        animationEvaluator.Evaluate(times[i], animationOutput.data());
+                        evaluator.ComputePalette(animationEvaluator, animationOutput.data(), palette.GetData());
+
+                        AreEqualMatrices(std::vector<float>(palette.GetData(), palette.GetData() + 32U), palettes.GetInstanceData(i));
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,175 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/TangentSpaceUtils.h>
+
+#include <TestUtilsCommon/MeshGenerator.h>
+
+#include "TestUtils.h"
+
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    void AreEqualVector(const std::vector<float>& expected, const float* actual)
+    {
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            Assert::AreEqual(expected[i], actual[i], 0.0001f);
+        }
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(TangentSpaceUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(TangentSpaceUtilsTests, TangentSpaceUtils_Test_GenerateNormals)
+                {
+                    // Three triangles around the corner of a box: a large one facing +Z and smaller ones facing +X and +Y.
+                    // Vertex 5 isn't referenced but is at the same position as the corner (vertex 0).
+                    const std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f,
+                        2.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f,
+                        1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f
+                    };
+
+                    const std::vector<uint32_t> indices = { 0U, 1U, 2U, 0U, 2U, 3U, 0U, 3U, 4U };
+
+                    // Every corner triangle has a right angle at vertex 0
+                    auto normals = TangentSpaceUtils::GenerateNormals(indices, positions, NORMAL_WEIGHTING_ANGLE, 2U);
+
+                    Assert::AreEqual(positions.size(), normals.size());
+
+                    const float a = 1.0f / std::sqrt(3.0f);
+                    AreEqualVector({ a, a, a }, &normals[0]);
+                    AreEqualVector({ a, a, a }, &normals[15]);
+
+                    // The +Z triangle has twice the area of the others
+                    normals = TangentSpaceUtils::GenerateNormals(indices, positions, NORMAL_WEIGHTING_AREA);
+
+                    const float b = 1.0f / std::sqrt(6.0f);
+                    AreEqualVector({ b, b, 2.0f * b }, &normals[0]);
+                    AreEqualVector({ b, b, 2.0f * b }, &normals[15]);
+
+                    // Vertex 1 is only part of the +Z triangle
+                    AreEqualVector({ 0.0f, 0.0f, 1.0f }, &normals[3]);
+                }
+
+                GLTFSDK_TEST_METHOD(TangentSpaceUtilsTests, TangentSpaceUtils_Test_GenerateTangents)
+                {
+                    for (const bool mirrored : { false, true })
+                    {
+                        std::vector<float> positions;
+                        std::vector<float> texCoords;
+                        std::vector<uint32_t> indices;
+
+                        CreateGrid(8U, positions, indices, 0.0f, &texCoords, mirrored);
+
+                        const auto normals = TangentSpaceUtils::GenerateNormals(indices, positions);
+                        const auto tangents = TangentSpaceUtils::GenerateTangents(indices, positions, normals, texCoords, 2U);
+
+                        Assert::AreEqual(positions.size() / 3U * 4U, tangents.size());
+
+                        // Mirrored texture coordinates flip both the tangent and the handedness so the bitangent still points along +Y
+                        const float sign = mirrored ? -1.0f : 1.0f;
+
+                        for (size_t i = 0; i < tangents.size(); i += 4U)
+                        {
+                            AreEqualVector({ sign, 0.0f, 0.0f, sign }, &tangents[i]);
+                        }
+                    }
+
+                    Assert::ExpectException<GLTFException>([]()
+                    {
+                        TangentSpaceUtils::GenerateTangents({ 0U, 1U, 2U }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f });
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(TangentSpaceUtilsTests, TangentSpaceUtils_Test_AddTangents)
+                {
+                    std::vector<float> positions;
+                    std::vector<float> texCoords;
+                    std::vector<uint32_t> indices;
+
+                    CreateGrid(4U, positions, indices, 0.0f, &texCoords);
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT });
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    auto positionsAccessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 0.0f }, { 4.0f, 4.0f, 0.0f } });
+                    auto texCoordsAccessor = bufferBuilder.AddAccessor(texCoords, { TYPE_VEC2, COMPONENT_FLOAT });
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = positionsAccessor.id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    auto tangentBufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter),
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.buffers.Size() + builder.GetBufferCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.bufferViews.Size() + builder.GetBufferViewCount()); },
+                        [&doc](const BufferBuilder& builder) { return std::to_string(doc.accessors.Size() + builder.GetAccessorCount()); });
+
+                    tangentBufferBuilder.AddBuffer();
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // Tangents can't be generated without texture coordinates
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        TangentSpaceUtils::AddTangents(doc, reader, meshPrimitive, tangentBufferBuilder);
+                    });
+
+                    meshPrimitive.attributes[ACCESSOR_TEXCOORD_0] = texCoordsAccessor.id;
+
+                    auto output = TangentSpaceUtils::AddTangents(doc, reader, meshPrimitive, tangentBufferBuilder);
+                    tangentBufferBuilder.Output(doc);
+
+                    Assert::IsTrue(output.HasAttribute(ACCESSOR_NORMAL));
+                    Assert::IsTrue(output.HasAttribute(ACCESSOR_TANGENT));
+                    Assert::AreEqual(texCoordsAccessor.id, output.GetAttributeAccessorId(ACCESSOR_TEXCOORD_0));
+
+                    const auto normals = MeshPrimitiveUtils::GetNormals(doc, reader, output);
+                    const auto tangents = MeshPrimitiveUtils::GetTangents(doc, reader, output);
+
+                    Assert::AreEqual(positions.size(), normals.size());
+                    Assert::AreEqual(positions.size() / 3U * 4U, tangents.size());
+
+                    for (size_t i = 0; i < positions.size() / 3U; ++i)
+                    {
+                        AreEqualVector({ 0.0f, 0.0f, 1.0f }, &normals[i * 3U]);
+                        AreEqualVector({ 1.0f, 0.0f, 0.0f, 1.0f }, &tangents[i * 4U]);
+                    }
+
+                    // Existing attributes are never replaced
+                    auto unchanged = TangentSpaceUtils::AddNormals(doc, reader, output, tangentBufferBuilder);
+                    Assert::IsTrue(unchanged.attributes == output.attributes);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/ParallelUtils.h>
+#include <GLTFSDK/Traverse.h>
+
+#include <atomic>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    // Creates a scene whose single root node has 'depth' levels of descendants below it, each non-leaf node having
+    // 'branching' children. Node ids are their indices.
+    Document CreateTree(size_t depth, size_t branching)
+    {
+        Document doc;
+
+        std::vector<Node> nodes(1U);
+        std::vector<size_t> level = { 0U };
+
+        for (size_t d = 0; d < depth; ++d)
+        {
+            std::vector<size_t> nextLevel;
+
+            for (const size_t parent : level)
+            {
+                for (size_t i = 0; i < branching; ++i)
+                {
+                    nodes[parent].children.push_back(std::to_string(nodes.size()));
+                    nextLevel.push_back(nodes.size());
+                    nodes.emplace_back();
+                }
+            }
+
+            level = std::move(nextLevel);
+        }
+
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            nodes[i].id = std::to_string(i);
+            doc.nodes.Append(std::move(nodes[i]));
+        }
+
+        Scene scene;
+        scene.id = "0";
+        scene.nodes = { "0" };
+
+        doc.SetDefaultScene(std::move(scene), AppendIdPolicy::ThrowOnEmpty);
+
+        return doc;
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(TraverseTests)
+            {
+                GLTFSDK_TEST_METHOD(TraverseTests, Traverse_Test_TraverseParallel)
+                {
+                    const auto doc = CreateTree(4U, 8U);
+                    const size_t nodeCount = doc.nodes.Size();
+
+                    const size_t threadCount = 4U;
+
+                    // Every node is visited once, after its parent
+                    std::vector<std::atomic<bool>> visited(nodeCount);
+                    std::atomic<bool> isParentFirst(true);
+
+                    ParallelUtils::PerThread<size_t> visitCounts(threadCount);
+
+                    TraverseParallel(doc, DefaultSceneIndex, [&](const Node& node, const Node* nodeParent, size_t threadIndex)
+                    {
+                        if (nodeParent && !visited[std::stoul(nodeParent->id)])
+                        {
+                            isParentFirst = false;
+                        }
+
+                        visited[std::stoul(node.id)] = true;
+                        ++visitCounts[threadIndex];
+                    }, threadCount);
+
+                    Assert::IsTrue(isParentFirst);
+                    Assert::AreEqual(nodeCount, visitCounts.Reduce(size_t(0U), [](size_t a, size_t b) { return a + b; }));
+
+                    for (const auto& v : visited)
+                    {
+                        Assert::IsTrue(v);
+                    }
+
+                    // Exceptions are propagated to the caller
+                    Assert::ExpectException<GLTFException>([&doc]()
+                    {
+                        TraverseParallel(doc, DefaultSceneIndex, [](const Node& node, const Node*, size_t)
+                        {
+                            if (node.id == "100")
+                            {
+                                throw GLTFException("Test");
+                            }
+                        });
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(TraverseTests, Traverse_Test_ParallelForEachTask)
+                {
+                    // Each task n > 1 spawns tasks n - 1 and n - 2, giving 2 * fib(n + 1) - 1 tasks in total
+                    const size_t threadCount = 3U;
+
+                    ParallelUtils::PerThread<size_t> taskCounts(threadCount);
+
+                    ParallelUtils::ParallelForEachTask(std::vector<int>({ 15, 10 }), [&taskCounts](int task, size_t threadIndex, ParallelUtils::WorkStealingQueues<int>& queues)
+                    {
+                        ++taskCounts[threadIndex];
+
+                        if (task > 1)
+                        {
+                            queues.Push(threadIndex, task - 1);
+                            queues.Push(threadIndex, task - 2);
+                        }
+                    }, threadCount);
+
+                    Assert::AreEqual<size_t>(3U, taskCounts.Size());
+                    Assert::AreEqual<size_t>(1973U + 177U, taskCounts.Reduce(size_t(0U), [](size_t a, size_t b) { return a + b; }));
+                }
+            };
+        }
+    }
+}
@@ -4,11 +4,15 @@
 #include "stdafx.h"
 
 #include <GLTFSDK/Validation.h>
+#include <GLTFSDK/BufferBuilder.h>
 #include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
 
 #include "TestResources.h"
 #include "TestUtils.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace glTF::UnitTest;
@@ -40,6 +44,34 @@ namespace Microsoft
                         Validation::Validate(doc);
                     });
                 }
+
+                // Creates a document with 'meshCount' meshes, each a single triangle with its own POSITION accessor
+                Document CreateTriangles(std::shared_ptr<const StreamReaderWriter> readerWriter, size_t meshCount)
+                {
+                    Document doc;
+
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    const std::vector<float> positions = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+
+                    for (size_t i = 0; i < meshCount; ++i)
+                    {
+                        MeshPrimitive meshPrimitive;
+                        meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                        Mesh mesh;
+                        mesh.id = std::to_string(i);
+                        mesh.primitives.push_back(std::move(meshPrimitive));
+
+                        doc.meshes.Append(std::move(mesh));
+                    }
+
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
             }
 
             GLTFSDK_TEST_CLASS(ValidationUnitTests)
@@ -300,6 +332,191 @@ namespace Microsoft
                     doc.accessors.Replace(accessor);
                     ExpectValidationFail(doc);
                 }
+
+                GLTFSDK_TEST_METHOD(ValidationUnitTests, ValidationReport_CollectsAll)
+                {
+                    auto doc = CreateTriangles(std::make_shared<const StreamReaderWriter>(), 300U);
+
+                    // Mesh 7 has too few vertices, mesh 9 has an invalid mode and accessor 20 refers to a missing buffer view
+                    auto accessor = doc.accessors[doc.meshes[7U].primitives.front().GetAttributeAccessorId(ACCESSOR_POSITION)];
+                    accessor.count = 2U;
+                    doc.accessors.Replace(accessor);
+
+                    auto mesh = doc.meshes[9U];
+                    mesh.primitives.front().mode = static_cast<MeshMode>(9);
+                    doc.meshes.Replace(mesh);
+
+                    accessor = doc.accessors[20U];
+                    accessor.bufferViewId = "missing";
+                    doc.accessors.Replace(accessor);
+
+                    ValidationReport report;
+                    Validation::Validate(doc, report, 4U);
+
+                    const auto& issues = report.GetIssues();
+
+                    Assert::IsTrue(report.HasErrors());
+                    Assert::IsTrue(issues.size() >= 3U);
+                    Assert::AreEqual(issues.size(), report.GetIssueCount(ValidationSeverity::Error));
+
+                    // Accessors are reported before meshes, each in document order
+                    Assert::AreEqual<std::string>("accessors", issues[0].entityType);
+                    Assert::AreEqual(accessor.id, issues[0].entityId);
+                    Assert::AreEqual<std::string>("/accessors/20/bufferView", issues[0].pointer);
+
+                    auto hasIssue = [&issues](const std::string& pointer)
+                    {
+                        return std::any_of(issues.begin(), issues.end(), [&pointer](const ValidationIssue& issue) { return issue.pointer == pointer; });
+                    };
+
+                    Assert::IsTrue(hasIssue("/meshes/7/primitives/0/mode"));
+                    Assert::IsTrue(hasIssue("/meshes/9/primitives/0/mode"));
+
+                    // The report is the same regardless of the thread count
+                    ValidationReport serialReport;
+                    Validation::Validate(doc, serialReport, 1U);
+
+                    Assert::AreEqual(issues.size(), serialReport.GetIssues().size());
+
+                    for (size_t i = 0; i < issues.size(); ++i)
+                    {
+                        Assert::AreEqual(issues[i].pointer, serialReport.GetIssues()[i].pointer);
+                        Assert::AreEqual(issues[i].message, serialReport.GetIssues()[i].message);
+                    }
+
+                    // The throwing overload reports the first of them
+                    std::string exceptionMessage;
+
+                    try
+                    {
+                        Validation::Validate(doc);
+                    }
+                    catch (const ValidationException& e)
+                    {
+                        exceptionMessage = e.what();
+                    }
+
+                    Assert::AreEqual(issues[0].message, exceptionMessage);
+                }
+
+                GLTFSDK_TEST_METHOD(ValidationUnitTests, ValidationReport_ThrowingWrappers)
+                {
+                    auto doc = CreateTriangles(std::make_shared<const StreamReaderWriter>(), 2U);
+
+                    ValidationReport report;
+                    Validation::Validate(doc, report);
+
+                    Assert::IsFalse(report.HasErrors());
+                    Assert::IsTrue(report.GetIssues().empty());
+
+                    // The throwing functions report the first issue's message
+                    auto accessor = doc.accessors.Front();
+                    accessor.count = 2U;
+                    doc.accessors.Replace(accessor);
+
+                    Validation::Validate(doc, report);
+
+                    Assert::AreEqual<size_t>(1U, report.GetIssues().size());
+
+                    const auto message = report.GetIssues().front().message;
+
+                    std::string exceptionMessage;
+
+                    try
+                    {
+                        Validation::Validate(doc);
+                    }
+                    catch (const ValidationException& e)
+                    {
+                        exceptionMessage = e.what();
+                    }
+
+                    Assert::AreEqual(message, exceptionMessage);
+                }
+
+                GLTFSDK_TEST_METHOD(ValidationUnitTests, ValidationCache_Incremental)
+                {
+                    const size_t meshCount = 300U;
+
+                    auto doc = CreateTriangles(std::make_shared<const StreamReaderWriter>(), meshCount);
+
+                    ValidationCache cache;
+                    cache.Validate(doc, 4U);
+
+                    Assert::AreEqual(meshCount * 2U, cache.GetValidationCount());
+
+                    // Nothing has changed
+                    cache.Validate(doc, 4U);
+                    Assert::AreEqual(meshCount * 2U, cache.GetValidationCount());
+
+                    // Only the edited accessor and the mesh that uses it are validated, and the error is cached
+                    auto accessor = doc.accessors[doc.meshes[7U].primitives.front().GetAttributeAccessorId(ACCESSOR_POSITION)];
+                    accessor.count = 2U;
+                    doc.accessors.Replace(accessor);
+
+                    Assert::ExpectException<ValidationException>([&cache, &doc]() { cache.Validate(doc); });
+                    Assert::AreEqual(meshCount * 2U + 2U, cache.GetValidationCount());
+
+                    Assert::ExpectException<ValidationException>([&cache, &doc]() { cache.Validate(doc); });
+                    Assert::AreEqual(meshCount * 2U + 2U, cache.GetValidationCount());
+
+                    // Editing the mesh instead makes it valid again
+                    auto mesh = doc.meshes[7U];
+                    mesh.primitives.front().mode = MESH_LINES;
+                    doc.meshes.Replace(mesh);
+
+                    cache.Validate(doc);
+                    Assert::AreEqual(meshCount * 2U + 3U, cache.GetValidationCount());
+
+                    // Entities that have been removed are forgotten
+                    doc.meshes.Remove(mesh.id);
+
+                    cache.Validate(doc);
+                    Assert::AreEqual(meshCount * 2U + 3U, cache.GetValidationCount());
+
+                    doc.meshes.Append(std::move(mesh));
+
+                    cache.Validate(doc);
+                    Assert::AreEqual(meshCount * 2U + 4U, cache.GetValidationCount());
+                }
+
+                GLTFSDK_TEST_METHOD(ValidationUnitTests, ValidationCache_ReadBinaryData)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = CreateTriangles(readerWriter, 3U);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // Repeated reads only validate each accessor once
+                    for (size_t i = 0; i < 2U; ++i)
+                    {
+                        for (const auto& accessor : doc.accessors.Elements())
+                        {
+                            Assert::AreEqual<size_t>(9U, reader.ReadBinaryData<float>(doc, accessor).size());
+                        }
+                    }
+
+                    const auto& cache = reader.GetValidationCache();
+                    Assert::AreEqual<size_t>(3U, cache->GetValidationCount());
+
+                    // The reader's results are reused when validating the document
+                    cache->Validate(doc);
+                    Assert::AreEqual<size_t>(6U, cache->GetValidationCount());
+
+                    // Editing a buffer view invalidates the accessors that use it
+                    auto bufferView = doc.bufferViews.Front();
+                    bufferView.byteLength = 36U;
+                    doc.bufferViews.Replace(bufferView);
+
+                    reader.ReadBinaryData<float>(doc, doc.accessors[0U]);
+
+                    Assert::ExpectException<ValidationException>([&reader, &doc]()
+                    {
+                        reader.ReadBinaryData<float>(doc, doc.accessors[1U]);
+                    });
+
+                    Assert::AreEqual<size_t>(8U, cache->GetValidationCount());
+                }
             };
         }
     }
@@ -396,6 +396,65 @@ namespace Microsoft
                     // Reset back to false - just in case the test is run multiple times by the same process
                     g_isVisited = false;
                 }
+
+                GLTFSDK_TEST_METHOD(VisitorTests, TestVisitorVisitState)
+                {
+                    // Three nodes instancing two meshes that share a material. Ids are not indices.
+                    Document gltfDoc;
+
+                    Material material;
+                    material.id = "material";
+                    gltfDoc.materials.Append(std::move(material));
+
+                    for (const auto& meshId : { "meshA", "meshB" })
+                    {
+                        MeshPrimitive meshPrimitive;
+                        meshPrimitive.materialId = "material";
+
+                        Mesh mesh;
+                        mesh.id = meshId;
+                        mesh.primitives.push_back(std::move(meshPrimitive));
+                        gltfDoc.meshes.Append(std::move(mesh));
+                    }
+
+                    Scene scene;
+                    scene.id = "scene";
+
+                    for (const auto& meshId : { "meshA", "meshB", "meshA" })
+                    {
+                        Node node;
+                        node.id = "node" + std::to_string(gltfDoc.nodes.Size());
+                        node.meshId = meshId;
+
+                        scene.nodes.push_back(node.id);
+                        gltfDoc.nodes.Append(std::move(node));
+                    }
+
+                    gltfDoc.SetDefaultScene(std::move(scene));
+
+                    std::vector<std::pair<std::string, VisitState>> meshVisits;
+                    std::vector<VisitState> materialVisits;
+
+                    Visit(gltfDoc, DefaultSceneIndex,
+                        [&meshVisits](const Mesh& mesh, VisitState visitState)
+                    {
+                        meshVisits.emplace_back(mesh.id, visitState);
+                    },
+                        [&materialVisits](const Material&, VisitState visitState)
+                    {
+                        materialVisits.push_back(visitState);
+                    });
+
+                    Assert::AreEqual<size_t>(3U, meshVisits.size());
+                    Assert::IsTrue(meshVisits[0] == std::make_pair(std::string("meshA"), VisitState::New));
+                    Assert::IsTrue(meshVisits[1] == std::make_pair(std::string("meshB"), VisitState::New));
+                    Assert::IsTrue(meshVisits[2] == std::make_pair(std::string("meshA"), VisitState::Duplicate));
+
+                    Assert::AreEqual<size_t>(3U, materialVisits.size());
+                    Assert::IsTrue(materialVisits[0] == VisitState::New);
+                    Assert::IsTrue(materialVisits[1] == VisitState::Duplicate);
+                    Assert::IsTrue(materialVisits[2] == VisitState::Duplicate);
+                }
             };
         }
     }
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            // Appends a (size + 1) x (size + 1) grid of vertices in the XY plane, offset along the X axis by 'offsetX', and
+            // triangulated into size * size * 2 triangles. If 'texCoords' isn't null, texture coordinates that increase from
+            // 0 to 1 along X and Y (or decrease from 0 to -1 along X if 'mirrored' is true) are also appended.
+            inline void CreateGrid(size_t size, std::vector<float>& positions, std::vector<uint32_t>& indices,
+                float offsetX = 0.0f, std::vector<float>* texCoords = nullptr, bool mirrored = false)
+            {
+                const uint32_t base = static_cast<uint32_t>(positions.size() / 3U);
+                const uint32_t stride = static_cast<uint32_t>(size + 1U);
+
+                for (uint32_t y = 0; y <= size; ++y)
+                {
+                    for (uint32_t x = 0; x <= size; ++x)
+                    {
+                        positions.insert(positions.end(), { offsetX + x, static_cast<float>(y), 0.0f });
+
+                        if (texCoords)
+                        {
+                            texCoords->insert(texCoords->end(), { (mirrored ? -1.0f : 1.0f) * x / size, static_cast<float>(y) / size });
+                        }
+                    }
+                }
+
+                for (uint32_t y = 0; y < size; ++y)
+                {
+                    for (uint32_t x = 0; x < size; ++x)
+                    {
+                        const uint32_t i = base + y * stride + x;
+
+                        indices.insert(indices.end(), { i, i + 1U, i + stride });
+                        indices.insert(indices.end(), { i + 1U, i + stride + 1U, i + stride });
+                    }
+                }
+            }
+        }
+    }
+}
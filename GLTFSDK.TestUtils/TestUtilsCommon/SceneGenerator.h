@@ -0,0 +1,533 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/MemoryStreamWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            // Generated nodes, meshes and materials may have an extension with this name (see SceneGeneratorDesc::extensionDensity)
+            constexpr const char* SYNTHETIC_EXTENSION_NAME = "EXT_synthetic_extension";
+
+            struct SceneGeneratorDesc
+            {
+                uint32_t seed = 0U; // Scenes generated from the same description and seed are identical
+
+                size_t nodeCount = 1U;      // Nodes form a tree with nodeChildCount children per node
+                size_t nodeChildCount = 4U;
+                size_t meshCount = 1U;      // Node i instances mesh i % meshCount
+                size_t materialCount = 1U;  // Mesh i uses material i % materialCount
+                size_t vertexCount = 1024U; // Per mesh, rounded up to a multiple of 4 (each quad is two triangles)
+
+                size_t morphTargetCount = 0U; // Per mesh
+                bool sparse = false;          // Morph targets only displace every eighth vertex, using sparse accessors
+
+                size_t animationCount = 0U; // Each animates the translation, rotation and scale of a node
+                size_t keyframeCount = 32U; // Per animation sampler
+
+                bool interleaved = false; // Vertex attributes share a single strided buffer view per mesh
+                bool base64 = false;      // Buffers are embedded in the manifest as base64 data URIs
+
+                float extensionDensity = 0.0f; // The fraction of nodes, meshes and materials with an extension
+            };
+
+            // Generates deterministic scenes of any size for stress, scaling and performance tests. Each mesh is a grid of
+            // quads with POSITION, NORMAL and TEXCOORD_0 attributes and 32-bit indices. Mesh geometry is generated once and
+            // shared by every mesh, so the cost of generating a scene is dominated by writing its data.
+            class SceneGenerator
+            {
+            public:
+                explicit SceneGenerator(SceneGeneratorDesc desc) : m_desc(std::move(desc))
+                {
+                }
+
+                const SceneGeneratorDesc& GetDesc() const
+                {
+                    return m_desc;
+                }
+
+                // Writes the scene's binary data to a single new buffer of 'bufferBuilder'. SceneGeneratorDesc::base64 is
+                // ignored as the buffer builder's resource writer determines where the buffer is written.
+                Document Generate(BufferBuilder& bufferBuilder, const char* bufferId = nullptr) const
+                {
+                    Document doc;
+
+                    bufferBuilder.AddBuffer(bufferId);
+
+                    std::vector<uint32_t> indices;
+                    const auto vertices = CreateGrid(indices);
+
+                    std::vector<Accessor> sparseAccessors;
+
+                    for (size_t i = 0; i < m_desc.meshCount; ++i)
+                    {
+                        Mesh mesh;
+                        mesh.id = std::to_string(i);
+                        mesh.primitives.push_back(CreateMeshPrimitive(bufferBuilder, vertices, indices, i, sparseAccessors));
+                        mesh.weights.assign(m_desc.morphTargetCount, 0.0f);
+
+                        AddExtension(mesh, i);
+
+                        doc.meshes.Append(std::move(mesh));
+                    }
+
+                    AddAnimations(bufferBuilder, doc);
+
+                    bufferBuilder.Output(doc);
+
+                    // The sparse accessors have no accessor data of their own, so they're added after those of the buffer builder
+                    for (auto& accessor : sparseAccessors)
+                    {
+                        doc.accessors.Append(std::move(accessor));
+                    }
+
+                    for (size_t i = 0; i < m_desc.materialCount; ++i)
+                    {
+                        Material material;
+                        material.id = std::to_string(i);
+                        material.metallicRoughness.metallicFactor = 0.0f;
+                        material.metallicRoughness.roughnessFactor = static_cast<float>(i % 16U) / 15.0f;
+
+                        AddExtension(material, i);
+
+                        doc.materials.Append(std::move(material));
+                    }
+
+                    AddNodes(doc);
+
+                    if (m_desc.extensionDensity > 0.0f)
+                    {
+                        doc.extensionsUsed.insert(SYNTHETIC_EXTENSION_NAME);
+                    }
+
+                    return doc;
+                }
+
+                // Writes the scene's binary data to 'streamWriter' with a GLTFResourceWriter, or embeds it in the document if
+                // SceneGeneratorDesc::base64 is set
+                Document Generate(std::shared_ptr<const IStreamWriter> streamWriter) const
+                {
+                    if (!m_desc.base64)
+                    {
+                        BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(std::move(streamWriter)));
+                        return Generate(bufferBuilder);
+                    }
+
+                    auto memoryWriter = std::make_shared<MemoryStreamWriter>();
+
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(memoryWriter));
+                    auto doc = Generate(bufferBuilder);
+
+                    for (auto buffer : doc.buffers.Elements())
+                    {
+                        buffer.uri = "data:application/octet-stream;base64," + EncodeBase64(memoryWriter->GetData(buffer.uri));
+                        doc.buffers.Replace(buffer);
+                    }
+
+                    return doc;
+                }
+
+                // Writes the manifest to 'uri' and, unless they're embedded, the buffers alongside it
+                Document WriteGLTF(std::shared_ptr<const IStreamWriter> streamWriter, const std::string& uri) const
+                {
+                    auto doc = Generate(streamWriter);
+
+                    auto stream = streamWriter->GetOutputStream(uri);
+                    *stream << Serialize(doc);
+                    stream->flush();
+
+                    return doc;
+                }
+
+                Document WriteGLB(std::shared_ptr<const IStreamWriter> streamWriter, const std::string& uri) const
+                {
+                    auto resourceWriter = std::make_unique<GLBResourceWriter>(std::move(streamWriter));
+                    auto& glbResourceWriter = *resourceWriter;
+
+                    BufferBuilder bufferBuilder(std::move(resourceWriter));
+
+                    auto doc = Generate(bufferBuilder, GLB_BUFFER_ID);
+                    glbResourceWriter.Flush(Serialize(doc), uri);
+
+                    return doc;
+                }
+
+            private:
+                static const size_t SparseStride = 8U; // Sparse morph targets displace every eighth vertex
+
+                struct Vertex
+                {
+                    float position[3];
+                    float normal[3];
+                    float texCoord[2];
+                };
+
+                static std::string EncodeBase64(const std::string& data)
+                {
+                    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+                    std::string encoded;
+                    encoded.reserve(((data.size() + 2U) / 3U) * 4U);
+
+                    for (size_t i = 0; i < data.size(); i += 3U)
+                    {
+                        const size_t remaining = data.size() - i;
+
+                        uint32_t bits = static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << 16;
+
+                        if (remaining > 1U)
+                        {
+                            bits |= static_cast<uint32_t>(static_cast<uint8_t>(data[i + 1U])) << 8;
+                        }
+
+                        if (remaining > 2U)
+                        {
+                            bits |= static_cast<uint8_t>(data[i + 2U]);
+                        }
+
+                        encoded += alphabet[(bits >> 18) & 0x3F];
+                        encoded += alphabet[(bits >> 12) & 0x3F];
+                        encoded += remaining > 1U ? alphabet[(bits >> 6) & 0x3F] : '=';
+                        encoded += remaining > 2U ? alphabet[bits & 0x3F] : '=';
+                    }
+
+                    return encoded;
+                }
+
+                // A linear congruential generator, used rather than <random> as the standard distributions aren't portable
+                static float NextFloat(uint32_t& state)
+                {
+                    state = state * 1664525U + 1013904223U;
+                    return static_cast<float>(state >> 8) / 16777216.0f;
+                }
+
+                // Entity 'index' has an extension if the running total of the extension density passes an integer at it
+                bool HasExtension(size_t index) const
+                {
+                    const auto density = static_cast<double>(std::min(std::max(m_desc.extensionDensity, 0.0f), 1.0f));
+                    return std::floor((index + 1U) * density) > std::floor(index * density);
+                }
+
+                template<typename T>
+                void AddExtension(T& t, size_t index) const
+                {
+                    if (HasExtension(index))
+                    {
+                        t.extensions.emplace(SYNTHETIC_EXTENSION_NAME, "{\"index\":" + std::to_string(index) + "}");
+                    }
+                }
+
+                std::vector<Vertex> CreateGrid(std::vector<uint32_t>& indices) const
+                {
+                    const size_t quadCount = (m_desc.vertexCount + 3U) / 4U;
+                    const size_t columnCount = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(quadCount))));
+
+                    uint32_t state = m_desc.seed;
+
+                    std::vector<Vertex> vertices;
+                    vertices.reserve(quadCount * 4U);
+
+                    indices.clear();
+                    indices.reserve(quadCount * 6U);
+
+                    for (size_t q = 0; q < quadCount; ++q)
+                    {
+                        const float x = static_cast<float>(q % columnCount);
+                        const float y = static_cast<float>(q / columnCount);
+                        const float z = NextFloat(state);
+
+                        const uint32_t first = static_cast<uint32_t>(vertices.size());
+
+                        for (uint32_t v = 0; v < 4U; ++v)
+                        {
+                            const float u = static_cast<float>(v & 1U);
+                            const float w = static_cast<float>(v >> 1);
+
+                            vertices.push_back({ { x + u, y + w, z }, { 0.0f, 0.0f, 1.0f }, { u, w } });
+                        }
+
+                        for (const uint32_t index : { 0U, 1U, 2U, 2U, 1U, 3U })
+                        {
+                            indices.push_back(first + index);
+                        }
+                    }
+
+                    return vertices;
+                }
+
+                static void GetBounds(const std::vector<Vertex>& vertices, std::vector<float>& min, std::vector<float>& max)
+                {
+                    min.assign(3U, 0.0f);
+                    max.assign(3U, 0.0f);
+
+                    if (!vertices.empty())
+                    {
+                        min.assign(vertices.front().position, vertices.front().position + 3U);
+                        max = min;
+                    }
+
+                    for (const auto& vertex : vertices)
+                    {
+                        for (size_t i = 0; i < 3U; ++i)
+                        {
+                            min[i] = std::min(min[i], vertex.position[i]);
+                            max[i] = std::max(max[i], vertex.position[i]);
+                        }
+                    }
+                }
+
+                void AddAttributes(BufferBuilder& bufferBuilder, const std::vector<Vertex>& vertices, MeshPrimitive& meshPrimitive) const
+                {
+                    std::vector<float> min;
+                    std::vector<float> max;
+                    GetBounds(vertices, min, max);
+
+                    AccessorDesc descs[] = {
+                        { TYPE_VEC3, COMPONENT_FLOAT, false, std::move(min), std::move(max), offsetof(Vertex, position) },
+                        { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, offsetof(Vertex, normal) },
+                        { TYPE_VEC2, COMPONENT_FLOAT, false, {}, {}, offsetof(Vertex, texCoord) }
+                    };
+
+                    const char* attributes[] = { ACCESSOR_POSITION, ACCESSOR_NORMAL, ACCESSOR_TEXCOORD_0 };
+
+                    if (m_desc.interleaved)
+                    {
+                        std::string ids[3];
+
+                        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                        bufferBuilder.AddAccessors(vertices.data(), vertices.size(), sizeof(Vertex), descs, 3U, ids);
+
+                        for (size_t i = 0; i < 3U; ++i)
+                        {
+                            meshPrimitive.attributes[attributes[i]] = ids[i];
+                        }
+
+                        return;
+                    }
+
+                    for (size_t i = 0; i < 3U; ++i)
+                    {
+                        const size_t componentCount = Accessor::GetTypeCount(descs[i].accessorType);
+
+                        std::vector<float> components;
+                        components.reserve(vertices.size() * componentCount);
+
+                        for (const auto& vertex : vertices)
+                        {
+                            const auto* first = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(&vertex) + descs[i].byteOffset);
+                            components.insert(components.end(), first, first + componentCount);
+                        }
+
+                        descs[i].byteOffset = 0U;
+
+                        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                        meshPrimitive.attributes[attributes[i]] = bufferBuilder.AddAccessor(components, descs[i]).id;
+                    }
+                }
+
+                // Morph target t displaces vertices by 0.25 * (t + 1) along z
+                MorphTarget AddMorphTarget(BufferBuilder& bufferBuilder, size_t vertexCount, size_t meshIndex, size_t targetIndex, std::vector<Accessor>& sparseAccessors) const
+                {
+                    const float displacement = 0.25f * (targetIndex + 1U);
+
+                    MorphTarget morphTarget;
+
+                    if (!m_desc.sparse)
+                    {
+                        std::vector<float> values(vertexCount * 3U, 0.0f);
+
+                        for (size_t i = 2U; i < values.size(); i += 3U)
+                        {
+                            values[i] = displacement;
+                        }
+
+                        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                        morphTarget.positionsAccessorId = bufferBuilder.AddAccessor(values, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, displacement }, { 0.0f, 0.0f, displacement } }).id;
+
+                        return morphTarget;
+                    }
+
+                    std::vector<uint32_t> indices;
+                    std::vector<float> values;
+
+                    for (size_t i = 0; i < vertexCount; i += SparseStride)
+                    {
+                        indices.push_back(static_cast<uint32_t>(i));
+                        values.insert(values.end(), { 0.0f, 0.0f, displacement });
+                    }
+
+                    // There is no base buffer view, so the values of the vertices that aren't displaced are zero
+                    Accessor accessor;
+                    accessor.id = "sparse_" + std::to_string(meshIndex) + "_" + std::to_string(targetIndex);
+                    accessor.type = TYPE_VEC3;
+                    accessor.componentType = COMPONENT_FLOAT;
+                    accessor.count = vertexCount;
+                    accessor.min = { 0.0f, 0.0f, 0.0f };
+                    accessor.max = { 0.0f, 0.0f, displacement };
+
+                    accessor.sparse.count = indices.size();
+                    accessor.sparse.indicesComponentType = COMPONENT_UNSIGNED_INT;
+                    accessor.sparse.indicesBufferViewId = bufferBuilder.AddBufferView(indices).id;
+                    accessor.sparse.valuesBufferViewId = bufferBuilder.AddBufferView(values).id;
+
+                    morphTarget.positionsAccessorId = accessor.id;
+                    sparseAccessors.push_back(std::move(accessor));
+
+                    return morphTarget;
+                }
+
+                MeshPrimitive CreateMeshPrimitive(BufferBuilder& bufferBuilder, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                    size_t meshIndex, std::vector<Accessor>& sparseAccessors) const
+                {
+                    MeshPrimitive meshPrimitive;
+
+                    AddAttributes(bufferBuilder, vertices, meshPrimitive);
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    meshPrimitive.indicesAccessorId = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+
+                    for (size_t t = 0; t < m_desc.morphTargetCount; ++t)
+                    {
+                        meshPrimitive.targets.push_back(AddMorphTarget(bufferBuilder, vertices.size(), meshIndex, t, sparseAccessors));
+                    }
+
+                    if (m_desc.materialCount > 0U)
+                    {
+                        meshPrimitive.materialId = std::to_string(meshIndex % m_desc.materialCount);
+                    }
+
+                    return meshPrimitive;
+                }
+
+                // Animation a animates node a % nodeCount, with its samplers sharing a single input accessor
+                void AddAnimations(BufferBuilder& bufferBuilder, Document& doc) const
+                {
+                    if (m_desc.animationCount == 0U || m_desc.nodeCount == 0U || m_desc.keyframeCount == 0U)
+                    {
+                        return;
+                    }
+
+                    const size_t keyframeCount = m_desc.keyframeCount;
+
+                    std::vector<float> times(keyframeCount);
+                    std::vector<float> translations(keyframeCount * 3U);
+                    std::vector<float> rotations(keyframeCount * 4U);
+                    std::vector<float> scales(keyframeCount * 3U);
+
+                    for (size_t k = 0; k < keyframeCount; ++k)
+                    {
+                        const float t = static_cast<float>(k) / 30.0f;
+                        const float angle = t * 0.5f;
+
+                        times[k] = t;
+
+                        translations[k * 3U] = std::sin(t);
+                        translations[k * 3U + 1U] = std::cos(t);
+                        translations[k * 3U + 2U] = 0.0f;
+
+                        rotations[k * 4U] = 0.0f;
+                        rotations[k * 4U + 1U] = std::sin(angle);
+                        rotations[k * 4U + 2U] = 0.0f;
+                        rotations[k * 4U + 3U] = std::cos(angle);
+
+                        std::fill_n(scales.begin() + k * 3U, 3U, 1.0f + 0.5f * std::sin(t));
+                    }
+
+                    for (size_t a = 0; a < m_desc.animationCount; ++a)
+                    {
+                        Animation animation;
+                        animation.id = std::to_string(a);
+
+                        bufferBuilder.AddBufferView();
+                        const auto inputAccessorId = bufferBuilder.AddAccessor(times, { TYPE_SCALAR, COMPONENT_FLOAT, false, { times.front() }, { times.back() } }).id;
+
+                        const std::pair<TargetPath, const std::vector<float>*> channels[] = {
+                            { TARGET_TRANSLATION, &translations },
+                            { TARGET_ROTATION, &rotations },
+                            { TARGET_SCALE, &scales }
+                        };
+
+                        for (const auto& channel : channels)
+                        {
+                            const auto type = channel.first == TARGET_ROTATION ? TYPE_VEC4 : TYPE_VEC3;
+
+                            AnimationSampler sampler;
+                            sampler.id = std::to_string(animation.samplers.Size());
+                            sampler.inputAccessorId = inputAccessorId;
+
+                            bufferBuilder.AddBufferView();
+                            sampler.outputAccessorId = bufferBuilder.AddAccessor(*channel.second, { type, COMPONENT_FLOAT }).id;
+
+                            AnimationChannel animationChannel;
+                            animationChannel.id = sampler.id;
+                            animationChannel.samplerId = sampler.id;
+                            animationChannel.target.nodeId = std::to_string(a % m_desc.nodeCount);
+                            animationChannel.target.path = channel.first;
+
+                            animation.samplers.Append(std::move(sampler));
+                            animation.channels.Append(std::move(animationChannel));
+                        }
+
+                        doc.animations.Append(std::move(animation));
+                    }
+                }
+
+                void AddNodes(Document& doc) const
+                {
+                    Scene scene;
+                    scene.id = "0";
+
+                    const size_t childCount = std::max<size_t>(m_desc.nodeChildCount, 1U);
+
+                    for (size_t i = 0; i < m_desc.nodeCount; ++i)
+                    {
+                        Node node;
+                        node.id = std::to_string(i);
+                        node.translation = { static_cast<float>(i % 64U), 0.0f, static_cast<float>((i / 64U) % 64U) };
+
+                        if (m_desc.meshCount > 0U)
+                        {
+                            node.meshId = std::to_string(i % m_desc.meshCount);
+                        }
+
+                        for (size_t child = i * childCount + 1U; child <= i * childCount + childCount && child < m_desc.nodeCount; ++child)
+                        {
+                            node.children.push_back(std::to_string(child));
+                        }
+
+                        AddExtension(node, i);
+
+                        doc.nodes.Append(std::move(node));
+                    }
+
+                    if (m_desc.nodeCount > 0U)
+                    {
+                        scene.nodes.push_back("0");
+                    }
+
+                    doc.defaultSceneId = doc.scenes.Append(std::move(scene)).id;
+                }
+
+                SceneGeneratorDesc m_desc;
+            };
+        }
+    }
+}
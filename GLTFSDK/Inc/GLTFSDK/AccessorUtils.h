@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+        class GLTFResourceReader;
+
+        struct AccessorBounds
+        {
+            std::vector<float> min; // One value per component, in the accessor's component type range (i.e. not normalized)
+            std::vector<float> max;
+        };
+
+        namespace AccessorUtils
+        {
+            // Computes the per-component min and max of 'count' elements that are 'byteStride' bytes apart (zero means tightly
+            // packed). Large inputs are reduced in parallel on up to 'threadCount' threads (zero selects the default).
+            AccessorBounds ComputeMinMax(const void* data, size_t count, size_t byteStride, AccessorType accessorType, ComponentType componentType, size_t threadCount = 0U);
+
+            AccessorBounds ComputeMinMax(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, size_t threadCount = 0U);
+
+            // Computes the min and max of every accessor in the document, returned in the same order as doc.accessors.
+            // Accessor data is read sequentially (resource readers are not thread safe) and reduced in parallel.
+            std::vector<AccessorBounds> ComputeMinMax(const Document& doc, const GLTFResourceReader& reader, size_t threadCount = 0U);
+
+            // Returns the ids of accessors whose min and max values differ from their data by more than 'epsilon'.
+            // Accessors that don't specify min and max values are not checked.
+            std::vector<std::string> VerifyMinMax(const Document& doc, const GLTFResourceReader& reader, float epsilon = 0.0f, size_t threadCount = 0U);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+        class GLTFResourceReader;
+
+        enum RotationInterpolation
+        {
+            ROTATION_INTERPOLATION_SLERP, // Spherical linear interpolation, as required by the glTF specification
+            ROTATION_INTERPOLATION_NLERP  // Normalized linear interpolation, cheaper but not constant velocity
+        };
+
+        // A compiled animation channel. Keyframe times and values are stored in arrays shared by all of an
+        // AnimationEvaluator's tracks and are referenced by offset. Times are stored separately from values, but each
+        // keyframe's components are kept together (x0 y0 z0 x1 y1 z1 ...) rather than split into an array per component:
+        // interpolating reads every component of two adjacent keyframes, and with this layout those are contiguous. See
+        // the AnimationEvaluator_EvaluateBatch_Reference benchmarks for a comparison of the two layouts. Interpolation is
+        // plain scalar code; each time needs its own keyframe lookup, so there's no run of identical work across times
+        // for explicit SIMD to speed up, and the library doesn't use platform intrinsics.
+        struct AnimationTrack
+        {
+            std::string nodeId;
+            TargetPath path = TARGET_UNKNOWN;
+            InterpolationType interpolation = INTERPOLATION_LINEAR;
+
+            size_t componentCount = 0U; // 3 for translation and scale, 4 for rotation (x, y, z, w), the morph target count for weights
+            size_t keyframeCount = 0U;
+            size_t timeOffset = 0U;     // Offset of the track's first keyframe time
+            size_t valueOffset = 0U;    // Offset of the track's first keyframe value. Each CUBICSPLINE keyframe stores an in-tangent, a value and an out-tangent.
+            size_t outputOffset = 0U;   // Offset of the track's evaluated value within the output of AnimationEvaluator::Evaluate
+        };
+
+        // Evaluates every channel of an Animation. The animation's samplers are read and converted to float once, when the
+        // evaluator is constructed, so that evaluation never touches the Document or resource reader.
+        class AnimationEvaluator final
+        {
+        public:
+            AnimationEvaluator(const Document& doc, const GLTFResourceReader& reader, const Animation& animation,
+                RotationInterpolation rotationInterpolation = ROTATION_INTERPOLATION_SLERP);
+
+            const std::vector<AnimationTrack>& GetTracks() const;
+
+            // The keyframe times and values of every track, see AnimationTrack::timeOffset and AnimationTrack::valueOffset
+            const std::vector<float>& GetTimes() const;
+            const std::vector<float>& GetValues() const;
+
+            // The number of floats written by each evaluation - the sum of every track's component count
+            size_t GetOutputSize() const;
+
+            float GetStartTime() const;
+            float GetEndTime() const;
+
+            // Evaluates every track at 'time', writing GetOutputSize() floats to 'output'. Times outside of a track's keyframes
+            // evaluate to its first or last value. 'cursors' caches the keyframe last used by each track: reusing it between
+            // calls makes evaluating at steadily increasing times (e.g. playback) constant time rather than a binary search.
+            void Evaluate(float time, float* output, std::vector<size_t>& cursors) const;
+            void Evaluate(float time, float* output) const;
+
+            // Evaluates every track at each of 'count' times (e.g. the current time of many instances of an animated model),
+            // writing GetOutputSize() floats per time to 'output'. Each track is evaluated for a range of times before moving
+            // on to the next so its keyframes stay in cache. Ranges of times are spread across 'threadCount' threads (zero
+            // selects the default); sorting the times improves the hit rate of the cached keyframe cursors.
+            void Evaluate(const float* times, size_t count, float* output, size_t threadCount = 0U) const;
+
+            // Evaluates a single track, writing its componentCount floats to 'output'
+            void EvaluateTrack(size_t trackIndex, float time, float* output, size_t& cursor) const;
+
+        private:
+            void EvaluateTrack(const AnimationTrack& track, float time, float* output, size_t& cursor) const;
+
+            std::vector<AnimationTrack> m_tracks;
+            std::vector<float> m_times;
+            std::vector<float> m_values;
+
+            size_t m_outputSize;
+            float m_startTime;
+            float m_endTime;
+
+            RotationInterpolation m_rotationInterpolation;
+        };
+    }
+}
@@ -3,17 +3,32 @@
 
 #pragma once
 
+#include <GLTFSDK/GLTF.h>
+
 #include <vector>
 
 namespace Microsoft
 {
     namespace glTF
     {
+        class BufferBuilder;
         class Document;
         class GLTFResourceReader;
-        struct Accessor;
-        struct AnimationSampler;
-        struct Skin;
+
+        struct KeyframeReductionOptions
+        {
+            // Keyframes per second that LINEAR and CUBICSPLINE channels are resampled at before reduction. Resampled cubic
+            // spline channels are output with LINEAR interpolation. Zero keeps each channel's original keyframe times.
+            float sampleRate = 0.0f;
+
+            // The maximum error permitted when removing a keyframe, measured against the value interpolated from its
+            // remaining neighbours: the distance between translations or scales, the angle (in radians) between rotations
+            // and the largest difference between any morph target weight
+            float translationTolerance = 0.0001f;
+            float rotationTolerance = 0.0001f;
+            float scaleTolerance = 0.0001f;
+            float weightsTolerance = 0.0001f;
+        };
 
         namespace AnimationUtils
         {
@@ -34,6 +49,15 @@ namespace Microsoft
 
             std::vector<float> GetMorphWeights(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
             std::vector<float> GetMorphWeights(const Document& doc, const GLTFResourceReader& reader, const AnimationSampler& accessor);
+
+            // Resamples each channel of 'animation' (see KeyframeReductionOptions::sampleRate) and removes keyframes that
+            // can be interpolated from their neighbours within the configured tolerances. The first and last keyframe of
+            // every channel are kept so the animation's duration is unchanged. Channels are processed in parallel across
+            // 'threadCount' threads (zero selects the default). Each channel is given its own sampler whose input and output
+            // accessors are written to a new buffer view in the current buffer of 'bufferBuilder', except CUBICSPLINE
+            // channels when no sample rate is set: these are left unchanged and keep their original accessors.
+            Animation ReduceKeyframes(const Document& doc, const GLTFResourceReader& reader, const Animation& animation, BufferBuilder& bufferBuilder,
+                const KeyframeReductionOptions& options = {}, size_t threadCount = 0U);
         };
     }
 }
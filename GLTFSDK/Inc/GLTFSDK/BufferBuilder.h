@@ -48,12 +48,14 @@ namespace Microsoft
             const Buffer& AddBuffer(const char* bufferId = nullptr);
 
             const BufferView& AddBufferView(Optional<BufferViewTarget> target = {});
-            const BufferView& AddBufferView(const void* data, size_t byteLength, Optional<size_t> byteStride = {}, Optional<BufferViewTarget> target = {});
+            // The buffer view's offset is padded to a multiple of byteAlignment, e.g. so that it's suitably aligned for the
+            // accessors that will refer to it
+            const BufferView& AddBufferView(const void* data, size_t byteLength, Optional<size_t> byteStride = {}, Optional<BufferViewTarget> target = {}, size_t byteAlignment = 1U);
 
             template<typename T>
-            const BufferView& AddBufferView(const std::vector<T>& data, Optional<size_t> byteStride = {}, Optional<BufferViewTarget> target = {})
+            const BufferView& AddBufferView(const std::vector<T>& data, Optional<size_t> byteStride = {}, Optional<BufferViewTarget> target = {}, size_t byteAlignment = 1U)
             {
-                return AddBufferView(data.data(), data.size() * sizeof(T), byteStride, target);
+                return AddBufferView(data.data(), data.size() * sizeof(T), byteStride, target, byteAlignment);
             }
 
             const Accessor& AddAccessor(const void* data, size_t count, AccessorDesc accessorDesc);
@@ -114,6 +116,11 @@ namespace Microsoft
             ResourceWriter& GetResourceWriter();
             const ResourceWriter& GetResourceWriter() const;
 
+            // When enabled, accessors added without min and max values have them computed from their data. Large
+            // accessors are reduced in parallel on up to 'threadCount' threads (zero selects the default).
+            void SetComputeMinMax(bool computeMinMax, size_t threadCount = 0U);
+            bool GetComputeMinMax() const;
+
         private:
             const Accessor& AddAccessor(size_t count, AccessorDesc desc);
 
@@ -126,6 +133,9 @@ namespace Microsoft
             FnGenId m_fnGenBufferId;
             FnGenId m_fnGenBufferViewId;
             FnGenId m_fnGenAccessorId;
+
+            bool m_computeMinMax;
+            size_t m_computeMinMaxThreadCount;
         };
     }
 }
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        struct BufferRepackOptions
+        {
+            // Removes accessors that aren't referenced by a mesh, skin or animation, buffer views that aren't referenced by
+            // a remaining accessor or an image, and the bytes at either end of a buffer view that none of its accessors use
+            bool removeUnused = true;
+
+            // Orders buffer views by their first use when walking meshes (primitive by primitive), then skins, animations
+            // and images, so that each mesh's data is contiguous. Otherwise buffer views keep their order in the document.
+            bool groupByMesh = true;
+
+            // Each buffer view's offset is padded to a multiple of byteAlignment. Multiples of 4 keep every accessor aligned
+            // to its component size.
+            size_t byteAlignment = 4U;
+
+            // Extensions such as KHR_draco_mesh_compression, EXT_meshopt_compression and EXT_mesh_gpu_instancing refer to
+            // accessors or buffer views that RepackBuffers doesn't know about - they may be removed or given new ids,
+            // leaving the extension's references dangling. RepackBuffers throws an InvalidGLTFException if one of these
+            // is in the document's extensionsUsed, unless this is set by a caller that updates the references itself.
+            bool allowExtensionReferences = false;
+        };
+
+        struct BufferRepackStatistics
+        {
+            size_t removedAccessorCount = 0U;
+            size_t removedBufferViewCount = 0U;
+
+            size_t sourceByteLength = 0U; // The total byte length of the document's buffers
+            size_t repackedByteLength = 0U;
+        };
+
+        namespace BufferUtils
+        {
+            // Returns a copy of 'doc' whose binary data is merged into the current buffer of 'bufferBuilder' (call AddBuffer
+            // first). Every buffer view is read with 'reader' and written to the buffer builder one at a time, so only a
+            // single buffer view's data is held in memory. BufferBuilder::Output is called to add the new buffer and buffer
+            // views to the returned document, and accessor and image references are updated to match. References from
+            // extensions aren't updated (see BufferRepackOptions::allowExtensionReferences).
+            Document RepackBuffers(const Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const BufferRepackOptions& options = {}, BufferRepackStatistics* statistics = nullptr);
+        }
+    }
+}
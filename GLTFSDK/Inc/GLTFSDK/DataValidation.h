@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/Validation.h>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class GLTFResourceReader;
+
+        struct DataValidationOptions
+        {
+            bool checkFinite = true;  // Float components must not be NaN or infinite
+            bool checkMinMax = true;  // Declared accessor min and max must match the data
+            bool checkIndices = true; // Mesh primitive indices must be less than the primitive's vertex count
+            bool checkWeights = true; // Each vertex's skinning weights must sum to one
+
+            float minMaxTolerance = 1e-5f; // Relative to the magnitude of the declared value (or 1, if it is smaller)
+            float weightsTolerance = 2e-3f; // Relative to the weight that represents one
+        };
+
+        namespace Validation
+        {
+            // Checks the contents of every accessor, in addition to the structural checks of Validate. Each accessor's
+            // data is read once and all of its checks are run over it together. Accessors are scanned in parallel on up to
+            // 'threadCount' threads (zero selects the default), while reads are sequential as readers aren't thread safe.
+            //
+            // Every issue found is added to 'report', in the order of doc.accessors. Accessors that can't be read are
+            // reported as an issue rather than stopping validation. Weights that don't sum to one are reported as
+            // warnings, and are only checked for primitives with a single set of weights (WEIGHTS_0) as the sum of
+            // several sets isn't known from any one accessor.
+            void ValidateData(const Document& doc, const GLTFResourceReader& reader, ValidationReport& report, const DataValidationOptions& options = {}, size_t threadCount = 0U);
+        }
+    }
+}
@@ -4,13 +4,17 @@
 #pragma once
 
 #include <GLTFSDK/Document.h>
+#include <GLTFSDK/IOStatistics.h>
 #include <GLTFSDK/IStreamReader.h>
+#include <GLTFSDK/Instrumentation.h>
 #include <GLTFSDK/ResourceReaderUtils.h>
 #include <GLTFSDK/StreamCacheLRU.h>
 #include <GLTFSDK/StreamUtils.h>
 #include <GLTFSDK/Validation.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace Microsoft
 {
@@ -25,7 +29,9 @@ namespace Microsoft
             }
 
             GLTFResourceReader(std::unique_ptr<IStreamReaderCache> streamCache)
-                : m_streamReaderCache(std::move(streamCache))
+                : m_streamReaderCache(std::move(streamCache)),
+                  m_validationCache(std::make_shared<ValidationCache>()),
+                  m_ioCounters(std::make_unique<IOCounters>())
             {
             }
 
@@ -33,6 +39,37 @@ namespace Microsoft
 
             virtual ~GLTFResourceReader() = default;
 
+            // Accessors are validated before they are read, with results cached so that repeated reads of an accessor
+            // are only validated again if it (or its buffer view or buffer) has changed. The cache can be shared with
+            // other readers or used to validate the whole document.
+            const std::shared_ptr<ValidationCache>& GetValidationCache() const
+            {
+                return m_validationCache;
+            }
+
+            void SetValidationCache(std::shared_ptr<ValidationCache> validationCache)
+            {
+                if (!validationCache)
+                {
+                    throw GLTFException("Validation cache must not be null");
+                }
+
+                m_validationCache = std::move(validationCache);
+            }
+
+            // The reads and seeks performed by this reader, including its stream cache's hits, misses and evictions.
+            // IOCounters::GetProcessStatistics returns the totals of every reader and writer.
+            IOStatistics GetIOStatistics() const
+            {
+                return m_ioCounters->GetStatistics() + m_streamReaderCache->GetIOStatistics();
+            }
+
+            void ResetIOStatistics()
+            {
+                m_ioCounters->Reset();
+                m_streamReaderCache->ResetIOStatistics();
+            }
+
             // TODO: return mimeType of image
             std::vector<uint8_t> ReadBinaryData(const Document& document, const Image& image) const
             {
@@ -56,7 +93,11 @@ namespace Microsoft
                 }
                 else if (auto stream = m_streamReaderCache->Get(image.uri))
                 {
+                    const auto start = IOCounters::Clock::now();
+
                     data = StreamUtils::ReadBinaryFull<uint8_t>(*stream);
+
+                    m_ioCounters->AddRead(data.size(), 2U, IOCounters::Clock::now() - start);
                 }
                 else
                 {
@@ -69,45 +110,17 @@ namespace Microsoft
             template<typename T>
             std::vector<T> ReadBinaryData(const Document& gltfDocument, const Accessor& accessor) const
             {
-                bool isValid;
+                ValidateComponentType<T>(accessor);
 
-                switch (accessor.componentType)
-                {
-                case COMPONENT_BYTE:
-                    isValid = std::is_same<T, int8_t>::value;
-                    break;
-                case COMPONENT_UNSIGNED_BYTE:
-                    isValid = std::is_same<T, uint8_t>::value;
-                    break;
-                case COMPONENT_SHORT:
-                    isValid = std::is_same<T, int16_t>::value;
-                    break;
-                case COMPONENT_UNSIGNED_SHORT:
-                    isValid = std::is_same<T, uint16_t>::value;
-                    break;
-                case COMPONENT_UNSIGNED_INT:
-                    isValid = std::is_same<T, uint32_t>::value;
-                    break;
-                case COMPONENT_FLOAT:
-                    isValid = std::is_same<T, float>::value;
-                    break;
-                default:
-                    throw GLTFException("Unsupported accessor ComponentType");
-                }
+                GLTFSDK_INSTRUMENT_SCOPE("GLTFResourceReader::ReadBinaryData");
 
-                if (!isValid)
-                {
-                    throw GLTFException("ReadAccessorData: Template type T does not match accessor ComponentType");
-                }
+                m_validationCache->ValidateAccessor(gltfDocument, accessor);
 
-                Validation::ValidateAccessor(gltfDocument, accessor);
+                auto data = (accessor.sparse.count > 0U) ? ReadSparseAccessor<T>(gltfDocument, accessor) : ReadAccessor<T>(gltfDocument, accessor);
 
-                if (accessor.sparse.count > 0U)
-                {
-                    return ReadSparseAccessor<T>(gltfDocument, accessor);
-                }
+                GLTFSDK_INSTRUMENT_COUNTER("GLTFResourceReader::BytesRead", data.size() * sizeof(T));
 
-                return ReadAccessor<T>(gltfDocument, accessor);
+                return data;
             }
 
             template<typename T>
@@ -123,6 +136,97 @@ namespace Microsoft
                 return ReadBinaryData<T>(buffer, bufferView.byteOffset, count);
             }
 
+            // Reads an accessor's elements in chunks, calling fn(const T* components, size_t elementCount) for each chunk in
+            // order. Each chunk is read with a single contiguous read (including any gaps between strided elements) into a
+            // buffer on the stack, so unlike ReadBinaryData the accessor's data is never copied into a vector - except for
+            // sparse accessors and accessors without a buffer view, which are read whole with ReadBinaryData.
+            template<typename T, typename Fn>
+            void ReadBinaryDataChunked(const Document& gltfDocument, const Accessor& accessor, Fn fn) const
+            {
+                if (accessor.sparse.count > 0U || accessor.bufferViewId.empty())
+                {
+                    const auto data = ReadBinaryData<T>(gltfDocument, accessor);
+                    fn(data.data(), accessor.count);
+                    return;
+                }
+
+                ValidateComponentType<T>(accessor);
+
+                GLTFSDK_INSTRUMENT_SCOPE("GLTFResourceReader::ReadBinaryDataChunked");
+
+                m_validationCache->ValidateAccessor(gltfDocument, accessor);
+
+                const auto typeCount = Accessor::GetTypeCount(accessor.type);
+                const size_t elementSize = sizeof(T) * typeCount;
+
+                const BufferView& bufferView = gltfDocument.bufferViews.Get(accessor.bufferViewId);
+                const Buffer& buffer = gltfDocument.buffers.Get(bufferView.bufferId);
+
+                const size_t byteStride = bufferView.byteStride ? bufferView.byteStride.Get() : elementSize;
+                const bool isPacked = (byteStride == elementSize);
+
+                if (std::max(byteStride, elementSize) > ChunkByteLength)
+                {
+                    throw GLTFException("Accessor " + accessor.id + " has an element stride that is too large to read");
+                }
+
+                const size_t chunkElementCount = ChunkByteLength / std::max(byteStride, elementSize);
+                const size_t offset = accessor.byteOffset + bufferView.byteOffset;
+
+                uint8_t bytes[ChunkByteLength];
+                T components[ChunkByteLength / sizeof(T)];
+
+                std::string::const_iterator itBegin;
+                std::string::const_iterator itEnd;
+
+                const bool isBase64 = IsUriBase64(buffer.uri, itBegin, itEnd);
+
+                std::shared_ptr<std::istream> bufferStream;
+                std::streampos bufferStreamPos;
+
+                if (!isBase64)
+                {
+                    bufferStream = GetBinaryStream(buffer);
+                    bufferStreamPos = GetBinaryStreamPos(buffer);
+                }
+
+                for (size_t first = 0U; first < accessor.count; first += chunkElementCount)
+                {
+                    const size_t elementCount = std::min(chunkElementCount, accessor.count - first);
+                    const size_t byteLength = (elementCount - 1U) * byteStride + elementSize;
+                    const auto chunkOffset = static_cast<std::streamoff>(offset + first * byteStride);
+
+                    void* const chunk = isPacked ? static_cast<void*>(components) : static_cast<void*>(bytes);
+
+                    if (isBase64)
+                    {
+                        ReadBinaryDataUri({ itBegin, itEnd }, Base64BufferView(chunk, byteLength), &chunkOffset);
+                    }
+                    else
+                    {
+                        const auto start = IOCounters::Clock::now();
+
+                        bufferStream->seekg(bufferStreamPos + chunkOffset);
+
+                        StreamUtils::ReadBinary(*bufferStream, static_cast<char*>(chunk), byteLength);
+
+                        m_ioCounters->AddRead(byteLength, 1U, IOCounters::Clock::now() - start);
+                    }
+
+                    if (!isPacked)
+                    {
+                        for (size_t i = 0U; i < elementCount; ++i)
+                        {
+                            std::memcpy(components + i * typeCount, bytes + i * byteStride, elementSize);
+                        }
+                    }
+
+                    fn(static_cast<const T*>(components), elementCount);
+                }
+
+                GLTFSDK_INSTRUMENT_COUNTER("GLTFResourceReader::BytesRead", accessor.count * elementSize);
+            }
+
             std::vector<float> ReadFloatData(const Document& gltfDocument, const Accessor& accessor) const;
 
         protected:
@@ -213,7 +317,50 @@ namespace Microsoft
                 return {};
             }
 
+            IOCounters& GetIOCounters() const
+            {
+                return *m_ioCounters;
+            }
+
         private:
+            // The size of the stack buffers used by ReadBinaryDataChunked
+            static const size_t ChunkByteLength = 16384U;
+
+            template<typename T>
+            static void ValidateComponentType(const Accessor& accessor)
+            {
+                bool isValid;
+
+                switch (accessor.componentType)
+                {
+                case COMPONENT_BYTE:
+                    isValid = std::is_same<T, int8_t>::value;
+                    break;
+                case COMPONENT_UNSIGNED_BYTE:
+                    isValid = std::is_same<T, uint8_t>::value;
+                    break;
+                case COMPONENT_SHORT:
+                    isValid = std::is_same<T, int16_t>::value;
+                    break;
+                case COMPONENT_UNSIGNED_SHORT:
+                    isValid = std::is_same<T, uint16_t>::value;
+                    break;
+                case COMPONENT_UNSIGNED_INT:
+                    isValid = std::is_same<T, uint32_t>::value;
+                    break;
+                case COMPONENT_FLOAT:
+                    isValid = std::is_same<T, float>::value;
+                    break;
+                default:
+                    throw GLTFException("Unsupported accessor ComponentType");
+                }
+
+                if (!isValid)
+                {
+                    throw GLTFException("ReadAccessorData: Template type T does not match accessor ComponentType");
+                }
+            }
+
             void ReadBinaryDataUri(Base64StringView encodedData, Base64BufferView decodedData, const std::streamoff* offsetOverride = nullptr) const
             {
                 // The number of unwanted extra bytes that must be decoded for the specified byte offset
@@ -263,6 +410,8 @@ namespace Microsoft
                 }
 
                 Base64Decode(encodedData, decodedData, offsetAdjustment);
+
+                m_ioCounters->AddBase64Decoded(decodedData.bufferByteLength);
             }
 
             template<typename T>
@@ -303,10 +452,14 @@ namespace Microsoft
                     auto bufferStream = GetBinaryStream(buffer);
                     auto bufferStreamPos = GetBinaryStreamPos(buffer);
 
+                    const auto start = IOCounters::Clock::now();
+
                     bufferStream->seekg(bufferStreamPos);
                     bufferStream->seekg(offset, std::ios_base::cur);
 
                     StreamUtils::ReadBinary(*bufferStream, reinterpret_cast<char*>(data.data()), componentCount * sizeof(T));
+
+                    m_ioCounters->AddRead(componentCount * sizeof(T), 2U, IOCounters::Clock::now() - start);
                 }
 
                 return data;
@@ -337,6 +490,8 @@ namespace Microsoft
                     auto bufferStream = GetBinaryStream(buffer);
                     auto bufferStreamPos = GetBinaryStreamPos(buffer) + offset;
 
+                    const auto start = IOCounters::Clock::now();
+
                     for (size_t componentsRead = 0U; componentsRead < componentCount; componentsRead += typeCount)
                     {
                         bufferStream->seekg(bufferStreamPos);
@@ -344,6 +499,9 @@ namespace Microsoft
 
                         StreamUtils::ReadBinary(*bufferStream, reinterpret_cast<char*>(data.data() + componentsRead), elementSize);
                     }
+
+                    // Interleaved data is read with a seek and a read per element
+                    m_ioCounters->AddRead(elementCount * elementSize, elementCount, IOCounters::Clock::now() - start, elementCount);
                 }
 
                 return data;
@@ -402,6 +560,8 @@ namespace Microsoft
             }
 
             std::unique_ptr<IStreamReaderCache> m_streamReaderCache;
+            std::shared_ptr<ValidationCache> m_validationCache;
+            std::unique_ptr<IOCounters> m_ioCounters;
         };
     }
 }
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        // A snapshot of the I/O performed by a reader, writer or stream cache (or by the whole process)
+        struct IOStatistics
+        {
+            uint64_t bytesRead = 0U;
+            uint64_t bytesWritten = 0U;
+            uint64_t readCount = 0U;
+            uint64_t writeCount = 0U;
+            uint64_t seekCount = 0U;
+            uint64_t cacheHitCount = 0U;
+            uint64_t cacheMissCount = 0U;
+            uint64_t cacheEvictionCount = 0U;
+            uint64_t base64BytesDecoded = 0U; // Bytes decoded from data uris rather than read from a stream
+
+            // Time spent in stream reads, writes and seeks, and opening streams on cache misses
+            std::chrono::nanoseconds blockedTime = std::chrono::nanoseconds::zero();
+
+            IOStatistics& operator+=(const IOStatistics& other);
+        };
+
+        IOStatistics operator+(IOStatistics lhs, const IOStatistics& rhs);
+
+        bool operator==(const IOStatistics& lhs, const IOStatistics& rhs);
+        bool operator!=(const IOStatistics& lhs, const IOStatistics& rhs);
+
+        // Thread safe counters owned by each reader, writer and stream cache instance. Every count is also added to the
+        // process-wide counters, so the totals of all instances (including destroyed ones) can be queried at any time.
+        class IOCounters
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            IOCounters();
+
+            IOCounters(const IOCounters&) = delete;
+            IOCounters& operator=(const IOCounters&) = delete;
+
+            void AddRead(uint64_t byteCount, uint64_t seekCount, Clock::duration blockedTime, uint64_t readCount = 1U);
+            void AddWrite(uint64_t byteCount, Clock::duration blockedTime);
+
+            void AddCacheHit();
+            void AddCacheMiss(Clock::duration blockedTime);
+            void AddCacheEviction();
+
+            void AddBase64Decoded(uint64_t byteCount);
+
+            IOStatistics GetStatistics() const;
+
+            // Resets this instance's counters only - the process-wide counters are never reset
+            void Reset();
+
+            static IOStatistics GetProcessStatistics();
+
+        private:
+            explicit IOCounters(IOCounters* parent);
+
+            static IOCounters& GetProcessCounters();
+
+            void Add(std::atomic<uint64_t> IOCounters::* counter, uint64_t value);
+            void AddBlockedTime(Clock::duration blockedTime);
+
+            IOCounters* const m_parent;
+
+            std::atomic<uint64_t> m_bytesRead;
+            std::atomic<uint64_t> m_bytesWritten;
+            std::atomic<uint64_t> m_readCount;
+            std::atomic<uint64_t> m_writeCount;
+            std::atomic<uint64_t> m_seekCount;
+            std::atomic<uint64_t> m_cacheHitCount;
+            std::atomic<uint64_t> m_cacheMissCount;
+            std::atomic<uint64_t> m_cacheEvictionCount;
+            std::atomic<uint64_t> m_base64BytesDecoded;
+            std::atomic<uint64_t> m_blockedNanoseconds;
+        };
+    }
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <GLTFSDK/IOStatistics.h>
+
 #include <istream>
 #include <memory>
 #include <ostream>
@@ -27,6 +29,17 @@ namespace Microsoft
 
             // Explicitly populate the cache with the specified stream
             virtual TStream Set(const std::string& uri, TStream stream) = 0;
+
+            // Cache hits, misses and evictions and the time spent opening streams. Implementations that don't
+            // track these return empty statistics.
+            virtual IOStatistics GetIOStatistics() const
+            {
+                return {};
+            }
+
+            virtual void ResetIOStatistics()
+            {
+            }
         };
 
         typedef IStreamCache<std::shared_ptr<std::istream>> IStreamReaderCache;
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// The SDK's major stages (Deserialize, schema validation, GLB parsing, accessor reads, Serialize, etc.) are instrumented
+// with the GLTFSDK_INSTRUMENT_* macros. They compile to nothing unless GLTFSDK_ENABLE_INSTRUMENTATION is defined as
+// non-zero (see the ENABLE_INSTRUMENTATION CMake option), in which case each records an event with the current sink.
+#ifndef GLTFSDK_ENABLE_INSTRUMENTATION
+#define GLTFSDK_ENABLE_INSTRUMENTATION 0
+#endif
+
+#if GLTFSDK_ENABLE_INSTRUMENTATION
+#define GLTFSDK_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define GLTFSDK_INSTRUMENT_CONCAT(a, b) GLTFSDK_INSTRUMENT_CONCAT_IMPL(a, b)
+
+// Times the remainder of the enclosing scope. 'name' must be a string literal (or otherwise outlive every sink).
+#define GLTFSDK_INSTRUMENT_SCOPE(name) ::Microsoft::glTF::Instrumentation::ScopedTimer GLTFSDK_INSTRUMENT_CONCAT(gltfsdkScopedTimer, __LINE__)(name)
+// Adds 'value' to the counter 'name'. When instrumentation is disabled 'value' isn't evaluated.
+#define GLTFSDK_INSTRUMENT_COUNTER(name, value) ::Microsoft::glTF::Instrumentation::AddCounter(name, static_cast<int64_t>(value))
+#else
+#define GLTFSDK_INSTRUMENT_SCOPE(name) ((void)0)
+#define GLTFSDK_INSTRUMENT_COUNTER(name, value) ((void)0)
+#endif
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Instrumentation
+        {
+            using Clock = std::chrono::steady_clock;
+
+            struct ScopeEvent
+            {
+                const char* name;
+                Clock::time_point start;
+                Clock::duration duration;
+                std::thread::id threadId;
+            };
+
+            struct CounterEvent
+            {
+                const char* name;
+                int64_t value;
+                Clock::time_point time;
+                std::thread::id threadId;
+            };
+
+            // Sinks are called on the thread that recorded each event, so must be thread safe
+            class ISink
+            {
+            public:
+                virtual ~ISink() = default;
+
+                virtual void OnScope(const ScopeEvent& scopeEvent) = 0;
+                virtual void OnCounter(const CounterEvent& counterEvent) = 0;
+            };
+
+            // Sets the sink that receives the events of every thread without a ScopedSink, or disables recording if
+            // 'sink' is null. It must not be called while instrumented operations are in progress on other threads.
+            void SetSink(std::shared_ptr<ISink> sink);
+            std::shared_ptr<ISink> GetSink();
+
+            // Directs the events recorded on the constructing thread to 'sink' for the ScopedSink's lifetime, e.g. to
+            // collect a breakdown per asset when several are loaded concurrently. Work that the SDK distributes to
+            // other threads (see ParallelUtils) is reported to the sink passed to SetSink.
+            class ScopedSink
+            {
+            public:
+                explicit ScopedSink(std::shared_ptr<ISink> sink);
+                ~ScopedSink();
+
+                ScopedSink(const ScopedSink&) = delete;
+                ScopedSink& operator=(const ScopedSink&) = delete;
+
+            private:
+                std::shared_ptr<ISink> m_sink;
+                ISink* m_previousSink;
+            };
+
+            // Records the time between construction and destruction. The clock isn't read if there is no sink.
+            class ScopedTimer
+            {
+            public:
+                explicit ScopedTimer(const char* name);
+                ~ScopedTimer();
+
+                ScopedTimer(const ScopedTimer&) = delete;
+                ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            private:
+                ISink* m_sink;
+                const char* m_name;
+                Clock::time_point m_start;
+            };
+
+            void AddCounter(const char* name, int64_t value);
+
+            // Forwards events to std::function callbacks, either of which may be empty
+            class CallbackSink : public ISink
+            {
+            public:
+                CallbackSink(std::function<void(const ScopeEvent&)> onScope, std::function<void(const CounterEvent&)> onCounter = {});
+
+                void OnScope(const ScopeEvent& scopeEvent) override;
+                void OnCounter(const CounterEvent& counterEvent) override;
+
+            private:
+                std::function<void(const ScopeEvent&)> m_onScope;
+                std::function<void(const CounterEvent&)> m_onCounter;
+            };
+
+            // Accumulates the total time and number of calls of each scope, and the total of each counter
+            class SummarySink : public ISink
+            {
+            public:
+                struct Entry
+                {
+                    size_t count = 0U;
+                    Clock::duration duration = Clock::duration::zero(); // Scopes only
+                    int64_t total = 0;                                   // Counters only
+                };
+
+                void OnScope(const ScopeEvent& scopeEvent) override;
+                void OnCounter(const CounterEvent& counterEvent) override;
+
+                std::map<std::string, Entry> GetScopes() const;
+                std::map<std::string, Entry> GetCounters() const;
+
+                void Clear();
+
+            private:
+                mutable std::mutex m_mutex;
+                std::map<std::string, Entry> m_scopes;
+                std::map<std::string, Entry> m_counters;
+            };
+
+            // Buffers events and writes them to a stream as a Chrome trace (in the JSON array format), for viewing with
+            // chrome://tracing or Perfetto. Buffered events are written by Flush, and the trace is completed when the
+            // sink is destroyed.
+            class ChromeTraceSink : public ISink
+            {
+            public:
+                explicit ChromeTraceSink(std::shared_ptr<std::ostream> stream);
+                ~ChromeTraceSink() override;
+
+                void OnScope(const ScopeEvent& scopeEvent) override;
+                void OnCounter(const CounterEvent& counterEvent) override;
+
+                void Flush();
+
+            private:
+                struct Event
+                {
+                    const char* name;
+                    char phase;
+                    int64_t timestamp; // Microseconds since the sink was created
+                    int64_t value;     // The duration in microseconds of scopes, or the value of counters
+                    size_t threadIndex;
+                };
+
+                void Add(const char* name, char phase, Clock::time_point time, int64_t value, std::thread::id threadId);
+
+                std::shared_ptr<std::ostream> m_stream;
+                const Clock::time_point m_startTime;
+
+                std::mutex m_mutex;
+                std::vector<Event> m_events;
+                std::unordered_map<std::thread::id, size_t> m_threadIndices;
+                bool m_hasWrittenEvents;
+            };
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 
 namespace Microsoft
 {
@@ -108,6 +109,106 @@ namespace Microsoft
             {
                 return static_cast<uint8_t>(value * 255.0f + 0.5f);
             }
+
+            // IEEE 754 binary32 -> binary16 using round-to-nearest-even. Values too large
+            // for a half-precision float become infinity and NaN payloads are preserved as NaN
+            inline uint16_t FloatToHalf(float value)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+
+                const uint32_t sign = (bits >> 16U) & 0x8000U;
+                const uint32_t exponent = (bits >> 23U) & 0xFFU;
+                uint32_t mantissa = bits & 0x7FFFFFU;
+
+                if (exponent == 0xFFU)
+                {
+                    return static_cast<uint16_t>(sign | 0x7C00U | (mantissa ? 0x200U : 0U));
+                }
+
+                const int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+
+                if (halfExponent >= 0x1F)
+                {
+                    return static_cast<uint16_t>(sign | 0x7C00U);
+                }
+
+                if (halfExponent <= 0)
+                {
+                    // Too small to be represented, even as a subnormal half
+                    if (halfExponent < -10)
+                    {
+                        return static_cast<uint16_t>(sign);
+                    }
+
+                    // Subnormal half - shift the mantissa (including the implicit leading bit) into place
+                    mantissa |= 0x800000U;
+
+                    const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+                    const uint32_t remainder = mantissa & ((1U << shift) - 1U);
+                    const uint32_t halfway = 1U << (shift - 1U);
+
+                    uint32_t half = mantissa >> shift;
+
+                    if (remainder > halfway || (remainder == halfway && (half & 1U)))
+                    {
+                        ++half;
+                    }
+
+                    return static_cast<uint16_t>(sign | half);
+                }
+
+                uint32_t half = (static_cast<uint32_t>(halfExponent) << 10U) | (mantissa >> 13U);
+                const uint32_t remainder = mantissa & 0x1FFFU;
+
+                // Rounding may carry into the exponent which correctly rounds up to the next power of two (or infinity)
+                if (remainder > 0x1000U || (remainder == 0x1000U && (half & 1U)))
+                {
+                    ++half;
+                }
+
+                return static_cast<uint16_t>(sign | half);
+            }
+
+            // IEEE 754 binary16 -> binary32 (exact, every half-precision value is representable)
+            inline float HalfToFloat(uint16_t value)
+            {
+                const uint32_t sign = static_cast<uint32_t>(value & 0x8000U) << 16U;
+                uint32_t exponent = (value >> 10U) & 0x1FU;
+                uint32_t mantissa = value & 0x3FFU;
+
+                uint32_t bits;
+
+                if (exponent == 0x1FU)
+                {
+                    bits = sign | 0x7F800000U | (mantissa << 13U);
+                }
+                else if (exponent != 0U)
+                {
+                    bits = sign | ((exponent + 127U - 15U) << 23U) | (mantissa << 13U);
+                }
+                else if (mantissa != 0U)
+                {
+                    // Subnormal half - normalize the mantissa
+                    exponent = 127U - 15U + 1U;
+
+                    while ((mantissa & 0x400U) == 0U)
+                    {
+                        mantissa <<= 1U;
+                        --exponent;
+                    }
+
+                    bits = sign | (exponent << 23U) | ((mantissa & 0x3FFU) << 13U);
+                }
+                else
+                {
+                    bits = sign;
+                }
+
+                float result;
+                std::memcpy(&result, &bits, sizeof(result));
+                return result;
+            }
         }
     }
 }
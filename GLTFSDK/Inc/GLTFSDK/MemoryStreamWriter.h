@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/IStreamWriter.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        // An IStreamWriter that keeps everything written to it in memory, one stream per uri. Requesting the same uri
+        // again returns the existing stream. Not thread-safe.
+        class MemoryStreamWriter : public IStreamWriter
+        {
+        public:
+            std::shared_ptr<std::ostream> GetOutputStream(const std::string& uri) const override
+            {
+                auto& stream = m_streams[uri];
+
+                if (!stream)
+                {
+                    stream = std::make_shared<std::stringstream>();
+                }
+
+                return stream;
+            }
+
+            // The data written to 'uri', or an empty string if nothing was
+            std::string GetData(const std::string& uri) const
+            {
+                const auto it = m_streams.find(uri);
+                return it == m_streams.end() ? std::string() : it->second->str();
+            }
+
+            const std::unordered_map<std::string, std::shared_ptr<std::stringstream>>& GetStreams() const
+            {
+                return m_streams;
+            }
+
+        private:
+            mutable std::unordered_map<std::string, std::shared_ptr<std::stringstream>> m_streams;
+        };
+    }
+}
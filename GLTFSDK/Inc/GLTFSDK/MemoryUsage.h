@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+
+        namespace MemoryUsage
+        {
+            // An estimate of the heap memory owned by a Document (excluding sizeof(Document) itself). Each container's
+            // size includes the elements' vectors, strings, extension maps and extras. The strings, extensions and
+            // extras totals break down the same bytes by kind, so they overlap the container sizes.
+            struct DocumentMemoryUsage
+            {
+                size_t asset = 0U;
+                size_t accessors = 0U;
+                size_t animations = 0U;
+                size_t buffers = 0U;
+                size_t bufferViews = 0U;
+                size_t cameras = 0U;
+                size_t images = 0U;
+                size_t materials = 0U;
+                size_t meshes = 0U;
+                size_t nodes = 0U;
+                size_t samplers = 0U;
+                size_t scenes = 0U;
+                size_t skins = 0U;
+                size_t textures = 0U;
+                size_t document = 0U; // The document's own extensions, extras, extensionsUsed, extensionsRequired and defaultSceneId
+
+                size_t strings = 0U;    // Ids, names, uris, etc. (including the copies of ids that index each container)
+                size_t extensions = 0U; // Unparsed extension maps (keys, values and the maps themselves)
+                size_t extras = 0U;
+
+                size_t GetTotal() const;
+            };
+
+            // Standard library containers are sized using typical node and bucket layouts, and strings short enough to be
+            // stored inline aren't counted. The contents of deserialized (registered) extensions aren't known, so only the
+            // map entries that hold them are counted.
+            DocumentMemoryUsage GetDocumentMemoryUsage(const Document& document);
+
+            // Tracks the net and peak bytes allocated on the constructing thread during its lifetime, e.g. around a call to
+            // Deserialize or GLTFResourceReader::ReadBinaryData. Trackers can be nested. Allocations are only reported if the
+            // application forwards them with RecordAllocation/RecordDeallocation - GLTFSDK_DEFINE_COUNTING_OPERATOR_NEW does
+            // this for every allocation made with operator new. Work that the SDK distributes to other threads isn't tracked.
+            class AllocationTracker
+            {
+            public:
+                AllocationTracker();
+                ~AllocationTracker();
+
+                AllocationTracker(const AllocationTracker&) = delete;
+                AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+                // Negative if more memory was released than allocated
+                int64_t GetCurrentBytes() const;
+                size_t GetPeakBytes() const;
+                size_t GetAllocationCount() const;
+
+            private:
+                friend void RecordAllocation(size_t byteCount);
+                friend void RecordDeallocation(size_t byteCount);
+
+                AllocationTracker* const m_previous;
+
+                int64_t m_currentBytes;
+                int64_t m_peakBytes;
+                size_t m_allocationCount;
+            };
+
+            // Reports an allocation or deallocation on the current thread to its AllocationTrackers. They don't allocate.
+            void RecordAllocation(size_t byteCount);
+            void RecordDeallocation(size_t byteCount);
+
+            // Allocate and free memory with malloc, recording the sizes (which are stored in a header before the returned
+            // pointer) with RecordAllocation/RecordDeallocation. CountingAllocate throws std::bad_alloc on failure.
+            void* CountingAllocate(size_t byteCount);
+            void* CountingAllocate(size_t byteCount, const std::nothrow_t&) noexcept;
+            void CountingFree(void* ptr) noexcept;
+        }
+    }
+}
+
+// Replaces the global operator new and delete with the counting allocator so that AllocationTrackers observe every
+// allocation. Opt-in: use it at namespace scope in exactly one source file of an application (never in a library).
+// Over-aligned (C++17) allocations are left to the default implementation.
+#define GLTFSDK_DEFINE_COUNTING_OPERATOR_NEW() \
+    void* operator new(std::size_t byteCount) { return ::Microsoft::glTF::MemoryUsage::CountingAllocate(byteCount); } \
+    void* operator new[](std::size_t byteCount) { return ::Microsoft::glTF::MemoryUsage::CountingAllocate(byteCount); } \
+    void* operator new(std::size_t byteCount, const std::nothrow_t& tag) noexcept { return ::Microsoft::glTF::MemoryUsage::CountingAllocate(byteCount, tag); } \
+    void* operator new[](std::size_t byteCount, const std::nothrow_t& tag) noexcept { return ::Microsoft::glTF::MemoryUsage::CountingAllocate(byteCount, tag); } \
+    void operator delete(void* ptr) noexcept { ::Microsoft::glTF::MemoryUsage::CountingFree(ptr); } \
+    void operator delete[](void* ptr) noexcept { ::Microsoft::glTF::MemoryUsage::CountingFree(ptr); } \
+    void operator delete(void* ptr, std::size_t) noexcept { ::Microsoft::glTF::MemoryUsage::CountingFree(ptr); } \
+    void operator delete[](void* ptr, std::size_t) noexcept { ::Microsoft::glTF::MemoryUsage::CountingFree(ptr); } \
+    void operator delete(void* ptr, const std::nothrow_t&) noexcept { ::Microsoft::glTF::MemoryUsage::CountingFree(ptr); } \
+    void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ::Microsoft::glTF::MemoryUsage::CountingFree(ptr); }
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        struct MeshOptimizationOptions
+        {
+            bool optimizeVertexCache = true;
+            bool optimizeOverdraw = true;
+            bool optimizeVertexFetch = true;
+
+            // The maximum permitted increase in the average cache miss ratio when reordering triangles to reduce
+            // overdraw - e.g. 1.05 allows the overdraw pass to make vertex cache efficiency up to 5% worse
+            float overdrawThreshold = 1.05f;
+        };
+
+        // A tightly packed array of per-vertex elements, e.g. the data read from a single vertex attribute accessor
+        struct VertexStream
+        {
+            VertexStream() = default;
+
+            VertexStream(const void* data, ComponentType componentType, size_t componentCount)
+                : data(static_cast<const uint8_t*>(data)), componentType(componentType), componentCount(componentCount)
+            { }
+
+            const uint8_t* data = nullptr;
+            ComponentType componentType = COMPONENT_UNKNOWN;
+            size_t componentCount = 0U;
+        };
+
+        namespace MeshOptimizationUtils
+        {
+            // Reorders the triangles of a triangle list to improve post-transform vertex cache utilization using
+            // Tom Forsyth's 'Linear-Speed Vertex Cache Optimisation' algorithm. Triangle winding is preserved.
+            std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount);
+
+            // Reorders clusters of triangles so that triangles facing outward from the mesh's centroid are drawn
+            // first. Clusters are formed from a vertex cache optimized triangle list such that the average cache miss
+            // ratio of the output is no worse than 'threshold' times that of the input.
+            std::vector<uint32_t> OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<float>& positions, float threshold = 1.05f);
+
+            // Returns a vertex remap table (old vertex index -> new vertex index) that orders vertices by their first
+            // use in the index buffer. Unreferenced vertices are retained and moved after all referenced vertices.
+            std::vector<uint32_t> OptimizeVertexFetchRemap(const std::vector<uint32_t>& indices, size_t vertexCount);
+
+            std::vector<uint32_t> RemapIndices(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap);
+
+            // Simulates a FIFO post-transform vertex cache and returns the number of cache misses per triangle
+            float GetAverageCacheMissRatio(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = 16U);
+
+            // Returns a vertex remap table (vertex index -> unique vertex index) where two vertices map to the same unique
+            // vertex if they are equal in every stream. Unique vertices are numbered in order of first occurrence. Float
+            // components are compared bitwise unless 'epsilon' is non-zero, in which case they are merged if they fall in
+            // the same epsilon sized quantization cell. Hashing and deduplication are spread across 'threadCount' threads
+            // (zero selects the default) and the result doesn't depend on the number of threads used.
+            std::vector<uint32_t> GenerateVertexRemap(const std::vector<VertexStream>& streams, size_t vertexCount, size_t& uniqueVertexCount, float epsilon = 0.0f, size_t threadCount = 0U);
+
+            // Welds vertices that are identical across all attribute and morph target accessors of a MeshPrimitive. An index
+            // accessor is generated for non-indexed primitives (the primitive's mode is unchanged). New accessors are written
+            // to the current buffer of 'bufferBuilder' and the returned MeshPrimitive references them.
+            MeshPrimitive WeldVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, float epsilon = 0.0f, size_t threadCount = 0U);
+
+            // Applies the passes enabled in 'options' to a triangle based MeshPrimitive. New index and vertex attribute
+            // accessors (including morph targets) are written to the current buffer of 'bufferBuilder' and the returned
+            // MeshPrimitive references them - call BufferBuilder::Output to add them to a Document.
+            MeshPrimitive OptimizeMeshPrimitive(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const MeshOptimizationOptions& options = {});
+        }
+    }
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include <GLTFSDK/GLTF.h>
@@ -14,6 +15,45 @@ namespace Microsoft
         class Document;
         class GLTFResourceReader;
 
+        // Storage formats for the components of an interleaved vertex element
+        enum VertexFormat
+        {
+            VERTEX_FORMAT_UNKNOWN = 0,
+            VERTEX_FORMAT_FLOAT32,
+            VERTEX_FORMAT_FLOAT16,
+            VERTEX_FORMAT_UNORM8,
+            VERTEX_FORMAT_SNORM8,
+            VERTEX_FORMAT_UNORM16,
+            VERTEX_FORMAT_SNORM16,
+            VERTEX_FORMAT_UINT8,
+            VERTEX_FORMAT_UINT16,
+            VERTEX_FORMAT_UINT32
+        };
+
+        // Describes where, and in which format, a single MeshPrimitive attribute is written to an interleaved vertex.
+        // When componentCount exceeds the number of components in the source accessor the remaining components are
+        // filled from (0, 0, 0, 1) - e.g. an RGB color written with 4 components gets an opaque alpha channel.
+        struct VertexElement
+        {
+            VertexElement() = default;
+
+            VertexElement(std::string attributeName, VertexFormat format, size_t componentCount, size_t byteOffset, bool required = true)
+                : attributeName(std::move(attributeName)), format(format), componentCount(componentCount), byteOffset(byteOffset), required(required)
+            { }
+
+            std::string attributeName;
+            VertexFormat format = VERTEX_FORMAT_UNKNOWN;
+            size_t componentCount = 0U;
+            size_t byteOffset = 0U;
+            bool required = true; // If false and the attribute is absent then the element is filled with default values
+        };
+
+        struct VertexLayout
+        {
+            std::vector<VertexElement> elements;
+            size_t byteStride = 0U;
+        };
+
         namespace MeshPrimitiveUtils
         {
             std::vector<uint16_t> GetIndices16(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
@@ -57,6 +97,22 @@ namespace Microsoft
             std::vector<uint32_t> GetJointWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
             std::vector<uint32_t> GetJointWeights32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive);
 
+            // Structure-of-arrays variants that return one stream per joint influence, i.e. [i][v] is influence i of vertex v
+            std::array<std::vector<uint16_t>, 4> GetJointIndicesSoA(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
+            std::array<std::vector<uint16_t>, 4> GetJointIndicesSoA_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive);
+
+            std::array<std::vector<float>, 4> GetJointWeightsSoA(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
+            std::array<std::vector<float>, 4> GetJointWeightsSoA_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive);
+
+            size_t GetVertexFormatSize(VertexFormat format);
+
+            // Decodes every attribute referenced by the layout directly into a single interleaved vertex buffer, converting
+            // each component (e.g. normalized integers to float, float to half or unorm) as it is written. Attributes are
+            // read from their buffer views in chunks (see GLTFResourceReader::ReadBinaryDataChunked) so that no
+            // intermediate per-attribute vectors are allocated.
+            std::vector<uint8_t> GetInterleavedVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const VertexLayout& layout);
+            void GetInterleavedVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const VertexLayout& layout, void* vertices, size_t verticesByteLength);
+
             std::vector<uint16_t> ReverseTriangulateIndices16(const uint16_t* indices, size_t indexCount, MeshMode mode);
             std::vector<uint32_t> ReverseTriangulateIndices32(const uint32_t* indices, size_t indexCount, MeshMode mode);
 
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        // Simplification stops at whichever of the two targets is reached first
+        struct MeshSimplificationLevel
+        {
+            MeshSimplificationLevel() = default;
+
+            MeshSimplificationLevel(float targetRatio, float targetRmsError) : targetRatio(targetRatio), targetRmsError(targetRmsError)
+            { }
+
+            float targetRatio = 0.5f;     // Fraction of the source primitive's triangles to keep
+            float targetRmsError = 0.01f; // Root mean square error (see Simplify), relative to the largest dimension of the mesh's bounds
+        };
+
+        namespace MeshSimplificationUtils
+        {
+            // Simplifies a triangle list using quadric error metric guided half-edge collapses, returning the new triangle
+            // list (vertices are never moved or added so the source vertex data remains valid). Vertices that share their
+            // position with another vertex (i.e. attribute seams) and vertices on open borders are never removed, so meshes
+            // with many seams simplify poorly - weld vertices whose attributes are close enough to be merged with
+            // MeshOptimizationUtils::WeldVertices first. If 'vertexGroups' is non-empty a vertex can only collapse onto
+            // another vertex of the same group. The error of each collapse is the area weighted root mean square distance
+            // from the vertex it collapses onto to the planes of the source triangles it replaces, relative to the largest
+            // dimension of the mesh's bounds. No collapse exceeds 'targetRmsError', but as a mean it doesn't bound the
+            // maximum deviation of the simplified surface. The largest error of any collapse is returned via
+            // 'resultRmsError' when specified.
+            std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, const std::vector<float>& positions, size_t targetIndexCount, float targetRmsError,
+                float* resultRmsError = nullptr, const std::vector<uint32_t>& vertexGroups = {});
+
+            // Generates a chain of simplified versions of a triangle based MeshPrimitive, one per level, each simplified from
+            // the previous level. The LOD primitives share the source primitive's vertex attribute accessors and only new index
+            // accessors are written to the current buffer of 'bufferBuilder'. When the primitive is skinned vertices only
+            // collapse onto vertices with the same most influential joint.
+            std::vector<MeshPrimitive> GenerateLODs(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+                const std::vector<MeshSimplificationLevel>& levels);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <array>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        struct Meshlet
+        {
+            uint32_t vertexOffset = 0U;   // Offset of the meshlet's first entry in MeshletData::vertices
+            uint32_t vertexCount = 0U;
+            uint32_t triangleOffset = 0U; // Offset of the meshlet's first triangle in MeshletData::triangles (in triangles, not bytes)
+            uint32_t triangleCount = 0U;
+        };
+
+        // A bounding sphere and a cone that bounds the normals of every triangle in a meshlet. Viewed from a position
+        // p, all of a meshlet's triangles are back facing (and the meshlet can be culled) when
+        // dot(center - p, coneAxis) >= coneCutoff * length(center - p) + radius. The radius term makes the test
+        // conservative for triangles anywhere within the bounding sphere, not just at its center.
+        struct MeshletBounds
+        {
+            std::array<float, 3> center = {};
+            float radius = 0.0f;
+            std::array<float, 3> coneAxis = {};
+            float coneCutoff = 1.0f; // Sine of the normal cone's half-angle, 1 when the cone is too wide to cull
+        };
+
+        struct MeshletData
+        {
+            std::vector<Meshlet> meshlets;
+            std::vector<MeshletBounds> bounds;    // One per meshlet
+            std::vector<uint32_t> vertices;       // Per meshlet lists of indices into the primitive's vertices
+            std::vector<uint8_t> triangles;       // Three meshlet local vertex indices per triangle
+        };
+
+        namespace MeshletUtils
+        {
+            const size_t MaxMeshletVertexCount = 256U; // Meshlet local indices are stored as unsigned bytes
+
+            // Partitions a triangle list into meshlets of at most 'maxVertices' unique vertices and 'maxTriangles' triangles.
+            // Meshlets are grown greedily from adjacent triangles, preferring triangles that add the fewest new vertices.
+            MeshletData BuildMeshlets(const std::vector<uint32_t>& indices, const std::vector<float>& positions, size_t maxVertices = 64U, size_t maxTriangles = 124U);
+
+            MeshletBounds ComputeMeshletBounds(const MeshletData& meshletData, const Meshlet& meshlet, const std::vector<float>& positions);
+
+            // Builds meshlets for a triangle based MeshPrimitive and writes them to the current buffer of 'bufferBuilder'. The
+            // 32-bit data is written to two buffer views without accessors (glTF only allows UNSIGNED_INT accessors for indices):
+            // meshlets (4 uint32 per meshlet: vertexOffset, vertexCount, triangleOffset, triangleCount) and vertices (uint32).
+            // The rest is written as three accessors: triangles (UNSIGNED_BYTE SCALAR), bounds (FLOAT VEC4: center, radius) and
+            // cones (FLOAT VEC4: axis, cutoff). The returned MeshPrimitive's extras has a "meshlets" object member referencing
+            // these as "meshletsBufferView", "verticesBufferView", "triangles", "bounds" and "cones", replacing any "meshlets"
+            // member already present.
+            //
+            // These members hold the SDK ids of the buffer views and accessors, not glTF indices - extras are serialized
+            // verbatim, so they must be resolved with ResolveMeshletIndices once the BufferBuilder has been output to the
+            // document and before it is serialized.
+            MeshPrimitive AddMeshlets(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+                size_t maxVertices = 64U, size_t maxTriangles = 124U);
+
+            // Replaces the buffer view and accessor ids of the "meshlets" member of the mesh primitive's extras (see
+            // AddMeshlets) with their indices in 'doc', as required by glTF. Throws if any of them isn't in 'doc'.
+            MeshPrimitive ResolveMeshletIndices(const Document& doc, const MeshPrimitive& meshPrimitive);
+        }
+    }
+}
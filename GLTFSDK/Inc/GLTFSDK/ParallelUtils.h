@@ -0,0 +1,363 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace ParallelUtils
+        {
+            // The number of threads used when a thread count of zero is requested
+            inline size_t GetDefaultThreadCount()
+            {
+                const auto threadCount = std::thread::hardware_concurrency();
+                return threadCount == 0U ? 1U : threadCount;
+            }
+
+            // Splits [0, count) into contiguous ranges and invokes fn(begin, end) for each of them on up to
+            // 'threadCount' threads (zero selects the default). The calling thread processes the first range.
+            // The first exception thrown by fn is rethrown on the calling thread once all ranges are complete.
+            template<typename Fn>
+            void ParallelFor(size_t count, Fn fn, size_t threadCount = 0U, size_t minRangeSize = 1U)
+            {
+                if (count == 0U)
+                {
+                    return;
+                }
+
+                if (threadCount == 0U)
+                {
+                    threadCount = GetDefaultThreadCount();
+                }
+
+                size_t rangeCount = std::max<size_t>(1U, std::min(threadCount, count / std::max<size_t>(1U, minRangeSize)));
+
+                if (rangeCount == 1U)
+                {
+                    fn(size_t(0U), count);
+                    return;
+                }
+
+                const size_t rangeSize = (count + rangeCount - 1U) / rangeCount;
+
+                // Rounding the range size up may leave fewer (non-empty) ranges than requested
+                rangeCount = (count + rangeSize - 1U) / rangeSize;
+
+                std::vector<std::exception_ptr> exceptions(rangeCount);
+                std::vector<std::thread> threads;
+
+                threads.reserve(rangeCount - 1U);
+
+                auto runRange = [&fn, &exceptions, rangeSize, count](size_t range)
+                {
+                    try
+                    {
+                        const size_t begin = range * rangeSize;
+                        fn(begin, std::min(begin + rangeSize, count));
+                    }
+                    catch (...)
+                    {
+                        exceptions[range] = std::current_exception();
+                    }
+                };
+
+                for (size_t range = 1U; range < rangeCount; ++range)
+                {
+                    threads.emplace_back(runRange, range);
+                }
+
+                runRange(0U);
+
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+
+                for (const auto& exception : exceptions)
+                {
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                }
+            }
+
+            // A value per thread for accumulating results without synchronization, e.g. from the callbacks of
+            // ParallelForEachTask or TraverseParallel, which pass the index of the calling thread. Values are padded
+            // so that threads updating neighbouring values don't contend for the same cache line.
+            template<typename T>
+            class PerThread final
+            {
+            public:
+                explicit PerThread(size_t threadCount = 0U, const T& value = T()) :
+                    m_slots(threadCount == 0U ? GetDefaultThreadCount() : threadCount, Slot{ value })
+                {
+                }
+
+                T& operator[](size_t threadIndex)
+                {
+                    return m_slots[threadIndex].value;
+                }
+
+                const T& operator[](size_t threadIndex) const
+                {
+                    return m_slots[threadIndex].value;
+                }
+
+                size_t Size() const
+                {
+                    return m_slots.size();
+                }
+
+                // Combines every thread's value with fn(accumulated, value), in thread index order
+                template<typename Fn>
+                T Reduce(T value, Fn fn) const
+                {
+                    for (const auto& slot : m_slots)
+                    {
+                        value = fn(std::move(value), slot.value);
+                    }
+
+                    return value;
+                }
+
+            private:
+                struct Slot
+                {
+                    T value;
+                    char padding[64];
+                };
+
+                std::vector<Slot> m_slots;
+            };
+
+            // Per-thread double-ended task queues. A thread pushes and pops tasks at the back of its own queue and, when
+            // that is empty, steals from the front of another thread's queue - taking the oldest, and for recursively
+            // spawned work typically the largest, task. Threads without a task block in WaitForTask until one is pushed
+            // or the last pending task completes.
+            template<typename Task>
+            class WorkStealingQueues final
+            {
+            public:
+                explicit WorkStealingQueues(size_t threadCount) :
+                    m_queues(threadCount),
+                    m_pendingCount(0U),
+                    m_queuedCount(0U),
+                    m_waitingCount(0U)
+                {
+                }
+
+                // Adds a task to the queue of the thread 'threadIndex'. Must only be called from that thread, or before
+                // the queues are being processed.
+                void Push(size_t threadIndex, Task task)
+                {
+                    ++m_pendingCount;
+
+                    {
+                        auto& queue = m_queues[threadIndex];
+                        std::lock_guard<std::mutex> lock(queue.mutex);
+                        queue.tasks.push_back(std::move(task));
+                    }
+
+                    ++m_queuedCount;
+
+                    if (m_waitingCount > 0U)
+                    {
+                        Notify(false);
+                    }
+                }
+
+                // Takes a task from the back of the thread's own queue or, failing that, the front of another thread's
+                // queue. Each task taken must be followed by a call to CompleteTask once it has been processed.
+                bool Pop(size_t threadIndex, Task& task)
+                {
+                    {
+                        auto& queue = m_queues[threadIndex];
+                        std::lock_guard<std::mutex> lock(queue.mutex);
+
+                        if (!queue.tasks.empty())
+                        {
+                            task = std::move(queue.tasks.back());
+                            queue.tasks.pop_back();
+                            --m_queuedCount;
+                            return true;
+                        }
+                    }
+
+                    for (size_t i = 1U; i < m_queues.size(); ++i)
+                    {
+                        auto& queue = m_queues[(threadIndex + i) % m_queues.size()];
+                        std::lock_guard<std::mutex> lock(queue.mutex);
+
+                        if (!queue.tasks.empty())
+                        {
+                            task = std::move(queue.tasks.front());
+                            queue.tasks.pop_front();
+                            --m_queuedCount;
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                void CompleteTask()
+                {
+                    if (--m_pendingCount == 0U)
+                    {
+                        Notify(true);
+                    }
+                }
+
+                // Blocks until a task has been pushed that no thread has taken yet, or no tasks are pending
+                void WaitForTask()
+                {
+                    std::unique_lock<std::mutex> lock(m_waitMutex);
+
+                    // Waiting threads are counted before the condition is checked so that Push either sees a waiting
+                    // thread and notifies it, or pushes its task before the condition is checked
+                    ++m_waitingCount;
+
+                    m_waitCondition.wait(lock, [this]()
+                    {
+                        return m_queuedCount > 0U || m_pendingCount == 0U;
+                    });
+
+                    --m_waitingCount;
+                }
+
+                // Whether any task has been pushed but not yet completed - tasks being processed may push more tasks
+                bool HasPendingTasks() const
+                {
+                    return m_pendingCount > 0U;
+                }
+
+            private:
+                struct Queue
+                {
+                    std::mutex mutex;
+                    std::deque<Task> tasks;
+                };
+
+                void Notify(bool all)
+                {
+                    // Taking the mutex ensures a thread that has checked the wait condition is waiting before it's notified
+                    {
+                        std::lock_guard<std::mutex> lock(m_waitMutex);
+                    }
+
+                    if (all)
+                    {
+                        m_waitCondition.notify_all();
+                    }
+                    else
+                    {
+                        m_waitCondition.notify_one();
+                    }
+                }
+
+                std::vector<Queue> m_queues;
+                std::atomic<size_t> m_pendingCount; // Pushed but not completed
+                std::atomic<size_t> m_queuedCount;  // Pushed but not popped
+                std::atomic<size_t> m_waitingCount;
+
+                std::mutex m_waitMutex;
+                std::condition_variable m_waitCondition;
+            };
+
+            // Invokes fn(task, threadIndex, queues) for every task, on up to 'threadCount' threads (zero selects the
+            // default) identified by a thread index in [0, threadCount). The calling thread has index zero. Tasks may
+            // push further tasks with queues.Push(threadIndex, task) and these are processed before ParallelForEachTask
+            // returns. Idle threads steal tasks from busy ones, and sleep while there are none to steal. The first
+            // exception thrown by fn is rethrown on the calling thread once all threads have stopped; tasks remaining
+            // after an exception are discarded.
+            template<typename Task, typename Fn>
+            void ParallelForEachTask(std::vector<Task> tasks, Fn fn, size_t threadCount = 0U)
+            {
+                if (threadCount == 0U)
+                {
+                    threadCount = GetDefaultThreadCount();
+                }
+
+                WorkStealingQueues<Task> queues(threadCount);
+
+                // Spread the initial tasks across the threads' queues
+                for (size_t i = 0; i < tasks.size(); ++i)
+                {
+                    queues.Push(i % threadCount, std::move(tasks[i]));
+                }
+
+                std::exception_ptr exception;
+                std::mutex exceptionMutex;
+                std::atomic<bool> isCancelled(false);
+
+                auto runThread = [&](size_t threadIndex)
+                {
+                    Task task;
+
+                    while (queues.HasPendingTasks())
+                    {
+                        if (!queues.Pop(threadIndex, task))
+                        {
+                            queues.WaitForTask();
+                            continue;
+                        }
+
+                        if (!isCancelled)
+                        {
+                            try
+                            {
+                                fn(task, threadIndex, queues);
+                            }
+                            catch (...)
+                            {
+                                std::lock_guard<std::mutex> lock(exceptionMutex);
+
+                                if (!exception)
+                                {
+                                    exception = std::current_exception();
+                                }
+
+                                isCancelled = true;
+                            }
+                        }
+
+                        queues.CompleteTask();
+                    }
+                };
+
+                std::vector<std::thread> threads;
+                threads.reserve(threadCount - 1U);
+
+                for (size_t threadIndex = 1U; threadIndex < threadCount; ++threadIndex)
+                {
+                    threads.emplace_back(runThread, threadIndex);
+                }
+
+                runThread(0U);
+
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
 
 #include <GLTFSDK/Document.h>
 #include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/IOStatistics.h>
 #include <GLTFSDK/IStreamCache.h>
 #include <GLTFSDK/StreamUtils.h>
 
@@ -66,6 +67,11 @@ namespace Microsoft
                 WriteExternal(uri, data.data(), data.size() * sizeof(T));
             }
 
+            // The writes performed by this writer, including its stream cache's hits, misses and evictions.
+            // IOCounters::GetProcessStatistics returns the totals of every reader and writer.
+            IOStatistics GetIOStatistics() const;
+            void ResetIOStatistics();
+
         protected:
             ResourceWriter(std::unique_ptr<IStreamWriterCache> streamWriter);
 
@@ -74,6 +80,7 @@ namespace Microsoft
             virtual void           SetBufferOffset(const std::string& bufferId, std::streamoff offset) = 0;
 
             std::unique_ptr<IStreamWriterCache> m_streamWriterCache;
+            std::unique_ptr<IOCounters> m_ioCounters;
 
         private:
             void WriteImpl(const BufferView& bufferView, const void* data, std::streamoff totalOffset, size_t totalByteLength);
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <array>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+        class GLTFResourceReader;
+        class SceneGraph;
+
+        struct BoundingBox
+        {
+            Vector3 min;
+            Vector3 max;
+
+            bool Intersects(const BoundingBox& other) const
+            {
+                return min.x <= other.max.x && max.x >= other.min.x
+                    && min.y <= other.max.y && max.y >= other.min.y
+                    && min.z <= other.max.z && max.z >= other.min.z;
+            }
+        };
+
+        // A plane with normal (a, b, c). Points where a * x + b * y + c * z + d >= 0 are inside the plane.
+        struct Plane
+        {
+            float a;
+            float b;
+            float c;
+            float d;
+        };
+
+        struct RayHit
+        {
+            size_t sceneIndex; // The node's index in the SceneGraph the BVH was built from
+            float distance;    // The distance along the ray at which it enters the node's bounding box
+        };
+
+        struct BVHNode
+        {
+            BoundingBox bounds;
+
+            size_t first; // The first of the node's two (adjacent) children, or the offset of a leaf's first item
+            size_t count; // The number of items in a leaf, or zero for interior nodes
+        };
+
+        // A bounding volume hierarchy over the world-space bounding boxes of every node in a SceneGraph that has a mesh.
+        // A mesh's bounds are the union of its primitives' POSITION accessor min and max (enlarged to account for morph
+        // targets) transformed by the node's world matrix. The hierarchy is built top-down with a binned surface area
+        // heuristic, and subtrees are split in parallel.
+        //
+        // glTF ignores the world transform of a node with a skinned mesh - its vertices are placed by the skin's joints.
+        // A skinned vertex is a weighted average (the weights sum to one) of the vertex transformed by each joint's world
+        // matrix times its inverse bind matrix, so it lies within the union of the mesh bounds transformed by every joint's
+        // matrix. That union is used as the item's bounds: it is conservative for any pose, though loose for skins with
+        // many joints that each influence a small part of the mesh. Inverse bind matrices are read with the
+        // GLTFResourceReader - without one, only skins that have no inverse bind matrices are supported.
+        //
+        // When world transforms change the BVH can be refit rather than rebuilt: node bounds are recomputed but the
+        // structure isn't, so query performance degrades if nodes move far from where they were when it was built.
+        class SceneBVH final
+        {
+        public:
+            // Every joint of a skinned mesh's skin must be part of the SceneGraph
+            SceneBVH(const Document& doc, const SceneGraph& sceneGraph, size_t threadCount = 0U);
+            SceneBVH(const Document& doc, const GLTFResourceReader& reader, const SceneGraph& sceneGraph, size_t threadCount = 0U);
+
+            // The number of nodes with a mesh, each of which is an item in the BVH
+            size_t GetItemCount() const;
+
+            // The SceneGraph index of each item
+            const std::vector<size_t>& GetSceneIndices() const;
+
+            // The world-space bounding box of each item
+            const std::vector<BoundingBox>& GetItemBounds() const;
+
+            // The BVH's nodes - the first is the root. A leaf refers to 'count' items listed from GetLeafItems()[first].
+            const std::vector<BVHNode>& GetNodes() const;
+            const std::vector<size_t>& GetLeafItems() const;
+
+            // Appends the SceneGraph index of every node whose bounding box intersects 'box'
+            void QueryBox(const BoundingBox& box, std::vector<size_t>& sceneIndices) const;
+
+            // Appends the SceneGraph index of every node whose bounding box is not entirely outside any of the planes
+            void QueryFrustum(const std::vector<Plane>& planes, std::vector<size_t>& sceneIndices) const;
+
+            // Appends a hit for every node whose bounding box is intersected by the ray within 'maxDistance', in order of
+            // increasing distance. 'direction' needn't be normalized, distances are measured in multiples of it.
+            void QueryRay(const Vector3& origin, const Vector3& direction, float maxDistance, std::vector<RayHit>& hits) const;
+
+            // Recomputes item bounds from the SceneGraph's current world matrices, including those of skin joints (call
+            // SceneGraph::UpdateWorldMatrices first), and then the bounds of every BVH node
+            void Refit(const SceneGraph& sceneGraph, size_t threadCount = 0U);
+
+            // Extracts the six planes of the view frustum described by a column-major view-projection matrix that maps
+            // to OpenGL clip space (-w <= x, y, z <= w), as glTF cameras do
+            static std::vector<Plane> GetFrustumPlanes(const std::array<float, 16>& viewProjection);
+
+        private:
+            SceneBVH(const Document& doc, const GLTFResourceReader* reader, const SceneGraph& sceneGraph, size_t threadCount);
+
+            BoundingBox GetWorldBounds(size_t item, const SceneGraph& sceneGraph) const;
+
+            void Build(size_t threadCount);
+
+            std::vector<size_t> m_sceneIndices;
+            std::vector<BoundingBox> m_localBounds;
+            std::vector<BoundingBox> m_itemBounds;
+
+            std::vector<size_t> m_itemSkins;          // Index of each item's skin, or the maximum size_t if it isn't skinned
+            std::vector<size_t> m_skinJointOffsets;   // The joints of skin i are [m_skinJointOffsets[i], m_skinJointOffsets[i + 1])
+            std::vector<size_t> m_jointSceneIndices;
+            std::vector<float> m_inverseBindMatrices; // 16 floats per joint
+
+            std::vector<BVHNode> m_nodes;
+            std::vector<size_t> m_leafItems;
+        };
+    }
+}
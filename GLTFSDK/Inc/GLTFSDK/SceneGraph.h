@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <limits>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+
+        // A flattened node hierarchy with cached world transforms. Nodes are stored in depth-first pre-order so that a
+        // node's parent always precedes it and every subtree occupies a contiguous range of indices. Parent indices and the
+        // local and world transform matrices (column-major, 16 floats each) are held in separate contiguous arrays indexed
+        // by this order rather than by the Document's node order - use GetNodeIndex and GetSceneIndex to convert.
+        //
+        // Local transforms are changed with SetLocalMatrix or SetLocalTransform, which mark the node dirty. World matrices
+        // are then brought up to date by UpdateWorldMatrices, which only recomputes the subtrees of dirty nodes.
+        class SceneGraph final
+        {
+        public:
+            static const size_t NoIndex = std::numeric_limits<size_t>::max();
+
+            // Flattens every node hierarchy in the Document, i.e. every node without a parent and its descendants
+            explicit SceneGraph(const Document& doc);
+
+            // Flattens the node hierarchies of a single scene
+            SceneGraph(const Document& doc, const Scene& scene);
+
+            size_t GetNodeCount() const;
+
+            // The index in Document::nodes of the node at 'sceneIndex'
+            size_t GetNodeIndex(size_t sceneIndex) const;
+
+            // The index in this scene graph of the node at 'nodeIndex' in Document::nodes, or NoIndex if the node isn't
+            // part of the flattened hierarchy
+            size_t GetSceneIndex(size_t nodeIndex) const;
+
+            // The scene index of each node's parent, or NoIndex for root nodes
+            const std::vector<size_t>& GetParentIndices() const;
+
+            // The end of each node's subtree: the subtree of node i is the range [i, GetSubtreeEnds()[i])
+            const std::vector<size_t>& GetSubtreeEnds() const;
+
+            const std::vector<float>& GetLocalMatrices() const;
+            const std::vector<float>& GetWorldMatrices() const;
+
+            const float* GetLocalMatrix(size_t sceneIndex) const;
+            const float* GetWorldMatrix(size_t sceneIndex) const;
+
+            void SetLocalMatrix(size_t sceneIndex, const float* matrix);
+            void SetLocalTransform(size_t sceneIndex, const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+
+            bool IsDirty() const;
+
+            // Recomputes the world matrices of every dirty node and its descendants. Large updates are split into
+            // independent subtrees that are spread across 'threadCount' threads (zero selects the default).
+            void UpdateWorldMatrices(size_t threadCount = 0U);
+
+        private:
+            void Flatten(const Document& doc, const std::vector<size_t>& rootIndices);
+            void MarkDirty(size_t sceneIndex);
+
+            void UpdateWorldMatrix(size_t sceneIndex);
+            void UpdateSubtree(size_t sceneIndex);
+
+            std::vector<size_t> m_nodeIndices;
+            std::vector<size_t> m_sceneIndices;
+            std::vector<size_t> m_parentIndices;
+            std::vector<size_t> m_subtreeEnds;
+
+            std::vector<float> m_localMatrices;
+            std::vector<float> m_worldMatrices;
+
+            // Roots of the subtrees whose world matrices are out of date
+            std::vector<size_t> m_dirtyNodes;
+        };
+    }
+}
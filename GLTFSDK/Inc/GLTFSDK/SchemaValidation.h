@@ -9,6 +9,8 @@ namespace Microsoft
 {
     namespace glTF
     {
+        class ValidationReport;
+
         class ISchemaLocator
         {
         public:
@@ -17,5 +19,9 @@ namespace Microsoft
         };
 
         void ValidateDocumentAgainstSchema(const rapidjson::Document& d, const std::string& schemaUri, std::unique_ptr<const ISchemaLocator> schemaLocator);
+
+        // Adds every schema violation to 'report' rather than throwing at the first. Each issue's entity type and id
+        // are taken from its JSON pointer (the ids of deserialized entities are their indices).
+        void ValidateDocumentAgainstSchema(const rapidjson::Document& d, const std::string& schemaUri, std::unique_ptr<const ISchemaLocator> schemaLocator, ValidationReport& report);
     }
 }
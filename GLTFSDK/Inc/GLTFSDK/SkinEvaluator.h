@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class AnimationEvaluator;
+        class Document;
+        class GLTFResourceReader;
+
+        // Storage for the joint matrices of one or more instances of a skin. Each joint matrix is a column-major 4x4 matrix
+        // and the palettes of all instances are contiguous. The data is aligned to PaletteAlignment bytes, and as each matrix
+        // is 64 bytes, every matrix starts on a 64 byte boundary - suitable for aligned SIMD loads or a direct upload.
+        class JointPalette final
+        {
+        public:
+            static const size_t PaletteAlignment = 64U;
+
+            JointPalette(size_t jointCount, size_t instanceCount = 1U);
+
+            float* GetData();
+            const float* GetData() const;
+
+            // The first joint matrix of an instance's palette
+            float* GetInstanceData(size_t instance);
+            const float* GetInstanceData(size_t instance) const;
+
+            size_t GetJointCount() const;
+            size_t GetInstanceCount() const;
+
+        private:
+            std::unique_ptr<uint8_t[]> m_storage;
+            float* m_data;
+
+            size_t m_jointCount;
+            size_t m_instanceCount;
+        };
+
+        // Computes the joint matrices of a Skin - the world transform of each joint multiplied by its inverse bind matrix.
+        // The skin's joints and their ancestors (the skeleton's nodes) are read from the Document once, when the evaluator
+        // is constructed, along with the inverse bind matrices. Joint matrices are in world space: to skin a mesh relative
+        // to the node it is instanced by, multiply them by the inverse of that node's world transform.
+        class SkinEvaluator final
+        {
+        public:
+            SkinEvaluator(const Document& doc, const GLTFResourceReader& reader, const Skin& skin);
+
+            size_t GetJointCount() const;
+
+            // The skin's joints and every ancestor of a joint, ordered such that a node's parent precedes it
+            const std::vector<std::string>& GetNodeIds() const;
+
+            // The number of floats in one instance's palette - 16 per joint
+            size_t GetPaletteSize() const;
+
+            // Computes the palette of the skeleton's rest pose - the transforms of its nodes in the Document
+            void ComputePalette(float* palette) const;
+
+            // Computes the palette of a pose given as one column-major local transform matrix per node in GetNodeIds()
+            void ComputePalette(const float* localMatrices, float* palette) const;
+
+            // Computes the palette of a pose produced by AnimationEvaluator::Evaluate: the translation, rotation and scale
+            // of nodes targeted by the evaluator's tracks are taken from 'animationOutput', other nodes keep their rest pose
+            void ComputePalette(const AnimationEvaluator& evaluator, const float* animationOutput, float* palette) const;
+
+            // Computes a palette per instance, writing GetPaletteSize() floats per instance to 'palettes'. Instances are
+            // spread across 'threadCount' threads (zero selects the default). The first overload takes the local matrices
+            // of each instance's pose, GetNodeIds().size() matrices per instance; the second evaluates an animation at each
+            // instance's time - sorting the times improves the hit rate of the animation's cached keyframe cursors.
+            void ComputePalettes(const float* localMatrices, size_t instanceCount, float* palettes, size_t threadCount = 0U) const;
+            void ComputePalettes(const AnimationEvaluator& evaluator, const float* times, size_t instanceCount, float* palettes, size_t threadCount = 0U) const;
+
+        private:
+            // Index in m_nodeIds of the node targeted by each of the evaluator's tracks
+            std::vector<size_t> GetTrackNodes(const AnimationEvaluator& evaluator) const;
+
+            void ComputePalette(const AnimationEvaluator& evaluator, const std::vector<size_t>& trackNodes, const float* animationOutput,
+                float* transforms, float* localMatrices, float* worldMatrices, float* palette) const;
+            void ComputePalette(const float* localMatrices, float* worldMatrices, float* palette) const;
+
+            std::vector<std::string> m_nodeIds;
+            std::unordered_map<std::string, size_t> m_nodeIndices;
+
+            std::vector<size_t> m_parents;        // Index of each node's parent in m_nodeIds, the maximum size_t for skeleton roots
+            std::vector<float> m_restTransforms;  // Translation, rotation and scale of each node (10 floats per node)
+            std::vector<float> m_restMatrices;    // Local transform matrix of each node
+            std::vector<bool> m_hasMatrix;        // Whether a node's local transform is a matrix, which animations can't target
+
+            std::vector<size_t> m_jointNodes;     // Index of each joint in m_nodeIds
+            std::vector<float> m_inverseBindMatrices;
+        };
+    }
+}
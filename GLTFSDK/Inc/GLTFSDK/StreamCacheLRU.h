@@ -19,8 +19,9 @@ namespace Microsoft
             template<typename Fn>
             StreamCacheLRU(Fn fnGenerate, size_t cacheMaxSize = std::numeric_limits<size_t>::max()) :
                 cacheMaxSize(cacheMaxSize),
-                m_cache([fnGenerate, this](const std::string& uri) { return Update(uri, fnGenerate(uri)); }),
-                m_cacheList()
+                m_cache([fnGenerate, this](const std::string& uri) { return Update(uri, Generate(fnGenerate, uri)); }),
+                m_cacheList(),
+                m_ioCounters()
             {
                 if (cacheMaxSize == 0U)
                 {
@@ -30,6 +31,12 @@ namespace Microsoft
 
             TStream Get(const std::string& uri) override
             {
+                // Misses are counted when the cache is populated by calling fnGenerate
+                if (m_cache.Has(uri))
+                {
+                    m_ioCounters.AddCacheHit();
+                }
+
                 auto it = m_cache.Get(uri);
 
                 // Sanity check that the list and cache sizes match
@@ -73,11 +80,33 @@ namespace Microsoft
                 return m_cache.Size();
             }
 
+            IOStatistics GetIOStatistics() const override
+            {
+                return m_ioCounters.GetStatistics();
+            }
+
+            void ResetIOStatistics() override
+            {
+                m_ioCounters.Reset();
+            }
+
             const size_t cacheMaxSize;
 
         private:
             typedef std::list<std::pair<std::string, TStream>> StreamCacheLRUList;
 
+            template<typename Fn>
+            TStream Generate(const Fn& fnGenerate, const std::string& uri)
+            {
+                const auto start = IOCounters::Clock::now();
+
+                TStream stream = fnGenerate(uri);
+
+                m_ioCounters.AddCacheMiss(IOCounters::Clock::now() - start);
+
+                return stream;
+            }
+
             typename StreamCacheLRUList::iterator Update(const std::string& uri, TStream&& stream)
             {
                 // Add the stream and uri to the front of the LRU list then erase the
@@ -88,6 +117,7 @@ namespace Microsoft
                 if (m_cache.Size() == cacheMaxSize)
                 {
                     m_cache.Erase(m_cacheList.back().first);
+                    m_ioCounters.AddCacheEviction();
                 }
 
                 // Remove the LRU stream from the LRU list if the list's size exceeds the maximum size - stream has already been added to the LRU list
@@ -101,6 +131,7 @@ namespace Microsoft
 
             StreamCache<typename StreamCacheLRUList::iterator> m_cache;
             StreamCacheLRUList m_cacheList;
+            IOCounters m_ioCounters;
         };
 
         typedef StreamCacheLRU<std::shared_ptr<std::istream>> StreamReaderCacheLRU;
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        enum NormalWeighting
+        {
+            NORMAL_WEIGHTING_AREA,  // Face normals are weighted by triangle area
+            NORMAL_WEIGHTING_ANGLE  // Face normals are weighted by the angle of the triangle's corner at each vertex
+        };
+
+        namespace TangentSpaceUtils
+        {
+            // Generates smooth vertex normals (VEC3) for a triangle list. Vertices with bitwise identical positions share
+            // a normal so that vertices split along texture or material seams don't introduce hard edges.
+            std::vector<float> GenerateNormals(const std::vector<uint32_t>& indices, const std::vector<float>& positions,
+                NormalWeighting weighting = NORMAL_WEIGHTING_ANGLE, size_t threadCount = 0U);
+
+            // Generates MikkTSpace style tangents (VEC4, w is the handedness of the bitangent as defined by the glTF specification)
+            // for a triangle list. Per-triangle tangents are projected onto each vertex's tangent plane and weighted by corner angle.
+            std::vector<float> GenerateTangents(const std::vector<uint32_t>& indices, const std::vector<float>& positions,
+                const std::vector<float>& normals, const std::vector<float>& texCoords, size_t threadCount = 0U);
+
+            // Adds a NORMAL accessor to a triangle based MeshPrimitive that doesn't have one. The accessor is written to the
+            // current buffer of 'bufferBuilder' and the returned MeshPrimitive references it.
+            MeshPrimitive AddNormals(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+                NormalWeighting weighting = NORMAL_WEIGHTING_ANGLE, size_t threadCount = 0U);
+
+            // Adds a TANGENT accessor, calculated from TEXCOORD_0, to a triangle based MeshPrimitive that doesn't have one.
+            // As tangents require normals a NORMAL accessor is also added if the primitive doesn't have one.
+            MeshPrimitive AddTangents(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+                NormalWeighting weighting = NORMAL_WEIGHTING_ANGLE, size_t threadCount = 0U);
+        }
+    }
+}
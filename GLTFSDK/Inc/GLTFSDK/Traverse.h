@@ -4,6 +4,7 @@
 #pragma once
 
 #include <GLTFSDK/Document.h>
+#include <GLTFSDK/ParallelUtils.h>
 
 #include <queue>
 #include <stack>
@@ -145,5 +146,65 @@ namespace Microsoft
                 Detail::TraverseNode(Detail::TraversalAlgorithmTag<Algorithm>(), gltfDocument.nodes.Get(nodeId), gltfDocument, fnCopy);
             }
         }
+
+        // Invokes fn(node, nodeParent, threadIndex) for every node of a scene, concurrently, on up to 'threadCount' threads
+        // (zero selects the default). Subtrees are distributed across threads by a work-stealing scheduler: each thread
+        // walks a subtree depth-first, leaving the node's other children for idle threads to take. 'threadIndex' is in the
+        // range [0, threadCount) and identifies the calling thread, e.g. to index a ParallelUtils::PerThread accumulator.
+        //
+        // Ordering guarantees:
+        //  - fn is invoked once per path from the scene's root nodes to a node. In a valid glTF document nodes form
+        //    disjoint trees, so that is exactly once per reachable node. A node with more than one parent (invalid glTF,
+        //    which isn't detected here) is visited once per path, possibly concurrently on different threads.
+        //  - fn returns for a node before it is invoked for any of that node's children, and its effects are visible to
+        //    the invocations for them (parent-before-child)
+        //  - there is no ordering between siblings or between nodes in different subtrees, which may be visited at once
+        //
+        // The first exception thrown by fn is rethrown once every thread has stopped.
+        template<typename Fn>
+        void TraverseParallel(const Document& gltfDocument, size_t sceneIndex, Fn&& fn, size_t threadCount = 0U)
+        {
+            struct Task
+            {
+                const Node* node;
+                const Node* nodeParent;
+            };
+
+            const Scene& scene = (sceneIndex == DefaultSceneIndex) ?
+                gltfDocument.GetDefaultScene() :
+                gltfDocument.scenes[sceneIndex];
+
+            std::vector<Task> rootTasks;
+            rootTasks.reserve(scene.nodes.size());
+
+            for (const auto& nodeId : scene.nodes)
+            {
+                rootTasks.push_back({ &gltfDocument.nodes.Get(nodeId), nullptr });
+            }
+
+            ParallelUtils::ParallelForEachTask(std::move(rootTasks), [&gltfDocument, &fn](const Task& rootTask, size_t threadIndex, ParallelUtils::WorkStealingQueues<Task>& queues)
+            {
+                Task task = rootTask;
+
+                // Continue into the first child on this thread, making the remaining children available to other threads
+                while (task.node)
+                {
+                    fn(*task.node, task.nodeParent, threadIndex);
+
+                    const Node* node = task.node;
+                    task.node = nullptr;
+
+                    for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+                    {
+                        if (task.node)
+                        {
+                            queues.Push(threadIndex, task);
+                        }
+
+                        task = { &gltfDocument.nodes.Get(*it), node };
+                    }
+                }
+            }, threadCount);
+        }
     }
 }
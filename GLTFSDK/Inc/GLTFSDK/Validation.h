@@ -5,15 +5,62 @@
 
 #include <GLTFSDK/Document.h>
 
+#include <array>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
 
 namespace Microsoft
 {
     namespace glTF
     {
+        enum class ValidationSeverity
+        {
+            Error,      // The document violates a requirement of the glTF specification
+            Warning,    // The document doesn't follow a recommendation of the specification
+            Information
+        };
+
+        struct ValidationIssue
+        {
+            ValidationSeverity severity = ValidationSeverity::Error;
+            std::string pointer;    // JSON pointer to the property with the issue, e.g. "/accessors/3/byteOffset" (empty if unknown)
+            std::string entityType; // The top-level glTF property the entity belongs to, e.g. "accessors"
+            std::string entityId;   // The id of the entity with the issue
+            std::string message;
+        };
+
+        // Every issue found by a validation pass, in a deterministic order
+        class ValidationReport
+        {
+        public:
+            void Add(ValidationIssue issue);
+            void Add(std::vector<ValidationIssue> issues);
+
+            const std::vector<ValidationIssue>& GetIssues() const;
+            size_t GetIssueCount(ValidationSeverity severity) const;
+
+            bool HasErrors() const;
+
+        private:
+            std::vector<ValidationIssue> m_issues;
+        };
+
         namespace Validation
         {
+            // Throws a ValidationException for the first issue reported by the overload below, i.e. that of the first
+            // invalid accessor or, when every accessor is valid, the first invalid mesh
             void Validate(const Document& doc);
+
+            // Collects every issue found by the checks of Validate, rather than throwing at the first. Accessors and
+            // meshes are checked together in a single parallel pass on up to 'threadCount' threads (zero selects the
+            // default). Problems are reported without throwing, so a broken document is as cheap to validate as a
+            // valid one.
+            void Validate(const Document& doc, ValidationReport& report, size_t threadCount = 0U);
+
             void ValidateAccessors(const Document& doc);
             void ValidateMeshes(const Document& doc);
             void ValidateMeshPrimitive(const Document& doc, const MeshPrimitive& primitive);
@@ -26,5 +73,60 @@ namespace Microsoft
             bool SafeAddition(size_t a, size_t b, size_t& result);
             bool SafeMultiplication(size_t a, size_t b, size_t& result);
         };
+
+        // Caches the result of validating each accessor and mesh, keyed by id. An entity is only validated again when a
+        // property its validation depends on has changed - including properties of the buffer views, buffers and
+        // accessors it refers to - so re-validating a document after a small edit only validates the edited entities.
+        class ValidationCache final
+        {
+        public:
+            ValidationCache();
+
+            // Equivalent to Validation::Validate, with the entities that need validating split across threads. Throws
+            // the error of the first invalid accessor or, when every accessor is valid, the first invalid mesh.
+            // Entries for entities that aren't in the document are discarded.
+            void Validate(const Document& doc, size_t threadCount = 0U);
+
+            // Equivalent to Validation::ValidateAccessor. May be called from several threads at once.
+            void ValidateAccessor(const Document& doc, const Accessor& accessor);
+
+            // The number of times an entity was validated rather than its result being found in the cache
+            size_t GetValidationCount() const;
+
+            void Clear();
+
+        private:
+            // The accessor, buffer view and buffer properties read by Validation::ValidateAccessor
+            typedef std::array<size_t, 18> AccessorSignature;
+
+            struct AccessorEntry
+            {
+                AccessorSignature signature;
+                std::exception_ptr error;
+                bool isCached = false;
+                size_t changedAt = 0U; // When the signature last changed, used to find meshes that must be re-validated
+                size_t seenAt = 0U;
+            };
+
+            struct MeshEntry
+            {
+                Mesh mesh;
+                std::exception_ptr error;
+                bool isCached = false;
+                size_t validatedAt = 0U;
+                size_t seenAt = 0U;
+            };
+
+            static bool TryGetSignature(const Document& doc, const Accessor& accessor, AccessorSignature& signature);
+
+            bool HasChangedAccessors(const Mesh& mesh, size_t validatedAt) const;
+
+            std::unordered_map<std::string, AccessorEntry> m_accessors;
+            std::unordered_map<std::string, MeshEntry> m_meshes;
+
+            size_t m_stamp;
+            std::atomic<size_t> m_validationCount;
+            std::mutex m_mutex;
+        };
     }
 }
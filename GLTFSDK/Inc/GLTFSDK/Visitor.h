@@ -5,8 +5,8 @@
 
 #include <GLTFSDK/Traverse.h>
 
-#include <set>
-#include <typeindex>
+#include <functional>
+#include <vector>
 
 namespace Microsoft
 {
@@ -49,34 +49,127 @@ namespace Microsoft
                 TryInvokeImpl(Priority1(), std::forward<Fn>(fn), std::forward<TArgs>(args)...);
             }
 
-            // Helper class for keeping track of which entities have been previously visited
+            // Maps each visitable entity type to its Document container and to a slot in VisitStateSet
+            template<typename T>
+            struct VisitStateTraits;
+
+            template<>
+            struct VisitStateTraits<Node>
+            {
+                static const size_t Slot = 0U;
+                static const IndexedContainer<const Node>& GetContainer(const Document& gltfDocument) { return gltfDocument.nodes; }
+            };
+
+            template<>
+            struct VisitStateTraits<Mesh>
+            {
+                static const size_t Slot = 1U;
+                static const IndexedContainer<const Mesh>& GetContainer(const Document& gltfDocument) { return gltfDocument.meshes; }
+            };
+
+            template<>
+            struct VisitStateTraits<Material>
+            {
+                static const size_t Slot = 2U;
+                static const IndexedContainer<const Material>& GetContainer(const Document& gltfDocument) { return gltfDocument.materials; }
+            };
+
+            template<>
+            struct VisitStateTraits<Texture>
+            {
+                static const size_t Slot = 3U;
+                static const IndexedContainer<const Texture>& GetContainer(const Document& gltfDocument) { return gltfDocument.textures; }
+            };
+
+            template<>
+            struct VisitStateTraits<Image>
+            {
+                static const size_t Slot = 4U;
+                static const IndexedContainer<const Image>& GetContainer(const Document& gltfDocument) { return gltfDocument.images; }
+            };
+
+            template<>
+            struct VisitStateTraits<Sampler>
+            {
+                static const size_t Slot = 5U;
+                static const IndexedContainer<const Sampler>& GetContainer(const Document& gltfDocument) { return gltfDocument.samplers; }
+            };
+
+            template<>
+            struct VisitStateTraits<Skin>
+            {
+                static const size_t Slot = 6U;
+                static const IndexedContainer<const Skin>& GetContainer(const Document& gltfDocument) { return gltfDocument.skins; }
+            };
+
+            template<>
+            struct VisitStateTraits<Camera>
+            {
+                static const size_t Slot = 7U;
+                static const IndexedContainer<const Camera>& GetContainer(const Document& gltfDocument) { return gltfDocument.cameras; }
+            };
+
+            // Helper class for keeping track of which entities have been previously visited. Each entity type has a
+            // dense bitset, sized from its Document container and indexed by the entity's position in that container.
             class VisitStateSet
             {
             public:
+                explicit VisitStateSet(const Document& gltfDocument) : gltfDocument(gltfDocument)
+                {
+                    visitStates[VisitStateTraits<Node>::Slot].resize(gltfDocument.nodes.Size());
+                    visitStates[VisitStateTraits<Mesh>::Slot].resize(gltfDocument.meshes.Size());
+                    visitStates[VisitStateTraits<Material>::Slot].resize(gltfDocument.materials.Size());
+                    visitStates[VisitStateTraits<Texture>::Slot].resize(gltfDocument.textures.Size());
+                    visitStates[VisitStateTraits<Image>::Slot].resize(gltfDocument.images.Size());
+                    visitStates[VisitStateTraits<Sampler>::Slot].resize(gltfDocument.samplers.Size());
+                    visitStates[VisitStateTraits<Skin>::Slot].resize(gltfDocument.skins.Size());
+                    visitStates[VisitStateTraits<Camera>::Slot].resize(gltfDocument.cameras.Size());
+                }
+
                 template<typename T>
                 VisitState GetVisitState(const T& t) const
                 {
-                    return visitStateSet.find({ typeid(T), std::stoul(t.id) }) == visitStateSet.end() ?
-                        VisitState::New :
-                        VisitState::Duplicate;
+                    return visitStates[VisitStateTraits<T>::Slot][GetIndex(t)] ?
+                        VisitState::Duplicate :
+                        VisitState::New;
                 }
 
                 template<typename T>
                 VisitState SetVisitState(const T& t)
                 {
-                    // Attempt to insert a unique identifier for the entity instance into the container by
-                    // combining the type information (resolved at compile time) and glTF index property.
-                    const auto result = visitStateSet.emplace(typeid(T), std::stoul(t.id));
+                    auto visitState = visitStates[VisitStateTraits<T>::Slot][GetIndex(t)];
 
-                    // If the insertion succeeded then the entity hasn't yet been visited. Otherwise
+                    // If the entity's bit wasn't already set then the entity hasn't yet been visited. Otherwise
                     // it is a 'duplicate' reference to an object that has already been visited.
-                    return result.second ?
-                        VisitState::New :
-                        VisitState::Duplicate;
+                    if (visitState)
+                    {
+                        return VisitState::Duplicate;
+                    }
+
+                    visitState = true;
+                    return VisitState::New;
                 }
 
             private:
-                std::set<std::pair<std::type_index, size_t>> visitStateSet;
+                template<typename T>
+                size_t GetIndex(const T& t) const
+                {
+                    const auto& elements = VisitStateTraits<T>::GetContainer(gltfDocument).Elements();
+
+                    // Entities are almost always references to elements of the Document's containers, in which case the
+                    // index is found without a lookup. Otherwise fall back to looking up the entity's id.
+                    const std::less<const T*> less;
+
+                    if (!elements.empty() && !less(&t, elements.data()) && less(&t, elements.data() + elements.size()))
+                    {
+                        return static_cast<size_t>(&t - elements.data());
+                    }
+
+                    return VisitStateTraits<T>::GetContainer(gltfDocument).GetIndex(t.id);
+                }
+
+                const Document& gltfDocument;
+                std::vector<bool> visitStates[8];
             };
 
             // Gets the 'raw' type of a template parameter so it can be inherited from
@@ -341,7 +434,7 @@ namespace Microsoft
         template<TraversalAlgorithm Algorithm = DepthFirst, typename Fn>
         void Visit(const Document& gltfDocument, size_t sceneIndex, Fn&& fn)
         {
-            Detail::VisitStateSet visitStateSet;
+            Detail::VisitStateSet visitStateSet(gltfDocument);
 
             Traverse<Algorithm>(gltfDocument, sceneIndex,
                 [&gltfDocument, &visitStateSet, fn = std::forward<Fn>(fn)](const Node& node, const Node* nodeParent) mutable
@@ -0,0 +1,246 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/AccessorUtils.h>
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include "MeshUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Inputs with fewer elements than this are reduced on the calling thread
+    const size_t MinParallelElementCount = 1U << 16;
+
+    // Approximate number of bytes of accessor data read before a batch of accessors is reduced in parallel
+    const size_t BatchByteSize = 16U << 20;
+
+    // N is a compile time constant so that the per-component loops are unrolled and the
+    // comparisons of each element can be vectorized
+    template<typename T, size_t N>
+    void ReduceMinMax(const uint8_t* data, size_t count, size_t byteStride, float* minValues, float* maxValues)
+    {
+        T mins[N];
+        T maxs[N];
+
+        std::fill(mins, mins + N, std::numeric_limits<T>::max());
+        std::fill(maxs, maxs + N, std::numeric_limits<T>::lowest());
+
+        for (size_t i = 0; i < count; ++i, data += byteStride)
+        {
+            T element[N];
+            std::memcpy(element, data, sizeof(element));
+
+            // Comparisons are written so that NaN values are ignored
+            for (size_t c = 0; c < N; ++c)
+            {
+                mins[c] = element[c] < mins[c] ? element[c] : mins[c];
+                maxs[c] = element[c] > maxs[c] ? element[c] : maxs[c];
+            }
+        }
+
+        for (size_t c = 0; c < N; ++c)
+        {
+            minValues[c] = std::min(minValues[c], static_cast<float>(mins[c]));
+            maxValues[c] = std::max(maxValues[c], static_cast<float>(maxs[c]));
+        }
+    }
+
+    template<typename T>
+    void ReduceMinMax(const uint8_t* data, size_t count, size_t byteStride, size_t typeCount, float* minValues, float* maxValues)
+    {
+        switch (typeCount)
+        {
+        case 1U:
+            return ReduceMinMax<T, 1U>(data, count, byteStride, minValues, maxValues);
+        case 2U:
+            return ReduceMinMax<T, 2U>(data, count, byteStride, minValues, maxValues);
+        case 3U:
+            return ReduceMinMax<T, 3U>(data, count, byteStride, minValues, maxValues);
+        case 4U:
+            return ReduceMinMax<T, 4U>(data, count, byteStride, minValues, maxValues);
+        case 9U:
+            return ReduceMinMax<T, 9U>(data, count, byteStride, minValues, maxValues);
+        case 16U:
+            return ReduceMinMax<T, 16U>(data, count, byteStride, minValues, maxValues);
+        default:
+            throw GLTFException("Invalid accessor type count " + std::to_string(typeCount));
+        }
+    }
+
+    void ReduceMinMax(ComponentType componentType, const uint8_t* data, size_t count, size_t byteStride, size_t typeCount, float* minValues, float* maxValues)
+    {
+        switch (componentType)
+        {
+        case COMPONENT_BYTE:
+            return ReduceMinMax<int8_t>(data, count, byteStride, typeCount, minValues, maxValues);
+        case COMPONENT_UNSIGNED_BYTE:
+            return ReduceMinMax<uint8_t>(data, count, byteStride, typeCount, minValues, maxValues);
+        case COMPONENT_SHORT:
+            return ReduceMinMax<int16_t>(data, count, byteStride, typeCount, minValues, maxValues);
+        case COMPONENT_UNSIGNED_SHORT:
+            return ReduceMinMax<uint16_t>(data, count, byteStride, typeCount, minValues, maxValues);
+        case COMPONENT_UNSIGNED_INT:
+            return ReduceMinMax<uint32_t>(data, count, byteStride, typeCount, minValues, maxValues);
+        case COMPONENT_FLOAT:
+            return ReduceMinMax<float>(data, count, byteStride, typeCount, minValues, maxValues);
+        default:
+            throw GLTFException("Invalid componentType " + std::to_string(componentType));
+        }
+    }
+
+    bool AreEqual(const std::vector<float>& expected, const std::vector<float>& actual, float epsilon)
+    {
+        if (expected.size() != actual.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            if (!(std::abs(expected[i] - actual[i]) <= epsilon))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+AccessorBounds AccessorUtils::ComputeMinMax(const void* data, size_t count, size_t byteStride, AccessorType accessorType, ComponentType componentType, size_t threadCount)
+{
+    const size_t typeCount = Accessor::GetTypeCount(accessorType);
+    const size_t elementSize = typeCount * Accessor::GetComponentTypeSize(componentType);
+
+    if (byteStride == 0U)
+    {
+        byteStride = elementSize;
+    }
+    else if (byteStride < elementSize)
+    {
+        throw GLTFException("Byte stride " + std::to_string(byteStride) + " is less than the element size " + std::to_string(elementSize));
+    }
+
+    AccessorBounds bounds;
+
+    if (count == 0U)
+    {
+        return bounds;
+    }
+
+    bounds.min.assign(typeCount, std::numeric_limits<float>::max());
+    bounds.max.assign(typeCount, std::numeric_limits<float>::lowest());
+
+    const auto bytes = static_cast<const uint8_t*>(data);
+
+    std::mutex mutex;
+
+    ParallelUtils::ParallelFor(count, [&](size_t begin, size_t end)
+    {
+        std::vector<float> rangeMin(typeCount, std::numeric_limits<float>::max());
+        std::vector<float> rangeMax(typeCount, std::numeric_limits<float>::lowest());
+
+        ReduceMinMax(componentType, bytes + begin * byteStride, end - begin, byteStride, typeCount, rangeMin.data(), rangeMax.data());
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (size_t c = 0; c < typeCount; ++c)
+        {
+            bounds.min[c] = std::min(bounds.min[c], rangeMin[c]);
+            bounds.max[c] = std::max(bounds.max[c], rangeMax[c]);
+        }
+    }, threadCount, MinParallelElementCount);
+
+    return bounds;
+}
+
+AccessorBounds AccessorUtils::ComputeMinMax(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, size_t threadCount)
+{
+    const auto data = Internal::ReadAccessorBytes(doc, reader, accessor);
+    return ComputeMinMax(data.data(), accessor.count, 0U, accessor.type, accessor.componentType, threadCount);
+}
+
+std::vector<AccessorBounds> AccessorUtils::ComputeMinMax(const Document& doc, const GLTFResourceReader& reader, size_t threadCount)
+{
+    std::vector<AccessorBounds> result(doc.accessors.Size());
+    std::vector<std::pair<size_t, std::vector<uint8_t>>> batch;
+    size_t batchSize = 0U;
+
+    // A batch of several accessors is reduced in parallel with one accessor per task. A batch with a single
+    // (large) accessor is reduced by splitting its elements between threads instead.
+    auto reduceBatch = [&]()
+    {
+        if (batch.size() == 1U)
+        {
+            const auto& accessor = doc.accessors[batch.front().first];
+            result[batch.front().first] = ComputeMinMax(batch.front().second.data(), accessor.count, 0U, accessor.type, accessor.componentType, threadCount);
+        }
+        else
+        {
+            ParallelUtils::ParallelFor(batch.size(), [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const auto& accessor = doc.accessors[batch[i].first];
+                    result[batch[i].first] = ComputeMinMax(batch[i].second.data(), accessor.count, 0U, accessor.type, accessor.componentType, 1U);
+                }
+            }, threadCount);
+        }
+
+        batch.clear();
+        batchSize = 0U;
+    };
+
+    for (size_t i = 0; i < doc.accessors.Size(); ++i)
+    {
+        batch.emplace_back(i, Internal::ReadAccessorBytes(doc, reader, doc.accessors[i]));
+        batchSize += batch.back().second.size();
+
+        if (batchSize >= BatchByteSize)
+        {
+            reduceBatch();
+        }
+    }
+
+    if (!batch.empty())
+    {
+        reduceBatch();
+    }
+
+    return result;
+}
+
+std::vector<std::string> AccessorUtils::VerifyMinMax(const Document& doc, const GLTFResourceReader& reader, float epsilon, size_t threadCount)
+{
+    const auto bounds = ComputeMinMax(doc, reader, threadCount);
+
+    std::vector<std::string> mismatches;
+
+    for (size_t i = 0; i < doc.accessors.Size(); ++i)
+    {
+        const auto& accessor = doc.accessors[i];
+
+        if (accessor.min.empty() && accessor.max.empty())
+        {
+            continue;
+        }
+
+        if (!AreEqual(bounds[i].min, accessor.min, epsilon) || !AreEqual(bounds[i].max, accessor.max, epsilon))
+        {
+            mismatches.push_back(accessor.id);
+        }
+    }
+
+    return mismatches;
+}
@@ -0,0 +1,341 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/AnimationEvaluator.h>
+
+#include <GLTFSDK/AnimationUtils.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Number of keyframes a cursor is stepped forward before falling back to a binary search
+    const size_t MaxCursorSteps = 4U;
+
+    // Batches with fewer times than this are evaluated on the calling thread
+    const size_t MinParallelTimeCount = 64U;
+
+    std::vector<float> GetOutputValues(const Document& doc, const GLTFResourceReader& reader, const AnimationChannel& channel, const AnimationSampler& sampler)
+    {
+        switch (channel.target.path)
+        {
+        case TARGET_TRANSLATION:
+            return AnimationUtils::GetTranslations(doc, reader, sampler);
+        case TARGET_ROTATION:
+            return AnimationUtils::GetRotations(doc, reader, sampler);
+        case TARGET_SCALE:
+            return AnimationUtils::GetScales(doc, reader, sampler);
+        case TARGET_WEIGHTS:
+            return AnimationUtils::GetMorphWeights(doc, reader, sampler);
+        default:
+            throw GLTFException("Animation channel " + channel.id + " has an unknown target path");
+        }
+    }
+
+    size_t GetComponentCount(TargetPath path)
+    {
+        switch (path)
+        {
+        case TARGET_TRANSLATION:
+        case TARGET_SCALE:
+            return 3U;
+        case TARGET_ROTATION:
+            return 4U;
+        default:
+            return 0U; // The number of morph targets is derived from the sampler's output count
+        }
+    }
+
+    // Returns k such that times[k] <= time < times[k + 1], where times[0] <= time < times[count - 1]
+    size_t FindKeyframe(const float* times, size_t count, float time, size_t& cursor)
+    {
+        size_t k = cursor;
+
+        if (k + 1U < count && times[k] <= time)
+        {
+            for (size_t step = 0U; step < MaxCursorSteps; ++step, ++k)
+            {
+                if (time < times[k + 1U])
+                {
+                    return cursor = k;
+                }
+            }
+        }
+
+        k = static_cast<size_t>(std::upper_bound(times, times + count, time) - times) - 1U;
+        return cursor = k;
+    }
+
+    void Lerp(const float* a, const float* b, float s, size_t componentCount, float* output)
+    {
+        for (size_t c = 0; c < componentCount; ++c)
+        {
+            output[c] = a[c] + (b[c] - a[c]) * s;
+        }
+    }
+
+    void NormalizeQuaternion(float* q)
+    {
+        const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+        if (length > 0.0f)
+        {
+            for (size_t c = 0; c < 4U; ++c)
+            {
+                q[c] /= length;
+            }
+        }
+    }
+
+    // Interpolates along the shorter of the two arcs between 'a' and 'b'
+    void Slerp(const float* a, const float* b, float s, bool normalizedLerp, float* output)
+    {
+        float d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        const float sign = d < 0.0f ? -1.0f : 1.0f;
+
+        d = std::abs(d);
+
+        float wa = 1.0f - s;
+        float wb = s;
+
+        // Nearly parallel quaternions are linearly interpolated to avoid dividing by sin(theta) ~ 0
+        if (!normalizedLerp && d < 0.9995f)
+        {
+            const float theta = std::acos(d);
+            const float sinTheta = std::sin(theta);
+
+            wa = std::sin(wa * theta) / sinTheta;
+            wb = std::sin(wb * theta) / sinTheta;
+        }
+
+        for (size_t c = 0; c < 4U; ++c)
+        {
+            output[c] = wa * a[c] + wb * sign * b[c];
+        }
+
+        NormalizeQuaternion(output);
+    }
+}
+
+AnimationEvaluator::AnimationEvaluator(const Document& doc, const GLTFResourceReader& reader, const Animation& animation, RotationInterpolation rotationInterpolation) :
+    m_outputSize(0U),
+    m_startTime(std::numeric_limits<float>::max()),
+    m_endTime(std::numeric_limits<float>::lowest()),
+    m_rotationInterpolation(rotationInterpolation)
+{
+    m_tracks.reserve(animation.channels.Size());
+
+    for (const auto& channel : animation.channels.Elements())
+    {
+        const auto& sampler = animation.samplers.Get(channel.samplerId);
+
+        const auto times = AnimationUtils::GetKeyframeTimes(doc, reader, sampler);
+        const auto values = GetOutputValues(doc, reader, channel, sampler);
+
+        if (times.empty())
+        {
+            throw GLTFException("Animation sampler " + sampler.id + " has no keyframes");
+        }
+
+        for (size_t i = 1U; i < times.size(); ++i)
+        {
+            if (!(times[i - 1U] < times[i]))
+            {
+                throw GLTFException("Animation sampler " + sampler.id + " keyframe times are not strictly increasing");
+            }
+        }
+
+        AnimationTrack track;
+        track.nodeId = channel.target.nodeId;
+        track.path = channel.target.path;
+        track.interpolation = sampler.interpolation;
+        track.keyframeCount = times.size();
+
+        const size_t valuesPerKeyframe = track.interpolation == INTERPOLATION_CUBICSPLINE ? 3U : 1U;
+
+        track.componentCount = GetComponentCount(track.path);
+
+        if (track.componentCount == 0U)
+        {
+            track.componentCount = values.size() / (track.keyframeCount * valuesPerKeyframe);
+        }
+
+        if (track.componentCount == 0U || values.size() != track.keyframeCount * valuesPerKeyframe * track.componentCount)
+        {
+            throw GLTFException("Animation sampler " + sampler.id + " output count does not match its keyframe count");
+        }
+
+        track.timeOffset = m_times.size();
+        track.valueOffset = m_values.size();
+        track.outputOffset = m_outputSize;
+
+        m_times.insert(m_times.end(), times.begin(), times.end());
+        m_values.insert(m_values.end(), values.begin(), values.end());
+        m_outputSize += track.componentCount;
+
+        m_startTime = std::min(m_startTime, times.front());
+        m_endTime = std::max(m_endTime, times.back());
+
+        m_tracks.push_back(std::move(track));
+    }
+
+    if (m_tracks.empty())
+    {
+        m_startTime = 0.0f;
+        m_endTime = 0.0f;
+    }
+}
+
+const std::vector<AnimationTrack>& AnimationEvaluator::GetTracks() const
+{
+    return m_tracks;
+}
+
+const std::vector<float>& AnimationEvaluator::GetTimes() const
+{
+    return m_times;
+}
+
+const std::vector<float>& AnimationEvaluator::GetValues() const
+{
+    return m_values;
+}
+
+size_t AnimationEvaluator::GetOutputSize() const
+{
+    return m_outputSize;
+}
+
+float AnimationEvaluator::GetStartTime() const
+{
+    return m_startTime;
+}
+
+float AnimationEvaluator::GetEndTime() const
+{
+    return m_endTime;
+}
+
+void AnimationEvaluator::Evaluate(float time, float* output, std::vector<size_t>& cursors) const
+{
+    cursors.resize(m_tracks.size(), 0U);
+
+    for (size_t i = 0; i < m_tracks.size(); ++i)
+    {
+        EvaluateTrack(m_tracks[i], time, output + m_tracks[i].outputOffset, cursors[i]);
+    }
+}
+
+void AnimationEvaluator::Evaluate(float time, float* output) const
+{
+    std::vector<size_t> cursors;
+    Evaluate(time, output, cursors);
+}
+
+void AnimationEvaluator::Evaluate(const float* times, size_t count, float* output, size_t threadCount) const
+{
+    ParallelUtils::ParallelFor(count, [&](size_t begin, size_t end)
+    {
+        for (const auto& track : m_tracks)
+        {
+            size_t cursor = 0U;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                EvaluateTrack(track, times[i], output + i * m_outputSize + track.outputOffset, cursor);
+            }
+        }
+    }, threadCount, MinParallelTimeCount);
+}
+
+void AnimationEvaluator::EvaluateTrack(size_t trackIndex, float time, float* output, size_t& cursor) const
+{
+    EvaluateTrack(m_tracks.at(trackIndex), time, output, cursor);
+}
+
+void AnimationEvaluator::EvaluateTrack(const AnimationTrack& track, float time, float* output, size_t& cursor) const
+{
+    const size_t componentCount = track.componentCount;
+    const bool isCubic = track.interpolation == INTERPOLATION_CUBICSPLINE;
+
+    // CUBICSPLINE keyframes store an in-tangent, the value and an out-tangent
+    const size_t keyframeStride = isCubic ? componentCount * 3U : componentCount;
+    const size_t valueOffset = isCubic ? componentCount : 0U;
+
+    const float* times = m_times.data() + track.timeOffset;
+    const float* values = m_values.data() + track.valueOffset;
+
+    const size_t last = track.keyframeCount - 1U;
+
+    if (last == 0U || time <= times[0])
+    {
+        std::copy_n(values + valueOffset, componentCount, output);
+        return;
+    }
+
+    if (time >= times[last])
+    {
+        std::copy_n(values + last * keyframeStride + valueOffset, componentCount, output);
+        return;
+    }
+
+    const size_t k = FindKeyframe(times, track.keyframeCount, time, cursor);
+
+    const float duration = times[k + 1U] - times[k];
+    const float s = (time - times[k]) / duration;
+
+    const float* v0 = values + k * keyframeStride + valueOffset;
+    const float* v1 = v0 + keyframeStride;
+
+    const bool isRotation = track.path == TARGET_ROTATION;
+
+    switch (track.interpolation)
+    {
+    case INTERPOLATION_STEP:
+        std::copy_n(v0, componentCount, output);
+        break;
+
+    case INTERPOLATION_CUBICSPLINE:
+    {
+        const float s2 = s * s;
+        const float s3 = s2 * s;
+
+        const float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+        const float h10 = (s3 - 2.0f * s2 + s) * duration;
+        const float h01 = -2.0f * s3 + 3.0f * s2;
+        const float h11 = (s3 - s2) * duration;
+
+        const float* outTangent0 = v0 + componentCount;
+        const float* inTangent1 = v1 - componentCount;
+
+        for (size_t c = 0; c < componentCount; ++c)
+        {
+            output[c] = h00 * v0[c] + h10 * outTangent0[c] + h01 * v1[c] + h11 * inTangent1[c];
+        }
+
+        if (isRotation)
+        {
+            NormalizeQuaternion(output);
+        }
+        break;
+    }
+
+    default:
+        if (isRotation)
+        {
+            Slerp(v0, v1, s, m_rotationInterpolation == ROTATION_INTERPOLATION_NLERP, output);
+        }
+        else
+        {
+            Lerp(v0, v1, s, componentCount, output);
+        }
+        break;
+    }
+}
@@ -3,11 +3,248 @@
 
 #include <GLTFSDK/AnimationUtils.h>
 
+#include <GLTFSDK/AnimationEvaluator.h>
+#include <GLTFSDK/BufferBuilder.h>
 #include <GLTFSDK/GLTF.h>
 #include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include <algorithm>
+#include <cmath>
 
 using namespace Microsoft::glTF;
 
+namespace
+{
+    struct ReducedTrack
+    {
+        InterpolationType interpolation = INTERPOLATION_LINEAR;
+        std::vector<float> times;
+        std::vector<float> values;
+    };
+
+    float GetTolerance(TargetPath path, const KeyframeReductionOptions& options)
+    {
+        switch (path)
+        {
+        case TARGET_TRANSLATION:
+            return options.translationTolerance;
+        case TARGET_ROTATION:
+            return options.rotationTolerance;
+        case TARGET_SCALE:
+            return options.scaleTolerance;
+        default:
+            return options.weightsTolerance;
+        }
+    }
+
+    float GetError(TargetPath path, const float* a, const float* b, size_t componentCount)
+    {
+        switch (path)
+        {
+        case TARGET_TRANSLATION:
+        case TARGET_SCALE:
+        {
+            float distanceSquared = 0.0f;
+
+            for (size_t c = 0; c < componentCount; ++c)
+            {
+                distanceSquared += (a[c] - b[c]) * (a[c] - b[c]);
+            }
+
+            return std::sqrt(distanceSquared);
+        }
+        case TARGET_ROTATION:
+        {
+            // The angle between two rotations is 4 * asin(|a - b| / 2) for unit quaternions in the same hemisphere,
+            // which unlike 2 * acos(|a . b|) remains accurate for the small angles tolerances are compared against
+            const float sign = (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]) < 0.0f ? -1.0f : 1.0f;
+
+            float distanceSquared = 0.0f;
+
+            for (size_t c = 0; c < 4U; ++c)
+            {
+                distanceSquared += (a[c] - sign * b[c]) * (a[c] - sign * b[c]);
+            }
+
+            return 4.0f * std::asin(std::min(std::sqrt(distanceSquared) * 0.5f, 1.0f));
+        }
+        default:
+        {
+            float error = 0.0f;
+
+            for (size_t c = 0; c < componentCount; ++c)
+            {
+                error = std::max(error, std::abs(a[c] - b[c]));
+            }
+
+            return error;
+        }
+        }
+    }
+
+    // Interpolates between two keyframe values as a LINEAR sampler would: rotations are slerped along the shorter arc
+    void Interpolate(TargetPath path, const float* a, const float* b, float s, size_t componentCount, float* output)
+    {
+        if (path != TARGET_ROTATION)
+        {
+            for (size_t c = 0; c < componentCount; ++c)
+            {
+                output[c] = a[c] + (b[c] - a[c]) * s;
+            }
+
+            return;
+        }
+
+        float d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        const float sign = d < 0.0f ? -1.0f : 1.0f;
+
+        d = std::abs(d);
+
+        float wa = 1.0f - s;
+        float wb = s;
+
+        if (d < 0.9995f)
+        {
+            const float theta = std::acos(d);
+            const float sinTheta = std::sin(theta);
+
+            wa = std::sin(wa * theta) / sinTheta;
+            wb = std::sin(wb * theta) / sinTheta;
+        }
+
+        float lengthSquared = 0.0f;
+
+        for (size_t c = 0; c < 4U; ++c)
+        {
+            output[c] = wa * a[c] + wb * sign * b[c];
+            lengthSquared += output[c] * output[c];
+        }
+
+        const float length = std::sqrt(lengthSquared);
+
+        for (size_t c = 0; c < 4U; ++c)
+        {
+            output[c] /= length;
+        }
+    }
+
+    // Returns the indices of the keyframes that must be kept so that every removed keyframe is within 'tolerance'
+    // of the value interpolated (or, for STEP samplers, held) from the kept keyframes either side of it
+    std::vector<size_t> SelectKeyframes(TargetPath path, InterpolationType interpolation, const std::vector<float>& times, const std::vector<float>& values,
+        size_t componentCount, float tolerance)
+    {
+        const size_t count = times.size();
+
+        std::vector<size_t> kept = { 0U };
+
+        if (count < 2U)
+        {
+            return kept;
+        }
+
+        std::vector<float> interpolated(componentCount);
+
+        size_t start = 0U;
+
+        for (size_t end = 2U; end < count; ++end)
+        {
+            bool isRedundant = true;
+
+            if (interpolation == INTERPOLATION_STEP)
+            {
+                // A STEP keyframe is redundant if it holds the same value as the last kept keyframe
+                isRedundant = GetError(path, &values[start * componentCount], &values[(end - 1U) * componentCount], componentCount) <= tolerance;
+            }
+            else
+            {
+                const float* a = &values[start * componentCount];
+                const float* b = &values[end * componentCount];
+
+                // Check that every keyframe the segment (start, end) would replace is within tolerance
+                for (size_t i = start + 1U; i < end && isRedundant; ++i)
+                {
+                    const float s = (times[i] - times[start]) / (times[end] - times[start]);
+
+                    Interpolate(path, a, b, s, componentCount, interpolated.data());
+                    isRedundant = GetError(path, interpolated.data(), &values[i * componentCount], componentCount) <= tolerance;
+                }
+            }
+
+            if (!isRedundant)
+            {
+                start = end - 1U;
+                kept.push_back(start);
+            }
+        }
+
+        kept.push_back(count - 1U);
+
+        return kept;
+    }
+
+    ReducedTrack ReduceTrack(const AnimationEvaluator& evaluator, size_t trackIndex, const KeyframeReductionOptions& options)
+    {
+        const auto& track = evaluator.GetTracks()[trackIndex];
+        const size_t componentCount = track.componentCount;
+
+        const float* trackTimes = evaluator.GetTimes().data() + track.timeOffset;
+        const float* trackValues = evaluator.GetValues().data() + track.valueOffset;
+
+        const float startTime = trackTimes[0];
+        const float endTime = trackTimes[track.keyframeCount - 1U];
+
+        std::vector<float> times;
+        std::vector<float> values;
+
+        if (options.sampleRate > 0.0f && track.interpolation != INTERPOLATION_STEP)
+        {
+            const size_t sampleCount = static_cast<size_t>(std::ceil((endTime - startTime) * options.sampleRate));
+
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                const float time = startTime + static_cast<float>(i) / options.sampleRate;
+
+                if (time < endTime)
+                {
+                    times.push_back(time);
+                }
+            }
+
+            times.push_back(endTime);
+            values.resize(times.size() * componentCount);
+
+            size_t cursor = 0U;
+
+            for (size_t i = 0; i < times.size(); ++i)
+            {
+                evaluator.EvaluateTrack(trackIndex, times[i], &values[i * componentCount], cursor);
+            }
+        }
+        else
+        {
+            times.assign(trackTimes, trackTimes + track.keyframeCount);
+            values.assign(trackValues, trackValues + track.keyframeCount * componentCount);
+        }
+
+        ReducedTrack result;
+        result.interpolation = track.interpolation == INTERPOLATION_STEP ? INTERPOLATION_STEP : INTERPOLATION_LINEAR;
+
+        const auto kept = SelectKeyframes(track.path, result.interpolation, times, values, componentCount, GetTolerance(track.path, options));
+
+        result.times.reserve(kept.size());
+        result.values.reserve(kept.size() * componentCount);
+
+        for (const size_t index : kept)
+        {
+            result.times.push_back(times[index]);
+            result.values.insert(result.values.end(), values.begin() + index * componentCount, values.begin() + (index + 1U) * componentCount);
+        }
+
+        return result;
+    }
+}
+
 std::vector<float> AnimationUtils::GetKeyframeTimes(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
 {
     if (accessor.type != TYPE_SCALAR)
@@ -123,3 +360,75 @@ std::vector<float> AnimationUtils::GetMorphWeights(const Document& doc, const GL
     auto& accessor = doc.accessors[sampler.outputAccessorId];
     return GetMorphWeights(doc, reader, accessor);
 }
+
+Animation AnimationUtils::ReduceKeyframes(const Document& doc, const GLTFResourceReader& reader, const Animation& animation, BufferBuilder& bufferBuilder,
+    const KeyframeReductionOptions& options, size_t threadCount)
+{
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("BufferBuilder must have a current buffer to write reduced animation samplers to");
+    }
+
+    const AnimationEvaluator evaluator(doc, reader, animation);
+    const auto& tracks = evaluator.GetTracks();
+
+    // CUBICSPLINE channels are only reduced once they have been resampled to LINEAR
+    std::vector<bool> isPassthrough(tracks.size());
+
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        isPassthrough[i] = tracks[i].interpolation == INTERPOLATION_CUBICSPLINE && !(options.sampleRate > 0.0f);
+    }
+
+    std::vector<ReducedTrack> reducedTracks(tracks.size());
+
+    ParallelUtils::ParallelFor(tracks.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!isPassthrough[i])
+            {
+                reducedTracks[i] = ReduceTrack(evaluator, i, options);
+            }
+        }
+    }, threadCount);
+
+    Animation result = animation;
+    result.channels.Clear();
+    result.samplers.Clear();
+
+    if (std::find(isPassthrough.begin(), isPassthrough.end(), false) != isPassthrough.end())
+    {
+        bufferBuilder.AddBufferView();
+    }
+
+    // The evaluator has one track per channel, in the same order as animation.channels
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        AnimationChannel channel = animation.channels[i];
+        AnimationSampler sampler;
+
+        if (isPassthrough[i])
+        {
+            sampler = animation.samplers.Get(channel.samplerId);
+        }
+        else
+        {
+            const auto& reducedTrack = reducedTracks[i];
+
+            const AccessorType outputType = tracks[i].path == TARGET_ROTATION ? TYPE_VEC4 : (tracks[i].path == TARGET_WEIGHTS ? TYPE_SCALAR : TYPE_VEC3);
+
+            sampler.interpolation = reducedTrack.interpolation;
+            sampler.inputAccessorId = bufferBuilder.AddAccessor(reducedTrack.times, { TYPE_SCALAR, COMPONENT_FLOAT, false, { reducedTrack.times.front() }, { reducedTrack.times.back() } }).id;
+            sampler.outputAccessorId = bufferBuilder.AddAccessor(reducedTrack.values, { outputType, COMPONENT_FLOAT }).id;
+        }
+
+        sampler.id = std::to_string(i);
+        channel.samplerId = sampler.id;
+
+        result.samplers.Append(std::move(sampler));
+        result.channels.Append(std::move(channel));
+    }
+
+    return result;
+}
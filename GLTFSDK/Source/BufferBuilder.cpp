@@ -3,6 +3,7 @@
 
 #include <GLTFSDK/BufferBuilder.h>
 
+#include <GLTFSDK/AccessorUtils.h>
 #include <GLTFSDK/ResourceWriter.h>
 
 using namespace Microsoft::glTF;
@@ -38,7 +39,9 @@ BufferBuilder::BufferBuilder(std::unique_ptr<ResourceWriter>&& resourceWriter,
     FnGenId fnGenAccessorId) : m_resourceWriter(std::move(resourceWriter)),
     m_fnGenBufferId(std::move(fnGenBufferId)),
     m_fnGenBufferViewId(std::move(fnGenBufferViewId)),
-    m_fnGenAccessorId(std::move(fnGenAccessorId))
+    m_fnGenAccessorId(std::move(fnGenAccessorId)),
+    m_computeMinMax(false),
+    m_computeMinMaxThreadCount(0U)
 {
 }
 
@@ -80,8 +83,13 @@ const BufferView& BufferBuilder::AddBufferView(Optional<BufferViewTarget> target
     return m_bufferViews.Append(std::move(bufferView), AppendIdPolicy::GenerateOnEmpty);
 }
 
-const BufferView& BufferBuilder::AddBufferView(const void* data, size_t byteLength, Optional<size_t> byteStride, Optional<BufferViewTarget> target)
+const BufferView& BufferBuilder::AddBufferView(const void* data, size_t byteLength, Optional<size_t> byteStride, Optional<BufferViewTarget> target, size_t byteAlignment)
 {
+    if (byteAlignment == 0U)
+    {
+        throw InvalidGLTFException("The buffer view's byte alignment must be greater than zero");
+    }
+
     Buffer& buffer = m_buffers.Back();
     BufferView bufferView;
 
@@ -91,7 +99,7 @@ const BufferView& BufferBuilder::AddBufferView(const void* data, size_t byteLeng
     }
 
     bufferView.bufferId = buffer.id;
-    bufferView.byteOffset = buffer.byteLength;
+    bufferView.byteOffset = buffer.byteLength + ::GetPadding(buffer.byteLength, byteAlignment);
     bufferView.byteLength = byteLength;
     bufferView.byteStride = byteStride;
     bufferView.target = target;
@@ -117,6 +125,14 @@ const Accessor& BufferBuilder::AddAccessor(const void* data, size_t count, Acces
         bufferView.byteOffset += ::GetPadding(bufferView.byteOffset, desc.componentType);
     }
 
+    if (m_computeMinMax && desc.minValues.empty() && desc.maxValues.empty())
+    {
+        auto bounds = AccessorUtils::ComputeMinMax(data, count, 0U, desc.accessorType, desc.componentType, m_computeMinMaxThreadCount);
+
+        desc.minValues = std::move(bounds.min);
+        desc.maxValues = std::move(bounds.max);
+    }
+
     desc.byteOffset = bufferView.byteLength;
     const Accessor& accessor = AddAccessor(count, std::move(desc));
 
@@ -199,7 +215,20 @@ void BufferBuilder::AddAccessors(const void* data, size_t count, size_t byteStri
 
     for (size_t i = 0; i < descCount; ++i)
     {
-        AddAccessor(count, pDescs[i]);
+        if (m_computeMinMax && pDescs[i].minValues.empty() && pDescs[i].maxValues.empty())
+        {
+            AccessorDesc desc = pDescs[i];
+            auto bounds = AccessorUtils::ComputeMinMax(static_cast<const uint8_t*>(data) + desc.byteOffset, count, byteStride, desc.accessorType, desc.componentType, m_computeMinMaxThreadCount);
+
+            desc.minValues = std::move(bounds.min);
+            desc.maxValues = std::move(bounds.max);
+
+            AddAccessor(count, std::move(desc));
+        }
+        else
+        {
+            AddAccessor(count, pDescs[i]);
+        }
 
         if (pOutIds != nullptr)
         {
@@ -253,6 +282,17 @@ const ResourceWriter& BufferBuilder::GetResourceWriter() const
     return *m_resourceWriter;
 }
 
+void BufferBuilder::SetComputeMinMax(bool computeMinMax, size_t threadCount)
+{
+    m_computeMinMax = computeMinMax;
+    m_computeMinMaxThreadCount = threadCount;
+}
+
+bool BufferBuilder::GetComputeMinMax() const
+{
+    return m_computeMinMax;
+}
+
 const Accessor& BufferBuilder::AddAccessor(size_t count, AccessorDesc desc)
 {
     Buffer& buffer = m_buffers.Back();
@@ -0,0 +1,330 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/BufferUtils.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/ExtensionsKHR.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Instrumentation.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Trimmed buffer views start at a multiple of the largest component size so that accessor offsets (which must be
+    // multiples of their component size) remain valid when made relative to the new start
+    const size_t MaxComponentSize = 4U;
+
+    // Extensions known to refer to accessors or buffer views
+    const char* const ReferencingExtensionNames[] = {
+        KHR::MeshPrimitives::DRACOMESHCOMPRESSION_NAME,
+        "EXT_meshopt_compression",
+        "EXT_mesh_gpu_instancing"
+    };
+
+    // The byte range of a source buffer view that is copied to the repacked buffer
+    struct BufferViewRange
+    {
+        size_t begin = std::numeric_limits<size_t>::max();
+        size_t end = 0U;
+        bool isWhole = false;
+    };
+
+    class RepackPlan
+    {
+    public:
+        RepackPlan(const Document& doc, const BufferRepackOptions& options) : m_doc(doc), m_options(options)
+        {
+            for (const auto& mesh : doc.meshes.Elements())
+            {
+                for (const auto& primitive : mesh.primitives)
+                {
+                    AddAccessor(primitive.indicesAccessorId);
+
+                    // Attributes are visited in name order so that the repacked layout is deterministic
+                    const std::map<std::string, std::string> attributes(primitive.attributes.begin(), primitive.attributes.end());
+
+                    for (const auto& attribute : attributes)
+                    {
+                        AddAccessor(attribute.second);
+                    }
+
+                    for (const auto& target : primitive.targets)
+                    {
+                        AddAccessor(target.positionsAccessorId);
+                        AddAccessor(target.normalsAccessorId);
+                        AddAccessor(target.tangentsAccessorId);
+                    }
+                }
+            }
+
+            for (const auto& skin : doc.skins.Elements())
+            {
+                AddAccessor(skin.inverseBindMatricesAccessorId);
+            }
+
+            for (const auto& animation : doc.animations.Elements())
+            {
+                for (const auto& sampler : animation.samplers.Elements())
+                {
+                    AddAccessor(sampler.inputAccessorId);
+                    AddAccessor(sampler.outputAccessorId);
+                }
+            }
+
+            if (!options.removeUnused)
+            {
+                for (const auto& accessor : doc.accessors.Elements())
+                {
+                    AddAccessor(accessor.id);
+                }
+            }
+
+            for (const auto& image : doc.images.Elements())
+            {
+                AddWholeBufferView(image.bufferViewId);
+            }
+
+            if (!options.removeUnused)
+            {
+                for (const auto& bufferView : doc.bufferViews.Elements())
+                {
+                    AddWholeBufferView(bufferView.id);
+                }
+            }
+
+            if (!options.groupByMesh)
+            {
+                m_bufferViewIds.clear();
+
+                for (const auto& bufferView : doc.bufferViews.Elements())
+                {
+                    if (m_ranges.count(bufferView.id))
+                    {
+                        m_bufferViewIds.push_back(bufferView.id);
+                    }
+                }
+            }
+
+            for (auto& range : m_ranges)
+            {
+                const auto& bufferView = doc.bufferViews.Get(range.first);
+
+                if (range.second.isWhole || range.second.begin >= range.second.end)
+                {
+                    range.second.begin = 0U;
+                    range.second.end = bufferView.byteLength;
+                }
+                else
+                {
+                    range.second.begin -= range.second.begin % MaxComponentSize;
+                    range.second.end = std::min(range.second.end, bufferView.byteLength);
+                }
+            }
+        }
+
+        bool IsAccessorUsed(const std::string& accessorId) const
+        {
+            return m_accessorIds.count(accessorId) > 0U;
+        }
+
+        // Buffer view ids in the order they're written to the repacked buffer
+        const std::vector<std::string>& GetBufferViewIds() const
+        {
+            return m_bufferViewIds;
+        }
+
+        const BufferViewRange& GetRange(const std::string& bufferViewId) const
+        {
+            return m_ranges.at(bufferViewId);
+        }
+
+    private:
+        void AddAccessor(const std::string& accessorId)
+        {
+            if (accessorId.empty() || !m_accessorIds.insert(accessorId).second)
+            {
+                return;
+            }
+
+            const auto& accessor = m_doc.accessors.Get(accessorId);
+
+            if (!accessor.bufferViewId.empty())
+            {
+                const auto& bufferView = m_doc.bufferViews.Get(accessor.bufferViewId);
+
+                const size_t elementSize = Accessor::GetComponentTypeSize(accessor.componentType) * Accessor::GetTypeCount(accessor.type);
+                const size_t byteStride = bufferView.byteStride ? bufferView.byteStride.Get() : elementSize;
+
+                auto& range = AddBufferView(accessor.bufferViewId);
+
+                range.begin = std::min(range.begin, accessor.byteOffset);
+                range.end = std::max(range.end, accessor.count ? accessor.byteOffset + byteStride * (accessor.count - 1U) + elementSize : accessor.byteOffset);
+            }
+
+            // Sparse indices and values are each tightly packed from their offset, but are rarely worth trimming
+            if (accessor.sparse.count > 0U)
+            {
+                AddWholeBufferView(accessor.sparse.indicesBufferViewId);
+                AddWholeBufferView(accessor.sparse.valuesBufferViewId);
+            }
+        }
+
+        void AddWholeBufferView(const std::string& bufferViewId)
+        {
+            if (!bufferViewId.empty())
+            {
+                AddBufferView(bufferViewId).isWhole = true;
+            }
+        }
+
+        BufferViewRange& AddBufferView(const std::string& bufferViewId)
+        {
+            auto it = m_ranges.find(bufferViewId);
+
+            if (it == m_ranges.end())
+            {
+                it = m_ranges.emplace(bufferViewId, BufferViewRange()).first;
+
+                m_bufferViewIds.push_back(bufferViewId);
+
+                if (!m_options.removeUnused)
+                {
+                    it->second.isWhole = true;
+                }
+            }
+
+            return it->second;
+        }
+
+        const Document& m_doc;
+        const BufferRepackOptions& m_options;
+
+        std::unordered_set<std::string> m_accessorIds;
+        std::vector<std::string> m_bufferViewIds;
+        std::unordered_map<std::string, BufferViewRange> m_ranges;
+    };
+}
+
+Document BufferUtils::RepackBuffers(const Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const BufferRepackOptions& options, BufferRepackStatistics* statistics)
+{
+    GLTFSDK_INSTRUMENT_SCOPE("BufferUtils::RepackBuffers");
+
+    if (!options.allowExtensionReferences)
+    {
+        for (const auto extensionName : ReferencingExtensionNames)
+        {
+            if (doc.extensionsUsed.count(extensionName))
+            {
+                throw InvalidGLTFException(std::string("Buffers can't be repacked as extension ") + extensionName + " refers to accessors or buffer views");
+            }
+        }
+    }
+
+    const RepackPlan plan(doc, options);
+
+    const size_t initialByteLength = bufferBuilder.GetCurrentBuffer().byteLength;
+
+    // Maps source buffer view ids to the ids of the buffer views written to the buffer builder
+    std::unordered_map<std::string, std::string> bufferViewIds;
+    std::vector<std::pair<std::string, const BufferView*>> repackedBufferViews;
+
+    for (const auto& bufferViewId : plan.GetBufferViewIds())
+    {
+        const auto& range = plan.GetRange(bufferViewId);
+
+        BufferView bufferView = doc.bufferViews.Get(bufferViewId);
+        bufferView.byteOffset += range.begin;
+        bufferView.byteLength = range.end - range.begin;
+
+        const auto data = reader.ReadBinaryData<uint8_t>(doc, bufferView);
+        const auto& repackedBufferView = bufferBuilder.AddBufferView(data, bufferView.byteStride, bufferView.target, options.byteAlignment);
+
+        bufferViewIds.emplace(bufferViewId, repackedBufferView.id);
+        repackedBufferViews.emplace_back(repackedBufferView.id, &doc.bufferViews.Get(bufferViewId));
+    }
+
+    Document result = doc;
+    result.buffers.Clear();
+    result.bufferViews.Clear();
+    result.accessors.Clear();
+
+    for (const auto& accessor : doc.accessors.Elements())
+    {
+        if (!plan.IsAccessorUsed(accessor.id))
+        {
+            continue;
+        }
+
+        Accessor repackedAccessor = accessor;
+
+        if (!accessor.bufferViewId.empty())
+        {
+            repackedAccessor.bufferViewId = bufferViewIds.at(accessor.bufferViewId);
+            repackedAccessor.byteOffset -= plan.GetRange(accessor.bufferViewId).begin;
+        }
+
+        if (accessor.sparse.count > 0U)
+        {
+            if (accessor.sparse.indicesBufferViewId.empty() || accessor.sparse.valuesBufferViewId.empty())
+            {
+                throw InvalidGLTFException("Sparse accessor " + accessor.id + " must have indices and values buffer views");
+            }
+
+            repackedAccessor.sparse.indicesBufferViewId = bufferViewIds.at(accessor.sparse.indicesBufferViewId);
+            repackedAccessor.sparse.valuesBufferViewId = bufferViewIds.at(accessor.sparse.valuesBufferViewId);
+        }
+
+        result.accessors.Append(std::move(repackedAccessor));
+    }
+
+    for (const auto& image : doc.images.Elements())
+    {
+        if (!image.bufferViewId.empty())
+        {
+            Image repackedImage = image;
+            repackedImage.bufferViewId = bufferViewIds.at(image.bufferViewId);
+
+            result.images.Replace(std::move(repackedImage));
+        }
+    }
+
+    const size_t repackedByteLength = bufferBuilder.GetCurrentBuffer().byteLength - initialByteLength;
+
+    bufferBuilder.Output(result);
+
+    // Restore the properties of the source buffer views that BufferBuilder doesn't know about
+    for (const auto& repackedBufferView : repackedBufferViews)
+    {
+        BufferView bufferView = result.bufferViews.Get(repackedBufferView.first);
+
+        bufferView.name = repackedBufferView.second->name;
+        bufferView.extensions = repackedBufferView.second->extensions;
+        bufferView.extras = repackedBufferView.second->extras;
+
+        result.bufferViews.Replace(std::move(bufferView));
+    }
+
+    if (statistics)
+    {
+        statistics->removedAccessorCount = doc.accessors.Size() - result.accessors.Size();
+        statistics->removedBufferViewCount = doc.bufferViews.Size() - repackedBufferViews.size();
+        statistics->sourceByteLength = 0U;
+        statistics->repackedByteLength = repackedByteLength;
+
+        for (const auto& buffer : doc.buffers.Elements())
+        {
+            statistics->sourceByteLength += buffer.byteLength;
+        }
+    }
+
+    return result;
+}
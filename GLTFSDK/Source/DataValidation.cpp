@@ -0,0 +1,545 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/DataValidation.h>
+
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Instrumentation.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include "MeshUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Approximate number of bytes of accessor data read before a batch of accessors is scanned in parallel
+    const size_t BatchByteSize = 16U << 20;
+
+    struct AccessorScan
+    {
+        std::vector<double> min; // Doubles represent every uint32 index exactly
+        std::vector<double> max;
+
+        size_t nonFiniteCount = 0U;
+        size_t firstNonFinite = 0U; // Element index
+
+        size_t invalidWeightCount = 0U;
+        size_t firstInvalidWeight = 0U; // Element index
+    };
+
+    // The data read for an accessor. An accessor without a buffer view is implicitly zero, so only its sparse values
+    // (and the indices of the elements they replace) are read - the zeros are accounted for by ScanAccessor rather than
+    // materialized, as the accessor's count is unbounded by any buffer.
+    struct AccessorData
+    {
+        size_t accessorIndex;
+        std::vector<uint8_t> bytes;
+        std::vector<uint32_t> sparseIndices;
+        bool isImplicitZero;
+    };
+
+    template<typename T>
+    std::vector<uint32_t> GetSparseIndices(const std::vector<uint8_t>& bytes)
+    {
+        std::vector<uint32_t> indices(bytes.size() / sizeof(T));
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            T index;
+            std::memcpy(&index, bytes.data() + i * sizeof(T), sizeof(T));
+
+            indices[i] = index;
+        }
+
+        return indices;
+    }
+
+    AccessorData ReadAccessorData(const Document& doc, const GLTFResourceReader& reader, size_t accessorIndex)
+    {
+        const auto& accessor = doc.accessors[accessorIndex];
+
+        AccessorData data = { accessorIndex, {}, {}, accessor.bufferViewId.empty() };
+
+        if (!data.isImplicitZero)
+        {
+            data.bytes = Internal::ReadAccessorBytes(doc, reader, accessor);
+            return data;
+        }
+
+        if (accessor.sparse.count == 0U)
+        {
+            return data;
+        }
+
+        if (accessor.sparse.count > accessor.count)
+        {
+            throw GLTFException("Accessor " + accessor.id + " has more sparse elements than elements");
+        }
+
+        if (accessor.sparse.indicesBufferViewId.empty() || accessor.sparse.valuesBufferViewId.empty())
+        {
+            throw GLTFException("Sparse accessor " + accessor.id + " must have indices and values buffer views");
+        }
+
+        // The sparse values and indices are read as tightly packed accessors, so their counts are bounded by their buffer views
+        Accessor values;
+        values.id = accessor.id;
+        values.bufferViewId = accessor.sparse.valuesBufferViewId;
+        values.byteOffset = accessor.sparse.valuesByteOffset;
+        values.count = accessor.sparse.count;
+        values.type = accessor.type;
+        values.componentType = accessor.componentType;
+
+        Accessor indices;
+        indices.id = accessor.id;
+        indices.bufferViewId = accessor.sparse.indicesBufferViewId;
+        indices.byteOffset = accessor.sparse.indicesByteOffset;
+        indices.count = accessor.sparse.count;
+        indices.type = TYPE_SCALAR;
+        indices.componentType = accessor.sparse.indicesComponentType;
+
+        data.bytes = Internal::ReadAccessorBytes(doc, reader, values);
+
+        const auto indexBytes = Internal::ReadAccessorBytes(doc, reader, indices);
+
+        switch (accessor.sparse.indicesComponentType)
+        {
+        case COMPONENT_UNSIGNED_BYTE:
+            data.sparseIndices = GetSparseIndices<uint8_t>(indexBytes);
+            break;
+        case COMPONENT_UNSIGNED_SHORT:
+            data.sparseIndices = GetSparseIndices<uint16_t>(indexBytes);
+            break;
+        case COMPONENT_UNSIGNED_INT:
+            data.sparseIndices = GetSparseIndices<uint32_t>(indexBytes);
+            break;
+        default:
+            throw GLTFException("Invalid sparse indices componentType for accessor " + accessor.id);
+        }
+
+        for (size_t i = 0; i < data.sparseIndices.size(); ++i)
+        {
+            if (data.sparseIndices[i] >= accessor.count || (i > 0U && data.sparseIndices[i] <= data.sparseIndices[i - 1U]))
+            {
+                throw GLTFException("Accessor " + accessor.id + " sparse indices must be strictly increasing and less than its count");
+            }
+        }
+
+        return data;
+    }
+
+    // Branch free so that the scan loops can be vectorized: NaN - NaN and inf - inf are both NaN
+    template<typename T>
+    bool IsNonFinite(T)
+    {
+        return false;
+    }
+
+    bool IsNonFinite(float value)
+    {
+        return !(value - value == 0.0f);
+    }
+
+    // N is a compile time constant so that the per-component loops are unrolled and the
+    // comparisons of each element can be vectorized
+    template<typename T, size_t N>
+    void ScanElements(const uint8_t* bytes, size_t count, AccessorScan& scan)
+    {
+        T mins[N];
+        T maxs[N];
+
+        std::fill(mins, mins + N, std::numeric_limits<T>::max());
+        std::fill(maxs, maxs + N, std::numeric_limits<T>::lowest());
+
+        size_t nonFiniteCount = 0U;
+
+        for (size_t i = 0; i < count; ++i, bytes += sizeof(T) * N)
+        {
+            T element[N];
+            std::memcpy(element, bytes, sizeof(element));
+
+            // Comparisons are written so that NaN values are ignored
+            for (size_t c = 0; c < N; ++c)
+            {
+                mins[c] = element[c] < mins[c] ? element[c] : mins[c];
+                maxs[c] = element[c] > maxs[c] ? element[c] : maxs[c];
+
+                nonFiniteCount += IsNonFinite(element[c]) ? 1U : 0U;
+            }
+        }
+
+        scan.min.assign(mins, mins + N);
+        scan.max.assign(maxs, maxs + N);
+
+        scan.nonFiniteCount = nonFiniteCount;
+    }
+
+    template<typename T>
+    void ScanElements(const uint8_t* bytes, size_t count, size_t typeCount, AccessorScan& scan)
+    {
+        switch (typeCount)
+        {
+        case 1U:
+            return ScanElements<T, 1U>(bytes, count, scan);
+        case 2U:
+            return ScanElements<T, 2U>(bytes, count, scan);
+        case 3U:
+            return ScanElements<T, 3U>(bytes, count, scan);
+        case 4U:
+            return ScanElements<T, 4U>(bytes, count, scan);
+        case 9U:
+            return ScanElements<T, 9U>(bytes, count, scan);
+        case 16U:
+            return ScanElements<T, 16U>(bytes, count, scan);
+        default:
+            throw GLTFException("Invalid accessor type count " + std::to_string(typeCount));
+        }
+    }
+
+    // Counts the elements whose four weights don't sum to 'one'
+    template<typename T>
+    void ScanWeights(const uint8_t* bytes, size_t count, float one, float tolerance, AccessorScan& scan)
+    {
+        size_t invalidCount = 0U;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            T weights[4];
+            std::memcpy(weights, bytes + i * sizeof(weights), sizeof(weights));
+
+            const float sum = static_cast<float>(weights[0]) + static_cast<float>(weights[1]) + static_cast<float>(weights[2]) + static_cast<float>(weights[3]);
+
+            invalidCount += std::abs(sum - one) <= tolerance ? 0U : 1U;
+        }
+
+        scan.invalidWeightCount = invalidCount;
+
+        if (invalidCount > 0U)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                T weights[4];
+                std::memcpy(weights, bytes + i * sizeof(weights), sizeof(weights));
+
+                const float sum = static_cast<float>(weights[0]) + static_cast<float>(weights[1]) + static_cast<float>(weights[2]) + static_cast<float>(weights[3]);
+
+                if (!(std::abs(sum - one) <= tolerance))
+                {
+                    scan.firstInvalidWeight = i;
+                    break;
+                }
+            }
+        }
+    }
+
+    void ScanAccessor(const Accessor& accessor, const AccessorData& data, bool isWeights, const DataValidationOptions& options, AccessorScan& scan)
+    {
+        const size_t typeCount = Accessor::GetTypeCount(accessor.type);
+
+        // Only the sparse values of an implicitly zero accessor are scanned
+        const uint8_t* bytes = data.bytes.data();
+        const size_t count = data.isImplicitZero ? data.sparseIndices.size() : accessor.count;
+
+        switch (accessor.componentType)
+        {
+        case COMPONENT_BYTE:
+            ScanElements<int8_t>(bytes, count, typeCount, scan);
+            break;
+        case COMPONENT_UNSIGNED_BYTE:
+            ScanElements<uint8_t>(bytes, count, typeCount, scan);
+            break;
+        case COMPONENT_SHORT:
+            ScanElements<int16_t>(bytes, count, typeCount, scan);
+            break;
+        case COMPONENT_UNSIGNED_SHORT:
+            ScanElements<uint16_t>(bytes, count, typeCount, scan);
+            break;
+        case COMPONENT_UNSIGNED_INT:
+            ScanElements<uint32_t>(bytes, count, typeCount, scan);
+            break;
+        case COMPONENT_FLOAT:
+            ScanElements<float>(bytes, count, typeCount, scan);
+            break;
+        default:
+            throw GLTFException("Invalid componentType for accessor " + accessor.id);
+        }
+
+        // Elements that aren't replaced by sparse values are zero. Sparse indices are strictly increasing, so the first
+        // such element is the first whose index differs from its position in the sparse indices.
+        const size_t zeroCount = data.isImplicitZero ? accessor.count - count : 0U;
+        size_t firstZero = 0U;
+
+        while (firstZero < data.sparseIndices.size() && data.sparseIndices[firstZero] == firstZero)
+        {
+            ++firstZero;
+        }
+
+        if (zeroCount > 0U)
+        {
+            for (size_t c = 0; c < typeCount; ++c)
+            {
+                scan.min[c] = std::min(scan.min[c], 0.0);
+                scan.max[c] = std::max(scan.max[c], 0.0);
+            }
+        }
+
+        // The rare non-finite values are located by a second, early-out pass
+        if (scan.nonFiniteCount > 0U)
+        {
+            const float* values = reinterpret_cast<const float*>(bytes);
+            const size_t valueCount = count * typeCount;
+
+            for (size_t i = 0; i < valueCount; ++i)
+            {
+                if (!std::isfinite(values[i]))
+                {
+                    scan.firstNonFinite = data.isImplicitZero ? data.sparseIndices[i / typeCount] : i / typeCount;
+                    break;
+                }
+            }
+        }
+
+        if (isWeights && accessor.type == TYPE_VEC4)
+        {
+            switch (accessor.componentType)
+            {
+            case COMPONENT_UNSIGNED_BYTE:
+                ScanWeights<uint8_t>(bytes, count, 255.0f, options.weightsTolerance * 255.0f, scan);
+                break;
+            case COMPONENT_UNSIGNED_SHORT:
+                ScanWeights<uint16_t>(bytes, count, 65535.0f, options.weightsTolerance * 65535.0f, scan);
+                break;
+            case COMPONENT_FLOAT:
+                ScanWeights<float>(bytes, count, 1.0f, options.weightsTolerance, scan);
+                break;
+            default:
+                return; // Invalid weight component types are reported by Validate
+            }
+
+            if (data.isImplicitZero && scan.invalidWeightCount > 0U)
+            {
+                scan.firstInvalidWeight = data.sparseIndices[scan.firstInvalidWeight];
+            }
+
+            // Zero weights never sum to one
+            if (zeroCount > 0U)
+            {
+                scan.firstInvalidWeight = scan.invalidWeightCount > 0U ? std::min(scan.firstInvalidWeight, firstZero) : firstZero;
+                scan.invalidWeightCount += zeroCount;
+            }
+        }
+    }
+
+    bool IsWithinTolerance(float declared, double actual, float tolerance)
+    {
+        return std::abs(declared - actual) <= tolerance * std::max(1.0, std::abs(static_cast<double>(declared)));
+    }
+
+    ValidationIssue MakeIssue(size_t accessorIndex, const Accessor& accessor, const std::string& property, std::string message, ValidationSeverity severity = ValidationSeverity::Error)
+    {
+        ValidationIssue issue;
+
+        issue.severity = severity;
+        issue.pointer = "/accessors/" + std::to_string(accessorIndex) + property;
+        issue.entityType = "accessors";
+        issue.entityId = accessor.id;
+        issue.message = std::move(message);
+
+        return issue;
+    }
+
+    void CheckMinMax(size_t accessorIndex, const Accessor& accessor, const AccessorScan& scan, float tolerance, std::vector<ValidationIssue>& issues)
+    {
+        if (accessor.min.empty() && accessor.max.empty())
+        {
+            return;
+        }
+
+        const size_t typeCount = Accessor::GetTypeCount(accessor.type);
+
+        if (accessor.min.size() != typeCount || accessor.max.size() != typeCount)
+        {
+            issues.push_back(MakeIssue(accessorIndex, accessor, accessor.min.size() != typeCount ? "/min" : "/max",
+                "Accessor " + accessor.id + " min and max must have " + std::to_string(typeCount) + " components"));
+            return;
+        }
+
+        if (accessor.count == 0U)
+        {
+            return;
+        }
+
+        for (size_t c = 0; c < typeCount; ++c)
+        {
+            const bool isMinValid = IsWithinTolerance(accessor.min[c], scan.min[c], tolerance);
+
+            if (!isMinValid || !IsWithinTolerance(accessor.max[c], scan.max[c], tolerance))
+            {
+                issues.push_back(MakeIssue(accessorIndex, accessor, (isMinValid ? "/max/" : "/min/") + std::to_string(c),
+                    "Accessor " + accessor.id + " component " + std::to_string(c) + " has min " + std::to_string(scan.min[c]) + " and max " + std::to_string(scan.max[c])
+                    + " but declares min " + std::to_string(accessor.min[c]) + " and max " + std::to_string(accessor.max[c])));
+            }
+        }
+    }
+}
+
+void Validation::ValidateData(const Document& doc, const GLTFResourceReader& reader, ValidationReport& report, const DataValidationOptions& options, size_t threadCount)
+{
+    GLTFSDK_INSTRUMENT_SCOPE("Validation::ValidateData");
+
+    const size_t accessorCount = doc.accessors.Size();
+
+    // Find the accessors that are used as weights, and whether any primitive uses them with other sets of weights
+    std::vector<bool> isWeights(accessorCount, false);
+    std::vector<bool> isMultipleWeights(accessorCount, false);
+
+    for (const auto& mesh : doc.meshes.Elements())
+    {
+        for (const auto& primitive : mesh.primitives)
+        {
+            std::string weightsAccessorId;
+
+            if (!primitive.TryGetAttributeAccessorId(ACCESSOR_WEIGHTS_0, weightsAccessorId) || !doc.accessors.Has(weightsAccessorId))
+            {
+                continue;
+            }
+
+            const bool hasMultipleWeights = std::any_of(primitive.attributes.begin(), primitive.attributes.end(), [](const std::pair<const std::string, std::string>& attribute)
+            {
+                return attribute.first.compare(0U, 8U, "WEIGHTS_") == 0 && attribute.first != ACCESSOR_WEIGHTS_0;
+            });
+
+            const size_t weightsIndex = doc.accessors.GetIndex(weightsAccessorId);
+
+            isWeights[weightsIndex] = true;
+            isMultipleWeights[weightsIndex] = isMultipleWeights[weightsIndex] || hasMultipleWeights;
+        }
+    }
+
+    std::vector<std::vector<ValidationIssue>> accessorIssues(accessorCount);
+    std::vector<AccessorScan> scans(accessorCount);
+    std::vector<bool> isScanned(accessorCount, false);
+
+    std::vector<AccessorData> batch;
+    size_t batchSize = 0U;
+
+    auto scanBatch = [&]()
+    {
+        ParallelUtils::ParallelFor(batch.size(), [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const size_t accessorIndex = batch[i].accessorIndex;
+                const auto& accessor = doc.accessors[accessorIndex];
+
+                auto& scan = scans[accessorIndex];
+                auto& issues = accessorIssues[accessorIndex];
+
+                const bool checkWeights = options.checkWeights && isWeights[accessorIndex] && !isMultipleWeights[accessorIndex];
+
+                ScanAccessor(accessor, batch[i], checkWeights, options, scan);
+
+                if (options.checkFinite && scan.nonFiniteCount > 0U)
+                {
+                    issues.push_back(MakeIssue(accessorIndex, accessor, "", "Accessor " + accessor.id + " has " + std::to_string(scan.nonFiniteCount)
+                        + " non-finite value(s), the first in element " + std::to_string(scan.firstNonFinite)));
+                }
+
+                if (options.checkMinMax)
+                {
+                    CheckMinMax(accessorIndex, accessor, scan, options.minMaxTolerance, issues);
+                }
+
+                if (scan.invalidWeightCount > 0U)
+                {
+                    issues.push_back(MakeIssue(accessorIndex, accessor, "", "Accessor " + accessor.id + " has " + std::to_string(scan.invalidWeightCount)
+                        + " set(s) of weights that don't sum to one, the first in element " + std::to_string(scan.firstInvalidWeight), ValidationSeverity::Warning));
+                }
+
+                // The scan keeps the bounds needed by the index checks but not the data
+                batch[i].bytes = {};
+                batch[i].sparseIndices = {};
+            }
+        }, threadCount);
+
+        batch.clear();
+        batchSize = 0U;
+    };
+
+    for (size_t i = 0; i < accessorCount; ++i)
+    {
+        const auto& accessor = doc.accessors[i];
+
+        try
+        {
+            batch.push_back(ReadAccessorData(doc, reader, i));
+            isScanned[i] = true;
+        }
+        catch (const GLTFException& ex)
+        {
+            accessorIssues[i].push_back(MakeIssue(i, accessor, "", "Accessor " + accessor.id + " can't be read: " + ex.what()));
+            continue;
+        }
+
+        batchSize += batch.back().bytes.size();
+
+        if (batchSize >= BatchByteSize)
+        {
+            scanBatch();
+        }
+    }
+
+    if (!batch.empty())
+    {
+        scanBatch();
+    }
+
+    // Indices are checked against the vertex count of every primitive that uses them, from the scanned maximum
+    if (options.checkIndices)
+    {
+        for (const auto& mesh : doc.meshes.Elements())
+        {
+            for (const auto& primitive : mesh.primitives)
+            {
+                std::string positionsAccessorId;
+
+                if (primitive.indicesAccessorId.empty() || !doc.accessors.Has(primitive.indicesAccessorId)
+                    || !primitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, positionsAccessorId) || !doc.accessors.Has(positionsAccessorId))
+                {
+                    continue;
+                }
+
+                const size_t indicesIndex = doc.accessors.GetIndex(primitive.indicesAccessorId);
+                const auto& indicesAccessor = doc.accessors[indicesIndex];
+                const size_t vertexCount = doc.accessors[positionsAccessorId].count;
+
+                if (!isScanned[indicesIndex] || indicesAccessor.count == 0U || indicesAccessor.type != TYPE_SCALAR)
+                {
+                    continue;
+                }
+
+                const double maxIndex = scans[indicesIndex].max[0];
+
+                if (maxIndex >= static_cast<double>(vertexCount))
+                {
+                    accessorIssues[indicesIndex].push_back(MakeIssue(indicesIndex, indicesAccessor, "", "Accessor " + indicesAccessor.id + " has index "
+                        + std::to_string(static_cast<uint64_t>(maxIndex)) + " but mesh " + mesh.id + " has " + std::to_string(vertexCount) + " vertices"));
+                }
+            }
+        }
+    }
+
+    for (auto& issues : accessorIssues)
+    {
+        if (!issues.empty())
+        {
+            report.Add(std::move(issues));
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include <GLTFSDK/Constants.h>
 #include <GLTFSDK/ExtensionHandlers.h>
 #include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/Instrumentation.h>
 #include <GLTFSDK/RapidJsonUtils.h>
 #include <GLTFSDK/Serialize.h>
 #include <GLTFSDK/SchemaValidation.h>
@@ -794,6 +795,8 @@ namespace
     {
         ValidateDocumentAgainstSchema(document, SCHEMA_URI_GLTF, GetDefaultSchemaLocator(schemaFlags));
 
+        GLTFSDK_INSTRUMENT_SCOPE("Deserialize::Build");
+
         Document gltfDocument;
 
         rapidjson::Value::ConstMemberIterator it;
@@ -842,9 +845,17 @@ Document Microsoft::glTF::Deserialize(const std::string& json, DeserializeFlags
 
 Document Microsoft::glTF::Deserialize(const std::string& json, const ExtensionDeserializer& extensionDeserializer, DeserializeFlags flags, SchemaFlags schemaFlags)
 {
-    const auto document = HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
-        RapidJsonUtils::CreateDocumentFromEncodedString(json) :
-        RapidJsonUtils::CreateDocumentFromString(json);
+    GLTFSDK_INSTRUMENT_SCOPE("Deserialize");
+    GLTFSDK_INSTRUMENT_COUNTER("Deserialize::Bytes", json.size());
+
+    const auto document = [&json, flags]()
+    {
+        GLTFSDK_INSTRUMENT_SCOPE("Deserialize::Parse");
+
+        return HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
+            RapidJsonUtils::CreateDocumentFromEncodedString(json) :
+            RapidJsonUtils::CreateDocumentFromString(json);
+    }();
 
     return DeserializeInternal(document, extensionDeserializer, schemaFlags);
 }
@@ -856,9 +867,16 @@ Document Microsoft::glTF::Deserialize(std::istream& jsonStream, DeserializeFlags
 
 Document Microsoft::glTF::Deserialize(std::istream& jsonStream, const ExtensionDeserializer& extensionDeserializer, DeserializeFlags flags, SchemaFlags schemaFlags)
 {
-    const auto document = HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
-        RapidJsonUtils::CreateDocumentFromEncodedStream(jsonStream) :
-        RapidJsonUtils::CreateDocumentFromStream(jsonStream);
+    GLTFSDK_INSTRUMENT_SCOPE("Deserialize");
+
+    const auto document = [&jsonStream, flags]()
+    {
+        GLTFSDK_INSTRUMENT_SCOPE("Deserialize::Parse");
+
+        return HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
+            RapidJsonUtils::CreateDocumentFromEncodedStream(jsonStream) :
+            RapidJsonUtils::CreateDocumentFromStream(jsonStream);
+    }();
 
     return DeserializeInternal(document, extensionDeserializer, schemaFlags);
 }
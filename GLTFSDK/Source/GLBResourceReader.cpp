@@ -4,6 +4,7 @@
 #include <GLTFSDK/GLBResourceReader.h>
 
 #include <GLTFSDK/Constants.h>
+#include <GLTFSDK/Instrumentation.h>
 
 #include <memory>
 #include <string.h>
@@ -94,6 +95,10 @@ const std::string& GLBResourceReader::GetJson() const
 
 void GLBResourceReader::Init()
 {
+    GLTFSDK_INSTRUMENT_SCOPE("GLBResourceReader::Init");
+
+    const auto start = IOCounters::Clock::now();
+
     // Get the length of the stream before reading anything, to validate against later
     // NOTE: The approach used below with seekg to the end and then tellg may be problematic since
     // seekg is not guaranteed to give the number of bytes from the start of the file:
@@ -147,6 +152,11 @@ void GLBResourceReader::Init()
 
     m_json = ReadJson(*m_buffer, jsonChunkLength);
 
+    // The GLB header and JSON chunk are recorded as a single read (with seeks to find the stream's length, and to the JSON)
+    GetIOCounters().AddRead(GLB_HEADER_BYTE_SIZE + jsonChunkLength, 3U, IOCounters::Clock::now() - start);
+
+    GLTFSDK_INSTRUMENT_COUNTER("GLBResourceReader::JsonBytes", jsonChunkLength);
+
     // If length is exactly equal to the json chunk length, plus the header, it means there is no binary buffer chunk
     if (length == (GLB_HEADER_BYTE_SIZE + jsonChunkLength))
     {
@@ -3,6 +3,8 @@
 
 #include <GLTFSDK/GLBResourceWriter.h>
 
+#include <GLTFSDK/Instrumentation.h>
+
 #include <sstream>
 #include <fstream>
 
@@ -61,6 +63,8 @@ void GLBResourceWriter::FlushStream(const std::string& manifest, T* stream)
         + sizeof(binaryChunkLength) + GLB_CHUNK_TYPE_SIZE // 8 bytes (BIN header)
         + binaryChunkLength;
 
+    const auto start = IOCounters::Clock::now();
+
 
     // Write GLB header (12 bytes)
     StreamUtils::WriteBinary(*stream, GLB_HEADER_MAGIC_STRING, GLB_HEADER_MAGIC_STRING_SIZE);
@@ -95,6 +99,10 @@ void GLBResourceWriter::FlushStream(const std::string& manifest, T* stream)
         // GLB spec requires the BIN chunk to be padded with trailing zeros (0x00) to satisfy alignment requirements
         StreamUtils::WriteBinary(*stream, std::vector<uint8_t>(binaryPaddingLength, 0));
     }
+
+    // The BIN chunk's contents were already counted when they were written to the temporary buffer, so only the GLB
+    // container's bytes are added - the total bytes written then equals the size of the GLB
+    m_ioCounters->AddWrite(length - (binaryChunkLength - binaryPaddingLength), IOCounters::Clock::now() - start);
 }
 
 template void GLBResourceWriter::FlushStream<std::fstream>(const std::string& manifest, std::fstream* stream);
@@ -102,6 +110,8 @@ template void GLBResourceWriter::FlushStream<std::stringstream>(const std::strin
 
 void GLBResourceWriter::Flush(const std::string& manifest, const std::string& uri)
 {
+    GLTFSDK_INSTRUMENT_SCOPE("GLBResourceWriter::Flush");
+
     auto stream = m_streamWriterCache->Get(uri);
     this->FlushStream<std::ostream>(manifest, stream.get());
 }
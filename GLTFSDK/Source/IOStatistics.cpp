@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/IOStatistics.h>
+
+#include <initializer_list>
+
+using namespace Microsoft::glTF;
+
+IOStatistics& IOStatistics::operator+=(const IOStatistics& other)
+{
+    bytesRead += other.bytesRead;
+    bytesWritten += other.bytesWritten;
+    readCount += other.readCount;
+    writeCount += other.writeCount;
+    seekCount += other.seekCount;
+    cacheHitCount += other.cacheHitCount;
+    cacheMissCount += other.cacheMissCount;
+    cacheEvictionCount += other.cacheEvictionCount;
+    base64BytesDecoded += other.base64BytesDecoded;
+    blockedTime += other.blockedTime;
+
+    return *this;
+}
+
+IOStatistics Microsoft::glTF::operator+(IOStatistics lhs, const IOStatistics& rhs)
+{
+    return lhs += rhs;
+}
+
+bool Microsoft::glTF::operator==(const IOStatistics& lhs, const IOStatistics& rhs)
+{
+    return lhs.bytesRead == rhs.bytesRead
+        && lhs.bytesWritten == rhs.bytesWritten
+        && lhs.readCount == rhs.readCount
+        && lhs.writeCount == rhs.writeCount
+        && lhs.seekCount == rhs.seekCount
+        && lhs.cacheHitCount == rhs.cacheHitCount
+        && lhs.cacheMissCount == rhs.cacheMissCount
+        && lhs.cacheEvictionCount == rhs.cacheEvictionCount
+        && lhs.base64BytesDecoded == rhs.base64BytesDecoded
+        && lhs.blockedTime == rhs.blockedTime;
+}
+
+bool Microsoft::glTF::operator!=(const IOStatistics& lhs, const IOStatistics& rhs)
+{
+    return !(lhs == rhs);
+}
+
+IOCounters::IOCounters() : IOCounters(&GetProcessCounters())
+{
+}
+
+IOCounters::IOCounters(IOCounters* parent) :
+    m_parent(parent),
+    m_bytesRead(0U),
+    m_bytesWritten(0U),
+    m_readCount(0U),
+    m_writeCount(0U),
+    m_seekCount(0U),
+    m_cacheHitCount(0U),
+    m_cacheMissCount(0U),
+    m_cacheEvictionCount(0U),
+    m_base64BytesDecoded(0U),
+    m_blockedNanoseconds(0U)
+{
+}
+
+void IOCounters::AddRead(uint64_t byteCount, uint64_t seekCount, Clock::duration blockedTime, uint64_t readCount)
+{
+    Add(&IOCounters::m_bytesRead, byteCount);
+    Add(&IOCounters::m_readCount, readCount);
+    Add(&IOCounters::m_seekCount, seekCount);
+    AddBlockedTime(blockedTime);
+}
+
+void IOCounters::AddWrite(uint64_t byteCount, Clock::duration blockedTime)
+{
+    Add(&IOCounters::m_bytesWritten, byteCount);
+    Add(&IOCounters::m_writeCount, 1U);
+    AddBlockedTime(blockedTime);
+}
+
+void IOCounters::AddCacheHit()
+{
+    Add(&IOCounters::m_cacheHitCount, 1U);
+}
+
+void IOCounters::AddCacheMiss(Clock::duration blockedTime)
+{
+    Add(&IOCounters::m_cacheMissCount, 1U);
+    AddBlockedTime(blockedTime);
+}
+
+void IOCounters::AddCacheEviction()
+{
+    Add(&IOCounters::m_cacheEvictionCount, 1U);
+}
+
+void IOCounters::AddBase64Decoded(uint64_t byteCount)
+{
+    Add(&IOCounters::m_base64BytesDecoded, byteCount);
+}
+
+IOStatistics IOCounters::GetStatistics() const
+{
+    IOStatistics statistics;
+
+    statistics.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+    statistics.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    statistics.readCount = m_readCount.load(std::memory_order_relaxed);
+    statistics.writeCount = m_writeCount.load(std::memory_order_relaxed);
+    statistics.seekCount = m_seekCount.load(std::memory_order_relaxed);
+    statistics.cacheHitCount = m_cacheHitCount.load(std::memory_order_relaxed);
+    statistics.cacheMissCount = m_cacheMissCount.load(std::memory_order_relaxed);
+    statistics.cacheEvictionCount = m_cacheEvictionCount.load(std::memory_order_relaxed);
+    statistics.base64BytesDecoded = m_base64BytesDecoded.load(std::memory_order_relaxed);
+    statistics.blockedTime = std::chrono::nanoseconds(m_blockedNanoseconds.load(std::memory_order_relaxed));
+
+    return statistics;
+}
+
+void IOCounters::Reset()
+{
+    for (auto counter : { &IOCounters::m_bytesRead, &IOCounters::m_bytesWritten, &IOCounters::m_readCount, &IOCounters::m_writeCount,
+        &IOCounters::m_seekCount, &IOCounters::m_cacheHitCount, &IOCounters::m_cacheMissCount, &IOCounters::m_cacheEvictionCount,
+        &IOCounters::m_base64BytesDecoded, &IOCounters::m_blockedNanoseconds })
+    {
+        (this->*counter).store(0U, std::memory_order_relaxed);
+    }
+}
+
+IOStatistics IOCounters::GetProcessStatistics()
+{
+    return GetProcessCounters().GetStatistics();
+}
+
+IOCounters& IOCounters::GetProcessCounters()
+{
+    static IOCounters processCounters(nullptr);
+
+    return processCounters;
+}
+
+void IOCounters::Add(std::atomic<uint64_t> IOCounters::* counter, uint64_t value)
+{
+    (this->*counter).fetch_add(value, std::memory_order_relaxed);
+
+    if (m_parent)
+    {
+        (m_parent->*counter).fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+void IOCounters::AddBlockedTime(Clock::duration blockedTime)
+{
+    Add(&IOCounters::m_blockedNanoseconds, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(blockedTime).count()));
+}
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/Instrumentation.h>
+
+#include <GLTFSDK/Exceptions.h>
+
+#include <atomic>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Instrumentation;
+
+namespace
+{
+    // The global sink is read by every instrumented scope, so it's published as a raw pointer. The shared_ptr keeps
+    // it alive until it's replaced.
+    std::shared_ptr<ISink> g_sinkOwner;
+    std::atomic<ISink*> g_sink(nullptr);
+    std::mutex g_sinkMutex;
+
+    thread_local ISink* t_sink = nullptr;
+
+    ISink* GetCurrentSink()
+    {
+        return t_sink ? t_sink : g_sink.load(std::memory_order_acquire);
+    }
+
+    int64_t ToMicroseconds(Clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+
+    // Event names are expected to be identifiers, but any character that would break the trace's JSON is escaped
+    void WriteEscaped(std::ostream& stream, const char* str)
+    {
+        for (; *str; ++str)
+        {
+            const char c = *str;
+
+            if (c == '"' || c == '\\')
+            {
+                stream << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                stream << ' ';
+            }
+            else
+            {
+                stream << c;
+            }
+        }
+    }
+}
+
+void Instrumentation::SetSink(std::shared_ptr<ISink> sink)
+{
+    std::lock_guard<std::mutex> lock(g_sinkMutex);
+
+    g_sink.store(sink.get(), std::memory_order_release);
+    g_sinkOwner = std::move(sink);
+}
+
+std::shared_ptr<ISink> Instrumentation::GetSink()
+{
+    std::lock_guard<std::mutex> lock(g_sinkMutex);
+
+    return g_sinkOwner;
+}
+
+ScopedSink::ScopedSink(std::shared_ptr<ISink> sink) : m_sink(std::move(sink)), m_previousSink(t_sink)
+{
+    t_sink = m_sink.get();
+}
+
+ScopedSink::~ScopedSink()
+{
+    t_sink = m_previousSink;
+}
+
+ScopedTimer::ScopedTimer(const char* name) : m_sink(GetCurrentSink()), m_name(name)
+{
+    if (m_sink)
+    {
+        m_start = Clock::now();
+    }
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    if (m_sink)
+    {
+        m_sink->OnScope({ m_name, m_start, Clock::now() - m_start, std::this_thread::get_id() });
+    }
+}
+
+void Instrumentation::AddCounter(const char* name, int64_t value)
+{
+    if (auto sink = GetCurrentSink())
+    {
+        sink->OnCounter({ name, value, Clock::now(), std::this_thread::get_id() });
+    }
+}
+
+CallbackSink::CallbackSink(std::function<void(const ScopeEvent&)> onScope, std::function<void(const CounterEvent&)> onCounter) :
+    m_onScope(std::move(onScope)),
+    m_onCounter(std::move(onCounter))
+{
+}
+
+void CallbackSink::OnScope(const ScopeEvent& scopeEvent)
+{
+    if (m_onScope)
+    {
+        m_onScope(scopeEvent);
+    }
+}
+
+void CallbackSink::OnCounter(const CounterEvent& counterEvent)
+{
+    if (m_onCounter)
+    {
+        m_onCounter(counterEvent);
+    }
+}
+
+void SummarySink::OnScope(const ScopeEvent& scopeEvent)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& entry = m_scopes[scopeEvent.name];
+    entry.count++;
+    entry.duration += scopeEvent.duration;
+}
+
+void SummarySink::OnCounter(const CounterEvent& counterEvent)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& entry = m_counters[counterEvent.name];
+    entry.count++;
+    entry.total += counterEvent.value;
+}
+
+std::map<std::string, SummarySink::Entry> SummarySink::GetScopes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_scopes;
+}
+
+std::map<std::string, SummarySink::Entry> SummarySink::GetCounters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_counters;
+}
+
+void SummarySink::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_scopes.clear();
+    m_counters.clear();
+}
+
+ChromeTraceSink::ChromeTraceSink(std::shared_ptr<std::ostream> stream) :
+    m_stream(std::move(stream)),
+    m_startTime(Clock::now()),
+    m_hasWrittenEvents(false)
+{
+    if (!m_stream)
+    {
+        throw GLTFException("ChromeTraceSink stream must not be null");
+    }
+}
+
+ChromeTraceSink::~ChromeTraceSink()
+{
+    try
+    {
+        Flush();
+
+        *m_stream << (m_hasWrittenEvents ? "\n]\n" : "[]\n");
+        m_stream->flush();
+    }
+    catch (...)
+    {
+        // Destructors must not throw - a failure to write the trace only loses the trace
+    }
+}
+
+void ChromeTraceSink::OnScope(const ScopeEvent& scopeEvent)
+{
+    Add(scopeEvent.name, 'X', scopeEvent.start, ToMicroseconds(scopeEvent.duration), scopeEvent.threadId);
+}
+
+void ChromeTraceSink::OnCounter(const CounterEvent& counterEvent)
+{
+    Add(counterEvent.name, 'C', counterEvent.time, counterEvent.value, counterEvent.threadId);
+}
+
+void ChromeTraceSink::Add(const char* name, char phase, Clock::time_point time, int64_t value, std::thread::id threadId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Threads are numbered in the order that they first record an event, which keeps trace ids small and stable
+    const auto itThread = m_threadIndices.emplace(threadId, m_threadIndices.size()).first;
+
+    m_events.push_back({ name, phase, ToMicroseconds(time - m_startTime), value, itThread->second });
+}
+
+void ChromeTraceSink::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& stream = *m_stream;
+
+    for (const auto& event : m_events)
+    {
+        stream << (m_hasWrittenEvents ? ",\n" : "[\n");
+        stream << "{\"name\":\"";
+        WriteEscaped(stream, event.name);
+        stream << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp << ",\"pid\":1,\"tid\":" << event.threadIndex;
+
+        if (event.phase == 'X')
+        {
+            stream << ",\"dur\":" << event.value << "}";
+        }
+        else
+        {
+            stream << ",\"args\":{\"value\":" << event.value << "}}";
+        }
+
+        m_hasWrittenEvents = true;
+    }
+
+    m_events.clear();
+    stream.flush();
+}
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/Math.h>
+
+#include <cstddef>
+
+// Column-major 4x4 matrix helpers shared by the scene graph and skinning. Not part of the public API. These are defined
+// inline as they're called once per node or joint in the hottest loops.
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Internal
+        {
+            // Multiplies column-major 4x4 matrices, output = a * b. 'output' must not alias 'a' or 'b'.
+            inline void MultiplyMatrices(const float* a, const float* b, float* output)
+            {
+                for (size_t column = 0; column < 4U; ++column)
+                {
+                    const float b0 = b[column * 4U + 0U];
+                    const float b1 = b[column * 4U + 1U];
+                    const float b2 = b[column * 4U + 2U];
+                    const float b3 = b[column * 4U + 3U];
+
+                    for (size_t row = 0; row < 4U; ++row)
+                    {
+                        output[column * 4U + row] = a[row] * b0 + a[4U + row] * b1 + a[8U + row] * b2 + a[12U + row] * b3;
+                    }
+                }
+            }
+
+            // Composes a column-major matrix from a translation, a rotation quaternion (x, y, z, w) and a scale
+            inline void ComposeMatrix(const float* t, const float* r, const float* s, float* output)
+            {
+                const float x = r[0], y = r[1], z = r[2], w = r[3];
+
+                output[0] = (1.0f - 2.0f * (y * y + z * z)) * s[0];
+                output[1] = (2.0f * (x * y + z * w)) * s[0];
+                output[2] = (2.0f * (x * z - y * w)) * s[0];
+                output[3] = 0.0f;
+
+                output[4] = (2.0f * (x * y - z * w)) * s[1];
+                output[5] = (1.0f - 2.0f * (x * x + z * z)) * s[1];
+                output[6] = (2.0f * (y * z + x * w)) * s[1];
+                output[7] = 0.0f;
+
+                output[8] = (2.0f * (x * z + y * w)) * s[2];
+                output[9] = (2.0f * (y * z - x * w)) * s[2];
+                output[10] = (1.0f - 2.0f * (x * x + y * y)) * s[2];
+                output[11] = 0.0f;
+
+                output[12] = t[0];
+                output[13] = t[1];
+                output[14] = t[2];
+                output[15] = 1.0f;
+            }
+
+            inline void ComposeMatrix(const Vector3& t, const Quaternion& r, const Vector3& s, float* output)
+            {
+                const float translation[3] = { t.x, t.y, t.z };
+                const float rotation[4] = { r.x, r.y, r.z, r.w };
+                const float scale[3] = { s.x, s.y, s.z };
+
+                ComposeMatrix(translation, rotation, scale, output);
+            }
+        }
+    }
+}
@@ -0,0 +1,431 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MemoryUsage.h>
+
+#include <GLTFSDK/Document.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <typeindex>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::MemoryUsage;
+
+namespace
+{
+    thread_local AllocationTracker* t_tracker = nullptr;
+
+    // The header that CountingAllocate stores each allocation's size in is padded to preserve malloc's alignment
+    union AllocationHeader
+    {
+        size_t byteCount;
+        std::max_align_t alignment;
+    };
+
+    // Unordered containers allocate a node per element (holding the next pointer, the value and usually the cached hash)
+    // and, once they have more than one bucket, a bucket array
+    template<typename TValue>
+    size_t GetHashNodeSize()
+    {
+        return sizeof(void*) + sizeof(TValue) + sizeof(size_t);
+    }
+
+    template<typename TContainer>
+    size_t GetBucketArraySize(const TContainer& container)
+    {
+        return container.bucket_count() > 1U ? container.bucket_count() * sizeof(void*) : 0U;
+    }
+
+    class MemoryUsageCalculator
+    {
+    public:
+        explicit MemoryUsageCalculator(DocumentMemoryUsage& usage) : m_usage(usage), m_total(0U)
+        {
+        }
+
+        void Add(const Document& document)
+        {
+            m_usage.asset = Measure([&]() { AddProperty(document.asset); AddMembers(document.asset); });
+
+            m_usage.accessors = Measure([&]() { AddContainer(document.accessors); });
+            m_usage.animations = Measure([&]() { AddContainer(document.animations); });
+            m_usage.buffers = Measure([&]() { AddContainer(document.buffers); });
+            m_usage.bufferViews = Measure([&]() { AddContainer(document.bufferViews); });
+            m_usage.cameras = Measure([&]() { AddContainer(document.cameras); });
+            m_usage.images = Measure([&]() { AddContainer(document.images); });
+            m_usage.materials = Measure([&]() { AddContainer(document.materials); });
+            m_usage.meshes = Measure([&]() { AddContainer(document.meshes); });
+            m_usage.nodes = Measure([&]() { AddContainer(document.nodes); });
+            m_usage.samplers = Measure([&]() { AddContainer(document.samplers); });
+            m_usage.scenes = Measure([&]() { AddContainer(document.scenes); });
+            m_usage.skins = Measure([&]() { AddContainer(document.skins); });
+            m_usage.textures = Measure([&]() { AddContainer(document.textures); });
+
+            m_usage.document = Measure([&]()
+            {
+                AddProperty(document);
+                AddStringSet(document.extensionsUsed);
+                AddStringSet(document.extensionsRequired);
+                AddString(document.defaultSceneId);
+            });
+        }
+
+    private:
+        template<typename Fn>
+        size_t Measure(Fn fn)
+        {
+            const size_t totalBefore = m_total;
+            fn();
+            return m_total - totalBefore;
+        }
+
+        static size_t GetStringSize(const std::string& str)
+        {
+            // Strings that are short enough are stored inline, in the string object itself
+            const auto data = reinterpret_cast<const char*>(str.data());
+            const auto object = reinterpret_cast<const char*>(&str);
+
+            return (data >= object && data < object + sizeof(std::string)) ? 0U : str.capacity() + 1U;
+        }
+
+        void AddBytes(size_t byteCount)
+        {
+            m_total += byteCount;
+        }
+
+        void AddString(const std::string& str, size_t DocumentMemoryUsage::* kind = &DocumentMemoryUsage::strings)
+        {
+            const size_t byteCount = GetStringSize(str);
+
+            m_usage.*kind += byteCount;
+            m_total += byteCount;
+        }
+
+        template<typename T>
+        void AddVector(const std::vector<T>& vector)
+        {
+            AddBytes(vector.capacity() * sizeof(T));
+        }
+
+        void AddStrings(const std::vector<std::string>& strings)
+        {
+            AddVector(strings);
+
+            for (const auto& str : strings)
+            {
+                AddString(str);
+            }
+        }
+
+        void AddStringSet(const std::unordered_set<std::string>& strings)
+        {
+            AddBytes(GetBucketArraySize(strings) + strings.size() * GetHashNodeSize<std::string>());
+
+            for (const auto& str : strings)
+            {
+                AddString(str);
+            }
+        }
+
+        void AddStringMap(const std::unordered_map<std::string, std::string>& map, size_t DocumentMemoryUsage::* kind)
+        {
+            const size_t byteCount = GetBucketArraySize(map) + map.size() * GetHashNodeSize<std::pair<const std::string, std::string>>();
+
+            m_usage.*kind += byteCount;
+            m_total += byteCount;
+
+            for (const auto& entry : map)
+            {
+                AddString(entry.first, kind);
+                AddString(entry.second, kind);
+            }
+        }
+
+        void AddProperty(const glTFProperty& property)
+        {
+            AddStringMap(property.extensions, &DocumentMemoryUsage::extensions);
+            AddString(property.extras, &DocumentMemoryUsage::extras);
+
+            const size_t registeredExtensionCount = property.GetExtensions().size();
+
+            if (registeredExtensionCount > 0U)
+            {
+                const size_t byteCount = registeredExtensionCount * (sizeof(void*) * 2U + sizeof(size_t) + sizeof(std::type_index));
+
+                m_usage.extensions += byteCount;
+                m_total += byteCount;
+            }
+        }
+
+        void AddProperty(const glTFChildOfRootProperty& property)
+        {
+            AddProperty(static_cast<const glTFProperty&>(property));
+            AddString(property.id);
+            AddString(property.name);
+        }
+
+        template<typename T>
+        void AddContainer(const IndexedContainer<const T>& container)
+        {
+            AddVector(container.Elements());
+
+            // Every element's id is copied into the container's index
+            const size_t indexedCount = container.Size();
+            AddBytes(indexedCount * (sizeof(void*) + GetHashNodeSize<std::pair<const std::string, size_t>>()));
+
+            for (const auto& element : container.Elements())
+            {
+                if (!element.id.empty())
+                {
+                    AddString(element.id);
+                }
+
+                AddProperty(element);
+                AddMembers(element);
+            }
+        }
+
+        void AddMembers(const Asset& asset)
+        {
+            AddString(asset.copyright);
+            AddString(asset.generator);
+            AddString(asset.version);
+            AddString(asset.minVersion);
+        }
+
+        void AddMembers(const Accessor& accessor)
+        {
+            AddString(accessor.bufferViewId);
+            AddVector(accessor.max);
+            AddVector(accessor.min);
+            AddString(accessor.sparse.indicesBufferViewId);
+            AddString(accessor.sparse.valuesBufferViewId);
+        }
+
+        void AddMembers(const Animation& animation)
+        {
+            AddContainer(animation.channels);
+            AddContainer(animation.samplers);
+        }
+
+        void AddMembers(const AnimationChannel& channel)
+        {
+            AddString(channel.id);
+            AddString(channel.samplerId);
+            AddProperty(channel.target);
+            AddString(channel.target.nodeId);
+        }
+
+        void AddMembers(const AnimationSampler& sampler)
+        {
+            AddString(sampler.id);
+            AddString(sampler.inputAccessorId);
+            AddString(sampler.outputAccessorId);
+        }
+
+        void AddMembers(const Buffer& buffer)
+        {
+            AddString(buffer.uri);
+        }
+
+        void AddMembers(const BufferView& bufferView)
+        {
+            AddString(bufferView.bufferId);
+        }
+
+        void AddMembers(const Camera& camera)
+        {
+            if (camera.projection)
+            {
+                AddBytes(camera.projection->GetProjectionType() == PROJECTION_PERSPECTIVE ? sizeof(Perspective) : sizeof(Orthographic));
+                AddProperty(*camera.projection);
+            }
+        }
+
+        void AddMembers(const Image& image)
+        {
+            AddString(image.uri);
+            AddString(image.mimeType);
+            AddString(image.bufferViewId);
+        }
+
+        void AddTextureInfo(const TextureInfo& textureInfo)
+        {
+            AddProperty(textureInfo);
+            AddString(textureInfo.textureId);
+        }
+
+        void AddMembers(const Material& material)
+        {
+            AddProperty(material.metallicRoughness);
+            AddTextureInfo(material.metallicRoughness.baseColorTexture);
+            AddTextureInfo(material.metallicRoughness.metallicRoughnessTexture);
+            AddTextureInfo(material.normalTexture);
+            AddTextureInfo(material.occlusionTexture);
+            AddTextureInfo(material.emissiveTexture);
+        }
+
+        void AddMembers(const Mesh& mesh)
+        {
+            AddVector(mesh.primitives);
+            AddVector(mesh.weights);
+
+            for (const auto& primitive : mesh.primitives)
+            {
+                AddProperty(primitive);
+                AddStringMap(primitive.attributes, &DocumentMemoryUsage::strings);
+                AddString(primitive.indicesAccessorId);
+                AddString(primitive.materialId);
+                AddVector(primitive.targets);
+
+                for (const auto& target : primitive.targets)
+                {
+                    AddString(target.positionsAccessorId);
+                    AddString(target.normalsAccessorId);
+                    AddString(target.tangentsAccessorId);
+                }
+            }
+        }
+
+        void AddMembers(const Node& node)
+        {
+            AddString(node.cameraId);
+            AddStrings(node.children);
+            AddString(node.skinId);
+            AddString(node.meshId);
+            AddVector(node.weights);
+        }
+
+        void AddMembers(const Sampler&)
+        {
+        }
+
+        void AddMembers(const Scene& scene)
+        {
+            AddStrings(scene.nodes);
+        }
+
+        void AddMembers(const Skin& skin)
+        {
+            AddString(skin.inverseBindMatricesAccessorId);
+            AddString(skin.skeletonId);
+            AddStrings(skin.jointIds);
+        }
+
+        void AddMembers(const Texture& texture)
+        {
+            AddString(texture.samplerId);
+            AddString(texture.imageId);
+        }
+
+        DocumentMemoryUsage& m_usage;
+        size_t m_total;
+    };
+}
+
+size_t DocumentMemoryUsage::GetTotal() const
+{
+    return asset + accessors + animations + buffers + bufferViews + cameras + images + materials + meshes + nodes + samplers + scenes + skins + textures + document;
+}
+
+DocumentMemoryUsage MemoryUsage::GetDocumentMemoryUsage(const Document& document)
+{
+    DocumentMemoryUsage usage;
+
+    MemoryUsageCalculator(usage).Add(document);
+
+    return usage;
+}
+
+AllocationTracker::AllocationTracker() :
+    m_previous(t_tracker),
+    m_currentBytes(0),
+    m_peakBytes(0),
+    m_allocationCount(0U)
+{
+    t_tracker = this;
+}
+
+AllocationTracker::~AllocationTracker()
+{
+    t_tracker = m_previous;
+}
+
+int64_t AllocationTracker::GetCurrentBytes() const
+{
+    return m_currentBytes;
+}
+
+size_t AllocationTracker::GetPeakBytes() const
+{
+    return static_cast<size_t>(m_peakBytes);
+}
+
+size_t AllocationTracker::GetAllocationCount() const
+{
+    return m_allocationCount;
+}
+
+void MemoryUsage::RecordAllocation(size_t byteCount)
+{
+    for (auto tracker = t_tracker; tracker; tracker = tracker->m_previous)
+    {
+        tracker->m_currentBytes += static_cast<int64_t>(byteCount);
+        tracker->m_peakBytes = std::max(tracker->m_peakBytes, tracker->m_currentBytes);
+        tracker->m_allocationCount++;
+    }
+}
+
+void MemoryUsage::RecordDeallocation(size_t byteCount)
+{
+    for (auto tracker = t_tracker; tracker; tracker = tracker->m_previous)
+    {
+        tracker->m_currentBytes -= static_cast<int64_t>(byteCount);
+    }
+}
+
+void* MemoryUsage::CountingAllocate(size_t byteCount)
+{
+    if (auto ptr = CountingAllocate(byteCount, std::nothrow))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* MemoryUsage::CountingAllocate(size_t byteCount, const std::nothrow_t&) noexcept
+{
+    if (byteCount > std::numeric_limits<size_t>::max() - sizeof(AllocationHeader))
+    {
+        return nullptr;
+    }
+
+    // Zero byte allocations must still return a unique pointer
+    auto header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + std::max<size_t>(byteCount, 1U)));
+
+    if (!header)
+    {
+        return nullptr;
+    }
+
+    header->byteCount = byteCount;
+
+    RecordAllocation(byteCount);
+
+    return header + 1;
+}
+
+void MemoryUsage::CountingFree(void* ptr) noexcept
+{
+    if (ptr)
+    {
+        auto header = static_cast<AllocationHeader*>(ptr) - 1;
+
+        RecordDeallocation(header->byteCount);
+
+        std::free(header);
+    }
+}
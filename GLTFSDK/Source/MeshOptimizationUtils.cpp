@@ -0,0 +1,889 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MeshOptimizationUtils.h>
+
+#include <GLTFSDK/AccessorUtils.h>
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include "MeshUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Forsyth's recommended tuning values (https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html)
+    const size_t ForsythCacheSize = 32U;
+    const float ForsythCacheDecayPower = 1.5f;
+    const float ForsythLastTriangleScore = 0.75f;
+    const float ForsythValenceBoostScale = 2.0f;
+    const float ForsythValenceBoostPower = 0.5f;
+
+    // Cache size used to find cluster boundaries in the overdraw pass, approximates common GPU FIFO caches
+    const size_t OverdrawCacheSize = 16U;
+
+    float ForsythVertexScore(int cachePosition, size_t remainingValence)
+    {
+        if (remainingValence == 0U)
+        {
+            return -1.0f; // No triangles left to emit that use this vertex
+        }
+
+        float score = 0.0f;
+
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // The vertex was used by the last triangle - fixed score to discourage long, thin strips
+                score = ForsythLastTriangleScore;
+            }
+            else
+            {
+                const float scaler = 1.0f / (ForsythCacheSize - 3U);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, ForsythCacheDecayPower);
+            }
+        }
+
+        // Boost the score of vertices with few remaining triangles so that lone triangles are not left behind
+        score += ForsythValenceBoostScale * std::pow(static_cast<float>(remainingValence), -ForsythValenceBoostPower);
+
+        return score;
+    }
+
+    // Simulates a FIFO cache of the specified size, returning the number of misses for each triangle
+    class FifoCache
+    {
+    public:
+        FifoCache(size_t vertexCount, size_t cacheSize) : m_timestamps(vertexCount, 0U), m_cacheSize(cacheSize), m_time(cacheSize + 1U)
+        {
+        }
+
+        size_t Access(uint32_t a, uint32_t b, uint32_t c)
+        {
+            return Access(a) + Access(b) + Access(c);
+        }
+
+        void Flush()
+        {
+            m_time += m_cacheSize + 1U;
+        }
+
+    private:
+        size_t Access(uint32_t vertex)
+        {
+            // A vertex is resident if fewer than m_cacheSize misses have occurred since it was inserted
+            if (m_time - m_timestamps[vertex] > m_cacheSize)
+            {
+                m_timestamps[vertex] = m_time++;
+                return 1U;
+            }
+
+            return 0U;
+        }
+
+        std::vector<size_t> m_timestamps;
+        size_t m_cacheSize;
+        size_t m_time;
+    };
+
+    // Writes accessor.count elements from 'data' (see ReadAccessorBytes) to a new accessor with 'vertexCount' elements
+    // where element i is written to position remap[i]. If several elements map to the same position the first is kept.
+    const Accessor& AddRemappedAccessor(const Accessor& accessor, const std::vector<uint8_t>& data, const std::vector<uint32_t>& remap, size_t vertexCount, BufferBuilder& bufferBuilder)
+    {
+        if (accessor.count != remap.size())
+        {
+            throw GLTFException("Accessor " + accessor.id + " count does not match the mesh primitive's vertex count");
+        }
+
+        const size_t typeCount = Accessor::GetTypeCount(accessor.type);
+        const size_t elementSize = typeCount * Accessor::GetComponentTypeSize(accessor.componentType);
+
+        // Vertex attribute elements must be aligned to 4-byte boundaries (e.g. an unsigned byte VEC3 needs padding)
+        const size_t byteStride = (elementSize + 3U) & ~static_cast<size_t>(3U);
+
+        std::vector<uint8_t> remapped(vertexCount * byteStride, 0U);
+
+        for (size_t i = accessor.count; i-- > 0U;)
+        {
+            std::memcpy(remapped.data() + remap[i] * byteStride, data.data() + i * elementSize, elementSize);
+        }
+
+        AccessorDesc desc(accessor.type, accessor.componentType, accessor.normalized);
+
+        // Merging vertices can remove the extreme values so min and max are recalculated rather than copied
+        if (!accessor.min.empty() || !accessor.max.empty())
+        {
+            auto bounds = AccessorUtils::ComputeMinMax(remapped.data(), vertexCount, byteStride, accessor.type, accessor.componentType);
+
+            desc.minValues = std::move(bounds.min);
+            desc.maxValues = std::move(bounds.max);
+        }
+
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+        if (byteStride == elementSize)
+        {
+            return bufferBuilder.AddAccessor(remapped.data(), vertexCount, std::move(desc));
+        }
+
+        bufferBuilder.AddAccessors(remapped.data(), vertexCount, byteStride, &desc, 1U);
+        return bufferBuilder.GetCurrentAccessor();
+    }
+
+    const Accessor& AddRemappedAccessor(const Document& doc, const GLTFResourceReader& reader, const std::string& accessorId, const std::vector<uint32_t>& remap, size_t vertexCount, BufferBuilder& bufferBuilder)
+    {
+        const auto& accessor = doc.accessors.Get(accessorId);
+        return AddRemappedAccessor(accessor, Internal::ReadAccessorBytes(doc, reader, accessor), remap, vertexCount, bufferBuilder);
+    }
+
+    uint64_t HashCombine(uint64_t hash, uint64_t value)
+    {
+        return hash ^ (value + 0x9E3779B97F4A7C15ULL + (hash << 6U) + (hash >> 2U));
+    }
+
+    // Computes and compares the per-vertex keys used to weld vertices
+    class VertexKeys
+    {
+    public:
+        VertexKeys(const std::vector<VertexStream>& streams, float epsilon) : m_streams(streams), m_invEpsilon(epsilon > 0.0f ? 1.0 / epsilon : 0.0)
+        {
+        }
+
+        uint64_t Hash(size_t vertex) const
+        {
+            uint64_t hash = 0U;
+
+            for (const auto& stream : m_streams)
+            {
+                const size_t componentSize = Accessor::GetComponentTypeSize(stream.componentType);
+                const uint8_t* element = stream.data + vertex * componentSize * stream.componentCount;
+
+                for (size_t c = 0; c < stream.componentCount; ++c)
+                {
+                    hash = HashCombine(hash, GetComponentKey(stream, element + c * componentSize, componentSize));
+                }
+            }
+
+            // Final avalanche (MurmurHash3 fmix64) so that the low bits are usable as a table index
+            hash ^= hash >> 33U;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33U;
+            hash *= 0xC4CEB9FE1A85EC53ULL;
+            hash ^= hash >> 33U;
+
+            return hash;
+        }
+
+        bool Equal(size_t a, size_t b) const
+        {
+            for (const auto& stream : m_streams)
+            {
+                const size_t componentSize = Accessor::GetComponentTypeSize(stream.componentType);
+                const size_t elementSize = componentSize * stream.componentCount;
+
+                const uint8_t* elementA = stream.data + a * elementSize;
+                const uint8_t* elementB = stream.data + b * elementSize;
+
+                if (m_invEpsilon == 0.0 || stream.componentType != COMPONENT_FLOAT)
+                {
+                    if (std::memcmp(elementA, elementB, elementSize) != 0)
+                    {
+                        return false;
+                    }
+
+                    continue;
+                }
+
+                for (size_t c = 0; c < stream.componentCount; ++c)
+                {
+                    if (GetComponentKey(stream, elementA + c * componentSize, componentSize) != GetComponentKey(stream, elementB + c * componentSize, componentSize))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        uint64_t GetComponentKey(const VertexStream& stream, const uint8_t* component, size_t componentSize) const
+        {
+            if (m_invEpsilon != 0.0 && stream.componentType == COMPONENT_FLOAT)
+            {
+                float value;
+                std::memcpy(&value, component, sizeof(value));
+
+                const double quantized = std::floor(value * m_invEpsilon + 0.5);
+
+                // Even keys are quantized values. Non-finite values, and those too large to quantize, fall back to their
+                // bit pattern (odd keys) so they are only merged with identical values
+                if (std::abs(quantized) < 4.0e18)
+                {
+                    return static_cast<uint64_t>(static_cast<int64_t>(quantized)) << 1U;
+                }
+            }
+
+            uint32_t bits = 0U;
+            std::memcpy(&bits, component, componentSize);
+
+            return (static_cast<uint64_t>(bits) << 1U) | 1U;
+        }
+
+        const std::vector<VertexStream>& m_streams;
+        const double m_invEpsilon;
+    };
+
+}
+
+std::vector<uint32_t> MeshOptimizationUtils::OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    const size_t triangleCount = indices.size() / 3U;
+
+    if (triangleCount == 0U)
+    {
+        return {};
+    }
+
+    // Build vertex -> triangle adjacency. Each vertex's live (not yet emitted) triangles are kept at the
+    // start of its range in 'adjacency' so that emitted triangles can be removed by swapping
+    std::vector<size_t> liveCount(vertexCount, 0U);
+
+    for (const auto index : indices)
+    {
+        ++liveCount[index];
+    }
+
+    std::vector<size_t> offsets(vertexCount + 1U, 0U);
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        offsets[i + 1U] = offsets[i] + liveCount[i];
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3U);
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    std::vector<float> triangleScores(triangleCount, 0.0f);
+    std::vector<bool> emitted(triangleCount, false);
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        vertexScores[i] = ForsythVertexScore(-1, liveCount[i]);
+    }
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        triangleScores[i / 3U] += vertexScores[indices[i]];
+    }
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+
+    cache.reserve(ForsythCacheSize + 3U);
+    nextCache.reserve(ForsythCacheSize + 3U);
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    size_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+    size_t nextUnemitted = 0U;
+
+    while (true)
+    {
+        emitted[bestTriangle] = true;
+
+        const uint32_t* triangle = &indices[bestTriangle * 3U];
+        result.insert(result.end(), triangle, triangle + 3U);
+
+        // Remove the emitted triangle from each of its vertices' live triangle lists
+        for (size_t i = 0; i < 3U; ++i)
+        {
+            const uint32_t vertex = triangle[i];
+            const auto begin = adjacency.begin() + offsets[vertex];
+            const auto end = begin + liveCount[vertex];
+            const auto it = std::find(begin, end, static_cast<uint32_t>(bestTriangle));
+
+            std::iter_swap(it, end - 1);
+            --liveCount[vertex];
+        }
+
+        // The emitted triangle's vertices move to the front of the LRU cache
+        nextCache.assign(triangle, triangle + 3U);
+
+        for (const auto vertex : cache)
+        {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+            {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        // Update the scores of every vertex whose cache position or valence changed, including those
+        // that were just evicted, and propagate the change to their live triangles
+        for (size_t i = 0; i < nextCache.size(); ++i)
+        {
+            const uint32_t vertex = nextCache[i];
+            const int cachePosition = i < ForsythCacheSize ? static_cast<int>(i) : -1;
+
+            cachePositions[vertex] = cachePosition;
+
+            const float score = ForsythVertexScore(cachePosition, liveCount[vertex]);
+            const float delta = score - vertexScores[vertex];
+
+            vertexScores[vertex] = score;
+
+            for (size_t j = offsets[vertex], end = offsets[vertex] + liveCount[vertex]; j < end; ++j)
+            {
+                triangleScores[adjacency[j]] += delta;
+            }
+        }
+
+        if (nextCache.size() > ForsythCacheSize)
+        {
+            nextCache.resize(ForsythCacheSize);
+        }
+
+        std::swap(cache, nextCache);
+
+        // The next triangle is the highest scoring live triangle that uses a vertex in the cache
+        float bestScore = -std::numeric_limits<float>::max();
+        bool found = false;
+
+        for (const auto vertex : cache)
+        {
+            for (size_t j = offsets[vertex], end = offsets[vertex] + liveCount[vertex]; j < end; ++j)
+            {
+                const uint32_t candidate = adjacency[j];
+
+                if (triangleScores[candidate] > bestScore)
+                {
+                    bestScore = triangleScores[candidate];
+                    bestTriangle = candidate;
+                    found = true;
+                }
+            }
+        }
+
+        if (!found)
+        {
+            // Nothing adjacent to the cache remains - restart from the first triangle not yet emitted
+            while (nextUnemitted < triangleCount && emitted[nextUnemitted])
+            {
+                ++nextUnemitted;
+            }
+
+            if (nextUnemitted == triangleCount)
+            {
+                break;
+            }
+
+            bestTriangle = nextUnemitted;
+        }
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> MeshOptimizationUtils::OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<float>& positions, float threshold)
+{
+    if (positions.size() % 3U != 0U)
+    {
+        throw GLTFException("Positions must contain 3 components per vertex");
+    }
+
+    const size_t vertexCount = positions.size() / 3U;
+
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    const size_t triangleCount = indices.size() / 3U;
+
+    if (triangleCount == 0U)
+    {
+        return {};
+    }
+
+    // Hard boundaries are triangles where the cache is effectively flushed (all three vertices miss)
+    std::vector<size_t> hardBoundaries;
+
+    {
+        FifoCache cache(vertexCount, OverdrawCacheSize);
+
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            if (cache.Access(indices[i * 3U], indices[i * 3U + 1U], indices[i * 3U + 2U]) == 3U)
+            {
+                hardBoundaries.push_back(i);
+            }
+        }
+
+        hardBoundaries.push_back(triangleCount);
+    }
+
+    // Split each hard cluster into smaller soft clusters whose (cold cache) miss ratio is within the threshold
+    // of the hard cluster's miss ratio - reordering clusters can then only degrade cache efficiency by that much
+    std::vector<size_t> clusters;
+
+    for (size_t h = 0; h + 1U < hardBoundaries.size(); ++h)
+    {
+        const size_t clusterBegin = hardBoundaries[h];
+        const size_t clusterEnd = hardBoundaries[h + 1U];
+
+        FifoCache cache(vertexCount, OverdrawCacheSize);
+        size_t clusterMisses = 0U;
+
+        for (size_t i = clusterBegin; i < clusterEnd; ++i)
+        {
+            clusterMisses += cache.Access(indices[i * 3U], indices[i * 3U + 1U], indices[i * 3U + 2U]);
+        }
+
+        const float thresholdRatio = threshold * clusterMisses / (clusterEnd - clusterBegin);
+
+        cache.Flush();
+
+        size_t softBegin = clusterBegin;
+        size_t softMisses = 0U;
+
+        clusters.push_back(clusterBegin);
+
+        for (size_t i = clusterBegin; i < clusterEnd; ++i)
+        {
+            softMisses += cache.Access(indices[i * 3U], indices[i * 3U + 1U], indices[i * 3U + 2U]);
+
+            const float softRatio = static_cast<float>(softMisses) / (i + 1U - softBegin);
+
+            if (softRatio <= thresholdRatio && i + 1U < clusterEnd)
+            {
+                clusters.push_back(i + 1U);
+                softBegin = i + 1U;
+                softMisses = 0U;
+                cache.Flush();
+            }
+        }
+    }
+
+    clusters.push_back(triangleCount);
+
+    Internal::Vector3f meshCentroid = { 0.0f, 0.0f, 0.0f };
+
+    for (const auto index : indices)
+    {
+        meshCentroid = meshCentroid + Internal::GetVector3(positions, index);
+    }
+
+    meshCentroid = meshCentroid * (1.0f / indices.size());
+
+    // Sort key is the distance of the cluster's area weighted centroid from the mesh centroid along the cluster's
+    // average normal. Clusters on the outside of the mesh that face outward have the largest keys and are drawn first
+    const size_t clusterCount = clusters.size() - 1U;
+
+    std::vector<float> sortKeys(clusterCount);
+
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        Internal::Vector3f centroid = { 0.0f, 0.0f, 0.0f };
+        Internal::Vector3f normal = { 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+
+        for (size_t i = clusters[c]; i < clusters[c + 1U]; ++i)
+        {
+            const auto p0 = Internal::GetVector3(positions, indices[i * 3U]);
+            const auto p1 = Internal::GetVector3(positions, indices[i * 3U + 1U]);
+            const auto p2 = Internal::GetVector3(positions, indices[i * 3U + 2U]);
+
+            const auto n = Internal::Cross(p1 - p0, p2 - p0);
+            const float triangleArea = Internal::Length(n);
+
+            centroid = centroid + (p0 + p1 + p2) * (triangleArea / 3.0f);
+            normal = normal + n;
+            area += triangleArea;
+        }
+
+        const float invArea = area == 0.0f ? 0.0f : 1.0f / area;
+
+        // A cluster whose normals cancel out has no facing and sorts with a key of zero
+        if (!Internal::Normalize(normal))
+        {
+            normal = { 0.0f, 0.0f, 0.0f };
+        }
+
+        sortKeys[c] = Internal::Dot(centroid * invArea - meshCentroid, normal);
+    }
+
+    std::vector<size_t> clusterOrder(clusterCount);
+
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        clusterOrder[c] = c;
+    }
+
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](size_t a, size_t b)
+    {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    for (const auto c : clusterOrder)
+    {
+        result.insert(result.end(), indices.begin() + clusters[c] * 3U, indices.begin() + clusters[c + 1U] * 3U);
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> MeshOptimizationUtils::OptimizeVertexFetchRemap(const std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> remap(vertexCount, unassigned);
+    uint32_t next = 0U;
+
+    for (const auto index : indices)
+    {
+        if (index >= vertexCount)
+        {
+            throw GLTFException("Index " + std::to_string(index) + " is out of range for " + std::to_string(vertexCount) + " vertices");
+        }
+
+        if (remap[index] == unassigned)
+        {
+            remap[index] = next++;
+        }
+    }
+
+    for (auto& value : remap)
+    {
+        if (value == unassigned)
+        {
+            value = next++;
+        }
+    }
+
+    return remap;
+}
+
+std::vector<uint32_t> MeshOptimizationUtils::RemapIndices(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap)
+{
+    std::vector<uint32_t> result(indices.size());
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        result[i] = remap.at(indices[i]);
+    }
+
+    return result;
+}
+
+float MeshOptimizationUtils::GetAverageCacheMissRatio(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    const size_t triangleCount = indices.size() / 3U;
+
+    if (triangleCount == 0U)
+    {
+        return 0.0f;
+    }
+
+    FifoCache cache(vertexCount, cacheSize);
+    size_t misses = 0U;
+
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        misses += cache.Access(indices[i * 3U], indices[i * 3U + 1U], indices[i * 3U + 2U]);
+    }
+
+    return static_cast<float>(misses) / triangleCount;
+}
+
+std::vector<uint32_t> MeshOptimizationUtils::GenerateVertexRemap(const std::vector<VertexStream>& streams, size_t vertexCount, size_t& uniqueVertexCount, float epsilon, size_t threadCount)
+{
+    if (vertexCount > std::numeric_limits<uint32_t>::max())
+    {
+        throw GLTFException("Vertex count exceeds the range of a 32-bit index");
+    }
+
+    for (const auto& stream : streams)
+    {
+        if (stream.componentCount == 0U || stream.componentType == COMPONENT_UNKNOWN || (stream.data == nullptr && vertexCount > 0U))
+        {
+            throw GLTFException("Invalid vertex stream");
+        }
+    }
+
+    if (threadCount == 0U)
+    {
+        threadCount = ParallelUtils::GetDefaultThreadCount();
+    }
+
+    const VertexKeys keys(streams, epsilon);
+
+    std::vector<uint64_t> hashes(vertexCount);
+
+    ParallelUtils::ParallelFor(vertexCount, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            hashes[i] = keys.Hash(i);
+        }
+    }, threadCount, 1024U);
+
+    // Vertices are partitioned into shards by hash - equal vertices always share a shard so each shard can be
+    // deduplicated independently. Within a shard vertices are visited in order so the first occurrence is kept.
+    const uint32_t empty = std::numeric_limits<uint32_t>::max();
+    const size_t shardCount = threadCount;
+
+    // Bucket the vertices by shard once: each chunk of vertices counts its shard sizes, the counts are turned into
+    // offsets, then each chunk scatters its vertex indices into 'shardVertices'. Chunks are contiguous and their
+    // offsets are assigned in order, so each shard's vertices remain in ascending order.
+    const size_t chunkCount = shardCount;
+    const size_t chunkSize = (vertexCount + chunkCount - 1U) / chunkCount;
+
+    std::vector<size_t> chunkOffsets(chunkCount * shardCount, 0U);
+
+    ParallelUtils::ParallelFor(chunkCount, [&](size_t begin, size_t end)
+    {
+        for (size_t chunk = begin; chunk < end; ++chunk)
+        {
+            size_t* counts = &chunkOffsets[chunk * shardCount];
+
+            for (size_t i = chunk * chunkSize, last = std::min(vertexCount, i + chunkSize); i < last; ++i)
+            {
+                ++counts[hashes[i] % shardCount];
+            }
+        }
+    }, chunkCount);
+
+    std::vector<size_t> shardOffsets(shardCount + 1U, 0U);
+
+    for (size_t shard = 0; shard < shardCount; ++shard)
+    {
+        size_t offset = shardOffsets[shard];
+
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            const size_t count = chunkOffsets[chunk * shardCount + shard];
+            chunkOffsets[chunk * shardCount + shard] = offset;
+            offset += count;
+        }
+
+        shardOffsets[shard + 1U] = offset;
+    }
+
+    std::vector<uint32_t> shardVertices(vertexCount);
+
+    ParallelUtils::ParallelFor(chunkCount, [&](size_t begin, size_t end)
+    {
+        for (size_t chunk = begin; chunk < end; ++chunk)
+        {
+            size_t* offsets = &chunkOffsets[chunk * shardCount];
+
+            for (size_t i = chunk * chunkSize, last = std::min(vertexCount, i + chunkSize); i < last; ++i)
+            {
+                shardVertices[offsets[hashes[i] % shardCount]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }, chunkCount);
+
+    std::vector<uint32_t> firstOccurrence(vertexCount);
+
+    ParallelUtils::ParallelFor(shardCount, [&](size_t begin, size_t end)
+    {
+        for (size_t shard = begin; shard < end; ++shard)
+        {
+            const size_t shardSize = shardOffsets[shard + 1U] - shardOffsets[shard];
+
+            size_t capacity = 16U;
+
+            while (capacity < shardSize * 2U)
+            {
+                capacity *= 2U;
+            }
+
+            const size_t mask = capacity - 1U;
+
+            std::vector<uint32_t> table(capacity, empty);
+
+            for (size_t j = shardOffsets[shard]; j < shardOffsets[shard + 1U]; ++j)
+            {
+                const uint32_t i = shardVertices[j];
+
+                size_t slot = static_cast<size_t>(hashes[i] / shardCount) & mask;
+
+                while (table[slot] != empty && !(hashes[table[slot]] == hashes[i] && keys.Equal(table[slot], i)))
+                {
+                    slot = (slot + 1U) & mask;
+                }
+
+                if (table[slot] == empty)
+                {
+                    table[slot] = i;
+                }
+
+                firstOccurrence[i] = table[slot];
+            }
+        }
+    }, shardCount);
+
+    std::vector<uint32_t> remap(vertexCount);
+    uint32_t next = 0U;
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        remap[i] = (firstOccurrence[i] == i) ? next++ : remap[firstOccurrence[i]];
+    }
+
+    uniqueVertexCount = next;
+
+    return remap;
+}
+
+MeshPrimitive MeshOptimizationUtils::WeldVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, float epsilon, size_t threadCount)
+{
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("The BufferBuilder has no buffer to write welded accessors to");
+    }
+
+    const size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
+
+    MeshPrimitive result = meshPrimitive;
+
+    // Every accessor with per-vertex data (attributes and morph targets) participates in the comparison
+    std::vector<std::string*> accessorIds;
+
+    for (auto& attribute : result.attributes)
+    {
+        accessorIds.push_back(&attribute.second);
+    }
+
+    for (auto& target : result.targets)
+    {
+        for (auto accessorId : { &target.positionsAccessorId, &target.normalsAccessorId, &target.tangentsAccessorId })
+        {
+            if (!accessorId->empty())
+            {
+                accessorIds.push_back(accessorId);
+            }
+        }
+    }
+
+    // Each accessor is read once, in its original component type, and the data is reused when writing the welded accessors
+    std::vector<std::vector<uint8_t>> data;
+    std::vector<VertexStream> streams;
+
+    data.reserve(accessorIds.size());
+    streams.reserve(accessorIds.size());
+
+    for (const auto accessorId : accessorIds)
+    {
+        const auto& accessor = doc.accessors.Get(*accessorId);
+
+        if (accessor.count != vertexCount)
+        {
+            throw GLTFException("Accessor " + accessor.id + " count does not match the mesh primitive's vertex count");
+        }
+
+        data.push_back(Internal::ReadAccessorBytes(doc, reader, accessor));
+        streams.emplace_back(data.back().data(), accessor.componentType, Accessor::GetTypeCount(accessor.type));
+    }
+
+    size_t uniqueVertexCount = 0U;
+    const auto remap = GenerateVertexRemap(streams, vertexCount, uniqueVertexCount, epsilon, threadCount);
+
+    const auto indices = meshPrimitive.indicesAccessorId.empty() ? remap : RemapIndices(MeshPrimitiveUtils::GetIndices32(doc, reader, meshPrimitive), remap);
+
+    result.indicesAccessorId = Internal::AddIndicesAccessor(indices, uniqueVertexCount, bufferBuilder).id;
+
+    for (size_t i = 0; i < accessorIds.size(); ++i)
+    {
+        *accessorIds[i] = AddRemappedAccessor(doc.accessors.Get(*accessorIds[i]), data[i], remap, uniqueVertexCount, bufferBuilder).id;
+    }
+
+    return result;
+}
+
+MeshPrimitive MeshOptimizationUtils::OptimizeMeshPrimitive(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const MeshOptimizationOptions& options)
+{
+    Internal::ValidateTriangleMode(meshPrimitive, "optimized");
+
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("The BufferBuilder has no buffer to write optimized accessors to");
+    }
+
+    const size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
+
+    auto indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+
+    if (options.optimizeVertexCache)
+    {
+        indices = OptimizeVertexCache(indices, vertexCount);
+    }
+
+    if (options.optimizeOverdraw)
+    {
+        indices = OptimizeOverdraw(indices, MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive), options.overdrawThreshold);
+    }
+
+    std::vector<uint32_t> remap;
+
+    if (options.optimizeVertexFetch)
+    {
+        remap = OptimizeVertexFetchRemap(indices, vertexCount);
+        indices = RemapIndices(indices, remap);
+    }
+    else
+    {
+        remap.resize(vertexCount);
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            remap[i] = static_cast<uint32_t>(i);
+        }
+    }
+
+    MeshPrimitive result = meshPrimitive;
+
+    result.mode = MESH_TRIANGLES;
+    result.indicesAccessorId = Internal::AddIndicesAccessor(indices, vertexCount, bufferBuilder).id;
+
+    for (auto& attribute : result.attributes)
+    {
+        attribute.second = AddRemappedAccessor(doc, reader, attribute.second, remap, vertexCount, bufferBuilder).id;
+    }
+
+    for (auto& target : result.targets)
+    {
+        for (auto accessorId : { &target.positionsAccessorId, &target.normalsAccessorId, &target.tangentsAccessorId })
+        {
+            if (!accessorId->empty())
+            {
+                *accessorId = AddRemappedAccessor(doc, reader, *accessorId, remap, vertexCount, bufferBuilder).id;
+            }
+        }
+    }
+
+    return result;
+}
@@ -6,8 +6,14 @@
 #include <GLTFSDK/GLTF.h>
 #include <GLTFSDK/GLTFResourceReader.h>
 #include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Math.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <numeric>
 
 using namespace Microsoft::glTF;
@@ -50,146 +56,280 @@ namespace
         return std::vector<TOut>(indices.begin(), indices.end());
     }
 
-    std::vector<uint32_t> PackColorsRGBA(const std::vector<float>& colors)
+    inline uint8_t ToByte(uint8_t value)
     {
-        assert(colors.size() % 4 == 0);
+        return value;
+    }
+
+    inline uint8_t ToByte(float value)
+    {
+        return Math::FloatToByte(value);
+    }
+
+    // The pack and unpack kernels below size their output up front, write it by index and have a component count
+    // that is known at compile time. Unlike per-element push_back calls this lets the compiler vectorize the loops.
+    template<size_t ComponentCount, typename T>
+    std::vector<uint32_t> PackBytes32(const std::vector<T>& data)
+    {
+        static_assert(ComponentCount == 3U || ComponentCount == 4U, "Only 3 or 4 components can be packed into 32-bits");
+        assert(data.size() % ComponentCount == 0);
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 4);
+        const size_t count = data.size() / ComponentCount;
 
-        for (size_t i = 0; i < colors.size(); i += 4)
+        std::vector<uint32_t> packed(count);
+
+        const T* src = data.data();
+        uint32_t* dst = packed.data();
+
+        for (size_t i = 0; i < count; ++i, src += ComponentCount)
         {
-            colors32.push_back(Color4(colors[i], colors[i + 1], colors[i + 2], colors[i + 3]).AsUint32RGBA());
+            // Three component data (i.e. RGB colors) is packed with an opaque alpha
+            const uint8_t byte3 = ComponentCount == 4U ? ToByte(src[ComponentCount - 1U]) : std::numeric_limits<uint8_t>::max();
+
+            dst[i] = ToUint32(ToByte(src[0]), ToByte(src[1]), ToByte(src[2]), byte3);
         }
 
-        return colors32;
+        return packed;
+    }
+
+    template<typename T>
+    std::vector<uint32_t> PackColorsRGBA(const std::vector<T>& colors)
+    {
+        return PackBytes32<4U>(colors);
+    }
+
+    template<typename T>
+    std::vector<uint32_t> PackColorsRGB(const std::vector<T>& colors)
+    {
+        return PackBytes32<3U>(colors);
+    }
+
+    std::vector<uint32_t> ReadJoints32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    {
+        return PackBytes32<4U>(reader.ReadBinaryData<uint8_t>(doc, accessor));
     }
 
-    std::vector<uint32_t> PackColorsRGB(const std::vector<float>& colors)
+    template<typename T>
+    std::vector<uint64_t> ReadJoints64(const std::vector<T>& joints)
     {
-        assert(colors.size() % 3 == 0);
+        assert(joints.size() % 4 == 0);
+
+        const size_t count = joints.size() / 4U;
+
+        std::vector<uint64_t> joints64(count);
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 3);
+        const T* src = joints.data();
+        uint64_t* dst = joints64.data();
 
-        for (size_t i = 0; i < colors.size(); i += 3)
+        for (size_t i = 0; i < count; ++i, src += 4U)
         {
-            colors32.push_back(Color4(colors[i], colors[i + 1], colors[i + 2], 1.0f).AsUint32RGBA());
+            dst[i] = ToUint64(src[0], src[1], src[2], src[3]);
         }
 
-        return colors32;
+        return joints64;
     }
 
-    std::vector<uint32_t> PackColorsRGBA(const std::vector<uint8_t>& colors)
+    template<typename T>
+    std::vector<uint64_t> ReadJoints64(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
     {
-        assert(colors.size() % 4 == 0);
+        return ReadJoints64(reader.ReadBinaryData<T>(doc, accessor));
+    }
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 4);
+    template<typename T>
+    std::vector<uint32_t> PackWeights32(const std::vector<T>& weights)
+    {
+        return PackBytes32<4U>(weights);
+    }
 
-        for (size_t i = 0; i < colors.size(); i += 4)
+    // Splits VEC4 elements into four separate streams, e.g. for the joint influences of a CPU skinning loop
+    template<typename TOut, typename TIn, typename FnDecode>
+    std::array<std::vector<TOut>, 4> Deinterleave4(const std::vector<TIn>& data, FnDecode fnDecode)
+    {
+        assert(data.size() % 4 == 0);
+
+        const size_t count = data.size() / 4U;
+
+        std::array<std::vector<TOut>, 4> streams;
+
+        for (auto& stream : streams)
+        {
+            stream.resize(count);
+        }
+
+        const TIn* src = data.data();
+
+        TOut* dst0 = streams[0].data();
+        TOut* dst1 = streams[1].data();
+        TOut* dst2 = streams[2].data();
+        TOut* dst3 = streams[3].data();
+
+        for (size_t i = 0; i < count; ++i, src += 4U)
         {
-            uint8_t r = colors[i];
-            uint8_t g = colors[i + 1];
-            uint8_t b = colors[i + 2];
-            uint8_t a = colors[i + 3];
-            uint32_t rgba = ToUint32(r, g, b, a);
-            colors32.push_back(rgba);
+            dst0[i] = fnDecode(src[0]);
+            dst1[i] = fnDecode(src[1]);
+            dst2[i] = fnDecode(src[2]);
+            dst3[i] = fnDecode(src[3]);
         }
 
-        return colors32;
+        return streams;
     }
 
-    std::vector<uint32_t> PackColorsRGB(const std::vector<uint8_t>& colors)
+    template<typename T>
+    std::array<std::vector<uint16_t>, 4> ReadJointsSoA(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
     {
-        assert(colors.size() % 3 == 0);
+        return Deinterleave4<uint16_t>(reader.ReadBinaryData<T>(doc, accessor), [](T joint) { return static_cast<uint16_t>(joint); });
+    }
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 3);
+    template<typename T>
+    std::array<std::vector<float>, 4> ReadWeightsSoA(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    {
+        const auto weights = reader.ReadBinaryData<T>(doc, accessor);
 
-        for (size_t i = 0; i < colors.size(); i += 3)
+        // The normalization test is made once rather than per component so that each loop remains branch free
+        if (accessor.normalized)
         {
-            uint8_t r = colors[i];
-            uint8_t g = colors[i + 1];
-            uint8_t b = colors[i + 2];
-            uint32_t rgba = ToUint32(r, g, b, 255);
-            colors32.push_back(rgba);
+            return Deinterleave4<float>(weights, [](T weight) { return ComponentToFloat(weight); });
         }
 
-        return colors32;
+        return Deinterleave4<float>(weights, [](T weight) { return static_cast<float>(weight); });
     }
 
-    std::vector<uint32_t> ReadJoints32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    inline float DecodeComponent(float value, bool)
+    {
+        return value;
+    }
+
+    inline float DecodeComponent(uint32_t value, bool)
     {
-        std::vector<uint8_t> joints = reader.ReadBinaryData<uint8_t>(doc, accessor);
-        std::vector<uint32_t> joints32;
-        joints32.reserve(joints.size() / 4);
-        for (size_t i = 0; i < joints.size(); i += 4)
+        return static_cast<float>(value); // Normalized unsigned int accessors aren't permitted by the spec
+    }
+
+    template<typename T>
+    inline float DecodeComponent(T value, bool normalized)
+    {
+        return normalized ? ComponentToFloat(value) : static_cast<float>(value);
+    }
+
+    template<typename T>
+    inline T EncodeNormalized(float value, float lo)
+    {
+        return static_cast<T>(std::round(Math::Clamp(value, lo, 1.0f) * std::numeric_limits<T>::max()));
+    }
+
+    template<typename T>
+    inline T EncodeInteger(float value)
+    {
+        // Clamp in double as the maximum value of uint32_t isn't representable as a float (it rounds up to 2^32, which
+        // can't be converted back). NaN encodes as zero.
+        if (!(value > 0.0f))
         {
-            joints32.push_back(ToUint32(joints[i], joints[i + 1], joints[i + 2], joints[i + 3]));
+            return 0;
         }
-        return joints32;
+
+        return static_cast<T>(std::min(static_cast<double>(value), static_cast<double>(std::numeric_limits<T>::max())));
     }
 
-    std::vector<uint64_t> ReadJoints64(const std::vector<uint8_t>& joints)
+    // Writes 'count' vertices worth of a single element, TSrc is the accessor's component type and TDst the
+    // layout element's storage type. Components missing from the source are filled from (0, 0, 0, 1).
+    template<typename TSrc, typename TDst, typename FnEncode>
+    void WriteVertexElement(const TSrc* src, size_t srcComponentCount, bool normalized, size_t count,
+        uint8_t* dst, size_t dstComponentCount, size_t byteStride, FnEncode fnEncode)
     {
-        std::vector<uint64_t> joints64;
-        joints64.reserve(joints.size() / 4);
-        for (size_t i = 0; i < joints.size(); i += 4)
+        static const float defaults[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        TDst encoded[4] = {};
+
+        // Default components are identical for every vertex so encode them just once
+        for (size_t c = srcComponentCount; c < dstComponentCount; ++c)
         {
-            joints64.push_back(ToUint64(joints[i], joints[i + 1], joints[i + 2], joints[i + 3]));
+            encoded[c] = fnEncode(defaults[c]);
+        }
+
+        const size_t copyCount = std::min(srcComponentCount, dstComponentCount);
+
+        for (size_t i = 0; i < count; ++i, src += srcComponentCount, dst += byteStride)
+        {
+            for (size_t c = 0; c < copyCount; ++c)
+            {
+                encoded[c] = fnEncode(DecodeComponent(src[c], normalized));
+            }
+
+            // The destination may not be suitably aligned for TDst so copy bytes rather than casting the pointer
+            std::memcpy(dst, encoded, sizeof(TDst) * dstComponentCount);
         }
-        return joints64;
     }
 
-    std::vector<uint64_t> ReadJoints64(const std::vector<uint16_t>& joints)
+    template<typename TSrc>
+    void WriteVertexElement(const TSrc* src, size_t srcComponentCount, bool normalized, size_t count,
+        uint8_t* dst, const VertexElement& element, size_t byteStride)
     {
-        std::vector<uint64_t> joints64;
-        joints64.reserve(joints.size() / 4);
-        for (size_t i = 0; i < joints.size(); i += 4)
+        const size_t dstComponentCount = element.componentCount;
+
+        switch (element.format)
         {
-            joints64.push_back(ToUint64(joints[i], joints[i + 1], joints[i + 2], joints[i + 3]));
+        case VERTEX_FORMAT_FLOAT32:
+            WriteVertexElement<TSrc, float>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, [](float v) { return v; });
+            break;
+        case VERTEX_FORMAT_FLOAT16:
+            WriteVertexElement<TSrc, uint16_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, Math::FloatToHalf);
+            break;
+        case VERTEX_FORMAT_UNORM8:
+            WriteVertexElement<TSrc, uint8_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, [](float v) { return EncodeNormalized<uint8_t>(v, 0.0f); });
+            break;
+        case VERTEX_FORMAT_SNORM8:
+            WriteVertexElement<TSrc, int8_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, [](float v) { return EncodeNormalized<int8_t>(v, -1.0f); });
+            break;
+        case VERTEX_FORMAT_UNORM16:
+            WriteVertexElement<TSrc, uint16_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, [](float v) { return EncodeNormalized<uint16_t>(v, 0.0f); });
+            break;
+        case VERTEX_FORMAT_SNORM16:
+            WriteVertexElement<TSrc, int16_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, [](float v) { return EncodeNormalized<int16_t>(v, -1.0f); });
+            break;
+        case VERTEX_FORMAT_UINT8:
+            WriteVertexElement<TSrc, uint8_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, EncodeInteger<uint8_t>);
+            break;
+        case VERTEX_FORMAT_UINT16:
+            WriteVertexElement<TSrc, uint16_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, EncodeInteger<uint16_t>);
+            break;
+        case VERTEX_FORMAT_UINT32:
+            WriteVertexElement<TSrc, uint32_t>(src, srcComponentCount, normalized, count, dst, dstComponentCount, byteStride, EncodeInteger<uint32_t>);
+            break;
+        default:
+            throw GLTFException("Invalid vertex format for element " + element.attributeName);
         }
-        return joints64;
     }
 
-    template<typename T>
-    std::vector<uint64_t> ReadJoints64(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    template<typename TSrc>
+    void WriteVertexElement(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint8_t* dst, const VertexElement& element, size_t byteStride)
     {
-        std::vector<T> joints = reader.ReadBinaryData<T>(doc, accessor);
-        return ReadJoints64(joints);
+        // The accessor's data is read straight from its buffer view in chunks, in its native component type, and
+        // converted while being interleaved
+        reader.ReadBinaryDataChunked<TSrc>(doc, accessor, [&](const TSrc* src, size_t count)
+        {
+            WriteVertexElement(src, Accessor::GetTypeCount(accessor.type), accessor.normalized, count, dst, element, byteStride);
+            dst += count * byteStride;
+        });
     }
 
-    std::vector<uint32_t> PackWeights32(const std::vector<float>& weights)
+    void ValidateVertexLayout(const VertexLayout& layout)
     {
-        std::vector<uint32_t> weights32;
-        weights32.reserve(weights.size() / 4);
-        for (size_t i = 0; i < weights.size(); i += 4)
+        if (layout.byteStride == 0U)
         {
-            weights32.push_back(
-                ToUint32(
-                    Math::FloatToByte(weights[i]),
-                    Math::FloatToByte(weights[i + 1]),
-                    Math::FloatToByte(weights[i + 2]),
-                    Math::FloatToByte(weights[i + 3])));
+            throw GLTFException("Vertex layout byte stride must be greater than zero");
         }
-        return weights32;
-    }
 
-    std::vector<uint32_t> PackWeights32(const std::vector<uint8_t>& weights)
-    {
-        std::vector<uint32_t> weights32;
-        weights32.reserve(weights.size() / 4);
-        for (size_t i = 0; i < weights.size(); i += 4)
+        for (const auto& element : layout.elements)
         {
-            weights32.push_back(
-                ToUint32(
-                    weights[i],
-                    weights[i + 1],
-                    weights[i + 2],
-                    weights[i + 3]));
+            if (element.componentCount == 0U || element.componentCount > 4U)
+            {
+                throw GLTFException("Vertex element " + element.attributeName + " must have between 1 and 4 components");
+            }
+
+            if (element.byteOffset + element.componentCount * MeshPrimitiveUtils::GetVertexFormatSize(element.format) > layout.byteStride)
+            {
+                throw GLTFException("Vertex element " + element.attributeName + " does not fit within the layout's byte stride");
+            }
         }
-        return weights32;
     }
 
     template<typename T>
@@ -844,6 +984,165 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetJointWeights32_0(const Document& do
     return GetJointWeights32(doc, reader, accessor);
 }
 
+// Joints and weights (structure-of-arrays)
+std::array<std::vector<uint16_t>, 4> MeshPrimitiveUtils::GetJointIndicesSoA(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor)
+{
+    if (jointsAccessor.type != TYPE_VEC4)
+    {
+        throw GLTFException("Invalid type for joints accessor " + jointsAccessor.id);
+    }
+
+    switch (jointsAccessor.componentType)
+    {
+    case COMPONENT_UNSIGNED_BYTE:
+        return ReadJointsSoA<uint8_t>(doc, reader, jointsAccessor);
+
+    case COMPONENT_UNSIGNED_SHORT:
+        return ReadJointsSoA<uint16_t>(doc, reader, jointsAccessor);
+
+    default:
+        throw GLTFException("Invalid componentType for joints accessor " + jointsAccessor.id);
+    }
+}
+
+std::array<std::vector<uint16_t>, 4> MeshPrimitiveUtils::GetJointIndicesSoA_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_JOINTS_0));
+    return GetJointIndicesSoA(doc, reader, accessor);
+}
+
+std::array<std::vector<float>, 4> MeshPrimitiveUtils::GetJointWeightsSoA(const Document& doc, const GLTFResourceReader& reader, const Accessor& weightsAccessor)
+{
+    if (weightsAccessor.type != TYPE_VEC4)
+    {
+        throw GLTFException("Invalid type for weights accessor " + weightsAccessor.id);
+    }
+
+    switch (weightsAccessor.componentType)
+    {
+    case COMPONENT_FLOAT:
+        return ReadWeightsSoA<float>(doc, reader, weightsAccessor);
+
+    case COMPONENT_UNSIGNED_BYTE:
+        return ReadWeightsSoA<uint8_t>(doc, reader, weightsAccessor);
+
+    case COMPONENT_UNSIGNED_SHORT:
+        return ReadWeightsSoA<uint16_t>(doc, reader, weightsAccessor);
+
+    default:
+        throw GLTFException("Invalid component type for weights accessor " + weightsAccessor.id);
+    }
+}
+
+std::array<std::vector<float>, 4> MeshPrimitiveUtils::GetJointWeightsSoA_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_WEIGHTS_0));
+    return GetJointWeightsSoA(doc, reader, accessor);
+}
+
+// Interleaved vertices
+size_t MeshPrimitiveUtils::GetVertexFormatSize(VertexFormat format)
+{
+    switch (format)
+    {
+    case VERTEX_FORMAT_UNORM8:
+    case VERTEX_FORMAT_SNORM8:
+    case VERTEX_FORMAT_UINT8:
+        return 1U;
+
+    case VERTEX_FORMAT_FLOAT16:
+    case VERTEX_FORMAT_UNORM16:
+    case VERTEX_FORMAT_SNORM16:
+    case VERTEX_FORMAT_UINT16:
+        return 2U;
+
+    case VERTEX_FORMAT_FLOAT32:
+    case VERTEX_FORMAT_UINT32:
+        return 4U;
+
+    default:
+        throw GLTFException("Unknown vertex format " + std::to_string(format));
+    }
+}
+
+std::vector<uint8_t> MeshPrimitiveUtils::GetInterleavedVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const VertexLayout& layout)
+{
+    const size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
+
+    std::vector<uint8_t> vertices(vertexCount * layout.byteStride);
+    GetInterleavedVertices(doc, reader, meshPrimitive, layout, vertices.data(), vertices.size());
+    return vertices;
+}
+
+void MeshPrimitiveUtils::GetInterleavedVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const VertexLayout& layout, void* vertices, size_t verticesByteLength)
+{
+    ValidateVertexLayout(layout);
+
+    const size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
+
+    if (verticesByteLength < vertexCount * layout.byteStride)
+    {
+        throw GLTFException("Output buffer is too small for " + std::to_string(vertexCount) + " interleaved vertices");
+    }
+
+    uint8_t* const output = static_cast<uint8_t*>(vertices);
+
+    for (const auto& element : layout.elements)
+    {
+        uint8_t* const dst = output + element.byteOffset;
+
+        std::string accessorId;
+
+        if (!meshPrimitive.TryGetAttributeAccessorId(element.attributeName, accessorId))
+        {
+            if (element.required)
+            {
+                throw GLTFException("Mesh primitive has no attribute named " + element.attributeName);
+            }
+
+            // An empty source writes only default values
+            WriteVertexElement<float>(nullptr, 0U, false, vertexCount, dst, element, layout.byteStride);
+            continue;
+        }
+
+        const auto& accessor = doc.accessors.Get(accessorId);
+
+        if (accessor.count != vertexCount)
+        {
+            throw GLTFException("Accessor " + accessor.id + " count does not match the mesh primitive's vertex count");
+        }
+
+        if (accessor.type == TYPE_UNKNOWN || accessor.type >= TYPE_MAT2)
+        {
+            throw GLTFException("Invalid type for vertex element accessor " + accessor.id);
+        }
+
+        switch (accessor.componentType)
+        {
+        case COMPONENT_BYTE:
+            WriteVertexElement<int8_t>(doc, reader, accessor, dst, element, layout.byteStride);
+            break;
+        case COMPONENT_UNSIGNED_BYTE:
+            WriteVertexElement<uint8_t>(doc, reader, accessor, dst, element, layout.byteStride);
+            break;
+        case COMPONENT_SHORT:
+            WriteVertexElement<int16_t>(doc, reader, accessor, dst, element, layout.byteStride);
+            break;
+        case COMPONENT_UNSIGNED_SHORT:
+            WriteVertexElement<uint16_t>(doc, reader, accessor, dst, element, layout.byteStride);
+            break;
+        case COMPONENT_UNSIGNED_INT:
+            WriteVertexElement<uint32_t>(doc, reader, accessor, dst, element, layout.byteStride);
+            break;
+        case COMPONENT_FLOAT:
+            WriteVertexElement<float>(doc, reader, accessor, dst, element, layout.byteStride);
+            break;
+        default:
+            throw GLTFException("Invalid componentType for vertex element accessor " + accessor.id);
+        }
+    }
+}
+
 std::vector<uint16_t> MeshPrimitiveUtils::ReverseTriangulateIndices16(const uint16_t* indices, size_t indexCount, MeshMode mode)
 {
     return ReverseTriangulateIndices(indices, indexCount, mode);
@@ -0,0 +1,492 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MeshSimplificationUtils.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshOptimizationUtils.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+
+#include "MeshUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    using Internal::Vector3d;
+
+    // Symmetric 4x4 matrix representing the weighted sum of squared distances to a set of planes, along with the sum of
+    // the weights so that the error can be evaluated as a weighted mean squared distance
+    struct Quadric
+    {
+        double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+        double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+        double a22 = 0.0, a23 = 0.0;
+        double a33 = 0.0;
+        double weight = 0.0;
+
+        void AddPlane(const Vector3d& n, double d, double weight)
+        {
+            a00 += weight * n.x * n.x; a01 += weight * n.x * n.y; a02 += weight * n.x * n.z; a03 += weight * n.x * d;
+            a11 += weight * n.y * n.y; a12 += weight * n.y * n.z; a13 += weight * n.y * d;
+            a22 += weight * n.z * n.z; a23 += weight * n.z * d;
+            a33 += weight * d * d;
+            this->weight += weight;
+        }
+
+        Quadric& operator+=(const Quadric& q)
+        {
+            a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+            a11 += q.a11; a12 += q.a12; a13 += q.a13;
+            a22 += q.a22; a23 += q.a23;
+            a33 += q.a33;
+            weight += q.weight;
+            return *this;
+        }
+
+        double Evaluate(const Vector3d& p) const
+        {
+            const double error =
+                a00 * p.x * p.x + 2.0 * a01 * p.x * p.y + 2.0 * a02 * p.x * p.z + 2.0 * a03 * p.x +
+                a11 * p.y * p.y + 2.0 * a12 * p.y * p.z + 2.0 * a13 * p.y +
+                a22 * p.z * p.z + 2.0 * a23 * p.z +
+                a33;
+
+            // Normalizing by the accumulated weight makes this the area weighted mean squared distance, regardless of the
+            // (area based) weights, so it can be compared against the squared target root mean square error
+            return weight > 0.0 ? std::max(error / weight, 0.0) : 0.0; // Guard against small negative values caused by rounding
+        }
+    };
+
+    struct Collapse
+    {
+        double cost;
+        uint32_t from;
+        uint32_t to;
+
+        bool operator<(const Collapse& other) const
+        {
+            return cost < other.cost || (cost == other.cost && (from < other.from || (from == other.from && to < other.to)));
+        }
+    };
+
+    // Vertices are grouped by their most influential joint so that collapses don't transfer vertices between bones
+    std::vector<uint32_t> GetDominantJoints(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, size_t vertexCount)
+    {
+        std::string weightsAccessorId;
+
+        if (!meshPrimitive.HasAttribute(ACCESSOR_JOINTS_0) || !meshPrimitive.TryGetAttributeAccessorId(ACCESSOR_WEIGHTS_0, weightsAccessorId))
+        {
+            return {};
+        }
+
+        const auto joints = MeshPrimitiveUtils::GetJointIndices64_0(doc, reader, meshPrimitive);
+        const auto weights = reader.ReadFloatData(doc, doc.accessors.Get(weightsAccessorId));
+
+        if (joints.size() != vertexCount || weights.size() != vertexCount * 4U)
+        {
+            throw GLTFException("Skinning attribute accessor counts do not match the mesh primitive's vertex count");
+        }
+
+        std::vector<uint32_t> dominantJoints(vertexCount);
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            const auto begin = weights.begin() + i * 4U;
+            const auto influence = static_cast<uint32_t>(std::max_element(begin, begin + 4U) - begin);
+
+            dominantJoints[i] = static_cast<uint32_t>((joints[i] >> (16U * influence)) & 0xFFFFU);
+        }
+
+        return dominantJoints;
+    }
+}
+
+std::vector<uint32_t> MeshSimplificationUtils::Simplify(const std::vector<uint32_t>& indices, const std::vector<float>& positions, size_t targetIndexCount, float targetRmsError,
+    float* resultRmsError, const std::vector<uint32_t>& vertexGroups)
+{
+    if (positions.size() % 3U != 0U)
+    {
+        throw GLTFException("Positions must contain 3 components per vertex");
+    }
+
+    const size_t vertexCount = positions.size() / 3U;
+
+    if (!vertexGroups.empty() && vertexGroups.size() != vertexCount)
+    {
+        throw GLTFException("The number of vertex groups must match the number of vertices");
+    }
+
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    if (resultRmsError)
+    {
+        *resultRmsError = 0.0f;
+    }
+
+    if (indices.size() <= targetIndexCount)
+    {
+        return indices;
+    }
+
+    // Positions are scaled so that the mesh's largest dimension is 1 - errors are then relative to the mesh size
+    float minValues[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    float maxValues[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+    for (const auto index : indices)
+    {
+        for (size_t c = 0; c < 3U; ++c)
+        {
+            minValues[c] = std::min(minValues[c], positions[index * 3U + c]);
+            maxValues[c] = std::max(maxValues[c], positions[index * 3U + c]);
+        }
+    }
+
+    const double extent = std::max({ maxValues[0] - minValues[0], maxValues[1] - minValues[1], maxValues[2] - minValues[2] });
+    const double scale = extent > 0.0 ? 1.0 / extent : 1.0;
+
+    std::vector<Vector3d> points(vertexCount);
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        points[i] = {
+            (positions[i * 3U] - minValues[0]) * scale,
+            (positions[i * 3U + 1U] - minValues[1]) * scale,
+            (positions[i * 3U + 2U] - minValues[2]) * scale
+        };
+    }
+
+    // Lock vertices that share a position with another vertex (attribute seams)
+    std::vector<bool> locked(vertexCount, false);
+
+    {
+        const std::vector<VertexStream> streams = { { positions.data(), COMPONENT_FLOAT, 3U } };
+
+        size_t uniquePositionCount = 0U;
+        const auto positionRemap = MeshOptimizationUtils::GenerateVertexRemap(streams, vertexCount, uniquePositionCount, 0.0f, 1U);
+
+        std::vector<uint32_t> positionUseCount(uniquePositionCount, 0U);
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            ++positionUseCount[positionRemap[i]];
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            locked[i] = positionUseCount[positionRemap[i]] > 1U;
+        }
+    }
+
+    // Lock vertices on border edges (edges without a matching opposite half-edge)
+    {
+        std::unordered_set<uint64_t> halfEdges;
+
+        auto makeEdge = [](uint32_t a, uint32_t b)
+        {
+            return (static_cast<uint64_t>(a) << 32U) | b;
+        };
+
+        for (size_t i = 0; i < indices.size(); i += 3U)
+        {
+            for (size_t e = 0; e < 3U; ++e)
+            {
+                halfEdges.insert(makeEdge(indices[i + e], indices[i + (e + 1U) % 3U]));
+            }
+        }
+
+        for (size_t i = 0; i < indices.size(); i += 3U)
+        {
+            for (size_t e = 0; e < 3U; ++e)
+            {
+                const uint32_t a = indices[i + e];
+                const uint32_t b = indices[i + (e + 1U) % 3U];
+
+                if (halfEdges.find(makeEdge(b, a)) == halfEdges.end())
+                {
+                    locked[a] = true;
+                    locked[b] = true;
+                }
+            }
+        }
+    }
+
+    // Accumulate the area weighted plane quadric of every triangle at its vertices
+    std::vector<Quadric> quadrics(vertexCount);
+
+    for (size_t i = 0; i < indices.size(); i += 3U)
+    {
+        const auto& p0 = points[indices[i]];
+        const auto& p1 = points[indices[i + 1U]];
+        const auto& p2 = points[indices[i + 2U]];
+
+        Vector3d normal = Cross(p1 - p0, p2 - p0);
+        const double length = Length(normal);
+
+        if (length == 0.0)
+        {
+            continue;
+        }
+
+        normal = { normal.x / length, normal.y / length, normal.z / length };
+
+        Quadric quadric;
+        quadric.AddPlane(normal, -Dot(normal, p0), length * 0.5);
+
+        for (size_t j = 0; j < 3U; ++j)
+        {
+            quadrics[indices[i + j]] += quadric;
+        }
+    }
+
+    const double maxCost = static_cast<double>(targetRmsError) * targetRmsError;
+    double achievedCost = 0.0;
+
+    std::vector<uint32_t> result = indices;
+
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<bool> removed(vertexCount, false);
+    std::vector<bool> changed(vertexCount);
+    std::vector<Collapse> collapses;
+    std::vector<size_t> offsets(vertexCount + 1U);
+    std::vector<uint32_t> adjacency;
+
+    while (result.size() > targetIndexCount)
+    {
+        // Gather the cheapest permitted collapses along every edge
+        collapses.clear();
+
+        for (size_t i = 0; i < result.size(); i += 3U)
+        {
+            for (size_t e = 0; e < 3U; ++e)
+            {
+                const uint32_t a = result[i + e];
+                const uint32_t b = result[i + (e + 1U) % 3U];
+
+                for (const auto& edge : { std::make_pair(a, b), std::make_pair(b, a) })
+                {
+                    const uint32_t from = edge.first;
+                    const uint32_t to = edge.second;
+
+                    if (locked[from] || (!vertexGroups.empty() && vertexGroups[from] != vertexGroups[to]))
+                    {
+                        continue;
+                    }
+
+                    const double cost = quadrics[from].Evaluate(points[to]);
+
+                    if (cost <= maxCost)
+                    {
+                        collapses.push_back({ cost, from, to });
+                    }
+                }
+            }
+        }
+
+        if (collapses.empty())
+        {
+            break;
+        }
+
+        std::sort(collapses.begin(), collapses.end());
+
+        // Vertex -> triangle adjacency for the current triangle list
+        std::fill(offsets.begin(), offsets.end(), 0U);
+
+        for (const auto index : result)
+        {
+            ++offsets[index + 1U];
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            offsets[i + 1U] += offsets[i];
+        }
+
+        adjacency.resize(result.size());
+
+        {
+            std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+
+            for (size_t i = 0; i < result.size(); ++i)
+            {
+                adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3U);
+            }
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            remap[i] = static_cast<uint32_t>(i);
+        }
+
+        std::fill(changed.begin(), changed.end(), false);
+
+        size_t indexCount = result.size();
+        size_t collapseCount = 0U;
+
+        for (const auto& collapse : collapses)
+        {
+            if (indexCount <= targetIndexCount)
+            {
+                break;
+            }
+
+            const uint32_t from = collapse.from;
+            const uint32_t to = collapse.to;
+
+            // Triangles around a vertex that has been touched by a collapse during this pass have changed, so only
+            // collapse vertices whose neighborhood is unchanged and never collapse onto a vertex that has been removed
+            if (changed[from] || removed[from] || removed[to])
+            {
+                continue;
+            }
+
+            // Reject collapses that flip the orientation of any remaining triangle. The quadric is also evaluated at the
+            // center of each new triangle, as the surface between the vertices can deviate further than the vertex does
+            // (e.g. on a curved surface).
+            bool flipped = false;
+            size_t degenerateCount = 0U;
+            double cost = collapse.cost;
+
+            for (size_t j = offsets[from]; j < offsets[from + 1U] && !flipped; ++j)
+            {
+                const uint32_t* triangle = &result[adjacency[j] * 3U];
+
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                {
+                    ++degenerateCount;
+                    continue;
+                }
+
+                Vector3d before[3];
+                Vector3d after[3];
+
+                for (size_t k = 0; k < 3U; ++k)
+                {
+                    before[k] = points[triangle[k]];
+                    after[k] = points[triangle[k] == from ? to : triangle[k]];
+                }
+
+                const Vector3d normalBefore = Cross(before[1] - before[0], before[2] - before[0]);
+                const Vector3d normalAfter = Cross(after[1] - after[0], after[2] - after[0]);
+
+                flipped = Dot(normalBefore, normalAfter) <= 0.0;
+
+                const Vector3d center = {
+                    (after[0].x + after[1].x + after[2].x) / 3.0,
+                    (after[0].y + after[1].y + after[2].y) / 3.0,
+                    (after[0].z + after[1].z + after[2].z) / 3.0
+                };
+
+                cost = std::max(cost, quadrics[from].Evaluate(center));
+            }
+
+            if (flipped || cost > maxCost)
+            {
+                continue;
+            }
+
+            remap[from] = to;
+            removed[from] = true;
+            quadrics[to] += quadrics[from];
+
+            for (size_t j = offsets[from]; j < offsets[from + 1U]; ++j)
+            {
+                const uint32_t* triangle = &result[adjacency[j] * 3U];
+
+                changed[triangle[0]] = true;
+                changed[triangle[1]] = true;
+                changed[triangle[2]] = true;
+            }
+
+            indexCount -= degenerateCount * 3U;
+            achievedCost = std::max(achievedCost, cost);
+            ++collapseCount;
+        }
+
+        if (collapseCount == 0U)
+        {
+            break;
+        }
+
+        // Apply the collapses and discard triangles that became degenerate
+        size_t write = 0U;
+
+        for (size_t i = 0; i < result.size(); i += 3U)
+        {
+            const uint32_t a = remap[result[i]];
+            const uint32_t b = remap[result[i + 1U]];
+            const uint32_t c = remap[result[i + 2U]];
+
+            if (a != b && b != c && a != c)
+            {
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+        }
+
+        result.resize(write);
+    }
+
+    if (resultRmsError)
+    {
+        *resultRmsError = static_cast<float>(std::sqrt(achievedCost));
+    }
+
+    return result;
+}
+
+std::vector<MeshPrimitive> MeshSimplificationUtils::GenerateLODs(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+    const std::vector<MeshSimplificationLevel>& levels)
+{
+    Internal::ValidateTriangleMode(meshPrimitive, "simplified");
+
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("The BufferBuilder has no buffer to write simplified accessors to");
+    }
+
+    const auto positions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+    const size_t vertexCount = positions.size() / 3U;
+    const auto vertexGroups = GetDominantJoints(doc, reader, meshPrimitive, vertexCount);
+
+    auto indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+    const size_t sourceIndexCount = indices.size();
+
+    std::vector<MeshPrimitive> lods;
+    lods.reserve(levels.size());
+
+    for (const auto& level : levels)
+    {
+        if (level.targetRatio < 0.0f || level.targetRatio > 1.0f)
+        {
+            throw GLTFException("Simplification target ratio must be between 0 and 1");
+        }
+
+        const size_t targetIndexCount = static_cast<size_t>(sourceIndexCount / 3U * level.targetRatio) * 3U;
+
+        indices = Simplify(indices, positions, targetIndexCount, level.targetRmsError, nullptr, vertexGroups);
+
+        if (indices.empty())
+        {
+            throw GLTFException("Simplification removed every triangle from the mesh primitive");
+        }
+
+        MeshPrimitive lod = meshPrimitive;
+
+        lod.mode = MESH_TRIANGLES;
+        lod.indicesAccessorId = Internal::AddIndicesAccessor(indices, vertexCount, bufferBuilder).id;
+
+        lods.push_back(std::move(lod));
+    }
+
+    return lods;
+}
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "MeshUtilsInternal.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+
+#include <cstring>
+#include <limits>
+#include <string>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Throws if an accessor's elements can't fit within its buffer view (or, without one, in memory) - checked before
+    // anything is allocated, as the element count is untrusted
+    void CheckAccessorExtent(const Document& doc, const Accessor& accessor)
+    {
+        const size_t elementSize = Accessor::GetComponentTypeSize(accessor.componentType) * Accessor::GetTypeCount(accessor.type);
+
+        if (elementSize == 0U || accessor.count > std::numeric_limits<size_t>::max() / elementSize)
+        {
+            throw GLTFException("Accessor " + accessor.id + " count " + std::to_string(accessor.count) + " is too large");
+        }
+
+        if (accessor.sparse.count > accessor.count)
+        {
+            throw GLTFException("Accessor " + accessor.id + " has more sparse elements than elements");
+        }
+
+        if (accessor.bufferViewId.empty() || accessor.count == 0U)
+        {
+            return;
+        }
+
+        const auto& bufferView = doc.bufferViews.Get(accessor.bufferViewId);
+        const size_t byteStride = bufferView.byteStride ? bufferView.byteStride.Get() : elementSize;
+
+        if (accessor.byteOffset > bufferView.byteLength
+            || bufferView.byteLength - accessor.byteOffset < elementSize
+            || (accessor.count - 1U) > (bufferView.byteLength - accessor.byteOffset - elementSize) / byteStride)
+        {
+            throw GLTFException("Accessor " + accessor.id + " count " + std::to_string(accessor.count) + " exceeds the length of buffer view " + bufferView.id);
+        }
+    }
+
+    template<typename T>
+    std::vector<uint8_t> ReadAccessorBytes(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    {
+        const auto data = reader.ReadBinaryData<T>(doc, accessor);
+
+        std::vector<uint8_t> bytes(data.size() * sizeof(T));
+        std::memcpy(bytes.data(), data.data(), bytes.size());
+        return bytes;
+    }
+}
+
+std::vector<uint8_t> Internal::ReadAccessorBytes(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+{
+    CheckAccessorExtent(doc, accessor);
+
+    if (accessor.bufferViewId.empty() && accessor.sparse.count == 0U)
+    {
+        return std::vector<uint8_t>(accessor.GetByteLength(), 0U);
+    }
+
+    switch (accessor.componentType)
+    {
+    case COMPONENT_BYTE:
+        return ::ReadAccessorBytes<int8_t>(doc, reader, accessor);
+    case COMPONENT_UNSIGNED_BYTE:
+        return ::ReadAccessorBytes<uint8_t>(doc, reader, accessor);
+    case COMPONENT_SHORT:
+        return ::ReadAccessorBytes<int16_t>(doc, reader, accessor);
+    case COMPONENT_UNSIGNED_SHORT:
+        return ::ReadAccessorBytes<uint16_t>(doc, reader, accessor);
+    case COMPONENT_UNSIGNED_INT:
+        return ::ReadAccessorBytes<uint32_t>(doc, reader, accessor);
+    case COMPONENT_FLOAT:
+        return ::ReadAccessorBytes<float>(doc, reader, accessor);
+    default:
+        throw GLTFException("Invalid componentType for accessor " + accessor.id);
+    }
+}
+
+const Accessor& Internal::AddIndicesAccessor(const std::vector<uint32_t>& indices, size_t vertexCount, BufferBuilder& bufferBuilder)
+{
+    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+
+    if (vertexCount <= std::numeric_limits<uint16_t>::max())
+    {
+        const std::vector<uint16_t> indices16(indices.begin(), indices.end());
+        return bufferBuilder.AddAccessor(indices16, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+    }
+
+    return bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT });
+}
+
+void Internal::ValidateTriangleMode(const MeshPrimitive& meshPrimitive, const char* operation)
+{
+    if (meshPrimitive.mode != MESH_TRIANGLES &&
+        meshPrimitive.mode != MESH_TRIANGLE_STRIP &&
+        meshPrimitive.mode != MESH_TRIANGLE_FAN)
+    {
+        throw GLTFException(std::string("Only triangle based mesh primitives can be ") + operation);
+    }
+}
+
+void Internal::ValidateTriangleList(const std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    if (indices.size() % 3U != 0U)
+    {
+        throw GLTFException("Triangle list index count must be a multiple of 3");
+    }
+
+    for (const auto index : indices)
+    {
+        if (index >= vertexCount)
+        {
+            throw GLTFException("Index " + std::to_string(index) + " is out of range for " + std::to_string(vertexCount) + " vertices");
+        }
+    }
+}
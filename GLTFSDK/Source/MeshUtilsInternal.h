@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Helpers shared by the accessor and mesh processing utilities. Not part of the public API.
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        namespace Internal
+        {
+            // Reads an accessor's elements, tightly packed and in their original component type. An accessor without a
+            // buffer view or sparse values is initialized with zeros. Throws a GLTFException, before allocating, if the
+            // accessor's count doesn't fit within its buffer view.
+            std::vector<uint8_t> ReadAccessorBytes(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
+
+            // Writes 'indices' to a new buffer view and accessor of 'bufferBuilder', as unsigned shorts if every index
+            // of 'vertexCount' vertices fits
+            const Accessor& AddIndicesAccessor(const std::vector<uint32_t>& indices, size_t vertexCount, BufferBuilder& bufferBuilder);
+
+            // Throws if the mesh primitive isn't a triangle list, strip or fan, e.g. "Only triangle based mesh primitives
+            // can be " + operation
+            void ValidateTriangleMode(const MeshPrimitive& meshPrimitive, const char* operation);
+
+            // Throws if 'indices' isn't a whole number of triangles or references a vertex at or beyond 'vertexCount'
+            void ValidateTriangleList(const std::vector<uint32_t>& indices, size_t vertexCount);
+
+            // Vector math for the mesh utilities - float for per-vertex work, double where errors accumulate
+            template<typename T>
+            struct Vector3T
+            {
+                T x;
+                T y;
+                T z;
+            };
+
+            typedef Vector3T<float> Vector3f;
+            typedef Vector3T<double> Vector3d;
+
+            template<typename T>
+            Vector3T<T> operator+(const Vector3T<T>& a, const Vector3T<T>& b)
+            {
+                return { a.x + b.x, a.y + b.y, a.z + b.z };
+            }
+
+            template<typename T>
+            Vector3T<T> operator-(const Vector3T<T>& a, const Vector3T<T>& b)
+            {
+                return { a.x - b.x, a.y - b.y, a.z - b.z };
+            }
+
+            template<typename T>
+            Vector3T<T> operator*(const Vector3T<T>& v, T s)
+            {
+                return { v.x * s, v.y * s, v.z * s };
+            }
+
+            template<typename T>
+            T Dot(const Vector3T<T>& a, const Vector3T<T>& b)
+            {
+                return a.x * b.x + a.y * b.y + a.z * b.z;
+            }
+
+            template<typename T>
+            Vector3T<T> Cross(const Vector3T<T>& a, const Vector3T<T>& b)
+            {
+                return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+            }
+
+            template<typename T>
+            T Length(const Vector3T<T>& v)
+            {
+                return std::sqrt(Dot(v, v));
+            }
+
+            // Scales 'v' to unit length. Returns false, leaving 'v' unchanged, if it has zero or non-finite length.
+            template<typename T>
+            bool Normalize(Vector3T<T>& v)
+            {
+                const T length = Length(v);
+
+                if (!(length > T(0)) || !std::isfinite(length))
+                {
+                    return false;
+                }
+
+                v = v * (T(1) / length);
+                return true;
+            }
+
+            // The 'index'th element of tightly packed xyz data, e.g. from MeshPrimitiveUtils::GetPositions
+            inline Vector3f GetVector3(const std::vector<float>& data, size_t index)
+            {
+                return { data[index * 3U], data[index * 3U + 1U], data[index * 3U + 2U] };
+            }
+        }
+    }
+}
@@ -0,0 +1,419 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MeshletUtils.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/RapidJsonUtils.h>
+
+#include "MeshUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    using Internal::Vector3f;
+    using Internal::GetVector3;
+
+    std::array<float, 3> ToArray(const Vector3f& v)
+    {
+        return { { v.x, v.y, v.z } };
+    }
+
+    // Parses a mesh primitive's extras, treating empty extras as an empty object
+    void ParseExtras(const MeshPrimitive& meshPrimitive, rapidjson::Document& extras)
+    {
+        if (meshPrimitive.extras.find_first_not_of(" \t\r\n") == std::string::npos)
+        {
+            extras.SetObject();
+        }
+        else if (extras.Parse(meshPrimitive.extras.c_str()).HasParseError() || !extras.IsObject())
+        {
+            throw GLTFException("Mesh primitive extras must be a JSON object");
+        }
+    }
+
+    // Replaces the string id 'name' of 'member' with the index of the element it refers to in 'container'
+    template<typename T>
+    void ResolveIndex(rapidjson::Value& member, const char* name, const IndexedContainer<const T>& container)
+    {
+        auto it = member.FindMember(name);
+
+        if (it == member.MemberEnd() || !it->value.IsString())
+        {
+            throw GLTFException(std::string("Mesh primitive extras have no meshlets ") + name + " id to resolve");
+        }
+
+        it->value = rapidjson::Value(ToKnownSizeType(container.GetIndex(it->value.GetString())));
+    }
+}
+
+MeshletData MeshletUtils::BuildMeshlets(const std::vector<uint32_t>& indices, const std::vector<float>& positions, size_t maxVertices, size_t maxTriangles)
+{
+    if (maxVertices < 3U || maxVertices > MaxMeshletVertexCount)
+    {
+        throw GLTFException("Meshlet vertex limit must be between 3 and " + std::to_string(MaxMeshletVertexCount));
+    }
+
+    if (maxTriangles == 0U)
+    {
+        throw GLTFException("Meshlet triangle limit must be greater than zero");
+    }
+
+    const size_t vertexCount = positions.size() / 3U;
+    const size_t triangleCount = indices.size() / 3U;
+
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    // Vertex -> triangle adjacency
+    std::vector<size_t> offsets(vertexCount + 1U, 0U);
+
+    for (const auto index : indices)
+    {
+        ++offsets[index + 1U];
+    }
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        offsets[i + 1U] += offsets[i];
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+
+    {
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3U);
+        }
+    }
+
+    const int notInMeshlet = -1;
+
+    std::vector<int> localIndices(vertexCount, notInMeshlet);
+    std::vector<bool> emitted(triangleCount, false);
+
+    MeshletData result;
+    Meshlet current;
+
+    auto flush = [&]()
+    {
+        if (current.triangleCount == 0U)
+        {
+            return;
+        }
+
+        for (size_t i = current.vertexOffset; i < result.vertices.size(); ++i)
+        {
+            localIndices[result.vertices[i]] = notInMeshlet;
+        }
+
+        result.meshlets.push_back(current);
+
+        current = Meshlet();
+        current.vertexOffset = static_cast<uint32_t>(result.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(result.triangles.size() / 3U);
+    };
+
+    auto getNewVertexCount = [&](size_t triangle)
+    {
+        return (localIndices[indices[triangle * 3U]] == notInMeshlet ? 1U : 0U) +
+            (localIndices[indices[triangle * 3U + 1U]] == notInMeshlet ? 1U : 0U) +
+            (localIndices[indices[triangle * 3U + 2U]] == notInMeshlet ? 1U : 0U);
+    };
+
+    size_t nextUnemitted = 0U;
+
+    for (size_t emittedCount = 0U; emittedCount < triangleCount; ++emittedCount)
+    {
+        // Prefer the triangle adjacent to the current meshlet that adds the fewest new vertices
+        size_t best = triangleCount;
+        size_t bestNewVertexCount = 4U;
+
+        for (size_t i = current.vertexOffset; i < result.vertices.size() && bestNewVertexCount > 0U; ++i)
+        {
+            const uint32_t vertex = result.vertices[i];
+
+            for (size_t j = offsets[vertex]; j < offsets[vertex + 1U]; ++j)
+            {
+                const uint32_t triangle = adjacency[j];
+
+                if (emitted[triangle])
+                {
+                    continue;
+                }
+
+                const size_t newVertexCount = getNewVertexCount(triangle);
+
+                if (newVertexCount < bestNewVertexCount || (newVertexCount == bestNewVertexCount && triangle < best))
+                {
+                    best = triangle;
+                    bestNewVertexCount = newVertexCount;
+                }
+            }
+        }
+
+        if (best == triangleCount)
+        {
+            // Nothing adjacent remains - continue from the first triangle not yet emitted
+            while (emitted[nextUnemitted])
+            {
+                ++nextUnemitted;
+            }
+
+            best = nextUnemitted;
+            bestNewVertexCount = getNewVertexCount(best);
+        }
+
+        if (current.vertexCount + bestNewVertexCount > maxVertices || current.triangleCount + 1U > maxTriangles)
+        {
+            flush();
+            bestNewVertexCount = 3U;
+        }
+
+        for (size_t k = 0; k < 3U; ++k)
+        {
+            const uint32_t vertex = indices[best * 3U + k];
+
+            if (localIndices[vertex] == notInMeshlet)
+            {
+                localIndices[vertex] = static_cast<int>(current.vertexCount++);
+                result.vertices.push_back(vertex);
+            }
+
+            result.triangles.push_back(static_cast<uint8_t>(localIndices[vertex]));
+        }
+
+        ++current.triangleCount;
+        emitted[best] = true;
+    }
+
+    flush();
+
+    result.bounds.reserve(result.meshlets.size());
+
+    for (const auto& meshlet : result.meshlets)
+    {
+        result.bounds.push_back(ComputeMeshletBounds(result, meshlet, positions));
+    }
+
+    return result;
+}
+
+MeshletBounds MeshletUtils::ComputeMeshletBounds(const MeshletData& meshletData, const Meshlet& meshlet, const std::vector<float>& positions)
+{
+    MeshletBounds bounds;
+
+    if (meshlet.vertexCount == 0U)
+    {
+        return bounds;
+    }
+
+    const uint32_t* vertices = &meshletData.vertices[meshlet.vertexOffset];
+
+    // Ritter's bounding sphere - start from two distant points and grow to include any points outside
+    auto first = GetVector3(positions, vertices[0]);
+    auto farthest = first;
+
+    for (size_t pass = 0; pass < 2U; ++pass)
+    {
+        float maxDistance = -1.0f;
+        const auto origin = farthest;
+
+        for (size_t i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const auto p = GetVector3(positions, vertices[i]);
+            const float distance = Length(p - origin);
+
+            if (distance > maxDistance)
+            {
+                maxDistance = distance;
+                farthest = p;
+            }
+        }
+
+        if (pass == 0U)
+        {
+            first = farthest;
+        }
+    }
+
+    auto center = (first + farthest) * 0.5f;
+    bounds.radius = Length(farthest - first) * 0.5f;
+
+    for (size_t i = 0; i < meshlet.vertexCount; ++i)
+    {
+        const auto p = GetVector3(positions, vertices[i]);
+        const float distance = Length(p - center);
+
+        if (distance > bounds.radius)
+        {
+            const float newRadius = (bounds.radius + distance) * 0.5f;
+            const float shift = (newRadius - bounds.radius) / distance;
+
+            center = center + (p - center) * shift;
+            bounds.radius = newRadius;
+        }
+    }
+
+    bounds.center = ToArray(center);
+
+    // Normal cone - the axis is the average triangle normal and the half-angle is the largest angle between it and any normal
+    std::vector<Vector3f> normals;
+    normals.reserve(meshlet.triangleCount);
+
+    Vector3f axis = { 0.0f, 0.0f, 0.0f };
+
+    for (size_t i = 0; i < meshlet.triangleCount; ++i)
+    {
+        const uint8_t* triangle = &meshletData.triangles[(meshlet.triangleOffset + i) * 3U];
+
+        const auto p0 = GetVector3(positions, vertices[triangle[0]]);
+        const auto p1 = GetVector3(positions, vertices[triangle[1]]);
+        const auto p2 = GetVector3(positions, vertices[triangle[2]]);
+
+        auto n = Cross(p1 - p0, p2 - p0);
+
+        if (!Normalize(n))
+        {
+            continue; // Degenerate triangles have no facing so they never prevent culling
+        }
+
+        axis = axis + n;
+        normals.push_back(n);
+    }
+
+    // A cutoff of 1 never passes the culling test
+    bounds.coneCutoff = 1.0f;
+
+    if (normals.empty() || !Normalize(axis))
+    {
+        return bounds;
+    }
+
+    bounds.coneAxis = ToArray(axis);
+
+    float minDot = 1.0f;
+
+    for (const auto& n : normals)
+    {
+        minDot = std::min(minDot, Dot(n, axis));
+    }
+
+    // Every triangle is back facing for view directions within 90 degrees minus the half-angle of the axis, so the
+    // cutoff is cos(90 - halfAngle) = sin(halfAngle). Normal cones of 90 degrees or wider can't be culled.
+    if (minDot > 0.0f)
+    {
+        bounds.coneCutoff = std::sqrt(std::max(0.0f, 1.0f - minDot * minDot));
+    }
+
+    return bounds;
+}
+
+MeshPrimitive MeshletUtils::AddMeshlets(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+    size_t maxVertices, size_t maxTriangles)
+{
+    Internal::ValidateTriangleMode(meshPrimitive, "split into meshlets");
+
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("The BufferBuilder has no buffer to write meshlet accessors to");
+    }
+
+    const auto positions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+    const auto indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+
+    const auto meshletData = BuildMeshlets(indices, positions, maxVertices, maxTriangles);
+
+    if (meshletData.meshlets.empty())
+    {
+        throw GLTFException("Mesh primitive has no triangles to build meshlets from");
+    }
+
+    std::vector<uint32_t> meshlets;
+    std::vector<float> bounds;
+    std::vector<float> cones;
+
+    meshlets.reserve(meshletData.meshlets.size() * 4U);
+    bounds.reserve(meshletData.meshlets.size() * 4U);
+    cones.reserve(meshletData.meshlets.size() * 4U);
+
+    for (size_t i = 0; i < meshletData.meshlets.size(); ++i)
+    {
+        const auto& meshlet = meshletData.meshlets[i];
+        const auto& meshletBounds = meshletData.bounds[i];
+
+        meshlets.insert(meshlets.end(), { meshlet.vertexOffset, meshlet.vertexCount, meshlet.triangleOffset, meshlet.triangleCount });
+        bounds.insert(bounds.end(), { meshletBounds.center[0], meshletBounds.center[1], meshletBounds.center[2], meshletBounds.radius });
+        cones.insert(cones.end(), { meshletBounds.coneAxis[0], meshletBounds.coneAxis[1], meshletBounds.coneAxis[2], meshletBounds.coneCutoff });
+    }
+
+    // Accessors may only use UNSIGNED_INT for indices, so the 32-bit meshlet data is written to buffer views without accessors
+    const auto meshletsBufferViewId = bufferBuilder.AddBufferView(meshlets, {}, {}, sizeof(uint32_t)).id;
+    const auto verticesBufferViewId = bufferBuilder.AddBufferView(meshletData.vertices, {}, {}, sizeof(uint32_t)).id;
+
+    bufferBuilder.AddBufferView();
+    const auto trianglesAccessorId = bufferBuilder.AddAccessor(meshletData.triangles, { TYPE_SCALAR, COMPONENT_UNSIGNED_BYTE }).id;
+
+    bufferBuilder.AddBufferView();
+    const auto boundsAccessorId = bufferBuilder.AddAccessor(bounds, { TYPE_VEC4, COMPONENT_FLOAT }).id;
+
+    bufferBuilder.AddBufferView();
+    const auto conesAccessorId = bufferBuilder.AddAccessor(cones, { TYPE_VEC4, COMPONENT_FLOAT }).id;
+
+    // Replace any "meshlets" member left by a previous call, keeping the rest of the extras as they are
+    rapidjson::Document extras;
+    ParseExtras(meshPrimitive, extras);
+
+    auto& a = extras.GetAllocator();
+
+    rapidjson::Value member(rapidjson::kObjectType);
+
+    member.AddMember("maxVertices", rapidjson::Value(ToKnownSizeType(maxVertices)), a);
+    member.AddMember("maxTriangles", rapidjson::Value(ToKnownSizeType(maxTriangles)), a);
+    member.AddMember("meshletsBufferView", RapidJsonUtils::ToStringValue(meshletsBufferViewId, a), a);
+    member.AddMember("verticesBufferView", RapidJsonUtils::ToStringValue(verticesBufferViewId, a), a);
+    member.AddMember("triangles", RapidJsonUtils::ToStringValue(trianglesAccessorId, a), a);
+    member.AddMember("bounds", RapidJsonUtils::ToStringValue(boundsAccessorId, a), a);
+    member.AddMember("cones", RapidJsonUtils::ToStringValue(conesAccessorId, a), a);
+
+    extras.RemoveMember("meshlets");
+    extras.AddMember("meshlets", member, a);
+
+    MeshPrimitive result = meshPrimitive;
+    result.extras = Serialize(extras);
+
+    return result;
+}
+
+MeshPrimitive MeshletUtils::ResolveMeshletIndices(const Document& doc, const MeshPrimitive& meshPrimitive)
+{
+    rapidjson::Document extras;
+    ParseExtras(meshPrimitive, extras);
+
+    auto it = extras.FindMember("meshlets");
+
+    if (it == extras.MemberEnd() || !it->value.IsObject())
+    {
+        throw GLTFException("Mesh primitive extras have no meshlets member");
+    }
+
+    ResolveIndex(it->value, "meshletsBufferView", doc.bufferViews);
+    ResolveIndex(it->value, "verticesBufferView", doc.bufferViews);
+    ResolveIndex(it->value, "triangles", doc.accessors);
+    ResolveIndex(it->value, "bounds", doc.accessors);
+    ResolveIndex(it->value, "cones", doc.accessors);
+
+    MeshPrimitive result = meshPrimitive;
+    result.extras = Serialize(extras);
+
+    return result;
+}
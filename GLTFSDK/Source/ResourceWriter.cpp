@@ -5,7 +5,9 @@
 
 using namespace Microsoft::glTF;
 
-ResourceWriter::ResourceWriter(std::unique_ptr<IStreamWriterCache> streamWriterCache) : m_streamWriterCache(std::move(streamWriterCache))
+ResourceWriter::ResourceWriter(std::unique_ptr<IStreamWriterCache> streamWriterCache) :
+    m_streamWriterCache(std::move(streamWriterCache)),
+    m_ioCounters(std::make_unique<IOCounters>())
 {
 }
 
@@ -52,7 +54,11 @@ void ResourceWriter::WriteExternal(const std::string& uri, const void* data, siz
 {
     if (auto stream = m_streamWriterCache->Get(uri))
     {
+        const auto start = IOCounters::Clock::now();
+
         StreamUtils::WriteBinary(*stream, data, byteLength);
+
+        m_ioCounters->AddWrite(byteLength, IOCounters::Clock::now() - start);
     }
 }
 
@@ -61,6 +67,17 @@ void ResourceWriter::WriteExternal(const std::string& uri, const std::string& da
     WriteExternal(uri, data.c_str(), data.length());
 }
 
+IOStatistics ResourceWriter::GetIOStatistics() const
+{
+    return m_ioCounters->GetStatistics() + m_streamWriterCache->GetIOStatistics();
+}
+
+void ResourceWriter::ResetIOStatistics()
+{
+    m_ioCounters->Reset();
+    m_streamWriterCache->ResetIOStatistics();
+}
+
 void ResourceWriter::WriteImpl(const BufferView& bufferView, const void* data, std::streamoff totalOffset, size_t totalByteLength)
 {
     // TODO: vertex attributes must be aligned to 4-byte boundaries inside a bufferView (accessor.byteOffset and bufferView.byteStride must be multiples of 4)
@@ -68,6 +85,7 @@ void ResourceWriter::WriteImpl(const BufferView& bufferView, const void* data, s
     if (auto bufferStream = GetBufferStream(bufferView.bufferId))
     {
         const auto bufferOffset = GetBufferOffset(bufferView.bufferId);
+        const auto start = IOCounters::Clock::now();
 
         if (totalOffset < bufferOffset)
         {
@@ -89,5 +107,8 @@ void ResourceWriter::WriteImpl(const BufferView& bufferView, const void* data, s
         }
 
         SetBufferOffset(bufferView.bufferId, totalOffset + totalByteLength);
+
+        // Padding is included in the bytes written
+        m_ioCounters->AddWrite(static_cast<uint64_t>(totalOffset - bufferOffset) + totalByteLength, IOCounters::Clock::now() - start);
     }
 }
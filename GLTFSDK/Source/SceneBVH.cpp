@@ -0,0 +1,645 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/SceneBVH.h>
+
+#include <GLTFSDK/AnimationUtils.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/ParallelUtils.h>
+#include <GLTFSDK/SceneGraph.h>
+
+#include "MatrixUtilsInternal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Nodes with this many items or fewer are never split
+    const size_t MaxLeafItemCount = 4U;
+
+    // Number of centroid bins evaluated per axis by the surface area heuristic
+    const size_t BinCount = 16U;
+
+    // Items per range when refitting item bounds across threads
+    const size_t MinParallelItemCount = 1024U;
+
+    const size_t NoSkin = std::numeric_limits<size_t>::max();
+
+    BoundingBox GetEmptyBox()
+    {
+        const float max = std::numeric_limits<float>::max();
+        return { { max, max, max }, { -max, -max, -max } };
+    }
+
+    void Grow(BoundingBox& box, const BoundingBox& other)
+    {
+        box.min = { std::min(box.min.x, other.min.x), std::min(box.min.y, other.min.y), std::min(box.min.z, other.min.z) };
+        box.max = { std::max(box.max.x, other.max.x), std::max(box.max.y, other.max.y), std::max(box.max.z, other.max.z) };
+    }
+
+    float GetSurfaceArea(const BoundingBox& box)
+    {
+        const float x = box.max.x - box.min.x;
+        const float y = box.max.y - box.min.y;
+        const float z = box.max.z - box.min.z;
+
+        return (x < 0.0f || y < 0.0f || z < 0.0f) ? 0.0f : 2.0f * (x * y + y * z + z * x);
+    }
+
+    float GetComponent(const Vector3& v, size_t axis)
+    {
+        return axis == 0U ? v.x : (axis == 1U ? v.y : v.z);
+    }
+
+    // Transforms a box by a column-major matrix, giving the box that bounds the transformed corners
+    BoundingBox TransformBox(const BoundingBox& box, const float* m)
+    {
+        const float c[3] = { (box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f, (box.min.z + box.max.z) * 0.5f };
+        const float e[3] = { (box.max.x - box.min.x) * 0.5f, (box.max.y - box.min.y) * 0.5f, (box.max.z - box.min.z) * 0.5f };
+
+        float center[3];
+        float extent[3];
+
+        for (size_t row = 0; row < 3U; ++row)
+        {
+            center[row] = m[row] * c[0] + m[4U + row] * c[1] + m[8U + row] * c[2] + m[12U + row];
+            extent[row] = std::abs(m[row]) * e[0] + std::abs(m[4U + row]) * e[1] + std::abs(m[8U + row]) * e[2];
+        }
+
+        return {
+            { center[0] - extent[0], center[1] - extent[1], center[2] - extent[2] },
+            { center[0] + extent[0], center[1] + extent[1], center[2] + extent[2] }
+        };
+    }
+
+    // The union of the bounds of a mesh's primitives. Morph targets may displace positions by up to their own min and
+    // max, for weights in [0, 1], so the bounds are conservatively enlarged by every target.
+    BoundingBox GetMeshBounds(const Document& doc, const Mesh& mesh)
+    {
+        BoundingBox meshBounds = GetEmptyBox();
+
+        for (const auto& meshPrimitive : mesh.primitives)
+        {
+            std::string accessorId;
+
+            if (!meshPrimitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, accessorId))
+            {
+                continue;
+            }
+
+            const auto& accessor = doc.accessors.Get(accessorId);
+
+            if (accessor.min.size() != 3U || accessor.max.size() != 3U)
+            {
+                throw GLTFException("Accessor " + accessor.id + " has no min and max - the bounds of mesh " + mesh.id + " are unknown");
+            }
+
+            BoundingBox bounds = { { accessor.min[0], accessor.min[1], accessor.min[2] }, { accessor.max[0], accessor.max[1], accessor.max[2] } };
+
+            for (const auto& morphTarget : meshPrimitive.targets)
+            {
+                if (morphTarget.positionsAccessorId.empty())
+                {
+                    continue;
+                }
+
+                const auto& targetAccessor = doc.accessors.Get(morphTarget.positionsAccessorId);
+
+                if (targetAccessor.min.size() != 3U || targetAccessor.max.size() != 3U)
+                {
+                    throw GLTFException("Accessor " + targetAccessor.id + " has no min and max - the bounds of mesh " + mesh.id + " are unknown");
+                }
+
+                bounds.min = { bounds.min.x + std::min(targetAccessor.min[0], 0.0f), bounds.min.y + std::min(targetAccessor.min[1], 0.0f), bounds.min.z + std::min(targetAccessor.min[2], 0.0f) };
+                bounds.max = { bounds.max.x + std::max(targetAccessor.max[0], 0.0f), bounds.max.y + std::max(targetAccessor.max[1], 0.0f), bounds.max.z + std::max(targetAccessor.max[2], 0.0f) };
+            }
+
+            Grow(meshBounds, bounds);
+        }
+
+        return meshBounds;
+    }
+
+    bool IsOutside(const BoundingBox& box, const Plane& plane)
+    {
+        // The corner of the box furthest along the plane's normal
+        const float x = plane.a >= 0.0f ? box.max.x : box.min.x;
+        const float y = plane.b >= 0.0f ? box.max.y : box.min.y;
+        const float z = plane.c >= 0.0f ? box.max.z : box.min.z;
+
+        return plane.a * x + plane.b * y + plane.c * z + plane.d < 0.0f;
+    }
+
+    bool IsOutside(const BoundingBox& box, const std::vector<Plane>& planes)
+    {
+        return std::any_of(planes.begin(), planes.end(), [&box](const Plane& plane) { return IsOutside(box, plane); });
+    }
+
+    // Returns the distance along the ray at which it enters the box, or a negative value if it misses
+    float IntersectRay(const BoundingBox& box, const float* origin, const float* inverseDirection, const bool* isParallel, float maxDistance)
+    {
+        float tEnter = 0.0f;
+        float tExit = maxDistance;
+
+        for (size_t axis = 0; axis < 3U; ++axis)
+        {
+            const float min = GetComponent(box.min, axis);
+            const float max = GetComponent(box.max, axis);
+
+            if (isParallel[axis])
+            {
+                if (origin[axis] < min || origin[axis] > max)
+                {
+                    return -1.0f;
+                }
+
+                continue;
+            }
+
+            float t0 = (min - origin[axis]) * inverseDirection[axis];
+            float t1 = (max - origin[axis]) * inverseDirection[axis];
+
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+
+            if (tEnter > tExit)
+            {
+                return -1.0f;
+            }
+        }
+
+        return tEnter;
+    }
+
+    // Visits the BVH's nodes depth-first, descending into a node's children when enter(node) returns true and
+    // calling visitItem(item) for each item of leaves that are entered
+    template<typename EnterFn, typename ItemFn>
+    void TraverseBVH(const std::vector<BVHNode>& nodes, const std::vector<size_t>& leafItems, EnterFn enter, ItemFn visitItem)
+    {
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        std::vector<size_t> stack = { 0U };
+
+        while (!stack.empty())
+        {
+            const auto& node = nodes[stack.back()];
+            stack.pop_back();
+
+            if (!enter(node))
+            {
+                continue;
+            }
+
+            if (node.count > 0U)
+            {
+                for (size_t i = node.first; i < node.first + node.count; ++i)
+                {
+                    visitItem(leafItems[i]);
+                }
+            }
+            else
+            {
+                stack.push_back(node.first + 1U);
+                stack.push_back(node.first);
+            }
+        }
+    }
+}
+
+SceneBVH::SceneBVH(const Document& doc, const SceneGraph& sceneGraph, size_t threadCount) : SceneBVH(doc, nullptr, sceneGraph, threadCount)
+{
+}
+
+SceneBVH::SceneBVH(const Document& doc, const GLTFResourceReader& reader, const SceneGraph& sceneGraph, size_t threadCount) : SceneBVH(doc, &reader, sceneGraph, threadCount)
+{
+}
+
+SceneBVH::SceneBVH(const Document& doc, const GLTFResourceReader* reader, const SceneGraph& sceneGraph, size_t threadCount)
+{
+    // Meshes are often instanced by many nodes so each mesh's bounds are found once, as are each skin's joints
+    std::vector<BoundingBox> meshBounds(doc.meshes.Size());
+    std::vector<bool> hasMeshBounds(doc.meshes.Size(), false);
+    std::vector<size_t> skinIndices(doc.skins.Size(), NoSkin);
+
+    m_skinJointOffsets.push_back(0U);
+
+    for (size_t sceneIndex = 0; sceneIndex < sceneGraph.GetNodeCount(); ++sceneIndex)
+    {
+        const auto& node = doc.nodes[sceneGraph.GetNodeIndex(sceneIndex)];
+
+        if (node.meshId.empty())
+        {
+            continue;
+        }
+
+        const size_t meshIndex = doc.meshes.GetIndex(node.meshId);
+
+        if (!hasMeshBounds[meshIndex])
+        {
+            meshBounds[meshIndex] = GetMeshBounds(doc, doc.meshes[meshIndex]);
+            hasMeshBounds[meshIndex] = true;
+        }
+
+        size_t skinIndex = NoSkin;
+
+        if (!node.skinId.empty())
+        {
+            const size_t docSkinIndex = doc.skins.GetIndex(node.skinId);
+
+            if (skinIndices[docSkinIndex] == NoSkin)
+            {
+                const auto& skin = doc.skins[docSkinIndex];
+
+                for (const auto& jointId : skin.jointIds)
+                {
+                    const size_t jointSceneIndex = sceneGraph.GetSceneIndex(doc.nodes.GetIndex(jointId));
+
+                    if (jointSceneIndex == SceneGraph::NoIndex)
+                    {
+                        throw GLTFException("Joint " + jointId + " of skin " + skin.id + " is not in the scene graph - the bounds of node " + node.id + " are unknown");
+                    }
+
+                    m_jointSceneIndices.push_back(jointSceneIndex);
+                }
+
+                if (skin.inverseBindMatricesAccessorId.empty())
+                {
+                    for (size_t i = 0; i < skin.jointIds.size(); ++i)
+                    {
+                        m_inverseBindMatrices.insert(m_inverseBindMatrices.end(), Matrix4::IDENTITY.values.begin(), Matrix4::IDENTITY.values.end());
+                    }
+                }
+                else
+                {
+                    if (!reader)
+                    {
+                        throw GLTFException("Skin " + skin.id + " has inverse bind matrices - a GLTFResourceReader is required to bound node " + node.id);
+                    }
+
+                    const auto inverseBindMatrices = AnimationUtils::GetInverseBindMatrices(doc, *reader, skin);
+
+                    if (inverseBindMatrices.size() != skin.jointIds.size() * 16U)
+                    {
+                        throw GLTFException("Skin " + skin.id + " inverse bind matrix count does not match its joint count");
+                    }
+
+                    m_inverseBindMatrices.insert(m_inverseBindMatrices.end(), inverseBindMatrices.begin(), inverseBindMatrices.end());
+                }
+
+                skinIndices[docSkinIndex] = m_skinJointOffsets.size() - 1U;
+                m_skinJointOffsets.push_back(m_jointSceneIndices.size());
+            }
+
+            skinIndex = skinIndices[docSkinIndex];
+        }
+
+        m_sceneIndices.push_back(sceneIndex);
+        m_localBounds.push_back(meshBounds[meshIndex]);
+        m_itemSkins.push_back(skinIndex);
+        m_itemBounds.push_back(GetWorldBounds(m_itemBounds.size(), sceneGraph));
+    }
+
+    Build(threadCount);
+}
+
+size_t SceneBVH::GetItemCount() const
+{
+    return m_sceneIndices.size();
+}
+
+const std::vector<size_t>& SceneBVH::GetSceneIndices() const
+{
+    return m_sceneIndices;
+}
+
+const std::vector<BoundingBox>& SceneBVH::GetItemBounds() const
+{
+    return m_itemBounds;
+}
+
+const std::vector<BVHNode>& SceneBVH::GetNodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<size_t>& SceneBVH::GetLeafItems() const
+{
+    return m_leafItems;
+}
+
+void SceneBVH::QueryBox(const BoundingBox& box, std::vector<size_t>& sceneIndices) const
+{
+    TraverseBVH(m_nodes, m_leafItems,
+        [&box](const BVHNode& node) { return node.bounds.Intersects(box); },
+        [this, &box, &sceneIndices](size_t item)
+    {
+        if (m_itemBounds[item].Intersects(box))
+        {
+            sceneIndices.push_back(m_sceneIndices[item]);
+        }
+    });
+}
+
+void SceneBVH::QueryFrustum(const std::vector<Plane>& planes, std::vector<size_t>& sceneIndices) const
+{
+    TraverseBVH(m_nodes, m_leafItems,
+        [&planes](const BVHNode& node) { return !IsOutside(node.bounds, planes); },
+        [this, &planes, &sceneIndices](size_t item)
+    {
+        if (!IsOutside(m_itemBounds[item], planes))
+        {
+            sceneIndices.push_back(m_sceneIndices[item]);
+        }
+    });
+}
+
+void SceneBVH::QueryRay(const Vector3& origin, const Vector3& direction, float maxDistance, std::vector<RayHit>& hits) const
+{
+    const float rayOrigin[3] = { origin.x, origin.y, origin.z };
+    const bool isParallel[3] = { direction.x == 0.0f, direction.y == 0.0f, direction.z == 0.0f };
+    const float inverseDirection[3] = {
+        isParallel[0] ? 0.0f : 1.0f / direction.x,
+        isParallel[1] ? 0.0f : 1.0f / direction.y,
+        isParallel[2] ? 0.0f : 1.0f / direction.z
+    };
+
+    const size_t firstHit = hits.size();
+
+    TraverseBVH(m_nodes, m_leafItems,
+        [&](const BVHNode& node) { return IntersectRay(node.bounds, rayOrigin, inverseDirection, isParallel, maxDistance) >= 0.0f; },
+        [&](size_t item)
+    {
+        const float distance = IntersectRay(m_itemBounds[item], rayOrigin, inverseDirection, isParallel, maxDistance);
+
+        if (distance >= 0.0f)
+        {
+            hits.push_back({ m_sceneIndices[item], distance });
+        }
+    });
+
+    std::sort(hits.begin() + firstHit, hits.end(), [](const RayHit& a, const RayHit& b) { return a.distance < b.distance; });
+}
+
+void SceneBVH::Refit(const SceneGraph& sceneGraph, size_t threadCount)
+{
+    ParallelUtils::ParallelFor(m_sceneIndices.size(), [this, &sceneGraph](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_itemBounds[i] = GetWorldBounds(i, sceneGraph);
+        }
+    }, threadCount, MinParallelItemCount);
+
+    // Children are always allocated after their parent so a reverse pass visits children first
+    for (size_t i = m_nodes.size(); i-- > 0U;)
+    {
+        auto& node = m_nodes[i];
+
+        node.bounds = GetEmptyBox();
+
+        if (node.count > 0U)
+        {
+            for (size_t j = node.first; j < node.first + node.count; ++j)
+            {
+                Grow(node.bounds, m_itemBounds[m_leafItems[j]]);
+            }
+        }
+        else
+        {
+            Grow(node.bounds, m_nodes[node.first].bounds);
+            Grow(node.bounds, m_nodes[node.first + 1U].bounds);
+        }
+    }
+}
+
+std::vector<Plane> SceneBVH::GetFrustumPlanes(const std::array<float, 16>& m)
+{
+    // Gribb and Hartmann's method: each plane is the sum or difference of the fourth row and one of the first three
+    std::vector<Plane> planes;
+
+    for (size_t row = 0; row < 3U; ++row)
+    {
+        for (const float sign : { 1.0f, -1.0f })
+        {
+            Plane plane = {
+                m[3] + sign * m[row],
+                m[7] + sign * m[4U + row],
+                m[11] + sign * m[8U + row],
+                m[15] + sign * m[12U + row]
+            };
+
+            const float length = std::sqrt(plane.a * plane.a + plane.b * plane.b + plane.c * plane.c);
+
+            if (length > 0.0f)
+            {
+                plane = { plane.a / length, plane.b / length, plane.c / length, plane.d / length };
+            }
+
+            planes.push_back(plane);
+        }
+    }
+
+    return planes;
+}
+
+BoundingBox SceneBVH::GetWorldBounds(size_t item, const SceneGraph& sceneGraph) const
+{
+    const size_t skinIndex = m_itemSkins[item];
+
+    if (skinIndex == NoSkin)
+    {
+        return TransformBox(m_localBounds[item], sceneGraph.GetWorldMatrix(m_sceneIndices[item]));
+    }
+
+    // The node's own transform is ignored - the mesh is placed by the joints (see the class comment)
+    BoundingBox bounds = GetEmptyBox();
+
+    for (size_t joint = m_skinJointOffsets[skinIndex]; joint < m_skinJointOffsets[skinIndex + 1U]; ++joint)
+    {
+        float jointMatrix[16];
+        Internal::MultiplyMatrices(sceneGraph.GetWorldMatrix(m_jointSceneIndices[joint]), &m_inverseBindMatrices[joint * 16U], jointMatrix);
+
+        Grow(bounds, TransformBox(m_localBounds[item], jointMatrix));
+    }
+
+    return bounds;
+}
+
+void SceneBVH::Build(size_t threadCount)
+{
+    const size_t itemCount = m_itemBounds.size();
+
+    m_nodes.clear();
+    m_leafItems.resize(itemCount);
+    std::iota(m_leafItems.begin(), m_leafItems.end(), size_t(0U));
+
+    if (itemCount == 0U)
+    {
+        return;
+    }
+
+    std::vector<Vector3> centroids(itemCount);
+
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        const auto& bounds = m_itemBounds[i];
+        centroids[i] = { (bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f };
+    }
+
+    // A binary tree with at least one item per leaf has at most 2n - 1 nodes. Nodes are allocated in pairs, by
+    // whichever thread splits their parent.
+    m_nodes.resize(itemCount * 2U - 1U);
+    std::atomic<size_t> nodeCount(1U);
+
+    struct Task
+    {
+        size_t node;
+        size_t begin;
+        size_t end;
+    };
+
+    ParallelUtils::ParallelForEachTask(std::vector<Task>({ { 0U, 0U, itemCount } }), [&](const Task& rootTask, size_t threadIndex, ParallelUtils::WorkStealingQueues<Task>& queues)
+    {
+        Task task = rootTask;
+
+        for (;;)
+        {
+            auto& node = m_nodes[task.node];
+
+            BoundingBox centroidBounds = GetEmptyBox();
+            node.bounds = GetEmptyBox();
+
+            for (size_t i = task.begin; i < task.end; ++i)
+            {
+                const size_t item = m_leafItems[i];
+
+                Grow(node.bounds, m_itemBounds[item]);
+                Grow(centroidBounds, { centroids[item], centroids[item] });
+            }
+
+            const size_t count = task.end - task.begin;
+
+            if (count <= MaxLeafItemCount)
+            {
+                node.first = task.begin;
+                node.count = count;
+                return;
+            }
+
+            // Find the bin boundary, on any axis, that minimizes the surface area heuristic
+            size_t bestAxis = 0U;
+            size_t bestBin = BinCount;
+            float bestCost = std::numeric_limits<float>::max();
+
+            for (size_t axis = 0; axis < 3U; ++axis)
+            {
+                const float min = GetComponent(centroidBounds.min, axis);
+                const float extent = GetComponent(centroidBounds.max, axis) - min;
+
+                if (!(extent > 0.0f))
+                {
+                    continue;
+                }
+
+                const float scale = BinCount / extent;
+
+                size_t binCounts[BinCount] = {};
+                BoundingBox binBounds[BinCount];
+                std::fill(std::begin(binBounds), std::end(binBounds), GetEmptyBox());
+
+                for (size_t i = task.begin; i < task.end; ++i)
+                {
+                    const size_t item = m_leafItems[i];
+                    const size_t bin = std::min(BinCount - 1U, static_cast<size_t>((GetComponent(centroids[item], axis) - min) * scale));
+
+                    ++binCounts[bin];
+                    Grow(binBounds[bin], m_itemBounds[item]);
+                }
+
+                // Sweep from the right to find the cost of everything after each boundary, then from the left
+                float rightAreas[BinCount];
+                size_t rightCounts[BinCount];
+
+                BoundingBox rightBounds = GetEmptyBox();
+                size_t rightCount = 0U;
+
+                for (size_t bin = BinCount - 1U; bin > 0U; --bin)
+                {
+                    Grow(rightBounds, binBounds[bin]);
+                    rightCount += binCounts[bin];
+
+                    rightAreas[bin] = GetSurfaceArea(rightBounds);
+                    rightCounts[bin] = rightCount;
+                }
+
+                BoundingBox leftBounds = GetEmptyBox();
+                size_t leftCount = 0U;
+
+                for (size_t bin = 0; bin < BinCount - 1U; ++bin)
+                {
+                    Grow(leftBounds, binBounds[bin]);
+                    leftCount += binCounts[bin];
+
+                    if (leftCount == 0U || rightCounts[bin + 1U] == 0U)
+                    {
+                        continue;
+                    }
+
+                    const float cost = leftCount * GetSurfaceArea(leftBounds) + rightCounts[bin + 1U] * rightAreas[bin + 1U];
+
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = bin;
+                    }
+                }
+            }
+
+            size_t split = task.begin;
+
+            if (bestBin < BinCount)
+            {
+                const float min = GetComponent(centroidBounds.min, bestAxis);
+                const float scale = BinCount / (GetComponent(centroidBounds.max, bestAxis) - min);
+
+                split = static_cast<size_t>(std::partition(m_leafItems.begin() + task.begin, m_leafItems.begin() + task.end, [&](size_t item)
+                {
+                    return std::min(BinCount - 1U, static_cast<size_t>((GetComponent(centroids[item], bestAxis) - min) * scale)) <= bestBin;
+                }) - m_leafItems.begin());
+            }
+
+            // Items whose centroids coincide can't be separated by binning - split them evenly instead
+            if (split == task.begin || split == task.end)
+            {
+                split = task.begin + count / 2U;
+            }
+
+            const size_t children = nodeCount.fetch_add(2U);
+
+            node.first = children;
+            node.count = 0U;
+
+            // Leave the left child for an idle thread and continue with the right
+            queues.Push(threadIndex, { children, task.begin, split });
+            task = { children + 1U, split, task.end };
+        }
+    }, threadCount);
+
+    m_nodes.resize(nodeCount);
+}
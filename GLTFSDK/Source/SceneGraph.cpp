@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/SceneGraph.h>
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include "MatrixUtilsInternal.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Updates touching fewer nodes than this are done on the calling thread
+    const size_t MinParallelNodeCount = 4096U;
+}
+
+const size_t SceneGraph::NoIndex;
+
+SceneGraph::SceneGraph(const Document& doc)
+{
+    std::vector<bool> hasParent(doc.nodes.Size(), false);
+
+    for (const auto& node : doc.nodes.Elements())
+    {
+        for (const auto& childId : node.children)
+        {
+            hasParent[doc.nodes.GetIndex(childId)] = true;
+        }
+    }
+
+    std::vector<size_t> rootIndices;
+
+    for (size_t i = 0; i < hasParent.size(); ++i)
+    {
+        if (!hasParent[i])
+        {
+            rootIndices.push_back(i);
+        }
+    }
+
+    Flatten(doc, rootIndices);
+}
+
+SceneGraph::SceneGraph(const Document& doc, const Scene& scene)
+{
+    std::vector<size_t> rootIndices;
+    rootIndices.reserve(scene.nodes.size());
+
+    for (const auto& nodeId : scene.nodes)
+    {
+        rootIndices.push_back(doc.nodes.GetIndex(nodeId));
+    }
+
+    Flatten(doc, rootIndices);
+}
+
+size_t SceneGraph::GetNodeCount() const
+{
+    return m_nodeIndices.size();
+}
+
+size_t SceneGraph::GetNodeIndex(size_t sceneIndex) const
+{
+    return m_nodeIndices.at(sceneIndex);
+}
+
+size_t SceneGraph::GetSceneIndex(size_t nodeIndex) const
+{
+    return nodeIndex < m_sceneIndices.size() ? m_sceneIndices[nodeIndex] : NoIndex;
+}
+
+const std::vector<size_t>& SceneGraph::GetParentIndices() const
+{
+    return m_parentIndices;
+}
+
+const std::vector<size_t>& SceneGraph::GetSubtreeEnds() const
+{
+    return m_subtreeEnds;
+}
+
+const std::vector<float>& SceneGraph::GetLocalMatrices() const
+{
+    return m_localMatrices;
+}
+
+const std::vector<float>& SceneGraph::GetWorldMatrices() const
+{
+    return m_worldMatrices;
+}
+
+const float* SceneGraph::GetLocalMatrix(size_t sceneIndex) const
+{
+    return &m_localMatrices.at(sceneIndex * 16U);
+}
+
+const float* SceneGraph::GetWorldMatrix(size_t sceneIndex) const
+{
+    return &m_worldMatrices.at(sceneIndex * 16U);
+}
+
+void SceneGraph::SetLocalMatrix(size_t sceneIndex, const float* matrix)
+{
+    MarkDirty(sceneIndex);
+    std::copy_n(matrix, 16U, &m_localMatrices[sceneIndex * 16U]);
+}
+
+void SceneGraph::SetLocalTransform(size_t sceneIndex, const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+{
+    MarkDirty(sceneIndex);
+    Internal::ComposeMatrix(translation, rotation, scale, &m_localMatrices[sceneIndex * 16U]);
+}
+
+bool SceneGraph::IsDirty() const
+{
+    return !m_dirtyNodes.empty();
+}
+
+void SceneGraph::UpdateWorldMatrices(size_t threadCount)
+{
+    if (m_dirtyNodes.empty())
+    {
+        return;
+    }
+
+    // Discard dirty nodes within the subtree of another dirty node. Nodes are in pre-order so, once sorted, a node is
+    // within an earlier node's subtree if its index is less than the end of that subtree.
+    std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end());
+
+    std::vector<size_t> subtrees;
+    size_t subtreesEnd = 0U;
+    size_t dirtyNodeCount = 0U;
+
+    for (const size_t sceneIndex : m_dirtyNodes)
+    {
+        if (sceneIndex >= subtreesEnd)
+        {
+            subtrees.push_back(sceneIndex);
+            subtreesEnd = m_subtreeEnds[sceneIndex];
+            dirtyNodeCount += subtreesEnd - sceneIndex;
+        }
+    }
+
+    m_dirtyNodes.clear();
+
+    if (threadCount == 0U)
+    {
+        threadCount = ParallelUtils::GetDefaultThreadCount();
+    }
+
+    if (threadCount <= 1U || dirtyNodeCount < MinParallelNodeCount)
+    {
+        for (const size_t sceneIndex : subtrees)
+        {
+            UpdateSubtree(sceneIndex);
+        }
+
+        return;
+    }
+
+    // Split large subtrees into the subtrees of their children (updating the split node first) until every piece is
+    // small enough for the pieces to be balanced across threads
+    const size_t maxSubtreeSize = std::max(MinParallelNodeCount, dirtyNodeCount / (threadCount * 8U));
+
+    std::vector<size_t> pieces;
+    std::vector<size_t> stack(subtrees.rbegin(), subtrees.rend());
+
+    while (!stack.empty())
+    {
+        const size_t sceneIndex = stack.back();
+        stack.pop_back();
+
+        const size_t subtreeEnd = m_subtreeEnds[sceneIndex];
+
+        if (subtreeEnd - sceneIndex <= maxSubtreeSize)
+        {
+            pieces.push_back(sceneIndex);
+            continue;
+        }
+
+        UpdateWorldMatrix(sceneIndex);
+
+        for (size_t child = sceneIndex + 1U; child < subtreeEnd; child = m_subtreeEnds[child])
+        {
+            stack.push_back(child);
+        }
+    }
+
+    ParallelUtils::ParallelFor(pieces.size(), [this, &pieces](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            UpdateSubtree(pieces[i]);
+        }
+    }, threadCount);
+}
+
+void SceneGraph::Flatten(const Document& doc, const std::vector<size_t>& rootIndices)
+{
+    m_sceneIndices.assign(doc.nodes.Size(), NoIndex);
+
+    // Depth-first traversal that resolves each child id once. Children are pushed in reverse so they are numbered in order.
+    std::vector<std::pair<size_t, size_t>> stack; // Node index, parent scene index
+
+    for (auto it = rootIndices.rbegin(); it != rootIndices.rend(); ++it)
+    {
+        stack.emplace_back(*it, NoIndex);
+    }
+
+    while (!stack.empty())
+    {
+        const size_t nodeIndex = stack.back().first;
+        const size_t parentIndex = stack.back().second;
+        stack.pop_back();
+
+        const auto& node = doc.nodes[nodeIndex];
+
+        if (m_sceneIndices[nodeIndex] != NoIndex)
+        {
+            throw GLTFException("Node " + node.id + " is reachable more than once from the scene's root nodes");
+        }
+
+        const size_t sceneIndex = m_nodeIndices.size();
+
+        m_sceneIndices[nodeIndex] = sceneIndex;
+        m_nodeIndices.push_back(nodeIndex);
+        m_parentIndices.push_back(parentIndex);
+
+        m_localMatrices.resize(m_localMatrices.size() + 16U);
+
+        if (node.GetTransformationType() == TRANSFORMATION_MATRIX)
+        {
+            std::copy(node.matrix.values.begin(), node.matrix.values.end(), m_localMatrices.end() - 16U);
+        }
+        else
+        {
+            Internal::ComposeMatrix(node.translation, node.rotation, node.scale, &m_localMatrices[sceneIndex * 16U]);
+        }
+
+        for (auto itChild = node.children.rbegin(); itChild != node.children.rend(); ++itChild)
+        {
+            stack.emplace_back(doc.nodes.GetIndex(*itChild), sceneIndex);
+        }
+    }
+
+    // In pre-order a node's subtree ends where the subtree of its last child ends
+    m_subtreeEnds.resize(m_nodeIndices.size());
+
+    for (size_t i = 0; i < m_subtreeEnds.size(); ++i)
+    {
+        m_subtreeEnds[i] = i + 1U;
+    }
+
+    for (size_t i = m_subtreeEnds.size(); i-- > 0U;)
+    {
+        if (m_parentIndices[i] != NoIndex)
+        {
+            m_subtreeEnds[m_parentIndices[i]] = std::max(m_subtreeEnds[m_parentIndices[i]], m_subtreeEnds[i]);
+        }
+    }
+
+    m_worldMatrices.resize(m_localMatrices.size());
+
+    for (size_t i = 0; i < m_nodeIndices.size(); i = m_subtreeEnds[i])
+    {
+        m_dirtyNodes.push_back(i);
+    }
+
+    UpdateWorldMatrices();
+}
+
+void SceneGraph::MarkDirty(size_t sceneIndex)
+{
+    if (sceneIndex >= m_nodeIndices.size())
+    {
+        throw GLTFException("Scene graph node index " + std::to_string(sceneIndex) + " is out of range");
+    }
+
+    m_dirtyNodes.push_back(sceneIndex);
+}
+
+void SceneGraph::UpdateWorldMatrix(size_t sceneIndex)
+{
+    const float* localMatrix = &m_localMatrices[sceneIndex * 16U];
+    float* worldMatrix = &m_worldMatrices[sceneIndex * 16U];
+
+    const size_t parentIndex = m_parentIndices[sceneIndex];
+
+    if (parentIndex == NoIndex)
+    {
+        std::copy_n(localMatrix, 16U, worldMatrix);
+    }
+    else
+    {
+        Internal::MultiplyMatrices(&m_worldMatrices[parentIndex * 16U], localMatrix, worldMatrix);
+    }
+}
+
+void SceneGraph::UpdateSubtree(size_t sceneIndex)
+{
+    const size_t subtreeEnd = m_subtreeEnds[sceneIndex];
+
+    for (size_t i = sceneIndex; i < subtreeEnd; ++i)
+    {
+        UpdateWorldMatrix(i);
+    }
+}
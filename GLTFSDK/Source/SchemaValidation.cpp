@@ -3,6 +3,8 @@
 
 #include <GLTFSDK/SchemaValidation.h>
 #include <GLTFSDK/Exceptions.h>
+#include <GLTFSDK/Instrumentation.h>
+#include <GLTFSDK/Validation.h>
 
 #include <unordered_map>
 
@@ -52,10 +54,112 @@ namespace
     private:
         std::unordered_map<std::string, rapidjson::SchemaDocument> schemaDocuments;
     };
+
+    // Converts a URI fragment identifier ("#/meshes/0") to a JSON pointer ("/meshes/0")
+    std::string GetPointer(const std::string& uriFragment)
+    {
+        std::string pointer;
+
+        for (size_t i = (uriFragment.empty() || uriFragment[0] != '#') ? 0U : 1U; i < uriFragment.size(); ++i)
+        {
+            if (uriFragment[i] == '%' && i + 2U < uriFragment.size())
+            {
+                pointer += static_cast<char>(std::stoi(uriFragment.substr(i + 1U, 2U), nullptr, 16));
+                i += 2U;
+            }
+            else
+            {
+                pointer += uriFragment[i];
+            }
+        }
+
+        return pointer;
+    }
+
+    template<typename Value>
+    void AddSchemaIssues(const Value& errors, ValidationReport& report);
+
+    template<typename Value>
+    void AddSchemaIssue(const std::string& keyword, const Value& error, ValidationReport& report)
+    {
+        if (!error.IsObject())
+        {
+            return;
+        }
+
+        // Keywords that combine subschemas (allOf, anyOf, oneOf) report the errors of each subschema
+        const auto itErrors = error.FindMember("errors");
+
+        if (itErrors != error.MemberEnd() && itErrors->value.IsArray() && !itErrors->value.Empty())
+        {
+            for (const auto& subschemaErrors : itErrors->value.GetArray())
+            {
+                AddSchemaIssues(subschemaErrors, report);
+            }
+
+            return;
+        }
+
+        std::string instanceRef;
+
+        const auto itInstanceRef = error.FindMember("instanceRef");
+
+        if (itInstanceRef != error.MemberEnd() && itInstanceRef->value.IsString())
+        {
+            instanceRef.assign(itInstanceRef->value.GetString(), itInstanceRef->value.GetStringLength());
+        }
+
+        ValidationIssue issue;
+        issue.pointer = GetPointer(instanceRef);
+        issue.message = "Schema violation at " + instanceRef + " due to " + keyword;
+
+        // The first two tokens of a pointer to a top-level entity are its type and index, e.g. "/meshes/0/primitives"
+        const size_t typeEnd = issue.pointer.find('/', 1U);
+
+        if (typeEnd != std::string::npos)
+        {
+            issue.entityType = issue.pointer.substr(1U, typeEnd - 1U);
+
+            const size_t idEnd = issue.pointer.find('/', typeEnd + 1U);
+            issue.entityId = issue.pointer.substr(typeEnd + 1U, idEnd == std::string::npos ? std::string::npos : idEnd - typeEnd - 1U);
+        }
+
+        report.Add(std::move(issue));
+    }
+
+    // Errors are an object with a member for each keyword that failed, whose value is an error object or, if the
+    // keyword failed more than once, an array of them
+    template<typename Value>
+    void AddSchemaIssues(const Value& errors, ValidationReport& report)
+    {
+        if (!errors.IsObject())
+        {
+            return;
+        }
+
+        for (auto it = errors.MemberBegin(); it != errors.MemberEnd(); ++it)
+        {
+            const std::string keyword(it->name.GetString(), it->name.GetStringLength());
+
+            if (it->value.IsArray())
+            {
+                for (const auto& error : it->value.GetArray())
+                {
+                    AddSchemaIssue(keyword, error, report);
+                }
+            }
+            else
+            {
+                AddSchemaIssue(keyword, it->value, report);
+            }
+        }
+    }
 }
 
 void Microsoft::glTF::ValidateDocumentAgainstSchema(const rapidjson::Document& document, const std::string& schemaUri, std::unique_ptr<const ISchemaLocator> schemaLocator)
 {
+    GLTFSDK_INSTRUMENT_SCOPE("ValidateDocumentAgainstSchema");
+
     if (!schemaLocator)
     {
         throw GLTFException("ISchemaLocator instance must not be null");
@@ -83,3 +187,32 @@ void Microsoft::glTF::ValidateDocumentAgainstSchema(const rapidjson::Document& d
         throw GLTFException("Schema document at " + schemaUri + " could not be located");
     }
 }
+
+void Microsoft::glTF::ValidateDocumentAgainstSchema(const rapidjson::Document& document, const std::string& schemaUri, std::unique_ptr<const ISchemaLocator> schemaLocator, ValidationReport& report)
+{
+    GLTFSDK_INSTRUMENT_SCOPE("ValidateDocumentAgainstSchema");
+
+    if (!schemaLocator)
+    {
+        throw GLTFException("ISchemaLocator instance must not be null");
+    }
+
+    RemoteSchemaDocumentProvider provider(std::move(schemaLocator));
+
+    if (auto* schemaDocument = provider.GetRemoteDocumentStr(schemaUri))
+    {
+        rapidjson::SchemaValidator schemaValidator(*schemaDocument);
+
+        // Validation continues after a violation so that every violation is found in a single pass
+        schemaValidator.SetValidateFlags(rapidjson::kValidateContinueOnErrorFlag);
+
+        if (!document.Accept(schemaValidator))
+        {
+            AddSchemaIssues(schemaValidator.GetError(), report);
+        }
+    }
+    else
+    {
+        throw GLTFException("Schema document at " + schemaUri + " could not be located");
+    }
+}
@@ -6,6 +6,7 @@
 #include <GLTFSDK/Document.h>
 #include <GLTFSDK/ExtensionHandlers.h>
 #include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/Instrumentation.h>
 #include <GLTFSDK/RapidJsonUtils.h>
 
 using namespace Microsoft::glTF;
@@ -868,7 +869,16 @@ std::string Microsoft::glTF::Serialize(const Document& gltfDocument, SerializeFl
 
 std::string Microsoft::glTF::Serialize(const Document& gltfDocument, const ExtensionSerializer& extensionSerializer, SerializeFlags flags)
 {
-    auto doc = CreateJsonDocument(gltfDocument, extensionSerializer);
+    GLTFSDK_INSTRUMENT_SCOPE("Serialize");
+
+    auto doc = [&gltfDocument, &extensionSerializer]()
+    {
+        GLTFSDK_INSTRUMENT_SCOPE("Serialize::Build");
+
+        return CreateJsonDocument(gltfDocument, extensionSerializer);
+    }();
+
+    GLTFSDK_INSTRUMENT_SCOPE("Serialize::Write");
 
     rapidjson::StringBuffer stringBuffer;
     if (HasFlag(flags, SerializeFlags::Pretty))
@@ -882,6 +892,8 @@ std::string Microsoft::glTF::Serialize(const Document& gltfDocument, const Exten
         doc.Accept(writer);
     }
 
+    GLTFSDK_INSTRUMENT_COUNTER("Serialize::Bytes", stringBuffer.GetSize());
+
     return stringBuffer.GetString();
 }
 
@@ -0,0 +1,320 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/SkinEvaluator.h>
+
+#include <GLTFSDK/AnimationEvaluator.h>
+#include <GLTFSDK/AnimationUtils.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include "MatrixUtilsInternal.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    const size_t NoParent = std::numeric_limits<size_t>::max();
+
+    // Instances per range when computing palettes across threads
+    const size_t MinParallelInstanceCount = 16U;
+}
+
+JointPalette::JointPalette(size_t jointCount, size_t instanceCount) :
+    m_storage(new uint8_t[jointCount * instanceCount * 16U * sizeof(float) + PaletteAlignment]()),
+    m_data(nullptr),
+    m_jointCount(jointCount),
+    m_instanceCount(instanceCount)
+{
+    const auto address = reinterpret_cast<uintptr_t>(m_storage.get());
+    const auto alignedAddress = (address + PaletteAlignment - 1U) & ~static_cast<uintptr_t>(PaletteAlignment - 1U);
+
+    m_data = reinterpret_cast<float*>(alignedAddress);
+}
+
+float* JointPalette::GetData()
+{
+    return m_data;
+}
+
+const float* JointPalette::GetData() const
+{
+    return m_data;
+}
+
+float* JointPalette::GetInstanceData(size_t instance)
+{
+    return m_data + instance * m_jointCount * 16U;
+}
+
+const float* JointPalette::GetInstanceData(size_t instance) const
+{
+    return m_data + instance * m_jointCount * 16U;
+}
+
+size_t JointPalette::GetJointCount() const
+{
+    return m_jointCount;
+}
+
+size_t JointPalette::GetInstanceCount() const
+{
+    return m_instanceCount;
+}
+
+SkinEvaluator::SkinEvaluator(const Document& doc, const GLTFResourceReader& reader, const Skin& skin)
+{
+    std::unordered_map<std::string, std::string> parentIds;
+
+    for (const auto& node : doc.nodes.Elements())
+    {
+        for (const auto& childId : node.children)
+        {
+            parentIds[childId] = node.id;
+        }
+    }
+
+    // Add each joint after its ancestors so that world transforms can be computed in a single pass
+    std::vector<std::string> chain;
+
+    for (const auto& jointId : skin.jointIds)
+    {
+        chain.clear();
+
+        for (auto nodeId = jointId; m_nodeIndices.find(nodeId) == m_nodeIndices.end();)
+        {
+            if (chain.size() > doc.nodes.Size())
+            {
+                throw GLTFException("Node hierarchy of skin " + skin.id + " contains a cycle");
+            }
+
+            chain.push_back(nodeId);
+
+            auto itParent = parentIds.find(nodeId);
+
+            if (itParent == parentIds.end())
+            {
+                break;
+            }
+
+            nodeId = itParent->second;
+        }
+
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            const auto& node = doc.nodes.Get(*it);
+            const auto itParent = parentIds.find(node.id);
+
+            m_parents.push_back(itParent == parentIds.end() ? NoParent : m_nodeIndices.at(itParent->second));
+            m_nodeIndices.emplace(node.id, m_nodeIds.size());
+            m_nodeIds.push_back(node.id);
+
+            m_restTransforms.insert(m_restTransforms.end(), {
+                node.translation.x, node.translation.y, node.translation.z,
+                node.rotation.x, node.rotation.y, node.rotation.z, node.rotation.w,
+                node.scale.x, node.scale.y, node.scale.z });
+
+            const bool hasMatrix = node.GetTransformationType() == TRANSFORMATION_MATRIX;
+            m_hasMatrix.push_back(hasMatrix);
+
+            if (hasMatrix)
+            {
+                m_restMatrices.insert(m_restMatrices.end(), node.matrix.values.begin(), node.matrix.values.end());
+            }
+            else
+            {
+                const float* transform = &m_restTransforms[m_restTransforms.size() - 10U];
+
+                m_restMatrices.resize(m_restMatrices.size() + 16U);
+                Internal::ComposeMatrix(transform, transform + 3U, transform + 7U, &m_restMatrices[m_restMatrices.size() - 16U]);
+            }
+        }
+
+        m_jointNodes.push_back(m_nodeIndices.at(jointId));
+    }
+
+    if (skin.inverseBindMatricesAccessorId.empty())
+    {
+        // Without inverse bind matrices each one is the identity
+        for (size_t i = 0; i < skin.jointIds.size(); ++i)
+        {
+            m_inverseBindMatrices.insert(m_inverseBindMatrices.end(), Matrix4::IDENTITY.values.begin(), Matrix4::IDENTITY.values.end());
+        }
+    }
+    else
+    {
+        m_inverseBindMatrices = AnimationUtils::GetInverseBindMatrices(doc, reader, skin);
+
+        if (m_inverseBindMatrices.size() != skin.jointIds.size() * 16U)
+        {
+            throw GLTFException("Skin " + skin.id + " inverse bind matrix count does not match its joint count");
+        }
+    }
+}
+
+size_t SkinEvaluator::GetJointCount() const
+{
+    return m_jointNodes.size();
+}
+
+const std::vector<std::string>& SkinEvaluator::GetNodeIds() const
+{
+    return m_nodeIds;
+}
+
+size_t SkinEvaluator::GetPaletteSize() const
+{
+    return m_jointNodes.size() * 16U;
+}
+
+void SkinEvaluator::ComputePalette(float* palette) const
+{
+    ComputePalette(m_restMatrices.data(), palette);
+}
+
+void SkinEvaluator::ComputePalette(const float* localMatrices, float* palette) const
+{
+    std::vector<float> worldMatrices(m_nodeIds.size() * 16U);
+    ComputePalette(localMatrices, worldMatrices.data(), palette);
+}
+
+void SkinEvaluator::ComputePalette(const AnimationEvaluator& evaluator, const float* animationOutput, float* palette) const
+{
+    std::vector<float> transforms(m_restTransforms.size());
+    std::vector<float> localMatrices(m_nodeIds.size() * 16U);
+    std::vector<float> worldMatrices(m_nodeIds.size() * 16U);
+
+    ComputePalette(evaluator, GetTrackNodes(evaluator), animationOutput, transforms.data(), localMatrices.data(), worldMatrices.data(), palette);
+}
+
+void SkinEvaluator::ComputePalettes(const float* localMatrices, size_t instanceCount, float* palettes, size_t threadCount) const
+{
+    const size_t nodeCount = m_nodeIds.size();
+    const size_t paletteSize = GetPaletteSize();
+
+    ParallelUtils::ParallelFor(instanceCount, [&](size_t begin, size_t end)
+    {
+        std::vector<float> worldMatrices(nodeCount * 16U);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            ComputePalette(localMatrices + i * nodeCount * 16U, worldMatrices.data(), palettes + i * paletteSize);
+        }
+    }, threadCount, MinParallelInstanceCount);
+}
+
+void SkinEvaluator::ComputePalettes(const AnimationEvaluator& evaluator, const float* times, size_t instanceCount, float* palettes, size_t threadCount) const
+{
+    const auto trackNodes = GetTrackNodes(evaluator);
+
+    const size_t nodeCount = m_nodeIds.size();
+    const size_t paletteSize = GetPaletteSize();
+
+    ParallelUtils::ParallelFor(instanceCount, [&](size_t begin, size_t end)
+    {
+        std::vector<float> animationOutput(evaluator.GetOutputSize());
+        std::vector<size_t> cursors;
+
+        std::vector<float> transforms(m_restTransforms.size());
+        std::vector<float> localMatrices(nodeCount * 16U);
+        std::vector<float> worldMatrices(nodeCount * 16U);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            evaluator.Evaluate(times[i], animationOutput.data(), cursors);
+            ComputePalette(evaluator, trackNodes, animationOutput.data(), transforms.data(), localMatrices.data(), worldMatrices.data(), palettes + i * paletteSize);
+        }
+    }, threadCount, MinParallelInstanceCount);
+}
+
+std::vector<size_t> SkinEvaluator::GetTrackNodes(const AnimationEvaluator& evaluator) const
+{
+    std::vector<size_t> trackNodes;
+    trackNodes.reserve(evaluator.GetTracks().size());
+
+    // Tracks that don't target a skeleton node, or that target a node with a matrix transform, are ignored
+    for (const auto& track : evaluator.GetTracks())
+    {
+        const auto it = m_nodeIndices.find(track.nodeId);
+        trackNodes.push_back(it == m_nodeIndices.end() || m_hasMatrix[it->second] ? NoParent : it->second);
+    }
+
+    return trackNodes;
+}
+
+void SkinEvaluator::ComputePalette(const AnimationEvaluator& evaluator, const std::vector<size_t>& trackNodes, const float* animationOutput,
+    float* transforms, float* localMatrices, float* worldMatrices, float* palette) const
+{
+    const auto& tracks = evaluator.GetTracks();
+
+    // Start from the rest pose and overwrite the components targeted by the animation
+    std::copy(m_restTransforms.begin(), m_restTransforms.end(), transforms);
+
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        if (trackNodes[i] == NoParent)
+        {
+            continue;
+        }
+
+        const float* value = animationOutput + tracks[i].outputOffset;
+        float* transform = transforms + trackNodes[i] * 10U;
+
+        switch (tracks[i].path)
+        {
+        case TARGET_TRANSLATION:
+            std::copy_n(value, 3U, transform);
+            break;
+        case TARGET_ROTATION:
+            std::copy_n(value, 4U, transform + 3U);
+            break;
+        case TARGET_SCALE:
+            std::copy_n(value, 3U, transform + 7U);
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (size_t node = 0; node < m_nodeIds.size(); ++node)
+    {
+        if (m_hasMatrix[node])
+        {
+            std::copy_n(&m_restMatrices[node * 16U], 16U, localMatrices + node * 16U);
+        }
+        else
+        {
+            const float* transform = transforms + node * 10U;
+            Internal::ComposeMatrix(transform, transform + 3U, transform + 7U, localMatrices + node * 16U);
+        }
+    }
+
+    ComputePalette(localMatrices, worldMatrices, palette);
+}
+
+void SkinEvaluator::ComputePalette(const float* localMatrices, float* worldMatrices, float* palette) const
+{
+    for (size_t node = 0; node < m_nodeIds.size(); ++node)
+    {
+        const float* localMatrix = localMatrices + node * 16U;
+
+        if (m_parents[node] == NoParent)
+        {
+            std::copy_n(localMatrix, 16U, worldMatrices + node * 16U);
+        }
+        else
+        {
+            Internal::MultiplyMatrices(worldMatrices + m_parents[node] * 16U, localMatrix, worldMatrices + node * 16U);
+        }
+    }
+
+    for (size_t joint = 0; joint < m_jointNodes.size(); ++joint)
+    {
+        Internal::MultiplyMatrices(worldMatrices + m_jointNodes[joint] * 16U, &m_inverseBindMatrices[joint * 16U], palette + joint * 16U);
+    }
+}
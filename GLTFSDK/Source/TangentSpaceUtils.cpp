@@ -0,0 +1,395 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/TangentSpaceUtils.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Math.h>
+#include <GLTFSDK/MeshOptimizationUtils.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/ParallelUtils.h>
+
+#include "MeshUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Triangle and vertex counts below which work isn't split between threads
+    const size_t MinParallelRangeSize = 4096U;
+
+    using Internal::Vector3f;
+    using Internal::GetVector3;
+
+    // Removes the component of 'v' that is parallel to the unit vector 'n'
+    Vector3f Project(const Vector3f& v, const Vector3f& n)
+    {
+        return v - n * Dot(n, v);
+    }
+
+    // The angle between two (not necessarily unit length) vectors, zero if either is degenerate
+    float GetAngle(Vector3f a, Vector3f b)
+    {
+        if (!Normalize(a) || !Normalize(b))
+        {
+            return 0.0f;
+        }
+
+        return std::acos(Math::Clamp(Dot(a, b), -1.0f, 1.0f));
+    }
+
+    // Groups the triangle corners that reference each (remapped) vertex so that per-vertex sums can be calculated in
+    // parallel without write conflicts. The corners of vertex v are corners[offsets[v]] to corners[offsets[v + 1] - 1]
+    // in ascending order, which makes each sum independent of the number of threads used.
+    void GetVertexCorners(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap, size_t uniqueVertexCount,
+        std::vector<uint32_t>& offsets, std::vector<uint32_t>& corners)
+    {
+        offsets.assign(uniqueVertexCount + 1U, 0U);
+        corners.resize(indices.size());
+
+        for (const auto index : indices)
+        {
+            ++offsets[remap[index] + 1U];
+        }
+
+        for (size_t i = 1U; i < offsets.size(); ++i)
+        {
+            offsets[i] += offsets[i - 1U];
+        }
+
+        std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            corners[next[remap[indices[i]]]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    Vector3f GetPerpendicular(const Vector3f& n)
+    {
+        Vector3f v = std::abs(n.x) < 0.9f ? Vector3f{ 1.0f, 0.0f, 0.0f } : Vector3f{ 0.0f, 1.0f, 0.0f };
+        v = Project(v, n);
+        Normalize(v);
+        return v;
+    }
+
+    const Accessor& AddVertexAccessor(const std::vector<float>& data, AccessorType type, BufferBuilder& bufferBuilder)
+    {
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+        return bufferBuilder.AddAccessor(data, { type, COMPONENT_FLOAT });
+    }
+}
+
+std::vector<float> TangentSpaceUtils::GenerateNormals(const std::vector<uint32_t>& indices, const std::vector<float>& positions,
+    NormalWeighting weighting, size_t threadCount)
+{
+    if (positions.size() % 3U != 0U)
+    {
+        throw GLTFException("Positions must contain 3 components per vertex");
+    }
+
+    const size_t vertexCount = positions.size() / 3U;
+    const size_t triangleCount = indices.size() / 3U;
+
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    size_t uniqueVertexCount = 0U;
+    const auto remap = MeshOptimizationUtils::GenerateVertexRemap({ VertexStream(positions.data(), COMPONENT_FLOAT, 3U) }, vertexCount, uniqueVertexCount, 0.0f, threadCount);
+
+    // The weighted face normal contributed by each triangle corner
+    std::vector<Vector3f> cornerNormals(indices.size());
+
+    ParallelUtils::ParallelFor(triangleCount, [&](size_t begin, size_t end)
+    {
+        for (size_t t = begin; t < end; ++t)
+        {
+            const Vector3f p[3] = { GetVector3(positions, indices[t * 3U]), GetVector3(positions, indices[t * 3U + 1U]), GetVector3(positions, indices[t * 3U + 2U]) };
+
+            // The length of the cross product is twice the triangle's area
+            Vector3f normal = Cross(p[1] - p[0], p[2] - p[0]);
+
+            for (size_t k = 0; k < 3U; ++k)
+            {
+                cornerNormals[t * 3U + k] = normal;
+            }
+
+            if (weighting == NORMAL_WEIGHTING_ANGLE && Normalize(normal))
+            {
+                for (size_t k = 0; k < 3U; ++k)
+                {
+                    const Vector3f& corner = p[k];
+                    cornerNormals[t * 3U + k] = normal * GetAngle(p[(k + 1U) % 3U] - corner, p[(k + 2U) % 3U] - corner);
+                }
+            }
+        }
+    }, threadCount, MinParallelRangeSize);
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> corners;
+
+    GetVertexCorners(indices, remap, uniqueVertexCount, offsets, corners);
+
+    std::vector<Vector3f> uniqueNormals(uniqueVertexCount);
+
+    ParallelUtils::ParallelFor(uniqueVertexCount, [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            Vector3f normal = { 0.0f, 0.0f, 0.0f };
+
+            for (uint32_t i = offsets[v]; i < offsets[v + 1U]; ++i)
+            {
+                normal = normal + cornerNormals[corners[i]];
+            }
+
+            // Unreferenced vertices and vertices of degenerate triangles are given an arbitrary unit length normal
+            if (!Normalize(normal))
+            {
+                normal = { 0.0f, 0.0f, 1.0f };
+            }
+
+            uniqueNormals[v] = normal;
+        }
+    }, threadCount, MinParallelRangeSize);
+
+    std::vector<float> normals(positions.size());
+
+    ParallelUtils::ParallelFor(vertexCount, [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            const Vector3f& normal = uniqueNormals[remap[v]];
+
+            normals[v * 3U] = normal.x;
+            normals[v * 3U + 1U] = normal.y;
+            normals[v * 3U + 2U] = normal.z;
+        }
+    }, threadCount, MinParallelRangeSize);
+
+    return normals;
+}
+
+std::vector<float> TangentSpaceUtils::GenerateTangents(const std::vector<uint32_t>& indices, const std::vector<float>& positions,
+    const std::vector<float>& normals, const std::vector<float>& texCoords, size_t threadCount)
+{
+    if (positions.size() % 3U != 0U)
+    {
+        throw GLTFException("Positions must contain 3 components per vertex");
+    }
+
+    const size_t vertexCount = positions.size() / 3U;
+    const size_t triangleCount = indices.size() / 3U;
+
+    if (normals.size() != vertexCount * 3U || texCoords.size() != vertexCount * 2U)
+    {
+        throw GLTFException("Normal and texture coordinate counts must match the position count");
+    }
+
+    Internal::ValidateTriangleList(indices, vertexCount);
+
+    // As with MikkTSpace, vertices that have identical positions, normals and texture coordinates share a tangent
+    size_t uniqueVertexCount = 0U;
+    const auto remap = MeshOptimizationUtils::GenerateVertexRemap({
+        VertexStream(positions.data(), COMPONENT_FLOAT, 3U),
+        VertexStream(normals.data(), COMPONENT_FLOAT, 3U),
+        VertexStream(texCoords.data(), COMPONENT_FLOAT, 2U) }, vertexCount, uniqueVertexCount, 0.0f, threadCount);
+
+    auto getNormal = [&normals](uint32_t index)
+    {
+        Vector3f normal = GetVector3(normals, index);
+        Normalize(normal);
+        return normal;
+    };
+
+    // The angle weighted tangent and bitangent contributed by each triangle corner, projected onto the corner's tangent plane
+    std::vector<Vector3f> cornerTangents(indices.size());
+    std::vector<Vector3f> cornerBitangents(indices.size());
+
+    ParallelUtils::ParallelFor(triangleCount, [&](size_t begin, size_t end)
+    {
+        for (size_t t = begin; t < end; ++t)
+        {
+            const uint32_t* triangle = &indices[t * 3U];
+
+            const Vector3f p[3] = { GetVector3(positions, triangle[0]), GetVector3(positions, triangle[1]), GetVector3(positions, triangle[2]) };
+
+            const Vector3f d1 = p[1] - p[0];
+            const Vector3f d2 = p[2] - p[0];
+
+            const float s1 = texCoords[triangle[1] * 2U] - texCoords[triangle[0] * 2U];
+            const float t1 = texCoords[triangle[1] * 2U + 1U] - texCoords[triangle[0] * 2U + 1U];
+            const float s2 = texCoords[triangle[2] * 2U] - texCoords[triangle[0] * 2U];
+            const float t2 = texCoords[triangle[2] * 2U + 1U] - texCoords[triangle[0] * 2U + 1U];
+
+            // Twice the signed area of the triangle in texture space, its sign determines the orientation of the basis
+            const float signedArea = s1 * t2 - s2 * t1;
+
+            Vector3f tangent = (d1 * t2 - d2 * t1) * (signedArea < 0.0f ? -1.0f : 1.0f);
+            Vector3f bitangent = (d2 * s1 - d1 * s2) * (signedArea < 0.0f ? -1.0f : 1.0f);
+
+            // Triangles with degenerate texture coordinates don't contribute to the tangent frame
+            const bool isDegenerate = signedArea == 0.0f || !Normalize(tangent) || !Normalize(bitangent);
+
+            for (size_t k = 0; k < 3U; ++k)
+            {
+                cornerTangents[t * 3U + k] = { 0.0f, 0.0f, 0.0f };
+                cornerBitangents[t * 3U + k] = { 0.0f, 0.0f, 0.0f };
+
+                if (isDegenerate)
+                {
+                    continue;
+                }
+
+                const Vector3f normal = getNormal(triangle[k]);
+
+                Vector3f projectedTangent = Project(tangent, normal);
+                Vector3f projectedBitangent = Project(bitangent, normal);
+
+                if (!Normalize(projectedTangent) || !Normalize(projectedBitangent))
+                {
+                    continue;
+                }
+
+                // The corner's angle is measured between the triangle's edges projected onto the tangent plane
+                const Vector3f& corner = p[k];
+                const float angle = GetAngle(Project(p[(k + 1U) % 3U] - corner, normal), Project(p[(k + 2U) % 3U] - corner, normal));
+
+                cornerTangents[t * 3U + k] = projectedTangent * angle;
+                cornerBitangents[t * 3U + k] = projectedBitangent * angle;
+            }
+        }
+    }, threadCount, MinParallelRangeSize);
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> corners;
+
+    GetVertexCorners(indices, remap, uniqueVertexCount, offsets, corners);
+
+    // The first vertex mapped to each unique vertex, used to look up the (shared) normal
+    std::vector<uint32_t> uniqueVertices(uniqueVertexCount, 0U);
+
+    for (size_t v = vertexCount; v-- > 0U;)
+    {
+        uniqueVertices[remap[v]] = static_cast<uint32_t>(v);
+    }
+
+    std::vector<float> uniqueTangents(uniqueVertexCount * 4U);
+
+    ParallelUtils::ParallelFor(uniqueVertexCount, [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            Vector3f tangentSum = { 0.0f, 0.0f, 0.0f };
+            Vector3f bitangentSum = { 0.0f, 0.0f, 0.0f };
+
+            for (uint32_t i = offsets[v]; i < offsets[v + 1U]; ++i)
+            {
+                tangentSum = tangentSum + cornerTangents[corners[i]];
+                bitangentSum = bitangentSum + cornerBitangents[corners[i]];
+            }
+
+            const Vector3f normal = getNormal(uniqueVertices[v]);
+
+            Vector3f tangent = Project(tangentSum, normal);
+
+            if (!Normalize(tangent))
+            {
+                tangent = GetPerpendicular(normal);
+            }
+
+            // The glTF bitangent is cross(normal, tangent.xyz) * tangent.w
+            const float handedness = Dot(Cross(normal, tangent), bitangentSum) < 0.0f ? -1.0f : 1.0f;
+
+            uniqueTangents[v * 4U] = tangent.x;
+            uniqueTangents[v * 4U + 1U] = tangent.y;
+            uniqueTangents[v * 4U + 2U] = tangent.z;
+            uniqueTangents[v * 4U + 3U] = handedness;
+        }
+    }, threadCount, MinParallelRangeSize);
+
+    std::vector<float> tangents(vertexCount * 4U);
+
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        std::copy_n(&uniqueTangents[remap[v] * 4U], 4U, &tangents[v * 4U]);
+    }
+
+    return tangents;
+}
+
+MeshPrimitive TangentSpaceUtils::AddNormals(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+    NormalWeighting weighting, size_t threadCount)
+{
+    Internal::ValidateTriangleMode(meshPrimitive, "used to generate normals and tangents");
+
+    MeshPrimitive output = meshPrimitive;
+
+    if (meshPrimitive.HasAttribute(ACCESSOR_NORMAL))
+    {
+        return output;
+    }
+
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("The BufferBuilder has no buffer to write the normals accessor to");
+    }
+
+    const auto positions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+    const auto indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+
+    const auto normals = GenerateNormals(indices, positions, weighting, threadCount);
+
+    output.attributes[ACCESSOR_NORMAL] = AddVertexAccessor(normals, TYPE_VEC3, bufferBuilder).id;
+
+    return output;
+}
+
+MeshPrimitive TangentSpaceUtils::AddTangents(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder,
+    NormalWeighting weighting, size_t threadCount)
+{
+    Internal::ValidateTriangleMode(meshPrimitive, "used to generate normals and tangents");
+
+    if (meshPrimitive.HasAttribute(ACCESSOR_TANGENT))
+    {
+        return meshPrimitive;
+    }
+
+    if (!meshPrimitive.HasAttribute(ACCESSOR_TEXCOORD_0))
+    {
+        throw GLTFException("Tangents can only be generated for mesh primitives with a TEXCOORD_0 attribute");
+    }
+
+    if (bufferBuilder.GetBufferCount() == 0U)
+    {
+        throw GLTFException("The BufferBuilder has no buffer to write the tangents accessor to");
+    }
+
+    MeshPrimitive output = meshPrimitive;
+
+    const auto positions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+    const auto indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+    const auto texCoords = MeshPrimitiveUtils::GetTexCoords_0(doc, reader, meshPrimitive);
+
+    std::vector<float> normals;
+
+    if (meshPrimitive.HasAttribute(ACCESSOR_NORMAL))
+    {
+        normals = MeshPrimitiveUtils::GetNormals(doc, reader, meshPrimitive);
+    }
+    else
+    {
+        normals = GenerateNormals(indices, positions, weighting, threadCount);
+        output.attributes[ACCESSOR_NORMAL] = AddVertexAccessor(normals, TYPE_VEC3, bufferBuilder).id;
+    }
+
+    const auto tangents = GenerateTangents(indices, positions, normals, texCoords, threadCount);
+
+    output.attributes[ACCESSOR_TANGENT] = AddVertexAccessor(tangents, TYPE_VEC4, bufferBuilder).id;
+
+    return output;
+}
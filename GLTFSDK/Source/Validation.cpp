@@ -4,7 +4,11 @@
 #include <GLTFSDK/Validation.h>
 
 #include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Instrumentation.h>
+#include <GLTFSDK/ParallelUtils.h>
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 #include <limits>
@@ -13,6 +17,20 @@ using namespace Microsoft::glTF;
 
 namespace
 {
+    // Entities validated per range when validating across threads
+    const size_t MinParallelEntityCount = 256U;
+
+    // The index of an entity that isn't known to be part of a document, so has no JSON pointer
+    const size_t NoIndex = std::numeric_limits<size_t>::max();
+
+    // The entity issues are reported against. JSON pointers are only built once an issue has been found.
+    struct EntityRef
+    {
+        const char* type;
+        size_t index;
+        const std::string& id;
+    };
+
     template<typename It>
     std::string Join(It it, It itEnd, const char* const delimiter)
     {
@@ -57,13 +75,121 @@ namespace
         return Join(componentTypeNames.begin(), componentTypeNames.end(), ", ");
     }
 
-    void ValidateAccessorsImpl(const size_t count, const size_t byteOffset, const ComponentType& componentType,
-        const AccessorType& accessorType, const std::string& id, const BufferView& bufferView, const Buffer& buffer)
+    // Escapes a reference token of a JSON pointer (RFC 6901)
+    std::string EscapePointerToken(const std::string& token)
+    {
+        std::string escaped;
+
+        for (const char c : token)
+        {
+            if (c == '~')
+            {
+                escaped += "~0";
+            }
+            else if (c == '/')
+            {
+                escaped += "~1";
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+
+        return escaped;
+    }
+
+    std::string GetPrimitivePointer(size_t primitiveIndex)
+    {
+        return "/primitives/" + std::to_string(primitiveIndex);
+    }
+
+    void AddIssue(std::vector<ValidationIssue>& issues, const EntityRef& entity, const std::string& property, std::string message)
+    {
+        ValidationIssue issue;
+
+        issue.entityType = entity.type;
+        issue.entityId = entity.id;
+        issue.message = std::move(message);
+
+        if (entity.index != NoIndex)
+        {
+            issue.pointer = "/" + issue.entityType + "/" + std::to_string(entity.index) + property;
+        }
+
+        issues.push_back(std::move(issue));
+    }
+
+    // Used by the functions that throw rather than collecting issues
+    void ThrowIfAny(const std::vector<ValidationIssue>& issues)
+    {
+        if (!issues.empty())
+        {
+            throw ValidationException(issues.front().message);
+        }
+    }
+
+    template<typename T>
+    size_t FindIndex(const IndexedContainer<const T>& container, const std::string& id)
+    {
+        return container.Has(id) ? container.GetIndex(id) : NoIndex;
+    }
+
+    bool CheckBufferView(const BufferView& bufferView, const Buffer& buffer, const EntityRef& bufferViewRef, std::vector<ValidationIssue>& issues)
+    {
+        size_t totalBufferViewLength;
+        if (!Validation::SafeAddition(bufferView.byteOffset, bufferView.byteLength, totalBufferViewLength))
+        {
+            AddIssue(issues, bufferViewRef, "/byteLength", "Buffer view size too large");
+            return false;
+        }
+
+        if (totalBufferViewLength > buffer.byteLength)
+        {
+            std::string totalBufferViewLengthStr = std::to_string(totalBufferViewLength);
+            std::string byteLength = std::to_string(buffer.byteLength);
+            AddIssue(issues, bufferViewRef, "/byteLength", "BufferView " + bufferView.bufferId + " offset + length (" + totalBufferViewLengthStr + ") greater than buffer length (" + byteLength + ")");
+            return false;
+        }
+
+        return true;
+    }
+
+    // Finds a buffer view and its buffer, reporting references to entities that don't exist
+    bool ResolveBufferView(const Document& doc, const std::string& bufferViewId, const EntityRef& entity, const std::string& property,
+        const BufferView*& bufferView, const Buffer*& buffer, size_t& bufferViewIndex, std::vector<ValidationIssue>& issues)
+    {
+        bufferViewIndex = FindIndex(doc.bufferViews, bufferViewId);
+
+        if (bufferViewIndex == NoIndex)
+        {
+            AddIssue(issues, entity, property, "Accessor " + entity.id + " refers to buffer view " + bufferViewId + " which doesn't exist");
+            return false;
+        }
+
+        bufferView = &doc.bufferViews[bufferViewIndex];
+
+        const size_t bufferIndex = FindIndex(doc.buffers, bufferView->bufferId);
+
+        if (bufferIndex == NoIndex)
+        {
+            AddIssue(issues, { "bufferViews", bufferViewIndex, bufferView->id }, "/buffer", "BufferView " + bufferView->id + " refers to buffer " + bufferView->bufferId + " which doesn't exist");
+            return false;
+        }
+
+        buffer = &doc.buffers[bufferIndex];
+
+        return true;
+    }
+
+    bool CheckAccessorRange(const size_t count, const size_t byteOffset, const ComponentType& componentType, const AccessorType& accessorType, const std::string& id,
+        const BufferView& bufferView, const Buffer& buffer, const EntityRef& accessorRef, const std::string& property, const EntityRef& bufferViewRef, std::vector<ValidationIssue>& issues)
     {
         if (byteOffset > bufferView.byteLength)
         {
             std::string byteLength = std::to_string(bufferView.byteLength);
-            throw ValidationException("Accessor" + id + " byteoffset (" + std::to_string(byteOffset) + ") is larger than bufferview byte length (" + byteLength + ")");
+            AddIssue(issues, accessorRef, property + "/byteOffset", "Accessor" + id + " byteoffset (" + std::to_string(byteOffset) + ") is larger than bufferview byte length (" + byteLength + ")");
+            return false;
         }
 
         // Check the multiplication in accessor.GetByteLength() for overflow
@@ -73,39 +199,102 @@ namespace
                 Accessor::GetTypeCount(accessorType))),
             testAccessorByteLength))
         {
-            throw ValidationException("Accessor" + id + " byte length too large");
+            AddIssue(issues, accessorRef, property + "/count", "Accessor" + id + " byte length too large");
+            return false;
         }
 
         size_t byteLength = static_cast<size_t>(count * Accessor::GetComponentTypeSize(componentType) * Accessor::GetTypeCount(accessorType));
 
         if (testAccessorByteLength != byteLength)
         {
-            throw ValidationException("Accessor" + id + " byte length safe value does not match actual value");
+            AddIssue(issues, accessorRef, property + "/count", "Accessor" + id + " byte length safe value does not match actual value");
+            return false;
         }
 
         size_t totalAccessorRange;
         if (!Validation::SafeAddition(byteOffset, byteLength, totalAccessorRange))
         {
-            throw ValidationException("Accessor" + id + " byte offset + byte length overflow");
+            AddIssue(issues, accessorRef, property + "/byteOffset", "Accessor" + id + " byte offset + byte length overflow");
+            return false;
         }
 
         if (totalAccessorRange > bufferView.byteLength)
         {
             std::string accessorByteLengthStr = std::to_string(byteLength);
             std::string bvByteLength = std::to_string(bufferView.byteLength);
-            throw ValidationException("Accessor" + id + " byte offset + byte length (" + std::to_string(byteOffset) + " + " + accessorByteLengthStr + ") greater than buffer view (" + bvByteLength + ")");
+            AddIssue(issues, accessorRef, property + "/count", "Accessor" + id + " byte offset + byte length (" + std::to_string(byteOffset) + " + " + accessorByteLengthStr + ") greater than buffer view (" + bvByteLength + ")");
+            return false;
         }
 
         short accessorComponentTypeSize = Accessor::GetComponentTypeSize(componentType);
         if ((byteOffset + bufferView.byteOffset) % accessorComponentTypeSize != 0)
         {
-            throw ValidationException("Accessor" + id + ": the accessor offset must be a multiple of the size of the accessor component type.");
+            AddIssue(issues, accessorRef, property + "/byteOffset", "Accessor" + id + ": the accessor offset must be a multiple of the size of the accessor component type.");
+            return false;
         }
 
-        Validation::ValidateBufferView(bufferView, buffer);
+        return CheckBufferView(bufferView, buffer, bufferViewRef, issues);
     }
 
-    void ValidateVertexCount(const MeshMode mode, const size_t count, const std::string& type)
+    bool CheckAccessor(const Document& doc, const Accessor& accessor, const EntityRef& accessorRef, std::vector<ValidationIssue>& issues)
+    {
+        const BufferView* bufferView;
+        const Buffer* buffer;
+        size_t bufferViewIndex;
+
+        if (!accessor.bufferViewId.empty())
+        {
+            if (!ResolveBufferView(doc, accessor.bufferViewId, accessorRef, "/bufferView", bufferView, buffer, bufferViewIndex, issues)
+                || !CheckAccessorRange(accessor.count, accessor.byteOffset, accessor.componentType, accessor.type, accessor.id,
+                    *bufferView, *buffer, accessorRef, "", { "bufferViews", bufferViewIndex, bufferView->id }, issues))
+            {
+                return false;
+            }
+        }
+
+        if (accessor.sparse.count > 0U)
+        {
+            if (!ResolveBufferView(doc, accessor.sparse.indicesBufferViewId, accessorRef, "/sparse/indices/bufferView", bufferView, buffer, bufferViewIndex, issues)
+                || !CheckAccessorRange(accessor.sparse.count, accessor.sparse.indicesByteOffset, accessor.sparse.indicesComponentType, TYPE_SCALAR, accessor.id + "_sparseIndices",
+                    *bufferView, *buffer, accessorRef, "/sparse/indices", { "bufferViews", bufferViewIndex, bufferView->id }, issues))
+            {
+                return false;
+            }
+
+            if (!ResolveBufferView(doc, accessor.sparse.valuesBufferViewId, accessorRef, "/sparse/values/bufferView", bufferView, buffer, bufferViewIndex, issues)
+                || !CheckAccessorRange(accessor.sparse.count, accessor.sparse.valuesByteOffset, accessor.componentType, accessor.type, accessor.id + "_sparseValues",
+                    *bufferView, *buffer, accessorRef, "/sparse/values", { "bufferViews", bufferViewIndex, bufferView->id }, issues))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool CheckAccessorTypes(const Accessor& accessor, const std::string& accessorName, const std::set<AccessorType>& accessorTypes, const std::set<ComponentType>& componentTypes,
+        const EntityRef& entity, const std::string& property, std::vector<ValidationIssue>& issues)
+    {
+        if (accessorTypes.find(accessor.type) == accessorTypes.end())
+        {
+            AddIssue(issues, entity, property,
+                "Accessor " + accessor.id + " " + accessorName + " type must be: [" + GetAccessorTypesAsString(accessorTypes) + "]"
+            );
+            return false;
+        }
+
+        if (componentTypes.find(accessor.componentType) == componentTypes.end())
+        {
+            AddIssue(issues, entity, property,
+                "Accessor " + accessor.id + " " + accessorName + " componentType must be: [" + GetComponentTypesAsString(componentTypes) + "]"
+            );
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CheckVertexCount(const MeshMode mode, const size_t count, const std::string& type, const EntityRef& meshRef, const std::string& property, std::vector<ValidationIssue>& issues)
     {
         switch (mode)
         {
@@ -115,12 +304,14 @@ namespace
         case MESH_LINES:
             if (count < 2)
             {
-                throw ValidationException(type + " count must be at least 2.");
+                AddIssue(issues, meshRef, property, type + " count must be at least 2.");
+                return false;
             }
 
             if (count % 2 != 0)
             {
-                throw ValidationException(type + " count for MESH_LINES must be a multiple of 2.");
+                AddIssue(issues, meshRef, property, type + " count for MESH_LINES must be a multiple of 2.");
+                return false;
             }
             break;
 
@@ -128,19 +319,22 @@ namespace
         case MESH_LINE_STRIP:
             if (count < 2)
             {
-                throw ValidationException(type + " count must be at least 2.");
+                AddIssue(issues, meshRef, property, type + " count must be at least 2.");
+                return false;
             }
             break;
 
         case MESH_TRIANGLES:
             if (count < 3)
             {
-                throw ValidationException(type + " count must be at least 3.");
+                AddIssue(issues, meshRef, property, type + " count must be at least 3.");
+                return false;
             }
 
             if (count % 3 != 0)
             {
-                throw ValidationException(type + " count for MESH_TRIANGLES must be a multiple of 3.");
+                AddIssue(issues, meshRef, property, type + " count for MESH_TRIANGLES must be a multiple of 3.");
+                return false;
             }
             break;
 
@@ -148,21 +342,233 @@ namespace
         case MESH_TRIANGLE_STRIP:
             if (count < 3)
             {
-                throw ValidationException(type + " count must be at least 3.");
+                AddIssue(issues, meshRef, property, type + " count must be at least 3.");
+                return false;
             }
             break;
 
         default:
-            throw ValidationException(type + " invalid mesh mode for validation " + std::to_string(mode));
-            break;
+            AddIssue(issues, meshRef, property, type + " invalid mesh mode for validation " + std::to_string(mode));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CheckMeshPrimitiveAttributeAccessors(const Document& doc, const std::unordered_map<std::string, std::string>& attributes, const size_t vertexCount,
+        const EntityRef& meshRef, size_t primitiveIndex, std::vector<ValidationIssue>& issues)
+    {
+        // https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#meshes
+        static const std::unordered_map <std::string, std::pair<std::set<AccessorType>, std::set<ComponentType>>> attributeDefinitions =
+        {
+            { ACCESSOR_POSITION,   { { TYPE_VEC3 },            { COMPONENT_FLOAT } } },
+            { ACCESSOR_NORMAL,     { { TYPE_VEC3 },            { COMPONENT_FLOAT } } },
+            { ACCESSOR_TANGENT,    { { TYPE_VEC4 },            { COMPONENT_FLOAT } } },
+            { ACCESSOR_TEXCOORD_0, { { TYPE_VEC2 },            { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
+            { ACCESSOR_TEXCOORD_1, { { TYPE_VEC2 },            { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
+            { ACCESSOR_COLOR_0,    { { TYPE_VEC3, TYPE_VEC4 }, { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
+            { ACCESSOR_JOINTS_0,   { { TYPE_VEC4 },            {                  COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
+            { ACCESSOR_WEIGHTS_0,  { { TYPE_VEC4 },            { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } }
+        };
+
+        bool isValid = true;
+
+        // TODO: Validate by prefix TEXCOORD_/COLOR_/JOINTS_/WEIGHTS_ 
+        for (const auto& attribute : attributes)
+        {
+            const auto& attributeName = attribute.first;
+            const auto& attributeAccessorId = attribute.second;
+
+            const auto it = attributeDefinitions.find(attributeName);
+            if (it != attributeDefinitions.end())
+            {
+                const size_t accessorIndex = FindIndex(doc.accessors, attributeAccessorId);
+
+                if (accessorIndex == NoIndex)
+                {
+                    AddIssue(issues, meshRef, GetPrimitivePointer(primitiveIndex) + "/attributes/" + EscapePointerToken(attributeName),
+                        "MeshPrimitive attribute '" + attributeName + "' refers to accessor " + attributeAccessorId + " which doesn't exist");
+                    isValid = false;
+                    continue;
+                }
+
+                const auto& accessor = doc.accessors[accessorIndex];
+
+                if (!CheckAccessorTypes(accessor, attributeName, it->second.first, it->second.second,
+                    meshRef, GetPrimitivePointer(primitiveIndex) + "/attributes/" + EscapePointerToken(attributeName), issues))
+                {
+                    isValid = false;
+                    continue;
+                }
+
+                if (accessor.count != vertexCount)
+                {
+                    AddIssue(issues, meshRef, GetPrimitivePointer(primitiveIndex) + "/attributes/" + EscapePointerToken(attributeName),
+                        "MeshPrimitive attribute '" + std::string(attributeName) + "' had an incorrect count ("
+                        + std::to_string(accessor.count) + " vs. " + std::to_string(vertexCount));
+                    isValid = false;
+                }
+            }
         }
+
+        return isValid;
     }
+
+    bool CheckMeshPrimitive(const Document& doc, const MeshPrimitive& primitive, const EntityRef& meshRef, size_t primitiveIndex, std::vector<ValidationIssue>& issues)
+    {
+        std::string positionsAccessorId;
+
+        if (!primitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, positionsAccessorId))
+        {
+            AddIssue(issues, meshRef, GetPrimitivePointer(primitiveIndex) + "/attributes", "MeshPrimitive must have 'POSITION' attribute.");
+            return false;
+        }
+
+        const size_t positionsIndex = FindIndex(doc.accessors, positionsAccessorId);
+
+        if (positionsIndex == NoIndex)
+        {
+            AddIssue(issues, meshRef, GetPrimitivePointer(primitiveIndex) + "/attributes/POSITION",
+                "MeshPrimitive attribute 'POSITION' refers to accessor " + positionsAccessorId + " which doesn't exist");
+            return false;
+        }
+
+        size_t vertexCount = doc.accessors[positionsIndex].count;
+
+        bool isValid = true;
+
+        const auto& indicesAccessorId = primitive.indicesAccessorId;
+        if (!indicesAccessorId.empty())
+        {
+            const size_t indicesIndex = FindIndex(doc.accessors, indicesAccessorId);
+
+            if (indicesIndex == NoIndex)
+            {
+                AddIssue(issues, meshRef, GetPrimitivePointer(primitiveIndex) + "/indices", "MeshPrimitive indices refer to accessor " + indicesAccessorId + " which doesn't exist");
+                isValid = false;
+            }
+            else
+            {
+                const auto& indicesAccessor = doc.accessors[indicesIndex];
+
+                isValid = CheckAccessorTypes(indicesAccessor, "indices", { TYPE_SCALAR }, { COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT, COMPONENT_UNSIGNED_INT },
+                        meshRef, GetPrimitivePointer(primitiveIndex) + "/indices", issues)
+                    && CheckVertexCount(primitive.mode, indicesAccessor.count, "Index", meshRef, GetPrimitivePointer(primitiveIndex) + "/indices", issues);
+            }
+        }
+        else
+        {
+            isValid = CheckVertexCount(primitive.mode, vertexCount, "Position", meshRef, GetPrimitivePointer(primitiveIndex) + "/mode", issues);
+        }
+
+        // Attributes are checked even if the vertex count isn't valid so that every issue is reported
+        const bool areAttributesValid = CheckMeshPrimitiveAttributeAccessors(doc, primitive.attributes, vertexCount, meshRef, primitiveIndex, issues);
+
+        return isValid && areAttributesValid;
+    }
+
+    template<typename Fn>
+    std::exception_ptr GetError(Fn fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (...)
+        {
+            return std::current_exception();
+        }
+
+        return nullptr;
+    }
+
+    template<typename Entry>
+    void EraseUnseen(std::unordered_map<std::string, Entry>& entries, size_t stamp)
+    {
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            it = (it->second.seenAt == stamp) ? std::next(it) : entries.erase(it);
+        }
+    }
+}
+
+void ValidationReport::Add(ValidationIssue issue)
+{
+    m_issues.push_back(std::move(issue));
+}
+
+void ValidationReport::Add(std::vector<ValidationIssue> issues)
+{
+    if (m_issues.empty())
+    {
+        m_issues = std::move(issues);
+    }
+    else
+    {
+        std::move(issues.begin(), issues.end(), std::back_inserter(m_issues));
+    }
+}
+
+const std::vector<ValidationIssue>& ValidationReport::GetIssues() const
+{
+    return m_issues;
+}
+
+size_t ValidationReport::GetIssueCount(ValidationSeverity severity) const
+{
+    return static_cast<size_t>(std::count_if(m_issues.begin(), m_issues.end(), [severity](const ValidationIssue& issue) { return issue.severity == severity; }));
+}
+
+bool ValidationReport::HasErrors() const
+{
+    return std::any_of(m_issues.begin(), m_issues.end(), [](const ValidationIssue& issue) { return issue.severity == ValidationSeverity::Error; });
 }
 
 void Validation::Validate(const Document& doc)
 {
-    ValidateAccessors(doc);
-    ValidateMeshes(doc);
+    ValidationReport report;
+    Validate(doc, report);
+    ThrowIfAny(report.GetIssues());
+}
+
+void Validation::Validate(const Document& doc, ValidationReport& report, size_t threadCount)
+{
+    GLTFSDK_INSTRUMENT_SCOPE("Validation::Validate");
+
+    const auto& accessors = doc.accessors.Elements();
+    const auto& meshes = doc.meshes.Elements();
+
+    // Issues are collected per entity so that they are reported in document order, regardless of thread scheduling
+    std::vector<std::vector<ValidationIssue>> entityIssues(accessors.size() + meshes.size());
+
+    ParallelUtils::ParallelFor(entityIssues.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (i < accessors.size())
+            {
+                CheckAccessor(doc, accessors[i], { "accessors", i, accessors[i].id }, entityIssues[i]);
+            }
+            else
+            {
+                const size_t meshIndex = i - accessors.size();
+                const auto& mesh = meshes[meshIndex];
+
+                for (size_t p = 0; p < mesh.primitives.size(); ++p)
+                {
+                    CheckMeshPrimitive(doc, mesh.primitives[p], { "meshes", meshIndex, mesh.id }, p, entityIssues[i]);
+                }
+            }
+        }
+    }, threadCount, MinParallelEntityCount);
+
+    for (auto& issues : entityIssues)
+    {
+        if (!issues.empty())
+        {
+            report.Add(std::move(issues));
+        }
+    }
 }
 
 void Validation::ValidateAccessors(const Document& doc)
@@ -186,26 +592,9 @@ void Validation::ValidateMeshes(const Document& doc)
 
 void Validation::ValidateMeshPrimitive(const Document& doc, const MeshPrimitive& primitive)
 {
-    if (!primitive.HasAttribute(ACCESSOR_POSITION))
-    {
-        throw ValidationException("MeshPrimitive must have 'POSITION' attribute.");
-    }
-
-    size_t vertexCount = doc.accessors.Get(primitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
-
-    const auto& indicesAccessorId = primitive.indicesAccessorId;
-    if (!indicesAccessorId.empty())
-    {
-        const auto& indicesAccessor = doc.accessors.Get(indicesAccessorId);
-        ValidateAccessorTypes(indicesAccessor, "indices", { TYPE_SCALAR }, { COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT, COMPONENT_UNSIGNED_INT });
-        ValidateVertexCount(primitive.mode, indicesAccessor.count, "Index");
-    }
-    else
-    {
-        ValidateVertexCount(primitive.mode, vertexCount, "Position");
-    }
-
-    ValidateMeshPrimitiveAttributeAccessors(doc, primitive.attributes, vertexCount);
+    std::vector<ValidationIssue> issues;
+    CheckMeshPrimitive(doc, primitive, { "meshes", NoIndex, std::string() }, 0U, issues);
+    ThrowIfAny(issues);
 }
 
 void Validation::ValidateMeshPrimitiveAttributeAccessors(
@@ -214,39 +603,9 @@ void Validation::ValidateMeshPrimitiveAttributeAccessors(
     const size_t vertexCount
 )
 {
-    // https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#meshes
-    static const std::unordered_map <std::string, std::pair<std::set<AccessorType>, std::set<ComponentType>>> attributeDefinitions =
-    {
-        { ACCESSOR_POSITION,   { { TYPE_VEC3 },            { COMPONENT_FLOAT } } },
-        { ACCESSOR_NORMAL,     { { TYPE_VEC3 },            { COMPONENT_FLOAT } } },
-        { ACCESSOR_TANGENT,    { { TYPE_VEC4 },            { COMPONENT_FLOAT } } },
-        { ACCESSOR_TEXCOORD_0, { { TYPE_VEC2 },            { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
-        { ACCESSOR_TEXCOORD_1, { { TYPE_VEC2 },            { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
-        { ACCESSOR_COLOR_0,    { { TYPE_VEC3, TYPE_VEC4 }, { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
-        { ACCESSOR_JOINTS_0,   { { TYPE_VEC4 },            {                  COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } },
-        { ACCESSOR_WEIGHTS_0,  { { TYPE_VEC4 },            { COMPONENT_FLOAT, COMPONENT_UNSIGNED_BYTE, COMPONENT_UNSIGNED_SHORT } } }
-    };
-
-    // TODO: Validate by prefix TEXCOORD_/COLOR_/JOINTS_/WEIGHTS_ 
-    for (const auto& attribute : attributes)
-    {
-        const auto& attributeName = attribute.first;
-        const auto& attributeAccessorId = attribute.second;
-
-        const auto it = attributeDefinitions.find(attributeName);
-        if (it != attributeDefinitions.end())
-        {
-            const auto& accessor = doc.accessors.Get(attributeAccessorId);
-            ValidateAccessorTypes(accessor, attributeName, it->second.first, it->second.second);
-
-            if (accessor.count != vertexCount)
-            {
-                throw ValidationException(
-                    "MeshPrimitive attribute '" + std::string(attributeName) + "' had an incorrect count ("
-                    + std::to_string(accessor.count) + " vs. " + std::to_string(vertexCount));
-            }
-        }
-    }
+    std::vector<ValidationIssue> issues;
+    CheckMeshPrimitiveAttributeAccessors(doc, attributes, vertexCount, { "meshes", NoIndex, std::string() }, 0U, issues);
+    ThrowIfAny(issues);
 }
 
 void Validation::ValidateAccessorTypes(
@@ -256,60 +615,23 @@ void Validation::ValidateAccessorTypes(
     const std::set<ComponentType>& componentTypes
 )
 {
-    if (accessorTypes.find(accessor.type) == accessorTypes.end())
-    {
-        throw ValidationException(
-            "Accessor " + accessor.id + " " + accessorName + " type must be: [" + GetAccessorTypesAsString(accessorTypes) + "]"
-        );
-    }
-
-    if (componentTypes.find(accessor.componentType) == componentTypes.end())
-    {
-        throw ValidationException(
-            "Accessor " + accessor.id + " " + accessorName + " componentType must be: [" + GetComponentTypesAsString(componentTypes) + "]"
-        );
-    }
+    std::vector<ValidationIssue> issues;
+    CheckAccessorTypes(accessor, accessorName, accessorTypes, componentTypes, { "accessors", NoIndex, accessor.id }, "", issues);
+    ThrowIfAny(issues);
 }
 
 void Validation::ValidateAccessor(const Document& gltfDocument, const Accessor& accessor)
 {
-    if (!accessor.bufferViewId.empty())
-    {
-        const BufferView& bufferView = gltfDocument.bufferViews.Get(accessor.bufferViewId);
-        const Buffer& buffer = gltfDocument.buffers.Get(bufferView.bufferId);
-        ValidateAccessorsImpl(accessor.count, accessor.byteOffset, accessor.componentType, accessor.type, accessor.id, bufferView, buffer);
-    }
-
-    if (accessor.sparse.count > 0U) 
-    {
-        const BufferView& indicesBufferView = gltfDocument.bufferViews.Get(accessor.sparse.indicesBufferViewId);
-        const Buffer& indicesBuffer = gltfDocument.buffers.Get(indicesBufferView.bufferId);
-        std::string indices_id = accessor.id + "_sparseIndices";
-        ValidateAccessorsImpl(accessor.sparse.count, accessor.sparse.indicesByteOffset, accessor.sparse.indicesComponentType,
-            TYPE_SCALAR, indices_id, indicesBufferView, indicesBuffer);
-
-        const BufferView& valuesBufferView = gltfDocument.bufferViews.Get(accessor.sparse.valuesBufferViewId);
-        const Buffer& valuesBuffer = gltfDocument.buffers.Get(valuesBufferView.bufferId);
-        std::string values_id = accessor.id + "_sparseValues";
-        ValidateAccessorsImpl(accessor.sparse.count, accessor.sparse.valuesByteOffset, accessor.componentType,
-            accessor.type, values_id, valuesBufferView, valuesBuffer);
-    }
+    std::vector<ValidationIssue> issues;
+    CheckAccessor(gltfDocument, accessor, { "accessors", NoIndex, accessor.id }, issues);
+    ThrowIfAny(issues);
 }
 
 void Validation::ValidateBufferView(const BufferView& buffer_view, const Buffer& buffer)
 {
-    size_t totalBufferViewLength;
-    if (!SafeAddition(buffer_view.byteOffset, buffer_view.byteLength, totalBufferViewLength))
-    {
-        throw ValidationException("Buffer view size too large");
-    }
-
-    if (totalBufferViewLength > buffer.byteLength)
-    {
-        std::string totalBufferViewLengthStr = std::to_string(totalBufferViewLength);
-        std::string byteLength = std::to_string(buffer.byteLength);
-        throw ValidationException("BufferView " + buffer_view.bufferId + " offset + length (" + totalBufferViewLengthStr + ") greater than buffer length (" + byteLength + ")");
-    }
+    std::vector<ValidationIssue> issues;
+    CheckBufferView(buffer_view, buffer, { "bufferViews", NoIndex, buffer_view.id }, issues);
+    ThrowIfAny(issues);
 }
 
 // Figure out if the two arguments, when summed, will overflow a size_t or not.
@@ -346,4 +668,254 @@ bool Validation::SafeMultiplication(size_t a, size_t b, size_t& result)
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+ValidationCache::ValidationCache() : m_stamp(0U), m_validationCount(0U)
+{
+}
+
+void ValidationCache::Validate(const Document& doc, size_t threadCount)
+{
+    GLTFSDK_INSTRUMENT_SCOPE("ValidationCache::Validate");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const size_t stamp = ++m_stamp;
+
+    // Find (or create) every entity's entry up front so they can be updated across threads without modifying the maps
+    const auto& accessors = doc.accessors.Elements();
+    const auto& meshes = doc.meshes.Elements();
+
+    std::vector<AccessorEntry*> accessorEntries(accessors.size());
+    std::vector<MeshEntry*> meshEntries(meshes.size());
+
+    for (size_t i = 0; i < accessors.size(); ++i)
+    {
+        accessorEntries[i] = &m_accessors[accessors[i].id];
+        accessorEntries[i]->seenAt = stamp;
+    }
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        meshEntries[i] = &m_meshes[meshes[i].id];
+        meshEntries[i]->seenAt = stamp;
+    }
+
+    EraseUnseen(m_accessors, stamp);
+    EraseUnseen(m_meshes, stamp);
+
+    ParallelUtils::ParallelFor(accessors.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto& accessor = accessors[i];
+            auto& entry = *accessorEntries[i];
+
+            AccessorSignature signature;
+            const bool hasSignature = TryGetSignature(doc, accessor, signature);
+
+            if (hasSignature && entry.isCached && entry.signature == signature)
+            {
+                continue;
+            }
+
+            entry.error = GetError([&doc, &accessor]() { Validation::ValidateAccessor(doc, accessor); });
+            entry.signature = signature;
+            entry.isCached = hasSignature;
+            entry.changedAt = stamp;
+
+            ++m_validationCount;
+        }
+    }, threadCount, MinParallelEntityCount);
+
+    for (const auto entry : accessorEntries)
+    {
+        if (entry->error)
+        {
+            std::rethrow_exception(entry->error);
+        }
+    }
+
+    ParallelUtils::ParallelFor(meshes.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto& mesh = meshes[i];
+            auto& entry = *meshEntries[i];
+
+            if (entry.isCached && entry.mesh == mesh && !HasChangedAccessors(mesh, entry.validatedAt))
+            {
+                continue;
+            }
+
+            entry.error = GetError([&doc, &mesh]()
+            {
+                for (const auto& primitive : mesh.primitives)
+                {
+                    Validation::ValidateMeshPrimitive(doc, primitive);
+                }
+            });
+            entry.mesh = mesh;
+            entry.isCached = true;
+            entry.validatedAt = stamp;
+
+            ++m_validationCount;
+        }
+    }, threadCount, MinParallelEntityCount);
+
+    for (const auto entry : meshEntries)
+    {
+        if (entry->error)
+        {
+            std::rethrow_exception(entry->error);
+        }
+    }
+}
+
+void ValidationCache::ValidateAccessor(const Document& doc, const Accessor& accessor)
+{
+    AccessorSignature signature;
+
+    // Accessors without an id, or that refer to buffer views or buffers that don't exist, aren't cached
+    if (accessor.id.empty() || !TryGetSignature(doc, accessor, signature))
+    {
+        ++m_validationCount;
+        Validation::ValidateAccessor(doc, accessor);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto it = m_accessors.find(accessor.id);
+
+        if (it != m_accessors.end() && it->second.isCached && it->second.signature == signature)
+        {
+            if (it->second.error)
+            {
+                std::rethrow_exception(it->second.error);
+            }
+
+            return;
+        }
+    }
+
+    // Validate without holding the lock so that other accessors can be read meanwhile
+    const auto error = GetError([&doc, &accessor]() { Validation::ValidateAccessor(doc, accessor); });
+    ++m_validationCount;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto& entry = m_accessors[accessor.id];
+
+        entry.signature = signature;
+        entry.error = error;
+        entry.isCached = true;
+        entry.changedAt = ++m_stamp;
+        entry.seenAt = entry.changedAt;
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+size_t ValidationCache::GetValidationCount() const
+{
+    return m_validationCount;
+}
+
+void ValidationCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_accessors.clear();
+    m_meshes.clear();
+}
+
+bool ValidationCache::TryGetSignature(const Document& doc, const Accessor& accessor, AccessorSignature& signature)
+{
+    // Writes the byte offset and length of a buffer view, and the byte length of its buffer, to three elements
+    auto getBufferView = [&doc](const std::string& bufferViewId, size_t* output)
+    {
+        if (!doc.bufferViews.Has(bufferViewId))
+        {
+            return false;
+        }
+
+        const auto& bufferView = doc.bufferViews.Get(bufferViewId);
+
+        if (!doc.buffers.Has(bufferView.bufferId))
+        {
+            return false;
+        }
+
+        output[0] = bufferView.byteOffset;
+        output[1] = bufferView.byteLength;
+        output[2] = doc.buffers.Get(bufferView.bufferId).byteLength;
+
+        return true;
+    };
+
+    signature.fill(0U);
+
+    signature[0] = accessor.count;
+    signature[1] = accessor.byteOffset;
+    signature[2] = static_cast<size_t>(accessor.componentType);
+    signature[3] = static_cast<size_t>(accessor.type);
+
+    if (!accessor.bufferViewId.empty())
+    {
+        signature[4] = 1U;
+
+        if (!getBufferView(accessor.bufferViewId, &signature[5]))
+        {
+            return false;
+        }
+    }
+
+    if (accessor.sparse.count > 0U)
+    {
+        signature[8] = accessor.sparse.count;
+        signature[9] = accessor.sparse.indicesByteOffset;
+        signature[10] = static_cast<size_t>(accessor.sparse.indicesComponentType);
+        signature[14] = accessor.sparse.valuesByteOffset;
+
+        if (!getBufferView(accessor.sparse.indicesBufferViewId, &signature[11])
+            || !getBufferView(accessor.sparse.valuesBufferViewId, &signature[15]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ValidationCache::HasChangedAccessors(const Mesh& mesh, size_t validatedAt) const
+{
+    auto hasChanged = [this, validatedAt](const std::string& accessorId)
+    {
+        const auto it = m_accessors.find(accessorId);
+        return it == m_accessors.end() || it->second.changedAt > validatedAt;
+    };
+
+    for (const auto& primitive : mesh.primitives)
+    {
+        if (!primitive.indicesAccessorId.empty() && hasChanged(primitive.indicesAccessorId))
+        {
+            return true;
+        }
+
+        for (const auto& attribute : primitive.attributes)
+        {
+            if (hasChanged(attribute.second))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}